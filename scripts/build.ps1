@@ -60,6 +60,9 @@ This script provides helpers for building msquic.
 .PARAMETER UseXdp
     Enables XDP support (Linux-only).
 
+.PARAMETER UseDpdk
+    Enables DPDK support (Linux-only).
+
 .PARAMETER Generator
     Specifies a specific cmake generator (Only supported on unix)
 
@@ -174,6 +177,9 @@ param (
     [Parameter(Mandatory = $false)]
     [switch]$UseXdp = $false,
 
+    [Parameter(Mandatory = $false)]
+    [switch]$UseDpdk = $false,
+
     [Parameter(Mandatory = $false)]
     [string]$Generator = "",
 
@@ -279,6 +285,10 @@ if ($IsLinux -And $Arch -ne "x64") {
     }
 }
 
+if ($UseXdp -and $UseDpdk) {
+    Write-Error "XDP and DPDK can't both be enabled"
+}
+
 if ($Platform -eq "ios" -and !$Static) {
     $Static = $true
     Write-Host "iOS can only be built as static"
@@ -474,6 +484,9 @@ function CMake-Generate {
     if ($UseXdp) {
         $Arguments += " -DQUIC_LINUX_XDP_ENABLED=on"
     }
+    if ($UseDpdk) {
+        $Arguments += " -DQUIC_LINUX_DPDK_ENABLED=on"
+    }
     if ($Platform -eq "uwp") {
         $Arguments += " -DCMAKE_SYSTEM_NAME=WindowsStore -DCMAKE_SYSTEM_VERSION=10.0 -DQUIC_UWP_BUILD=on"
     }
@@ -0,0 +1,34 @@
+#!/bin/bash
+
+# Runs the UDP datapath tests over the DPDK datapath, on the DuoNic veth pair
+# (see duonic.sh), without a DPDK capable NIC or hugepages. DPDK drives duo1
+# through the AF_PACKET PMD, so the test traffic crosses the real DPDK Rx/Tx
+# paths.
+#
+# Usage: dpdk-loopback.sh <path to msquicplatformtest> [gtest filter]
+
+set -e
+
+if [ -z "$1" ]; then
+    echo "Usage: $0 <path to msquicplatformtest> [gtest filter]"
+    exit 1
+fi
+
+TestPath=$(realpath "$1")
+Filter=${2:-"DataPathTest/DataPathTest.Udp*"}
+ScriptDir=$(dirname "$(realpath "$0")")
+
+if ! ip link show duo1 > /dev/null 2>&1; then
+    bash "$ScriptDir/duonic.sh" install
+fi
+
+# The DPDK datapath reads dpdk.ini from the working directory.
+WorkDir=$(mktemp -d)
+trap 'rm -rf "$WorkDir"' EXIT
+cat > "$WorkDir/dpdk.ini" << EOF
+Vdev=net_af_packet0,iface=duo1
+NoHuge=1
+EOF
+
+cd "$WorkDir"
+sudo "$TestPath" --duoNic --gtest_filter="$Filter"
@@ -78,6 +78,9 @@ param (
     [Parameter(Mandatory = $false)]
     [switch]$ForceXdpInstall,
 
+    [Parameter(Mandatory = $false)]
+    [switch]$UseDpdk,
+
     [Parameter(Mandatory = $false)]
     [switch]$InstallArm64Toolchain,
 
@@ -562,6 +565,11 @@ if ($IsLinux) {
             sudo apt-get -y install libxdp-dev libbpf-dev
             sudo apt-get -y install libnl-3-dev libnl-genl-3-dev libnl-route-3-dev zlib1g-dev zlib1g pkg-config m4 clang libpcap-dev libelf-dev
         }
+
+        # DPDK dependencies
+        if ($UseDpdk) {
+            sudo apt-get -y install dpdk-dev libnl-3-dev libnl-route-3-dev pkg-config
+        }
     }
 
     if ($ForTest) {
@@ -580,6 +588,11 @@ if ($IsLinux) {
             sudo apt-get install -y iproute2 iptables
             Install-DuoNic
         }
+        if ($UseDpdk) {
+            sudo apt-get install -y dpdk libnl-3-200 libnl-route-3-200
+            sudo apt-get install -y iproute2 iptables
+            Install-DuoNic
+        }
 
         # Enable core dumps for the system.
         Write-Host "Setting core dump size limit"
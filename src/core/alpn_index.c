@@ -0,0 +1,166 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    ALPN to listener index for a binding.
+
+    Without the index, finding the listener for a new connection means walking
+    every listener on the binding and comparing each of its ALPNs against the
+    client's list. With many ALPNs on one binding that cost is paid by every
+    new connection. The index is a hash table with an entry per listener ALPN,
+    so a lookup only costs one probe per client ALPN. The index is immutable
+    once built; the binding builds a new one whenever a listener is registered
+    or unregistered.
+
+--*/
+
+#include "precomp.h"
+#ifdef QUIC_CLOG
+#include "alpn_index.c.clog.h"
+#endif
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+_Ret_maybenull_
+QUIC_ALPN_INDEX*
+QuicAlpnIndexCreate(
+    _In_ const CXPLAT_LIST_ENTRY* Listeners
+    )
+{
+    uint32_t EntryCount = 0;
+    for (const CXPLAT_LIST_ENTRY* Link = Listeners->Flink;
+        Link != Listeners;
+        Link = Link->Flink) {
+        const QUIC_LISTENER* Listener =
+            CXPLAT_CONTAINING_RECORD(Link, QUIC_LISTENER, Link);
+        uint16_t Offset = 0;
+        while (Offset < Listener->AlpnListLength) {
+            Offset += Listener->AlpnList[Offset] + 1;
+            EntryCount++;
+        }
+    }
+
+    if (EntryCount == 0) {
+        return NULL;
+    }
+
+    const size_t IndexSize =
+        sizeof(QUIC_ALPN_INDEX) + EntryCount * sizeof(QUIC_ALPN_INDEX_ENTRY);
+    QUIC_ALPN_INDEX* Index = CXPLAT_ALLOC_NONPAGED(IndexSize, QUIC_POOL_ALPN_INDEX);
+    if (Index == NULL) {
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "QUIC_ALPN_INDEX",
+            IndexSize);
+        return NULL;
+    }
+
+    if (!CxPlatHashtableInitializeEx(&Index->Table, CXPLAT_HASH_MIN_SIZE)) {
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "QUIC_ALPN_INDEX table",
+            0);
+        CXPLAT_FREE(Index, QUIC_POOL_ALPN_INDEX);
+        return NULL;
+    }
+
+    Index->EntryCount = 0;
+    uint32_t ListenerOrdinal = 0;
+    for (const CXPLAT_LIST_ENTRY* Link = Listeners->Flink;
+        Link != Listeners;
+        Link = Link->Flink, ++ListenerOrdinal) {
+        QUIC_LISTENER* Listener =
+            CXPLAT_CONTAINING_RECORD(Link, QUIC_LISTENER, Link);
+        uint16_t Offset = 0;
+        uint32_t AlpnOrdinal = 0;
+        while (Offset < Listener->AlpnListLength) {
+            QUIC_ALPN_INDEX_ENTRY* Entry = &Index->Entries[Index->EntryCount++];
+            Entry->Listener = Listener;
+            Entry->Alpn = Listener->AlpnList + Offset;
+            Entry->ListenerOrdinal = ListenerOrdinal;
+            Entry->AlpnOrdinal = AlpnOrdinal++;
+            CxPlatHashtableInsert(
+                &Index->Table,
+                &Entry->TableEntry,
+                CxPlatHashSimple(Entry->Alpn[0], Entry->Alpn + 1),
+                NULL);
+            Offset += Entry->Alpn[0] + 1;
+        }
+    }
+    CXPLAT_DBG_ASSERT(Index->EntryCount == EntryCount);
+
+    return Index;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicAlpnIndexFree(
+    _In_opt_ QUIC_ALPN_INDEX* Index
+    )
+{
+    if (Index == NULL) {
+        return;
+    }
+    for (uint32_t i = 0; i < Index->EntryCount; ++i) {
+        CxPlatHashtableRemove(&Index->Table, &Index->Entries[i].TableEntry, NULL);
+    }
+    CxPlatHashtableUninitialize(&Index->Table);
+    CXPLAT_FREE(Index, QUIC_POOL_ALPN_INDEX);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+_Success_(return != NULL)
+QUIC_LISTENER*
+QuicAlpnIndexLookup(
+    _In_ const QUIC_ALPN_INDEX* Index,
+    _In_ const QUIC_ADDR* LocalAddress,
+    _In_ uint16_t ClientAlpnListLength,
+    _In_reads_(ClientAlpnListLength)
+        const uint8_t* ClientAlpnList,
+    _Outptr_ const uint8_t** NegotiatedAlpn
+    )
+{
+    const QUIC_ALPN_INDEX_ENTRY* Best = NULL;
+
+    while (ClientAlpnListLength != 0) {
+        const uint8_t AlpnLength = ClientAlpnList[0];
+        if (AlpnLength + 1 > ClientAlpnListLength) {
+            break;
+        }
+
+        CXPLAT_HASHTABLE_LOOKUP_CONTEXT Context;
+        CXPLAT_HASHTABLE_ENTRY* TableEntry =
+            CxPlatHashtableLookup(
+                &Index->Table,
+                CxPlatHashSimple(AlpnLength, ClientAlpnList + 1),
+                &Context);
+        while (TableEntry != NULL) {
+            const QUIC_ALPN_INDEX_ENTRY* Entry =
+                CXPLAT_CONTAINING_RECORD(TableEntry, QUIC_ALPN_INDEX_ENTRY, TableEntry);
+            if (Entry->Alpn[0] == AlpnLength &&
+                memcmp(Entry->Alpn + 1, ClientAlpnList + 1, AlpnLength) == 0 &&
+                (Best == NULL ||
+                 Entry->ListenerOrdinal < Best->ListenerOrdinal ||
+                 (Entry->ListenerOrdinal == Best->ListenerOrdinal &&
+                  Entry->AlpnOrdinal < Best->AlpnOrdinal)) &&
+                QuicListenerMatchesLocalAddress(Entry->Listener, LocalAddress)) {
+                Best = Entry;
+            }
+            TableEntry = CxPlatHashtableLookupNext(&Index->Table, &Context);
+        }
+
+        ClientAlpnListLength -= AlpnLength + 1;
+        ClientAlpnList += AlpnLength + 1;
+    }
+
+    if (Best == NULL) {
+        return NULL;
+    }
+
+    *NegotiatedAlpn = Best->Alpn;
+    return Best->Listener;
+}
@@ -0,0 +1,92 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+--*/
+
+#pragma once
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+//
+// One ALPN of one listener.
+//
+typedef struct QUIC_ALPN_INDEX_ENTRY {
+
+    //
+    // Keyed by the hash of the ALPN.
+    //
+    CXPLAT_HASHTABLE_ENTRY TableEntry;
+
+    QUIC_LISTENER* Listener;
+
+    //
+    // The length prefixed ALPN, pointing into the listener's ALPN list.
+    //
+    const uint8_t* Alpn;
+
+    //
+    // The position of the listener in the binding's (sorted) listener list, and
+    // of the ALPN in the listener's (preference ordered) ALPN list. Used to
+    // pick the same listener and ALPN as a walk of the lists would.
+    //
+    uint32_t ListenerOrdinal;
+    uint32_t AlpnOrdinal;
+
+} QUIC_ALPN_INDEX_ENTRY;
+
+//
+// A read-only lookup table from ALPN to the listeners registered for it, built
+// from a binding's listener list. Rebuilt whenever the list changes, so that
+// finding the listener for a new connection doesn't depend on how many
+// listeners (or ALPNs) there are.
+//
+typedef struct QUIC_ALPN_INDEX {
+
+    CXPLAT_HASHTABLE Table;
+
+    uint32_t EntryCount;
+    QUIC_ALPN_INDEX_ENTRY Entries[0];
+
+} QUIC_ALPN_INDEX;
+
+//
+// Builds a new index for all the listeners in the list. Returns NULL if there
+// are no listeners (or ALPNs), or on allocation failure.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+_Ret_maybenull_
+QUIC_ALPN_INDEX*
+QuicAlpnIndexCreate(
+    _In_ const CXPLAT_LIST_ENTRY* Listeners
+    );
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicAlpnIndexFree(
+    _In_opt_ QUIC_ALPN_INDEX* Index
+    );
+
+//
+// Finds the first listener (in list order) that matches the local address and
+// any of the client's ALPNs, and the listener's most preferred ALPN the client
+// offered. Returns NULL if there is no match.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+_Success_(return != NULL)
+QUIC_LISTENER*
+QuicAlpnIndexLookup(
+    _In_ const QUIC_ALPN_INDEX* Index,
+    _In_ const QUIC_ADDR* LocalAddress,
+    _In_ uint16_t ClientAlpnListLength,
+    _In_reads_(ClientAlpnListLength)
+        const uint8_t* ClientAlpnList,
+    _Outptr_ const uint8_t** NegotiatedAlpn
+    );
+
+#if defined(__cplusplus)
+}
+#endif
@@ -0,0 +1,136 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Replay detection for 0-RTT resumption tickets.
+
+    Each server ticket carries a random 64-bit nonce. On resumption the nonce is
+    added to a rotating pair of Bloom filters. A nonce that is already present
+    is treated as a replay. False positives are possible (and only cause the
+    client to fall back to a full handshake); false negatives are not, as long
+    as the ticket is younger than the filter window.
+
+    The nonce is random and authenticated by the ticket encryption, so it is
+    used directly (split in two halves) for double hashing.
+
+--*/
+
+#include "precomp.h"
+#ifdef QUIC_CLOG
+#include "anti_replay.c.clog.h"
+#endif
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+QuicAntiReplayFilterInitialize(
+    _In_ uint32_t WindowMs,
+    _In_ uint32_t Capacity,
+    _Outptr_ _At_(*NewFilter, __drv_allocatesMem(Mem))
+        QUIC_ANTI_REPLAY_FILTER** NewFilter
+    )
+{
+    CXPLAT_DBG_ASSERT(WindowMs != 0);
+    CXPLAT_DBG_ASSERT(Capacity != 0);
+
+    uint64_t BitCount = 64;
+    while (BitCount < (uint64_t)Capacity * QUIC_ANTI_REPLAY_BITS_PER_ENTRY &&
+           BitCount < 0x80000000ull) {
+        BitCount <<= 1;
+    }
+
+    const size_t GenerationSize = (size_t)(BitCount / 8);
+    const size_t FilterSize = sizeof(QUIC_ANTI_REPLAY_FILTER) + 2 * GenerationSize;
+    QUIC_ANTI_REPLAY_FILTER* Filter =
+        CXPLAT_ALLOC_NONPAGED(FilterSize, QUIC_POOL_ANTI_REPLAY);
+    if (Filter == NULL) {
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "anti-replay filter",
+            FilterSize);
+        return QUIC_STATUS_OUT_OF_MEMORY;
+    }
+
+    CxPlatZeroMemory(Filter, FilterSize);
+    Filter->WindowMs = WindowMs;
+    Filter->Capacity = Capacity;
+    Filter->BitMask = (uint32_t)(BitCount - 1);
+    Filter->Bits[0] = (uint64_t*)(Filter + 1);
+    Filter->Bits[1] = (uint64_t*)((uint8_t*)(Filter + 1) + GenerationSize);
+
+    *NewFilter = Filter;
+    return QUIC_STATUS_SUCCESS;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicAntiReplayFilterUninitialize(
+    _In_ __drv_freesMem(Mem) QUIC_ANTI_REPLAY_FILTER* Filter
+    )
+{
+    CXPLAT_FREE(Filter, QUIC_POOL_ANTI_REPLAY);
+}
+
+static
+void
+QuicAntiReplayFilterRotate(
+    _Inout_ QUIC_ANTI_REPLAY_FILTER* Filter,
+    _In_ uint64_t TimeNowMs
+    )
+{
+    const uint64_t Generation = TimeNowMs / Filter->WindowMs;
+    if (Generation <= Filter->Generation) {
+        return; // Still current (or the clock went backwards).
+    }
+
+    const size_t GenerationSize = ((size_t)Filter->BitMask + 1) / 8;
+    if (Generation == Filter->Generation + 1) {
+        //
+        // The previous generation becomes the older one; the oldest is
+        // recycled as the new current generation.
+        //
+        CxPlatZeroMemory(Filter->Bits[Generation & 1], GenerationSize);
+    } else {
+        //
+        // More than a whole window passed with no activity; forget everything.
+        //
+        CxPlatZeroMemory(Filter->Bits[0], GenerationSize);
+        CxPlatZeroMemory(Filter->Bits[1], GenerationSize);
+    }
+    Filter->Generation = Generation;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+QuicAntiReplayFilterInsert(
+    _Inout_ QUIC_ANTI_REPLAY_FILTER* Filter,
+    _In_ uint64_t Nonce,
+    _In_ uint64_t TimeNowMs
+    )
+{
+    QuicAntiReplayFilterRotate(Filter, TimeNowMs);
+
+    uint64_t* Current = Filter->Bits[Filter->Generation & 1];
+    uint64_t* Previous = Filter->Bits[(Filter->Generation + 1) & 1];
+
+    const uint32_t Hash1 = (uint32_t)Nonce;
+    const uint32_t Hash2 = (uint32_t)(Nonce >> 32) | 1;
+
+    BOOLEAN InCurrent = TRUE, InPrevious = TRUE;
+    for (uint32_t i = 0; i < QUIC_ANTI_REPLAY_HASH_COUNT; ++i) {
+        const uint32_t Bit = (Hash1 + i * Hash2) & Filter->BitMask;
+        const uint64_t Mask = 1ull << (Bit & 63);
+        if (!(Previous[Bit >> 6] & Mask)) {
+            InPrevious = FALSE;
+        }
+        if (!(Current[Bit >> 6] & Mask)) {
+            InCurrent = FALSE;
+            Current[Bit >> 6] |= Mask;
+        }
+    }
+
+    return !InCurrent && !InPrevious;
+}
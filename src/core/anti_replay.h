@@ -0,0 +1,109 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+--*/
+
+#pragma once
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+//
+// The number of bits per expected entry in each generation. Along with the
+// hash count below, this gives a false positive rate of roughly 0.1% when the
+// filter is at capacity.
+//
+#define QUIC_ANTI_REPLAY_BITS_PER_ENTRY     16
+#define QUIC_ANTI_REPLAY_HASH_COUNT         10
+
+//
+// A time-bucketed Bloom filter used to detect replayed resumption tickets.
+//
+// The filter is made of two generations, each covering one window of time.
+// Lookups test both generations and inserts go into the current one. When the
+// window rolls over, the older generation is cleared and becomes the current
+// one. So, each entry is remembered for at least one full window.
+//
+typedef struct QUIC_ANTI_REPLAY_FILTER {
+
+    //
+    // The length of one generation, in milliseconds.
+    //
+    uint32_t WindowMs;
+
+    //
+    // The number of entries per generation the filter was sized for.
+    //
+    uint32_t Capacity;
+
+    //
+    // The number of bits in each generation, minus one (power of two).
+    //
+    uint32_t BitMask;
+
+    //
+    // The index (time / WindowMs) of the current generation.
+    //
+    uint64_t Generation;
+
+    //
+    // Bits for the two generations. Indexed by (Generation & 1).
+    //
+    uint64_t* Bits[2];
+
+} QUIC_ANTI_REPLAY_FILTER;
+
+//
+// Creates a new filter sized for Capacity entries per WindowMs.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+QuicAntiReplayFilterInitialize(
+    _In_ uint32_t WindowMs,
+    _In_ uint32_t Capacity,
+    _Outptr_ _At_(*NewFilter, __drv_allocatesMem(Mem))
+        QUIC_ANTI_REPLAY_FILTER** NewFilter
+    );
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicAntiReplayFilterUninitialize(
+    _In_ __drv_freesMem(Mem) QUIC_ANTI_REPLAY_FILTER* Filter
+    );
+
+//
+// Adds the nonce to the filter. Returns FALSE if the nonce was (probably)
+// already present, i.e. this is a replay. Not thread safe.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+QuicAntiReplayFilterInsert(
+    _Inout_ QUIC_ANTI_REPLAY_FILTER* Filter,
+    _In_ uint64_t Nonce,
+    _In_ uint64_t TimeNowMs
+    );
+
+//
+// Returns which of ShardCount filters tracks the nonce. The filter probes with
+// the nonce's low and high 32 bits directly, so picking the shard from any of
+// those bits as-is would leave them constant within a shard and shrink each
+// filter's effective size. Instead, the shard comes from the top bits of a
+// multiplicative hash, which depend on every bit of the nonce.
+//
+inline
+uint32_t
+QuicAntiReplayShardIndex(
+    _In_ uint64_t Nonce,
+    _In_ uint32_t ShardCount
+    )
+{
+    const uint32_t Hash = (uint32_t)((Nonce * 0x9E3779B97F4A7C15ull) >> 32);
+    return (uint32_t)(((uint64_t)Hash * ShardCount) >> 32);
+}
+
+#if defined(__cplusplus)
+}
+#endif
@@ -42,15 +42,18 @@ QuicBindingInitialize(
 {
     QUIC_STATUS Status;
     QUIC_BINDING* Binding;
-    BOOLEAN HashTableInitialized = FALSE;
+    uint16_t ShardsInitialized = 0;
+    const uint16_t ShardCount = CXPLAT_MAX(MsQuicLib.PartitionCount, 1);
+    const size_t BindingSize =
+        sizeof(QUIC_BINDING) + ShardCount * sizeof(QUIC_STATELESS_OPER_SHARD);
 
-    Binding = CXPLAT_ALLOC_NONPAGED(sizeof(QUIC_BINDING), QUIC_POOL_BINDING);
+    Binding = CXPLAT_ALLOC_NONPAGED(BindingSize, QUIC_POOL_BINDING);
     if (Binding == NULL) {
         QuicTraceEvent(
             AllocFailure,
             "Allocation of '%s' failed. (%llu bytes)",
             "QUIC_BINDING",
-            sizeof(QUIC_BINDING));
+            BindingSize);
         Status = QUIC_STATUS_OUT_OF_MEMORY;
         goto Error;
     }
@@ -59,17 +62,22 @@ QuicBindingInitialize(
     Binding->Exclusive = !(UdpConfig->Flags & CXPLAT_SOCKET_FLAG_SHARE);
     Binding->ServerOwned = !!(UdpConfig->Flags & CXPLAT_SOCKET_SERVER_OWNED);
     Binding->Connected = UdpConfig->RemoteAddress == NULL ? FALSE : TRUE;
-    Binding->StatelessOperCount = 0;
+    Binding->StatelessOperShardCount = ShardCount;
     CxPlatDispatchRwLockInitialize(&Binding->RwLock);
-    CxPlatDispatchLockInitialize(&Binding->StatelessOperLock);
     CxPlatListInitializeHead(&Binding->Listeners);
+    Binding->AlpnIndex = NULL;
     QuicLookupInitialize(&Binding->Lookup);
-    if (!CxPlatHashtableInitializeEx(&Binding->StatelessOperTable, CXPLAT_HASH_MIN_SIZE)) {
-        Status = QUIC_STATUS_OUT_OF_MEMORY;
-        goto Error;
+    for (; ShardsInitialized < ShardCount; ++ShardsInitialized) {
+        QUIC_STATELESS_OPER_SHARD* Shard =
+            &Binding->StatelessOperShards[ShardsInitialized];
+        if (!CxPlatHashtableInitializeEx(&Shard->Table, CXPLAT_HASH_MIN_SIZE)) {
+            Status = QUIC_STATUS_OUT_OF_MEMORY;
+            goto Error;
+        }
+        CxPlatDispatchLockInitialize(&Shard->Lock);
+        CxPlatListInitializeHead(&Shard->List);
+        Shard->Count = 0;
     }
-    HashTableInitialized = TRUE;
-    CxPlatListInitializeHead(&Binding->StatelessOperList);
 
     //
     // Random reserved version number for version negotation.
@@ -172,10 +180,10 @@ Error:
     if (QUIC_FAILED(Status)) {
         if (Binding != NULL) {
             QuicLookupUninitialize(&Binding->Lookup);
-            if (HashTableInitialized) {
-                CxPlatHashtableUninitialize(&Binding->StatelessOperTable);
+            for (uint16_t i = 0; i < ShardsInitialized; ++i) {
+                CxPlatHashtableUninitialize(&Binding->StatelessOperShards[i].Table);
+                CxPlatDispatchLockUninitialize(&Binding->StatelessOperShards[i].Lock);
             }
-            CxPlatDispatchLockUninitialize(&Binding->StatelessOperLock);
             CxPlatDispatchRwLockUninitialize(&Binding->RwLock);
             CXPLAT_FREE(Binding, QUIC_POOL_BINDING);
         }
@@ -197,6 +205,7 @@ QuicBindingUninitialize(
 
     CXPLAT_TEL_ASSERT(Binding->RefCount == 0);
     CXPLAT_TEL_ASSERT(CxPlatListIsEmpty(&Binding->Listeners));
+    CXPLAT_DBG_ASSERT(Binding->AlpnIndex == NULL);
 
     //
     // Delete the datapath binding. This function blocks until all receive
@@ -207,26 +216,29 @@ QuicBindingUninitialize(
     //
     // Clean up any leftover stateless operations being tracked.
     //
-    while (!CxPlatListIsEmpty(&Binding->StatelessOperList)) {
-        QUIC_STATELESS_CONTEXT* StatelessCtx =
-            CXPLAT_CONTAINING_RECORD(
-                CxPlatListRemoveHead(&Binding->StatelessOperList),
-                QUIC_STATELESS_CONTEXT,
-                ListEntry);
-        Binding->StatelessOperCount--;
-        CxPlatHashtableRemove(
-            &Binding->StatelessOperTable,
-            &StatelessCtx->TableEntry,
-            NULL);
-        CXPLAT_DBG_ASSERT(StatelessCtx->IsProcessed);
-        CxPlatPoolFree(StatelessCtx);
+    for (uint16_t i = 0; i < Binding->StatelessOperShardCount; ++i) {
+        QUIC_STATELESS_OPER_SHARD* Shard = &Binding->StatelessOperShards[i];
+        while (!CxPlatListIsEmpty(&Shard->List)) {
+            QUIC_STATELESS_CONTEXT* StatelessCtx =
+                CXPLAT_CONTAINING_RECORD(
+                    CxPlatListRemoveHead(&Shard->List),
+                    QUIC_STATELESS_CONTEXT,
+                    ListEntry);
+            Shard->Count--;
+            CxPlatHashtableRemove(
+                &Shard->Table,
+                &StatelessCtx->TableEntry,
+                NULL);
+            CXPLAT_DBG_ASSERT(StatelessCtx->IsProcessed);
+            CxPlatPoolFree(StatelessCtx);
+        }
+        CXPLAT_DBG_ASSERT(Shard->Count == 0);
+        CXPLAT_DBG_ASSERT(Shard->Table.NumEntries == 0);
+        CxPlatHashtableUninitialize(&Shard->Table);
+        CxPlatDispatchLockUninitialize(&Shard->Lock);
     }
-    CXPLAT_DBG_ASSERT(Binding->StatelessOperCount == 0);
-    CXPLAT_DBG_ASSERT(Binding->StatelessOperTable.NumEntries == 0);
 
     QuicLookupUninitialize(&Binding->Lookup);
-    CxPlatDispatchLockUninitialize(&Binding->StatelessOperLock);
-    CxPlatHashtableUninitialize(&Binding->StatelessOperTable);
     CxPlatDispatchRwLockUninitialize(&Binding->RwLock);
 
     QuicTraceEvent(
@@ -311,6 +323,21 @@ QuicBindingHasListenerRegistered(
     return !CxPlatListIsEmpty(&Binding->Listeners);
 }
 
+//
+// Replaces the ALPN index with one for the current listener list. Called with
+// the RwLock held exclusively. If the new index can't be allocated, lookups
+// just fall back to walking the list.
+//
+static
+void
+QuicBindingRebuildAlpnIndex(
+    _In_ QUIC_BINDING* Binding
+    )
+{
+    QuicAlpnIndexFree(Binding->AlpnIndex);
+    Binding->AlpnIndex = QuicAlpnIndexCreate(&Binding->Listeners);
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 QUIC_STATUS
 QuicBindingRegisterListener(
@@ -393,6 +420,7 @@ QuicBindingRegisterListener(
             NewListener->Link.Blink->Flink = &NewListener->Link;
             Link->Blink = &NewListener->Link;
         }
+        QuicBindingRebuildAlpnIndex(Binding);
     }
 
     CxPlatDispatchRwLockReleaseExclusive(&Binding->RwLock, PrevIrql);
@@ -418,30 +446,47 @@ QuicBindingGetListener(
     QUIC_LISTENER* Listener = NULL;
 
     const QUIC_ADDR* Addr = Info->LocalAddress;
-    const QUIC_ADDRESS_FAMILY Family = QuicAddrGetFamily(Addr);
 
     BOOLEAN FailedAlpnMatch = FALSE;
     BOOLEAN FailedAddrMatch = TRUE;
 
     CxPlatDispatchRwLockAcquireShared(&Binding->RwLock, PrevIrql);
 
+    if (Binding->AlpnIndex != NULL) {
+        const uint8_t* Alpn = NULL;
+        QUIC_LISTENER* IndexListener =
+            QuicAlpnIndexLookup(
+                Binding->AlpnIndex,
+                Addr,
+                Info->ClientAlpnListLength,
+                Info->ClientAlpnList,
+                &Alpn);
+        if (IndexListener != NULL) {
+            Info->NegotiatedAlpnLength = Alpn[0]; // The length prefixed to the ALPN buffer.
+            Info->NegotiatedAlpn = Alpn + 1;
+            if (CxPlatRefIncrementNonZero(&IndexListener->RefCount, 1)) {
+                Listener = IndexListener;
+            }
+            FailedAddrMatch = FALSE;
+            goto Done;
+        }
+
+        //
+        // No match. Fall back to walking the list, to trace why.
+        //
+    }
+
     for (CXPLAT_LIST_ENTRY* Link = Binding->Listeners.Flink;
         Link != &Binding->Listeners;
         Link = Link->Flink) {
 
         QUIC_LISTENER* ExistingListener =
             CXPLAT_CONTAINING_RECORD(Link, QUIC_LISTENER, Link);
-        const QUIC_ADDR* ExistingAddr = &ExistingListener->LocalAddress;
-        const BOOLEAN ExistingWildCard = ExistingListener->WildCard;
-        const QUIC_ADDRESS_FAMILY ExistingFamily = QuicAddrGetFamily(ExistingAddr);
         FailedAlpnMatch = FALSE;
 
-        if (ExistingFamily != QUIC_ADDRESS_FAMILY_UNSPEC) {
-            if (Family != ExistingFamily ||
-                (!ExistingWildCard && !QuicAddrCompareIp(Addr, ExistingAddr))) {
-                FailedAddrMatch = TRUE;
-                continue; // No IP match.
-            }
+        if (!QuicListenerMatchesLocalAddress(ExistingListener, Addr)) {
+            FailedAddrMatch = TRUE;
+            continue; // No IP match.
         }
         FailedAddrMatch = FALSE;
 
@@ -486,6 +531,7 @@ QuicBindingUnregisterListener(
 {
     CxPlatDispatchRwLockAcquireExclusive(&Binding->RwLock, PrevIrql);
     CxPlatListEntryRemove(&Listener->Link);
+    QuicBindingRebuildAlpnIndex(Binding);
     CxPlatDispatchRwLockReleaseExclusive(&Binding->RwLock, PrevIrql);
 }
 
@@ -611,11 +657,38 @@ QuicBindingOnConnectionHandshakeConfirmed(
     }
 }
 
+//
+// The number of stateless operations a shard may have outstanding. Since an
+// operation is only aged out after StatelessOperationExpirationMs, this also
+// limits the rate of stateless responses each partition can generate.
+//
+// The binding wide limit is split across the shards, with the remainder going
+// to the lowest shards, so the shards add up to exactly the limit. Only when
+// there are more shards than the limit allows does each still get one, so no
+// partition is shut out of stateless responses entirely.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+uint32_t
+QuicBindingGetMaxStatelessOperationsPerShard(
+    _In_ const QUIC_BINDING* Binding,
+    _In_ uint16_t ShardIndex
+    )
+{
+    const uint32_t Max = (uint32_t)MsQuicLib.Settings.MaxBindingStatelessOperations;
+    const uint32_t ShardCount = Binding->StatelessOperShardCount;
+    const uint32_t ShardMax =
+        Max / ShardCount + (ShardIndex < Max % ShardCount ? 1 : 0);
+    return CXPLAT_MAX(ShardMax, CXPLAT_MIN(Max, 1));
+}
+
 //
 // This attempts to add a new stateless operation (for a given remote endpoint)
-// to the tracking structures in the binding. It first ages out any old
-// operations that might have expired. Then it adds the new operation only if
-// the remote address isn't already in the table.
+// to the tracking structures in the binding. Operations are tracked in the
+// shard for the partition the packet was received on; since a given remote
+// address is consistently steered to the same partition, duplicates are still
+// caught. It first ages out any old operations in the shard that might have
+// expired. Then it adds the new operation only if the remote address isn't
+// already in the shard's table.
 //
 _IRQL_requires_max_(DISPATCH_LEVEL)
 QUIC_STATELESS_CONTEXT*
@@ -629,8 +702,11 @@ QuicBindingCreateStatelessOperation(
     const QUIC_ADDR* RemoteAddress = &Packet->Route->RemoteAddress;
     uint32_t Hash = QuicAddrHash(RemoteAddress);
     QUIC_STATELESS_CONTEXT* StatelessCtx = NULL;
+    const uint16_t ShardIndex =
+        Worker->Partition->Index % Binding->StatelessOperShardCount;
+    QUIC_STATELESS_OPER_SHARD* Shard = &Binding->StatelessOperShards[ShardIndex];
 
-    CxPlatDispatchLockAcquire(&Binding->StatelessOperLock);
+    CxPlatDispatchLockAcquire(&Shard->Lock);
 
     if (Binding->RefCount == 0) {
         goto Exit;
@@ -639,10 +715,10 @@ QuicBindingCreateStatelessOperation(
     //
     // Age out all expired operation contexts.
     //
-    while (!CxPlatListIsEmpty(&Binding->StatelessOperList)) {
+    while (!CxPlatListIsEmpty(&Shard->List)) {
         QUIC_STATELESS_CONTEXT* OldStatelessCtx =
             CXPLAT_CONTAINING_RECORD(
-                Binding->StatelessOperList.Flink,
+                Shard->List.Flink,
                 QUIC_STATELESS_CONTEXT,
                 ListEntry);
 
@@ -656,11 +732,11 @@ QuicBindingCreateStatelessOperation(
         //
         OldStatelessCtx->IsExpired = TRUE;
         CxPlatHashtableRemove(
-            &Binding->StatelessOperTable,
+            &Shard->Table,
             &OldStatelessCtx->TableEntry,
             NULL);
         CxPlatListEntryRemove(&OldStatelessCtx->ListEntry);
-        Binding->StatelessOperCount--;
+        Shard->Count--;
 
         //
         // If it's also processed, free it.
@@ -670,7 +746,7 @@ QuicBindingCreateStatelessOperation(
         }
     }
 
-    if (Binding->StatelessOperCount >= (uint32_t)MsQuicLib.Settings.MaxBindingStatelessOperations) {
+    if (Shard->Count >= QuicBindingGetMaxStatelessOperationsPerShard(Binding, ShardIndex)) {
         QuicPacketLogDrop(Binding, Packet, "Max binding operations reached");
         goto Exit;
     }
@@ -681,7 +757,7 @@ QuicBindingCreateStatelessOperation(
 
     CXPLAT_HASHTABLE_LOOKUP_CONTEXT Context;
     CXPLAT_HASHTABLE_ENTRY* TableEntry =
-        CxPlatHashtableLookup(&Binding->StatelessOperTable, Hash, &Context);
+        CxPlatHashtableLookup(&Shard->Table, Hash, &Context);
 
     while (TableEntry != NULL) {
         const QUIC_STATELESS_CONTEXT* ExistingCtx =
@@ -693,7 +769,7 @@ QuicBindingCreateStatelessOperation(
         }
 
         TableEntry =
-            CxPlatHashtableLookupNext(&Binding->StatelessOperTable, &Context);
+            CxPlatHashtableLookupNext(&Shard->Table, &Context);
     }
 
     //
@@ -711,27 +787,28 @@ QuicBindingCreateStatelessOperation(
     StatelessCtx->Worker = Worker;
     StatelessCtx->Packet = Packet;
     StatelessCtx->CreationTimeMs = TimeMs;
+    StatelessCtx->ShardIndex = ShardIndex;
     StatelessCtx->HasBindingRef = FALSE;
     StatelessCtx->IsProcessed = FALSE;
     StatelessCtx->IsExpired = FALSE;
     CxPlatCopyMemory(&StatelessCtx->RemoteAddress, RemoteAddress, sizeof(QUIC_ADDR));
 
     CxPlatHashtableInsert(
-        &Binding->StatelessOperTable,
+        &Shard->Table,
         &StatelessCtx->TableEntry,
         Hash,
         NULL); // TODO - Context?
 
     CxPlatListInsertTail(
-        &Binding->StatelessOperList,
+        &Shard->List,
         &StatelessCtx->ListEntry
         );
 
-    Binding->StatelessOperCount++;
+    Shard->Count++;
 
 Exit:
 
-    CxPlatDispatchLockRelease(&Binding->StatelessOperLock);
+    CxPlatDispatchLockRelease(&Shard->Lock);
 
     return StatelessCtx;
 }
@@ -779,6 +856,90 @@ QuicBindingQueueStatelessOperation(
     return TRUE;
 }
 
+#define SIP_ROTL(X, B) (((X) << (B)) | ((X) >> (64 - (B))))
+
+#define SIP_ROUND(V0, V1, V2, V3) do { \
+    V0 += V1; V1 = SIP_ROTL(V1, 13); V1 ^= V0; V0 = SIP_ROTL(V0, 32); \
+    V2 += V3; V3 = SIP_ROTL(V3, 16); V3 ^= V2; \
+    V0 += V3; V3 = SIP_ROTL(V3, 21); V3 ^= V0; \
+    V2 += V1; V1 = SIP_ROTL(V1, 17); V1 ^= V2; V2 = SIP_ROTL(V2, 32); \
+} while (0)
+
+//
+// SipHash-2-4 of the input under a 128-bit key.
+//
+static
+uint64_t
+QuicSipHash24(
+    _In_reads_(2) const uint64_t* Key,
+    _In_reads_bytes_(Length) const uint8_t* Input,
+    _In_ uint32_t Length
+    )
+{
+    uint64_t V0 = Key[0] ^ 0x736f6d6570736575ull;
+    uint64_t V1 = Key[1] ^ 0x646f72616e646f6dull;
+    uint64_t V2 = Key[0] ^ 0x6c7967656e657261ull;
+    uint64_t V3 = Key[1] ^ 0x7465646279746573ull;
+
+    const uint8_t* End = Input + (Length & ~7u);
+    for (; Input != End; Input += sizeof(uint64_t)) {
+        uint64_t M = 0;
+        for (uint32_t i = 0; i < sizeof(uint64_t); ++i) {
+            M |= (uint64_t)Input[i] << (8 * i);
+        }
+        V3 ^= M;
+        SIP_ROUND(V0, V1, V2, V3);
+        SIP_ROUND(V0, V1, V2, V3);
+        V0 ^= M;
+    }
+
+    uint64_t M = (uint64_t)Length << 56;
+    for (uint32_t i = 0; i < (Length & 7u); ++i) {
+        M |= (uint64_t)Input[i] << (8 * i);
+    }
+    V3 ^= M;
+    SIP_ROUND(V0, V1, V2, V3);
+    SIP_ROUND(V0, V1, V2, V3);
+    V0 ^= M;
+
+    V2 ^= 0xff;
+    for (uint32_t i = 0; i < 4; ++i) {
+        SIP_ROUND(V0, V1, V2, V3);
+    }
+    return V0 ^ V1 ^ V2 ^ V3;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+uint16_t
+QuicRetryTokenComputePreFilterTag(
+    _In_ const QUIC_ADDR* RemoteAddress,
+    _In_ uint64_t Timestamp
+    )
+{
+    //
+    // The timestamp, port and IP address, in that order.
+    //
+    uint8_t Input[sizeof(uint64_t) + sizeof(uint16_t) + 16];
+    uint32_t Length = 0;
+    for (uint32_t i = 0; i < sizeof(uint64_t); ++i) {
+        Input[Length++] = (uint8_t)(Timestamp >> (8 * i));
+    }
+    if (QuicAddrGetFamily(RemoteAddress) == QUIC_ADDRESS_FAMILY_INET) {
+        CxPlatCopyMemory(
+            Input + Length, ((uint8_t*)RemoteAddress) + QUIC_ADDR_V4_PORT_OFFSET, 2);
+        CxPlatCopyMemory(
+            Input + Length + 2, ((uint8_t*)RemoteAddress) + QUIC_ADDR_V4_IP_OFFSET, 4);
+        Length += 2 + 4;
+    } else {
+        CxPlatCopyMemory(
+            Input + Length, ((uint8_t*)RemoteAddress) + QUIC_ADDR_V6_PORT_OFFSET, 2);
+        CxPlatCopyMemory(
+            Input + Length + 2, ((uint8_t*)RemoteAddress) + QUIC_ADDR_V6_IP_OFFSET, 16);
+        Length += 2 + 16;
+    }
+    return (uint16_t)QuicSipHash24(MsQuicLib.RetryTokenPreFilterKey, Input, Length);
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
 QuicBindingProcessStatelessOperation(
@@ -980,6 +1141,10 @@ QuicBindingProcessStatelessOperation(
         QUIC_TOKEN_CONTENTS Token = { 0 };
         Token.Authenticated.Timestamp = (uint64_t)CxPlatTimeEpochMs64();
         Token.Authenticated.IsNewToken = FALSE;
+        Token.Authenticated.PreFilterTag =
+            QuicRetryTokenComputePreFilterTag(
+                &RecvPacket->Route->RemoteAddress,
+                (uint64_t)Token.Authenticated.Timestamp);
 
         Token.Encrypted.RemoteAddress = RecvPacket->Route->RemoteAddress;
         CxPlatCopyMemory(Token.Encrypted.OrigConnId, RecvPacket->DestCid, RecvPacket->DestCidLen);
@@ -1054,7 +1219,8 @@ QuicBindingProcessStatelessOperation(
         RecvPacket->Route,
         SendData,
         SendDatagram->Length,
-        1);
+        1,
+        NULL);
     SendData = NULL;
 
 Exit:
@@ -1072,18 +1238,20 @@ QuicBindingReleaseStatelessOperation(
     )
 {
     QUIC_BINDING* Binding = StatelessCtx->Binding;
+    QUIC_STATELESS_OPER_SHARD* Shard =
+        &Binding->StatelessOperShards[StatelessCtx->ShardIndex];
 
     if (ReturnDatagram) {
         CxPlatRecvDataReturn((CXPLAT_RECV_DATA*)StatelessCtx->Packet);
     }
     StatelessCtx->Packet = NULL;
 
-    CxPlatDispatchLockAcquire(&Binding->StatelessOperLock);
+    CxPlatDispatchLockAcquire(&Shard->Lock);
 
     StatelessCtx->IsProcessed = TRUE;
     uint8_t FreeCtx = StatelessCtx->IsExpired;
 
-    CxPlatDispatchLockRelease(&Binding->StatelessOperLock);
+    CxPlatDispatchLockRelease(&Shard->Lock);
 
     if (StatelessCtx->HasBindingRef) {
         QuicLibraryReleaseBinding(Binding);
@@ -1197,6 +1365,41 @@ QuicBindingPreprocessPacket(
     return TRUE;
 }
 
+//
+// Returns TRUE if any listener on the binding has admission control configured
+// and is loaded enough to require address validation. The listener for the new
+// connection isn't known until the TLS ClientHello is processed, so all of the
+// binding's listeners are considered.
+//
+static
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+QuicBindingAdmissionRequiresRetry(
+    _In_ QUIC_BINDING* Binding,
+    _In_ const QUIC_RX_PACKET* Packet
+    )
+{
+    BOOLEAN Retry = FALSE;
+
+    CxPlatDispatchRwLockAcquireShared(&Binding->RwLock, PrevIrql);
+    for (CXPLAT_LIST_ENTRY* Link = Binding->Listeners.Flink;
+            Link != &Binding->Listeners;
+            Link = Link->Flink) {
+
+        QUIC_LISTENER* Listener = CXPLAT_CONTAINING_RECORD(Link, QUIC_LISTENER, Link);
+        if (QuicListenerHasAdmissionControl(Listener) &&
+            QuicListenerAdmissionLevel(
+                QuicListenerUpdateAdmission(Listener, Packet->PartitionIndex)) >=
+                QUIC_LISTENER_ADMISSION_LEVEL_RETRY) {
+            Retry = TRUE;
+            break;
+        }
+    }
+    CxPlatDispatchRwLockReleaseShared(&Binding->RwLock, PrevIrql);
+
+    return Retry;
+}
+
 //
 // Returns TRUE if we should respond to the connection attempt with a Retry
 // packet.
@@ -1204,7 +1407,7 @@ QuicBindingPreprocessPacket(
 _IRQL_requires_max_(DISPATCH_LEVEL)
 BOOLEAN
 QuicBindingShouldRetryConnection(
-    _In_ const QUIC_BINDING* const Binding,
+    _In_ QUIC_BINDING* Binding,
     _In_ QUIC_RX_PACKET* Packet,
     _In_ uint16_t TokenLength,
     _In_reads_(TokenLength)
@@ -1239,7 +1442,9 @@ QuicBindingShouldRetryConnection(
     uint64_t CurrentMemoryLimit =
         (MsQuicLib.Settings.RetryMemoryLimit * CxPlatTotalMemory) / UINT16_MAX;
 
-    return MsQuicLib.CurrentHandshakeMemoryUsage >= CurrentMemoryLimit;
+    return
+        MsQuicLib.CurrentHandshakeMemoryUsage >= CurrentMemoryLimit ||
+        QuicBindingAdmissionRequiresRetry(Binding, Packet);
 }
 
 _IRQL_requires_max_(DISPATCH_LEVEL)
@@ -1361,15 +1566,12 @@ Exit:
     return Connection;
 }
 
-_IRQL_requires_max_(DISPATCH_LEVEL)
+static
 BOOLEAN
-QuicBindingDropBlockedSourcePorts(
-    _In_ QUIC_BINDING* Binding,
-    _In_ const QUIC_RX_PACKET* Packet
+QuicBindingIsSourcePortBlocked(
+    _In_ uint16_t SourcePort
     )
 {
-    const uint16_t SourcePort = QuicAddrGetPort(&Packet->Route->RemoteAddress);
-
     //
     // These UDP source ports are recommended to be blocked by the QUIC WG. See
     // draft-ietf-quic-applicability for more details on the set of ports that
@@ -1396,7 +1598,6 @@ QuicBindingDropBlockedSourcePorts(
 
     for (size_t i = 0; i < ARRAYSIZE(BlockedPorts) && SourcePort <= BlockedPorts[i]; ++i) {
         if (BlockedPorts[i] == SourcePort) {
-            QuicPacketLogDrop(Binding, Packet, "Blocked source port");
             return TRUE;
         }
     }
@@ -1404,6 +1605,21 @@ QuicBindingDropBlockedSourcePorts(
     return FALSE;
 }
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+QuicBindingDropBlockedSourcePorts(
+    _In_ QUIC_BINDING* Binding,
+    _In_ const QUIC_RX_PACKET* Packet
+    )
+{
+    if (QuicBindingIsSourcePortBlocked(QuicAddrGetPort(&Packet->Route->RemoteAddress))) {
+        QuicPacketLogDrop(Binding, Packet, "Blocked source port");
+        return TRUE;
+    }
+
+    return FALSE;
+}
+
 //
 // Looks up or creates a connection to handle a chain of packets.
 // Returns TRUE if the packets were delivered, and FALSE if they should be
@@ -1583,6 +1799,157 @@ QuicBindingDeliverPackets(
     return TRUE;
 }
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+_Function_class_(CXPLAT_DATAPATH_RECEIVE_FILTER_CALLBACK)
+BOOLEAN
+QuicBindingReceiveFilter(
+    _In_ CXPLAT_SOCKET* Socket,
+    _In_ void* RecvCallbackContext,
+    _In_ uint16_t PartitionIndex,
+    _In_ const QUIC_ADDR* RemoteAddress,
+    _In_reads_(BufferLength)
+        const uint8_t* Buffer,
+    _In_ uint16_t BufferLength
+    )
+{
+    UNREFERENCED_PARAMETER(Socket);
+    QUIC_BINDING* Binding = (QUIC_BINDING*)RecvCallbackContext;
+
+    //
+    // The filter only kicks in while in DoS mode, for server bindings. Outside
+    // of that, everything is left to the regular receive path.
+    //
+    if (!MsQuicLib.SendRetryEnabled || !Binding->ServerOwned) {
+        return TRUE;
+    }
+
+    if (BufferLength < MIN_INV_LONG_HDR_LENGTH ||
+        !((const QUIC_HEADER_INVARIANT*)Buffer)->IsLongHeader) {
+        return TRUE; // Short header (or empty); not a new connection attempt.
+    }
+
+    //
+    // Only the Initial packets of versions we know are considered. Anything
+    // else is left for version negotiation.
+    //
+    const QUIC_LONG_HEADER_V1* LongHeader = (const QUIC_LONG_HEADER_V1*)Buffer;
+    uint32_t Version;
+    CxPlatCopyMemory(&Version, &LongHeader->Version, sizeof(Version));
+    if (!QuicIsVersionSupported(Version)) {
+        return TRUE;
+    }
+    if ((Version != QUIC_VERSION_2 && LongHeader->Type != QUIC_INITIAL_V1) ||
+        (Version == QUIC_VERSION_2 && LongHeader->Type != QUIC_INITIAL_V2)) {
+        return TRUE;
+    }
+
+    //
+    // Drop the obviously invalid ones (the regular receive path would too),
+    // and then rate limit per source prefix.
+    //
+    if (BufferLength < QUIC_MIN_INITIAL_PACKET_LENGTH ||
+        QuicBindingIsSourcePortBlocked(QuicAddrGetPort(RemoteAddress)) ||
+        !QuicPartitionInitialFilterAllow(
+            &MsQuicLib.Partitions[PartitionIndex % MsQuicLib.PartitionCount],
+            RemoteAddress,
+            CxPlatTimeMs32())) {
+        InterlockedIncrement64((int64_t*)&Binding->Stats.Recv.DroppedPackets);
+        QuicPerfCounterIncrement(
+            &MsQuicLib.Partitions[PartitionIndex % MsQuicLib.PartitionCount],
+            QUIC_PERF_COUNTER_PKTS_DROPPED);
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+//
+// A chain of received datagrams with the same destination CID, to be delivered
+// to a connection together.
+//
+typedef struct QUIC_RECV_SUBCHAIN {
+    CXPLAT_RECV_DATA* Head;
+    CXPLAT_RECV_DATA** Tail;        // End of the handshake packets.
+    CXPLAT_RECV_DATA** DataTail;    // End of the chain.
+    uint32_t Length;
+    uint32_t Bytes;
+} QUIC_RECV_SUBCHAIN;
+
+static
+void
+QuicRecvSubChainInitialize(
+    _Out_ QUIC_RECV_SUBCHAIN* SubChain
+    )
+{
+    SubChain->Head = NULL;
+    SubChain->Tail = &SubChain->Head;
+    SubChain->DataTail = &SubChain->Head;
+    SubChain->Length = 0;
+    SubChain->Bytes = 0;
+}
+
+static
+BOOLEAN
+QuicRecvSubChainMatches(
+    _In_ const QUIC_RECV_SUBCHAIN* SubChain,
+    _In_ const QUIC_RX_PACKET* Packet
+    )
+{
+    const QUIC_RX_PACKET* SubChainPacket = (const QUIC_RX_PACKET*)SubChain->Head;
+    return
+        Packet->DestCidLen == SubChainPacket->DestCidLen &&
+        memcmp(Packet->DestCid, SubChainPacket->DestCid, Packet->DestCidLen) == 0;
+}
+
+//
+// Inserts the datagram into the subchain, with handshake packets first (we
+// assume handshake packets don't come after non-handshake packets in a
+// datagram). We do this so that we can more easily determine if the chain of
+// packets can create a new connection.
+//
+static
+void
+QuicRecvSubChainAdd(
+    _Inout_ QUIC_RECV_SUBCHAIN* SubChain,
+    _In_ CXPLAT_RECV_DATA* Datagram
+    )
+{
+    SubChain->Length++;
+    SubChain->Bytes += Datagram->BufferLength;
+    if (!QuicPacketIsHandshake(((QUIC_RX_PACKET*)Datagram)->Invariant)) {
+        *SubChain->DataTail = Datagram;
+        SubChain->DataTail = &Datagram->Next;
+    } else {
+        if (*SubChain->Tail == NULL) {
+            *SubChain->Tail = Datagram;
+            SubChain->Tail = &Datagram->Next;
+            SubChain->DataTail = &Datagram->Next;
+        } else {
+            Datagram->Next = *SubChain->Tail;
+            *SubChain->Tail = Datagram;
+            SubChain->Tail = &Datagram->Next;
+        }
+    }
+}
+
+//
+// Delivers the subchain, or adds it to the release chain if it's dropped.
+//
+static
+void
+QuicBindingDeliverSubChain(
+    _In_ QUIC_BINDING* Binding,
+    _In_ QUIC_RECV_SUBCHAIN* SubChain,
+    _Inout_ CXPLAT_RECV_DATA*** ReleaseChainTail
+    )
+{
+    if (!QuicBindingDeliverPackets(
+            Binding, (QUIC_RX_PACKET*)SubChain->Head, SubChain->Length, SubChain->Bytes)) {
+        **ReleaseChainTail = SubChain->Head;
+        *ReleaseChainTail = SubChain->DataTail;
+    }
+}
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 _Function_class_(CXPLAT_DATAPATH_RECEIVE_CALLBACK)
 void
@@ -1599,19 +1966,27 @@ QuicBindingReceive(
     QUIC_BINDING* Binding = (QUIC_BINDING*)RecvCallbackContext;
     CXPLAT_RECV_DATA* ReleaseChain = NULL;
     CXPLAT_RECV_DATA** ReleaseChainTail = &ReleaseChain;
-    CXPLAT_RECV_DATA* SubChain = NULL;
-    CXPLAT_RECV_DATA** SubChainTail = &SubChain;
-    CXPLAT_RECV_DATA** SubChainDataTail = &SubChain;
-    uint32_t SubChainLength = 0;
-    uint32_t SubChainBytes = 0;
+    QUIC_RECV_SUBCHAIN SubChains[QUIC_MAX_RECEIVE_GROUP_COUNT];
+    uint8_t SubChainTable[QUIC_RECEIVE_GROUP_HASH_SIZE]; // Index + 1 into SubChains, or 0.
+    uint32_t SubChainCount = 0;
+    QUIC_RECV_SUBCHAIN* SubChain = NULL; // The last one added to.
     uint32_t TotalChainLength = 0;
     uint32_t TotalDatagramBytes = 0;
 
     CXPLAT_DBG_ASSERT(Socket == Binding->Socket);
+    CXPLAT_STATIC_ASSERT(
+        QUIC_MAX_RECEIVE_GROUP_COUNT < QUIC_RECEIVE_GROUP_HASH_SIZE &&
+        (QUIC_RECEIVE_GROUP_HASH_SIZE & (QUIC_RECEIVE_GROUP_HASH_SIZE - 1)) == 0,
+        "The group table must be a power of two with room to spare");
+    CxPlatZeroMemory(SubChainTable, sizeof(SubChainTable));
 
     //
-    // Breaks the chain of datagrams into subchains by destination CID and
-    // delivers the subchains.
+    // Groups the chain of datagrams into subchains by destination CID and
+    // delivers the subchains, so that a connection is looked up and queued
+    // once per receive indication, even when the datagrams of many
+    // connections are interleaved. The subchains are indexed by a small hash
+    // table. If more connections show up than there are subchains, the ones
+    // gathered so far are delivered first.
     //
     // NB: All packets in a datagram are required to have the same destination
     // CID, so we don't split datagrams here. Later on, the packet handling
@@ -1690,61 +2065,51 @@ QuicBindingReceive(
         CXPLAT_DBG_ASSERT(Packet->ValidatedHeaderInv);
 
         //
-        // If the next datagram doesn't match the current subchain, deliver the
-        // current subchain and start a new one.
-        // (If the binding is exclusively owned, all datagrams are delivered to
-        // the same connection and this chain-splitting step is skipped.)
+        // Find the subchain for the datagram's destination CID, starting with
+        // the last one used, since datagrams often come in trains. (If the
+        // binding is exclusively owned, all datagrams are delivered to the
+        // same connection and the grouping step is skipped.)
         //
-        if (!Binding->Exclusive && SubChain != NULL) {
-            QUIC_RX_PACKET* SubChainPacket = (QUIC_RX_PACKET*)SubChain;
-            if ((Packet->DestCidLen != SubChainPacket->DestCidLen ||
-                 memcmp(Packet->DestCid, SubChainPacket->DestCid, Packet->DestCidLen) != 0)) {
-                if (!QuicBindingDeliverPackets(Binding, (QUIC_RX_PACKET*)SubChain, SubChainLength, SubChainBytes)) {
-                    *ReleaseChainTail = SubChain;
-                    ReleaseChainTail = SubChainDataTail;
+        if (SubChain == NULL ||
+            (!Binding->Exclusive && !QuicRecvSubChainMatches(SubChain, Packet))) {
+            uint32_t Slot =
+                CxPlatHashSimple(Packet->DestCidLen, Packet->DestCid) &
+                (QUIC_RECEIVE_GROUP_HASH_SIZE - 1);
+            SubChain = NULL;
+            while (SubChainTable[Slot] != 0) {
+                QUIC_RECV_SUBCHAIN* Candidate = &SubChains[SubChainTable[Slot] - 1];
+                if (QuicRecvSubChainMatches(Candidate, Packet)) {
+                    SubChain = Candidate;
+                    break;
                 }
-                SubChain = NULL;
-                SubChainTail = &SubChain;
-                SubChainDataTail = &SubChain;
-                SubChainLength = 0;
-                SubChainBytes = 0;
+                Slot = (Slot + 1) & (QUIC_RECEIVE_GROUP_HASH_SIZE - 1);
             }
-        }
-
-        //
-        // Insert the datagram into the current chain, with handshake packets
-        // first (we assume handshake packets don't come after non-handshake
-        // packets in a datagram).
-        // We do this so that we can more easily determine if the chain of
-        // packets can create a new connection.
-        //
 
-        SubChainLength++;
-        SubChainBytes += Datagram->BufferLength;
-        if (!QuicPacketIsHandshake(Packet->Invariant)) {
-            *SubChainDataTail = Datagram;
-            SubChainDataTail = &Datagram->Next;
-        } else {
-            if (*SubChainTail == NULL) {
-                *SubChainTail = Datagram;
-                SubChainTail = &Datagram->Next;
-                SubChainDataTail = &Datagram->Next;
-            } else {
-                Datagram->Next = *SubChainTail;
-                *SubChainTail = Datagram;
-                SubChainTail = &Datagram->Next;
+            if (SubChain == NULL) {
+                if (SubChainCount == QUIC_MAX_RECEIVE_GROUP_COUNT) {
+                    for (uint32_t i = 0; i < SubChainCount; ++i) {
+                        QuicBindingDeliverSubChain(Binding, &SubChains[i], &ReleaseChainTail);
+                    }
+                    SubChainCount = 0;
+                    CxPlatZeroMemory(SubChainTable, sizeof(SubChainTable));
+                    Slot =
+                        CxPlatHashSimple(Packet->DestCidLen, Packet->DestCid) &
+                        (QUIC_RECEIVE_GROUP_HASH_SIZE - 1);
+                }
+                SubChain = &SubChains[SubChainCount++];
+                SubChainTable[Slot] = (uint8_t)SubChainCount;
+                QuicRecvSubChainInitialize(SubChain);
             }
         }
+
+        QuicRecvSubChainAdd(SubChain, Datagram);
     }
 
-    if (SubChain != NULL) {
-        //
-        // Deliver the last subchain.
-        //
-        if (!QuicBindingDeliverPackets(Binding, (QUIC_RX_PACKET*)SubChain, SubChainLength, SubChainBytes)) {
-            *ReleaseChainTail = SubChain;
-            ReleaseChainTail = SubChainTail; // cppcheck-suppress unreadVariable; NOLINT
-        }
+    //
+    // Deliver the subchains, in the order of their first datagram.
+    //
+    for (uint32_t i = 0; i < SubChainCount; ++i) {
+        QuicBindingDeliverSubChain(Binding, &SubChains[i], &ReleaseChainTail);
     }
 
     if (ReleaseChain != NULL) {
@@ -1782,6 +2147,62 @@ QuicBindingUnreachable(
     }
 }
 
+//
+// Queues the send in the batch. Returns FALSE if the batch holds sends for
+// another binding or the datapath didn't take the send. The worker flushes
+// the batch before processing a connection on another binding, so a mismatch
+// here only happens for a send on a secondary path; flushing now could drop
+// the last reference on the connection that started the batch.
+//
+static
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+QuicBindingSendBatched(
+    _In_ QUIC_BINDING* Binding,
+    _In_ const CXPLAT_ROUTE* Route,
+    _In_ CXPLAT_SEND_DATA* SendData,
+    _In_ QUIC_CONNECTION* Connection,
+    _Inout_ QUIC_SEND_BATCH* Batch
+    )
+{
+    if (Batch->Binding != NULL && Batch->Binding != Binding) {
+        return FALSE;
+    }
+
+    if (!CxPlatSocketSendBatched(Binding->Socket, Route, SendData, &Batch->Sends)) {
+        return FALSE;
+    }
+
+    if (Batch->Binding == NULL) {
+        //
+        // The batch may outlive the connection's processing, so it keeps the
+        // connection, and through its path the binding, alive until it is
+        // flushed. A binding reference would take the library's datapath lock
+        // on every batch.
+        //
+        QuicConnAddRef(Connection, QUIC_CONN_REF_SEND_BATCH);
+        Batch->Binding = Binding;
+        Batch->Connection = Connection;
+    }
+
+    return TRUE;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicSendBatchFlush(
+    _Inout_ QUIC_SEND_BATCH* Batch
+    )
+{
+    if (Batch->Binding != NULL) {
+        QUIC_CONNECTION* Connection = Batch->Connection;
+        CxPlatSendBatchFlush(&Batch->Sends);
+        Batch->Binding = NULL;
+        Batch->Connection = NULL;
+        QuicConnRelease(Connection, QUIC_CONN_REF_SEND_BATCH);
+    }
+}
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 void
 QuicBindingSend(
@@ -1790,7 +2211,8 @@ QuicBindingSend(
     _In_ const CXPLAT_ROUTE* Route,
     _In_ CXPLAT_SEND_DATA* SendData,
     _In_ uint32_t BytesToSend,
-    _In_ uint32_t DatagramsToSend
+    _In_ uint32_t DatagramsToSend,
+    _In_opt_ QUIC_CONNECTION* Connection
     )
 {
 #if QUIC_TEST_DATAPATH_HOOKS_ENABLED
@@ -1816,7 +2238,12 @@ QuicBindingSend(
         }
     } else {
 #endif
-        CxPlatSocketSend(Binding->Socket, Route, SendData);
+        if (Connection == NULL ||
+            Connection->SendBatch == NULL ||
+            !QuicBindingSendBatched(
+                Binding, Route, SendData, Connection, Connection->SendBatch)) {
+            CxPlatSocketSend(Binding->Socket, Route, SendData);
+        }
 #if QUIC_TEST_DATAPATH_HOOKS_ENABLED
     }
 #endif
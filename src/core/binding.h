@@ -14,8 +14,9 @@ typedef struct QUIC_STATELESS_CONTEXT QUIC_STATELESS_CONTEXT;
 //
 typedef struct QUIC_TOKEN_CONTENTS {
     struct {
-        uint64_t IsNewToken : 1;
-        uint64_t Timestamp  : 63;
+        uint64_t IsNewToken     : 1;
+        uint64_t Timestamp      : 47;   // Milliseconds since the epoch.
+        uint64_t PreFilterTag   : 16;   // See QuicRetryTokenComputePreFilterTag.
     } Authenticated;
     struct {
         QUIC_ADDR RemoteAddress;
@@ -179,6 +180,30 @@ typedef enum QUIC_BINDING_LOOKUP_TYPE {
 
 } QUIC_BINDING_LOOKUP_TYPE;
 
+//
+// One partition's share of the stateless operations (retry, version negotiation
+// and stateless reset) tracked by a binding. Each shard has its own lock and
+// limit so that receive paths on different partitions never contend with each
+// other, and a flood on one partition can't starve responses on the others.
+//
+typedef struct QUIC_STATELESS_OPER_SHARD {
+
+    CXPLAT_DISPATCH_LOCK Lock;
+
+    //
+    // Outstanding operations, indexed by remote address.
+    //
+    CXPLAT_HASHTABLE Table;
+
+    //
+    // Outstanding operations, in order of creation (for aging out).
+    //
+    CXPLAT_LIST_ENTRY List;
+
+    uint32_t Count;
+
+} QUIC_STATELESS_OPER_SHARD;
+
 //
 // Represents a UDP binding of local IP address and UDP port, and optionally
 // remote IP address.
@@ -242,19 +267,21 @@ typedef struct QUIC_BINDING {
     //
     CXPLAT_LIST_ENTRY Listeners;
 
+    //
+    // Index of the listeners by ALPN. Rebuilt (under the RwLock) whenever the
+    // listener list changes. NULL if there are no listeners.
+    //
+    QUIC_ALPN_INDEX* AlpnIndex;
+
     //
     // Lookup tables for connection IDs.
     //
     QUIC_LOOKUP Lookup;
 
     //
-    // Stateless operation tracking structures.
+    // The number of stateless operation tracking shards (one per partition).
     //
-    CXPLAT_DISPATCH_LOCK StatelessOperLock;
-    CXPLAT_HASHTABLE StatelessOperTable;
-    CXPLAT_LIST_ENTRY StatelessOperList;
-    CXPLAT_POOL StatelessOperCtxPool;
-    uint32_t StatelessOperCount;
+    uint16_t StatelessOperShardCount;
 
     struct {
 
@@ -264,6 +291,12 @@ typedef struct QUIC_BINDING {
 
     } Stats;
 
+    //
+    // Stateless operation tracking structures, sharded by partition. Count of
+    // `StatelessOperShardCount`.
+    //
+    QUIC_STATELESS_OPER_SHARD StatelessOperShards[0];
+
 } QUIC_BINDING;
 
 //
@@ -271,6 +304,7 @@ typedef struct QUIC_BINDING {
 //
 CXPLAT_DATAPATH_RECEIVE_CALLBACK QuicBindingReceive;
 CXPLAT_DATAPATH_UNREACHABLE_CALLBACK QuicBindingUnreachable;
+CXPLAT_DATAPATH_RECEIVE_FILTER_CALLBACK QuicBindingReceiveFilter;
 
 //
 // Initializes a new binding.
@@ -420,6 +454,29 @@ QuicBindingOnConnectionHandshakeConfirmed(
     _In_ QUIC_CONNECTION* Connection
     );
 
+//
+// The number of stateless operations the given shard may have outstanding.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+uint32_t
+QuicBindingGetMaxStatelessOperationsPerShard(
+    _In_ const QUIC_BINDING* Binding,
+    _In_ uint16_t ShardIndex
+    );
+
+//
+// Tracks a new stateless operation for the packet's remote address in the
+// worker's partition's shard. Returns NULL if the shard is full or already has
+// one for that address.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATELESS_CONTEXT*
+QuicBindingCreateStatelessOperation(
+    _In_ QUIC_BINDING* Binding,
+    _In_ QUIC_WORKER* Worker,
+    _In_ QUIC_RX_PACKET* Packet
+    );
+
 //
 // Queues a stateless operation on the binding.
 //
@@ -451,9 +508,35 @@ QuicBindingReleaseStatelessOperation(
     _In_ BOOLEAN ReturnDatagram
     );
 
+//
+// Sends collected from many connections, on a single binding, to be handed to
+// the datapath together.
+//
+typedef struct QUIC_SEND_BATCH {
+
+    //
+    // The binding the sends are for.
+    //
+    QUIC_BINDING* Binding;
+
+    //
+    // The connection that queued the first send. The batch holds a reference
+    // on it while it has sends queued, and its path keeps the binding alive.
+    //
+    QUIC_CONNECTION* Connection;
+
+    //
+    // The sends queued in the datapath.
+    //
+    CXPLAT_SEND_BATCH Sends;
+
+} QUIC_SEND_BATCH;
+
 //
 // Sends data to a remote host. Note, the buffer must remain valid for
-// the duration of the send operation.
+// the duration of the send operation. If the send is for a connection that is
+// being processed by its worker, it may be held in the worker's batch until the
+// batch is flushed.
 //
 _IRQL_requires_max_(DISPATCH_LEVEL)
 void
@@ -463,7 +546,17 @@ QuicBindingSend(
     _In_ const CXPLAT_ROUTE* Route,
     _In_ CXPLAT_SEND_DATA* SendData,
     _In_ uint32_t BytesToSend,
-    _In_ uint32_t DatagramsToSend
+    _In_ uint32_t DatagramsToSend,
+    _In_opt_ QUIC_CONNECTION* Connection
+    );
+
+//
+// Sends everything held in the batch and releases its connection reference.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicSendBatchFlush(
+    _Inout_ QUIC_SEND_BATCH* Batch
     );
 
 
@@ -477,6 +570,21 @@ QuicBindingHandleDosModeStateChange(
     _In_ BOOLEAN DosModeEnabled
     );
 
+//
+// Computes the tag used to cheaply reject retry tokens before decrypting them.
+// It is a keyed PRF (SipHash-2-4) of the client's address and the token's
+// timestamp, so random tokens, and valid tokens sprayed from other (spoofed)
+// addresses, are dropped without taking the retry key lock or running the
+// AEAD. It does not replace the AEAD, which still authenticates every token
+// that gets past it.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+uint16_t
+QuicRetryTokenComputePreFilterTag(
+    _In_ const QUIC_ADDR* RemoteAddress,
+    _In_ uint64_t Timestamp
+    );
+
 //
 // Decrypts the retry token.
 //
@@ -492,14 +600,22 @@ QuicRetryTokenDecrypt(
 {
 #ifdef __cplusplus
     QUIC_PARTITION* Partition = &MsQuicLib.Partitions[Packet->_.PartitionIndex];
+    const QUIC_ADDR* RemoteAddress = &Packet->_.Route->RemoteAddress;
 #else
     QUIC_PARTITION* Partition = &MsQuicLib.Partitions[Packet->PartitionIndex];
+    const QUIC_ADDR* RemoteAddress = &Packet->Route->RemoteAddress;
 #endif
     //
     // Copy the token locally so as to not effect the original packet buffer,
     //
     CxPlatCopyMemory(Token, TokenBuffer, sizeof(QUIC_TOKEN_CONTENTS));
 
+    if (Token->Authenticated.PreFilterTag !=
+        QuicRetryTokenComputePreFilterTag(
+            RemoteAddress, (uint64_t)Token->Authenticated.Timestamp)) {
+        return FALSE;
+    }
+
     uint8_t Iv[CXPLAT_MAX_IV_LENGTH];
     if (MsQuicLib.CidTotalLength >= CXPLAT_IV_LENGTH) {
         CxPlatCopyMemory(Iv, Packet->DestCid, CXPLAT_IV_LENGTH);
@@ -71,7 +71,10 @@ QuicConnAlloc(
     const uint16_t PartitionId = QuicPartitionIdCreate(Partition->Index);
     CXPLAT_DBG_ASSERT(Partition->Index == QuicPartitionIdGetIndex(PartitionId));
 
-    QUIC_CONNECTION* Connection = CxPlatPoolAlloc(&Partition->ConnectionPool);
+    QUIC_CONNECTION* Connection =
+        Partition->UseObjectArenas ?
+            QuicObjectArenaAlloc(&Partition->ConnectionArena) :
+            CxPlatPoolAlloc(&Partition->ConnectionPool);
     if (Connection == NULL) {
         QuicTraceEvent(
             AllocFailure,
@@ -326,6 +329,15 @@ QuicConnFree(
             Connection->Packets[i] = NULL;
         }
     }
+    //
+    // A connection that failed to rehydrate is shut down while still
+    // hibernated, so its frozen packet space may still be around.
+    //
+    CXPLAT_DBG_ASSERT(!Connection->State.Hibernated || Connection->State.ShutdownComplete);
+    if (Connection->FrozenPackets != NULL) {
+        CXPLAT_FREE(Connection->FrozenPackets, QUIC_POOL_PACKET_SPACE_FROZEN);
+        Connection->FrozenPackets = NULL;
+    }
 #if DEBUG
     while (!CxPlatListIsEmpty(&Connection->Streams.AllStreams)) {
         QUIC_STREAM *Stream =
@@ -402,7 +414,11 @@ QuicConnFree(
         ConnDestroyed,
         "[conn][%p] Destroyed",
         Connection);
-    CxPlatPoolFree(Connection);
+    if (Connection->Partition->UseObjectArenas) {
+        QuicObjectArenaFree(Connection);
+    } else {
+        CxPlatPoolFree(Connection);
+    }
 
 #if DEBUG
     InterlockedDecrement(&MsQuicLib.ConnectionCount);
@@ -1254,7 +1270,20 @@ QuicConnTimerExpired(
                 "[conn][%p] %hhu expired",
                 Connection,
                 (uint8_t)Type);
-            if (Type == QUIC_CONN_TIMER_ACK_DELAY) {
+            if ((Type == QUIC_CONN_TIMER_ACK_DELAY || Type == QUIC_CONN_TIMER_PACING) &&
+                Connection->State.Hibernated) {
+                //
+                // These two run inline against the released send state, but
+                // hibernation requires both to be cancelled. Drop the expiration
+                // instead of touching the missing state.
+                //
+                CXPLAT_TEL_ASSERTMSG(FALSE, "Send timer expired while hibernated");
+                QuicTraceEvent(
+                    ConnError,
+                    "[conn][%p] ERROR, %s.",
+                    Connection,
+                    "Send timer expired while hibernated");
+            } else if (Type == QUIC_CONN_TIMER_ACK_DELAY) {
                 QuicTraceEvent(
                     ConnExecTimerOper,
                     "[conn][%p] Execute: %u",
@@ -1730,6 +1759,56 @@ QuicConnOnQuicVersionSet(
     }
 }
 
+//
+// Applies a ticket from the registration's resumption cache, if one matches
+// the server name and ALPN list. Any failure just results in a full handshake.
+//
+static
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicConnTakeCachedResumptionTicket(
+    _In_ QUIC_CONNECTION* Connection,
+    _In_ const QUIC_CONFIGURATION* Configuration
+    )
+{
+    const size_t ServerNameLength =
+        Connection->RemoteServerName == NULL ?
+            0 : strlen(Connection->RemoteServerName);
+    if (ServerNameLength == 0 || ServerNameLength > UINT16_MAX) {
+        return;
+    }
+
+    QUIC_RESUMPTION_CACHE_ENTRY* Entry =
+        QuicResumptionCacheTake(
+            Connection->Registration->ResumptionCache,
+            (uint16_t)ServerNameLength,
+            Connection->RemoteServerName,
+            Configuration->AlpnListLength,
+            Configuration->AlpnList,
+            CxPlatTimeUs64());
+    if (Entry == NULL) {
+        return;
+    }
+
+    QUIC_STATUS Status =
+        QuicCryptoDecodeClientTicket(
+            Connection,
+            Entry->TicketLength,
+            Entry->Ticket,
+            &Connection->PeerTransportParams,
+            &Connection->Crypto.ResumptionTicket,
+            &Connection->Crypto.ResumptionTicketLength,
+            &Connection->Stats.QuicVersion);
+    QuicResumptionCacheEntryFree(Entry);
+    if (QUIC_FAILED(Status)) {
+        return;
+    }
+
+    QuicConnOnQuicVersionSet(Connection);
+    Status = QuicConnProcessPeerTransportParameters(Connection, TRUE);
+    CXPLAT_DBG_ASSERT(QUIC_SUCCEEDED(Status));
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 QUIC_STATUS
 QuicConnStart(
@@ -1916,6 +1995,14 @@ QuicConnStart(
     Connection->RemoteServerName = ServerName;
     ServerName = NULL;
 
+    if (Connection->Crypto.ResumptionTicket == NULL &&
+        Connection->Registration->ResumptionCache != NULL) {
+        //
+        // The app didn't provide a ticket, so try to find one in the cache.
+        //
+        QuicConnTakeCachedResumptionTicket(Connection, Configuration);
+    }
+
     Status = QuicCryptoInitialize(&Connection->Crypto);
     if (QUIC_FAILED(Status)) {
         goto Exit;
@@ -2120,6 +2207,39 @@ QuicConnRecvResumptionTicket(
             goto Error;
         }
 
+        if (Connection->Settings.ServerResumptionLevel == QUIC_SERVER_RESUME_AND_ZERORTT &&
+            MsQuicLib.Settings.AntiReplayWindowMs != 0) {
+            //
+            // 0-RTT data may be replayed by an attacker, so only accept each
+            // ticket once. Tickets older than the window can't be tracked and
+            // are rejected outright. The filter shard is picked by the ticket
+            // nonce, not the connection's partition, so that replays sent to
+            // a different partition are still caught.
+            //
+            uint64_t Nonce, IssueTime;
+            QuicCryptoGetServerTicketReplayInfo(TicketLength, Ticket, &Nonce, &IssueTime);
+            const uint64_t TimeNow = CxPlatTimeEpochMs64();
+            if (CxPlatTimeDiff64(IssueTime, TimeNow) > MsQuicLib.Settings.AntiReplayWindowMs) {
+                QuicTraceEvent(
+                    ConnError,
+                    "[conn][%p] ERROR, %s.",
+                    Connection,
+                    "Resumption Ticket too old for anti-replay window");
+                goto Error;
+            }
+            QUIC_PARTITION* Partition =
+                &MsQuicLib.Partitions[
+                    QuicAntiReplayShardIndex(Nonce, MsQuicLib.PartitionCount)];
+            if (!QuicPartitionAntiReplayInsert(Partition, Nonce, TimeNow)) {
+                QuicTraceEvent(
+                    ConnError,
+                    "[conn][%p] ERROR, %s.",
+                    Connection,
+                    "Resumption Ticket replay detected");
+                goto Error;
+            }
+        }
+
         QUIC_CONNECTION_EVENT Event;
         Event.Type = QUIC_CONNECTION_EVENT_RESUMED;
         Event.RESUMED.ResumptionStateLength = (uint16_t)AppDataLength;
@@ -2179,6 +2299,23 @@ QuicConnRecvResumptionTicket(
                 "Indicating QUIC_CONNECTION_EVENT_RESUMPTION_TICKET_RECEIVED");
             (void)QuicConnIndicateEvent(Connection, &Event);
 
+            if (Connection->Registration->ResumptionCache != NULL &&
+                Connection->RemoteServerName != NULL &&
+                Connection->Configuration != NULL) {
+                const size_t ServerNameLength = strlen(Connection->RemoteServerName);
+                if (ServerNameLength != 0 && ServerNameLength <= UINT16_MAX) {
+                    QuicResumptionCacheInsert(
+                        Connection->Registration->ResumptionCache,
+                        (uint16_t)ServerNameLength,
+                        Connection->RemoteServerName,
+                        Connection->Configuration->AlpnListLength,
+                        Connection->Configuration->AlpnList,
+                        ClientTicketLength,
+                        ClientTicket,
+                        CxPlatTimeUs64());
+                }
+            }
+
             CXPLAT_FREE(ClientTicket, QUIC_POOL_CLIENT_CRYPTO_TICKET);
             ResumptionAccepted = TRUE;
         }
@@ -2217,8 +2354,10 @@ QuicConnCleanupServerResumptionState(
         if (Crypto->Initialized) {
             QuicRecvBufferUninitialize(&Crypto->RecvBuffer);
             QuicRangeUninitialize(&Crypto->SparseAckRanges);
-            CXPLAT_FREE(Crypto->TlsState.Buffer, QUIC_POOL_TLS_BUFFER);
-            Crypto->TlsState.Buffer = NULL;
+            if (Crypto->TlsState.Buffer != NULL) { // NULL while hibernated.
+                CXPLAT_FREE(Crypto->TlsState.Buffer, QUIC_POOL_TLS_BUFFER);
+                Crypto->TlsState.Buffer = NULL;
+            }
             Crypto->Initialized = FALSE;
         }
     }
@@ -3212,6 +3351,8 @@ QuicConnQueueRecvPackets(
         return;
     }
 
+    QuicPerfCounterIncrement(Connection->Partition, QUIC_PERF_COUNTER_CONN_RECV_QUEUED);
+
     if (QueueOperation) {
         QUIC_OPERATION* ConnOper =
             QuicConnAllocOperation(Connection, QUIC_OPER_TYPE_FLUSH_RECV);
@@ -5623,13 +5764,25 @@ QuicConnRecvDatagrams(
         CXPLAT_DBG_ASSERT(Packet->ReleaseDeferred == IsDeferred);
         Packet->ReleaseDeferred = FALSE;
 
-        QUIC_PATH* DatagramPath = QuicConnGetPathForPacket(Connection, Packet);
-        if (DatagramPath == NULL) {
-            QuicPacketLogDrop(Connection, Packet, "Max paths already tracked");
-            goto Drop;
-        }
+        QUIC_PATH* DatagramPath;
+        if (Packet->Coalesced && BatchCount != 0 &&
+            Batch[BatchCount - 1]->Route == Packet->Route) {
+            //
+            // The rest of a coalesced (GRO/URO) receive, following a packet
+            // of the same receive that is still in the current batch. It has
+            // the same route and therefore path, which the batch's pending
+            // processing can't have changed yet.
+            //
+            DatagramPath = CurrentPath;
+        } else {
+            DatagramPath = QuicConnGetPathForPacket(Connection, Packet);
+            if (DatagramPath == NULL) {
+                QuicPacketLogDrop(Connection, Packet, "Max paths already tracked");
+                goto Drop;
+            }
 
-        CxPlatUpdateRoute(&DatagramPath->Route, Packet->Route);
+            CxPlatUpdateRoute(&DatagramPath->Route, Packet->Route);
+        }
 
         if (DatagramPath != CurrentPath) {
             if (BatchCount != 0) {
@@ -6054,6 +6207,25 @@ QuicConnProcessRouteCompletion(
     }
 }
 
+//
+// (Re)starts the timer after which an idle connection hibernates, if enabled.
+//
+static
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicConnRestartHibernateTimer(
+    _In_ QUIC_CONNECTION* Connection
+    )
+{
+    if (Connection->Settings.IdleHibernationTimeoutMs != 0 &&
+        Connection->State.HandshakeConfirmed) {
+        QuicConnTimerSet(
+            Connection,
+            QUIC_CONN_TIMER_HIBERNATE,
+            MS_TO_US(Connection->Settings.IdleHibernationTimeoutMs));
+    }
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
 QuicConnResetIdleTimeout(
@@ -6106,6 +6278,9 @@ QuicConnResetIdleTimeout(
             QUIC_CONN_TIMER_KEEP_ALIVE,
             MS_TO_US(Connection->Settings.KeepAliveIntervalMs));
     }
+
+    Connection->State.HibernatePending = FALSE;
+    QuicConnRestartHibernateTimer(Connection);
 }
 
 _IRQL_requires_max_(PASSIVE_LEVEL)
@@ -6145,6 +6320,215 @@ QuicConnProcessKeepAliveOperation(
         MS_TO_US(Connection->Settings.KeepAliveIntervalMs));
 }
 
+//
+// Estimates the memory held by the connection: the connection object, its
+// packet spaces, crypto buffers, CIDs and streams. TLS library state and
+// pooled operations are not included.
+//
+static
+_IRQL_requires_max_(PASSIVE_LEVEL)
+uint32_t
+QuicConnGetMemoryFootprint(
+    _In_ QUIC_CONNECTION* Connection
+    )
+{
+    uint32_t Size = sizeof(QUIC_CONNECTION);
+
+    for (uint32_t i = 0; i < ARRAYSIZE(Connection->Packets); i++) {
+        if (Connection->Packets[i] != NULL) {
+            Size += sizeof(QUIC_PACKET_SPACE);
+        }
+    }
+    if (Connection->FrozenPackets != NULL) {
+        Size += QuicPacketSpaceFrozenSize(Connection->FrozenPackets);
+    }
+
+    QUIC_CRYPTO* Crypto = &Connection->Crypto;
+    if (Crypto->Initialized) {
+        if (Crypto->TlsState.Buffer != NULL) {
+            Size += Crypto->TlsState.BufferAllocLength;
+        }
+        Size += QuicRecvBufferGetAllocatedSize(&Crypto->RecvBuffer);
+    }
+
+    for (CXPLAT_SLIST_ENTRY* Entry = Connection->SourceCids.Next;
+            Entry != NULL;
+            Entry = Entry->Next) {
+        const QUIC_CID_HASH_ENTRY* SourceCid =
+            CXPLAT_CONTAINING_RECORD(Entry, QUIC_CID_HASH_ENTRY, Link);
+        Size += sizeof(QUIC_CID_HASH_ENTRY) + SourceCid->CID.Length;
+    }
+    for (CXPLAT_LIST_ENTRY* Entry = Connection->DestCids.Flink;
+            Entry != &Connection->DestCids;
+            Entry = Entry->Flink) {
+        const QUIC_CID_LIST_ENTRY* DestCid =
+            CXPLAT_CONTAINING_RECORD(Entry, QUIC_CID_LIST_ENTRY, Link);
+        Size += sizeof(QUIC_CID_LIST_ENTRY) + DestCid->CID.Length;
+    }
+
+    if (Connection->Streams.StreamTable != NULL) {
+        CXPLAT_HASHTABLE_ENUMERATOR Enumerator;
+        CXPLAT_HASHTABLE_ENTRY* Entry;
+        CxPlatHashtableEnumerateBegin(Connection->Streams.StreamTable, &Enumerator);
+        while ((Entry = CxPlatHashtableEnumerateNext(Connection->Streams.StreamTable, &Enumerator)) != NULL) {
+            QUIC_STREAM* Stream = CXPLAT_CONTAINING_RECORD(Entry, QUIC_STREAM, TableEntry);
+            Size += sizeof(QUIC_STREAM) + QuicRecvBufferGetAllocatedSize(&Stream->RecvBuffer);
+        }
+        CxPlatHashtableEnumerateEnd(Connection->Streams.StreamTable, &Enumerator);
+    }
+
+    return Size;
+}
+
+//
+// Returns TRUE if the connection has nothing in flight or pending, so that its
+// receive and send state can be released.
+//
+static
+_IRQL_requires_max_(PASSIVE_LEVEL)
+BOOLEAN
+QuicConnCanHibernate(
+    _In_ const QUIC_CONNECTION* Connection
+    )
+{
+    const QUIC_PACKET_SPACE* Packets = Connection->Packets[QUIC_ENCRYPT_LEVEL_1_RTT];
+    return
+        Connection->State.Connected &&
+        Connection->State.HandshakeConfirmed &&
+        !Connection->State.ClosedLocally &&
+        !Connection->State.ClosedRemotely &&
+        !Connection->State.Hibernated &&
+        Connection->Packets[QUIC_ENCRYPT_LEVEL_INITIAL] == NULL &&
+        Connection->Packets[QUIC_ENCRYPT_LEVEL_HANDSHAKE] == NULL &&
+        Packets != NULL &&
+        Packets->DeferredPackets == NULL &&
+        Packets->AckTracker.AckElicitingPacketsToAcknowledge == 0 &&
+        Connection->LossDetection.SentPackets == NULL &&
+        Connection->Send.SendFlags == 0 &&
+        CxPlatListIsEmpty(&Connection->Send.SendStreams) &&
+        Connection->ExpirationTimes[QUIC_CONN_TIMER_PACING] == UINT64_MAX &&
+        Connection->ExpirationTimes[QUIC_CONN_TIMER_ACK_DELAY] == UINT64_MAX &&
+        Connection->ExpirationTimes[QUIC_CONN_TIMER_LOSS_DETECTION] == UINT64_MAX;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicConnHibernate(
+    _In_ QUIC_CONNECTION* Connection
+    )
+{
+    if (!QuicConnCanHibernate(Connection)) {
+        if (!Connection->State.ClosedLocally && !Connection->State.ClosedRemotely) {
+            //
+            // Try again after another idle period.
+            //
+            QuicConnRestartHibernateTimer(Connection);
+        }
+        return;
+    }
+
+    if (QUIC_FAILED(
+            QuicPacketSpaceFreeze(
+                Connection->Packets[QUIC_ENCRYPT_LEVEL_1_RTT],
+                &Connection->FrozenPackets))) {
+        return; // Not worth failing the connection over.
+    }
+    Connection->Packets[QUIC_ENCRYPT_LEVEL_1_RTT] = NULL;
+
+    QuicCryptoHibernate(&Connection->Crypto);
+
+    if (Connection->Streams.StreamTable != NULL) {
+        CXPLAT_HASHTABLE_ENUMERATOR Enumerator;
+        CXPLAT_HASHTABLE_ENTRY* Entry;
+        CxPlatHashtableEnumerateBegin(Connection->Streams.StreamTable, &Enumerator);
+        while ((Entry = CxPlatHashtableEnumerateNext(Connection->Streams.StreamTable, &Enumerator)) != NULL) {
+            QuicStreamHibernate(CXPLAT_CONTAINING_RECORD(Entry, QUIC_STREAM, TableEntry));
+        }
+        CxPlatHashtableEnumerateEnd(Connection->Streams.StreamTable, &Enumerator);
+    }
+
+    Connection->State.Hibernated = TRUE;
+    Connection->HibernatedBytes = QuicConnGetMemoryFootprint(Connection);
+    QuicPerfCounterIncrement(Connection->Partition, QUIC_PERF_COUNTER_CONN_HIBERNATED);
+    QuicPerfCounterAdd(
+        Connection->Partition,
+        QUIC_PERF_COUNTER_CONN_HIBERNATED_BYTES,
+        Connection->HibernatedBytes);
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+QuicConnRehydrate(
+    _In_ QUIC_CONNECTION* Connection
+    )
+{
+    CXPLAT_DBG_ASSERT(Connection->State.Hibernated);
+    CXPLAT_DBG_ASSERT(!Connection->State.ShutdownComplete);
+    QUIC_STATUS Status;
+
+    QuicPerfCounterDecrement(Connection->Partition, QUIC_PERF_COUNTER_CONN_HIBERNATED);
+    QuicPerfCounterAdd(
+        Connection->Partition,
+        QUIC_PERF_COUNTER_CONN_HIBERNATED_BYTES,
+        -(int64_t)Connection->HibernatedBytes);
+    Connection->HibernatedBytes = 0;
+
+    Status =
+        QuicPacketSpaceThaw(
+            Connection,
+            Connection->FrozenPackets,
+            &Connection->Packets[QUIC_ENCRYPT_LEVEL_1_RTT]);
+    if (QUIC_FAILED(Status)) {
+        goto Error;
+    }
+    Connection->FrozenPackets = NULL;
+
+    if (QUIC_FAILED(Status = QuicCryptoRehydrate(&Connection->Crypto))) {
+        goto Error;
+    }
+
+    if (Connection->Streams.StreamTable != NULL) {
+        CXPLAT_HASHTABLE_ENUMERATOR Enumerator;
+        CXPLAT_HASHTABLE_ENTRY* Entry;
+        CxPlatHashtableEnumerateBegin(Connection->Streams.StreamTable, &Enumerator);
+        while ((Entry = CxPlatHashtableEnumerateNext(Connection->Streams.StreamTable, &Enumerator)) != NULL) {
+            Status = QuicStreamRehydrate(CXPLAT_CONTAINING_RECORD(Entry, QUIC_STREAM, TableEntry));
+            if (QUIC_FAILED(Status)) {
+                break;
+            }
+        }
+        CxPlatHashtableEnumerateEnd(Connection->Streams.StreamTable, &Enumerator);
+        if (QUIC_FAILED(Status)) {
+            goto Error;
+        }
+    }
+
+    Connection->State.Hibernated = FALSE;
+    QuicConnRestartHibernateTimer(Connection);
+    return QUIC_STATUS_SUCCESS;
+
+Error:
+
+    //
+    // The connection can't safely process anything without its state, so it
+    // is closed silently and immediately. It stays marked as hibernated, which
+    // tells the operation processing that only teardown is still possible.
+    //
+    QuicTraceEvent(
+        ConnErrorStatus,
+        "[conn][%p] ERROR, %u, %s.",
+        Connection,
+        Status,
+        "Rehydrate hibernated connection");
+    QuicConnCloseLocally(
+        Connection,
+        QUIC_CLOSE_INTERNAL_SILENT | QUIC_CLOSE_QUIC_STATUS,
+        (uint64_t)Status,
+        NULL);
+    QuicConnOnShutdownComplete(Connection);
+    return Status;
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
 QuicConnUpdatePeerPacketTolerance(
@@ -6255,6 +6639,13 @@ QuicConnParamSet(
 
             QuicBindingMoveSourceConnectionIDs(
                 OldBinding, Connection->Paths[0].Binding, Connection);
+            if (Connection->Worker->SendBatch.Connection == Connection) {
+                //
+                // The batch relies on this connection to keep its binding
+                // alive.
+                //
+                QuicSendBatchFlush(&Connection->Worker->SendBatch);
+            }
             QuicLibraryReleaseBinding(OldBinding);
 
             QuicTraceEvent(
@@ -7632,6 +8023,52 @@ QuicConnProcessApiOperation(
     }
 }
 
+//
+// Returns TRUE for the API calls that can touch the crypto, 1-RTT packet space
+// or stream receive state a hibernated connection released. The rest only tear
+// down or cancel, which a shut down connection handles without that state.
+//
+static
+_IRQL_requires_max_(PASSIVE_LEVEL)
+BOOLEAN
+QuicConnApiNeedsRehydratedState(
+    _In_ QUIC_API_TYPE Type
+    )
+{
+    switch (Type) {
+    case QUIC_API_TYPE_CONN_CLOSE:
+    case QUIC_API_TYPE_CONN_SHUTDOWN:
+    case QUIC_API_TYPE_STRM_CLOSE:
+    case QUIC_API_TYPE_STRM_SHUTDOWN:
+    case QUIC_API_TYPE_STRM_START:
+    case QUIC_API_TYPE_STRM_SEND:
+    case QUIC_API_TYPE_STRM_RECV_COMPLETE:
+    case QUIC_API_TYPE_DATAGRAM_SEND:
+        return FALSE;
+    default:
+        return TRUE;
+    }
+}
+
+//
+// Completes an API call without processing it, for a connection that was shut
+// down because it couldn't rehydrate.
+//
+static
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicConnFailApiOperation(
+    _In_ QUIC_API_CONTEXT* ApiCtx
+    )
+{
+    if (ApiCtx->Status) {
+        *ApiCtx->Status = QUIC_STATUS_INVALID_STATE;
+    }
+    if (ApiCtx->Completed) {
+        CxPlatEventSet(*ApiCtx->Completed);
+    }
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
 QuicConnProcessExpiredTimer(
@@ -7649,6 +8086,9 @@ QuicConnProcessExpiredTimer(
     case QUIC_CONN_TIMER_KEEP_ALIVE:
         QuicConnProcessKeepAliveOperation(Connection);
         break;
+    case QUIC_CONN_TIMER_HIBERNATE:
+        Connection->State.HibernatePending = TRUE;
+        break;
     case QUIC_CONN_TIMER_SHUTDOWN:
         QuicConnProcessShutdownTimerOperation(Connection);
         break;
@@ -7673,6 +8113,16 @@ QuicConnDrainOperations(
 
     CXPLAT_PASSIVE_CODE();
 
+    if (Connection->State.Hibernated &&
+        !Connection->State.ShutdownComplete &&
+        QUIC_FAILED(QuicConnRehydrate(Connection))) {
+        //
+        // The connection is now shut down without its released state. The
+        // operations below still run, but API calls that need that state fail.
+        //
+        CXPLAT_DBG_ASSERT(Connection->State.ShutdownComplete);
+    }
+
     if (!Connection->State.Initialized && !Connection->State.ShutdownComplete) {
         //
         // TODO - Try to move this only after the connection is accepted by the
@@ -7714,9 +8164,14 @@ QuicConnDrainOperations(
 
         case QUIC_OPER_TYPE_API_CALL:
             CXPLAT_DBG_ASSERT(Oper->API_CALL.Context != NULL);
-            QuicConnProcessApiOperation(
-                Connection,
-                Oper->API_CALL.Context);
+            if (Connection->State.Hibernated &&
+                QuicConnApiNeedsRehydratedState(Oper->API_CALL.Context->Type)) {
+                QuicConnFailApiOperation(Oper->API_CALL.Context);
+            } else {
+                QuicConnProcessApiOperation(
+                    Connection,
+                    Oper->API_CALL.Context);
+            }
             break;
 
         case QUIC_OPER_TYPE_FLUSH_RECV:
@@ -7820,6 +8275,15 @@ QuicConnDrainOperations(
 
     QuicStreamSetDrainClosedStreams(&Connection->Streams);
 
+    if (Connection->State.HibernatePending) {
+        Connection->State.HibernatePending = FALSE;
+        if (!HasMoreWorkToDo && !Connection->State.ShutdownComplete) {
+            QuicConnHibernate(Connection);
+        } else if (!Connection->State.ShutdownComplete) {
+            QuicConnRestartHibernateTimer(Connection);
+        }
+    }
+
     QuicConnValidate(Connection);
 
     if (HasMoreWorkToDo) {
@@ -194,6 +194,19 @@ typedef union QUIC_CONNECTION_STATE {
         //
         BOOLEAN DelayedApplicationError : 1;
 
+        //
+        // Indicates the connection has been idle long enough that its packet
+        // space and empty buffers were released to save memory. They are
+        // recreated before any further processing.
+        //
+        BOOLEAN Hibernated : 1;
+
+        //
+        // The hibernation timer fired and the connection will hibernate once
+        // its operation queue has been drained.
+        //
+        BOOLEAN HibernatePending : 1;
+
 #ifdef CxPlatVerifierEnabledByAddr
         //
         // The calling app is being verified (app or driver verifier).
@@ -225,6 +238,7 @@ typedef enum QUIC_CONNECTION_REF {
     QUIC_CONN_REF_TIMER_WHEEL,          // The timer wheel is tracking the connection.
     QUIC_CONN_REF_ROUTE,                // Route resolution is undergoing.
     QUIC_CONN_REF_STREAM,               // A stream depends on the connection.
+    QUIC_CONN_REF_SEND_BATCH,           // Worker send batch holds its sends.
 
     QUIC_CONN_REF_COUNT
 
@@ -385,6 +399,12 @@ typedef struct QUIC_CONNECTION {
     //
     CXPLAT_THREAD_ID WorkerThreadID;
 
+    //
+    // The send batch of the worker processing the connection. NULL if not
+    // being processed right now.
+    //
+    QUIC_SEND_BATCH* SendBatch;
+
     //
     // The server ID for the connection ID.
     //
@@ -612,6 +632,17 @@ typedef struct QUIC_CONNECTION {
     //
     QUIC_PACKET_SPACE* Packets[QUIC_ENCRYPT_LEVEL_COUNT];
 
+    //
+    // The compact form of the 1-RTT packet space while hibernated.
+    //
+    QUIC_PACKET_SPACE_FROZEN* FrozenPackets;
+
+    //
+    // The memory footprint counted in QUIC_PERF_COUNTER_CONN_HIBERNATED_BYTES
+    // while hibernated.
+    //
+    uint32_t HibernatedBytes;
+
     //
     // Manages the stream of cryptographic TLS data sent and received.
     //
@@ -1587,6 +1618,27 @@ QuicConnResetIdleTimeout(
     _In_ QUIC_CONNECTION* Connection
     );
 
+//
+// Releases the memory of an idle connection that isn't needed until it sends
+// or receives again. Does nothing if the connection isn't idle.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicConnHibernate(
+    _In_ QUIC_CONNECTION* Connection
+    );
+
+//
+// Recreates the state released by QuicConnHibernate. Called before the
+// connection processes any operation. On failure the connection is shut down
+// silently and stays marked as hibernated.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+QuicConnRehydrate(
+    _In_ QUIC_CONNECTION* Connection
+    );
+
 //
 // Queues a received packet chain to a connection for processing.
 //
@@ -257,10 +257,64 @@ QuicCryptoUninitialize(
     if (Crypto->Initialized) {
         QuicRecvBufferUninitialize(&Crypto->RecvBuffer);
         QuicRangeUninitialize(&Crypto->SparseAckRanges);
+        if (Crypto->TlsState.Buffer != NULL) { // NULL while hibernated.
+            CXPLAT_FREE(Crypto->TlsState.Buffer, QUIC_POOL_TLS_BUFFER);
+            Crypto->TlsState.Buffer = NULL;
+        }
+        Crypto->Initialized = FALSE;
+    }
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicCryptoHibernate(
+    _In_ QUIC_CRYPTO* Crypto
+    )
+{
+    if (!Crypto->Initialized) {
+        return;
+    }
+
+    if (Crypto->TlsState.Buffer != NULL && Crypto->TlsState.BufferLength == 0) {
         CXPLAT_FREE(Crypto->TlsState.Buffer, QUIC_POOL_TLS_BUFFER);
         Crypto->TlsState.Buffer = NULL;
-        Crypto->Initialized = FALSE;
     }
+    (void)QuicRecvBufferRelease(&Crypto->RecvBuffer);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+QuicCryptoRehydrate(
+    _In_ QUIC_CRYPTO* Crypto
+    )
+{
+    if (!Crypto->Initialized) {
+        return QUIC_STATUS_SUCCESS;
+    }
+
+    if (Crypto->TlsState.Buffer == NULL) {
+        Crypto->TlsState.Buffer =
+            CXPLAT_ALLOC_NONPAGED(Crypto->TlsState.BufferAllocLength, QUIC_POOL_TLS_BUFFER);
+        if (Crypto->TlsState.Buffer == NULL) {
+            QuicTraceEvent(
+                AllocFailure,
+                "Allocation of '%s' failed. (%llu bytes)",
+                "crypto send buffer",
+                Crypto->TlsState.BufferAllocLength);
+            return QUIC_STATUS_OUT_OF_MEMORY;
+        }
+    }
+
+    if (QuicRecvBufferIsReleased(&Crypto->RecvBuffer)) {
+        return
+            QuicRecvBufferRestore(
+                &Crypto->RecvBuffer,
+                QuicConnIsServer(QuicCryptoGetConnection(Crypto)) ?
+                    QUIC_MAX_TLS_CLIENT_SEND_BUFFER : QUIC_DEFAULT_STREAM_RECV_BUFFER_SIZE,
+                NULL);
+    }
+
+    return QUIC_STATUS_SUCCESS;
 }
 
 _IRQL_requires_max_(PASSIVE_LEVEL)
@@ -2208,7 +2262,8 @@ QuicCryptoEncodeServerTicket(
         QuicVarIntSize(AppDataLength) +
         AlpnLength +
         EncodedTPLength +
-        AppDataLength);
+        AppDataLength +
+        QUIC_SERVER_TICKET_REPLAY_INFO_LENGTH);
 
     TicketBuffer = CXPLAT_ALLOC_NONPAGED(TotalTicketLength, QUIC_POOL_SERVER_CRYPTO_TICKET);
     if (TicketBuffer == NULL) {
@@ -2231,6 +2286,8 @@ QuicCryptoEncodeServerTicket(
     //   Negotiated ALPN [...]
     //   Transport Parameters [...]
     //   App Ticket (omitted if length is zero) [...]
+    //   Ticket Nonce (random) [8]
+    //   Issue Time (ms since epoch) [8]
     //
 
     _Analysis_assume_(sizeof(*TicketBuffer) >= 8);
@@ -2248,6 +2305,13 @@ QuicCryptoEncodeServerTicket(
         CxPlatCopyMemory(TicketCursor, AppResumptionData, AppDataLength);
         TicketCursor += AppDataLength;
     }
+    uint64_t Nonce;
+    CxPlatRandom(sizeof(Nonce), &Nonce);
+    CxPlatCopyMemory(TicketCursor, &Nonce, sizeof(Nonce));
+    TicketCursor += sizeof(Nonce);
+    const uint64_t IssueTime = CxPlatTimeEpochMs64();
+    CxPlatCopyMemory(TicketCursor, &IssueTime, sizeof(IssueTime));
+    TicketCursor += sizeof(IssueTime);
     CXPLAT_DBG_ASSERT(TicketCursor == TicketBuffer + TotalTicketLength);
 
     *Ticket = TicketBuffer;
@@ -2393,7 +2457,7 @@ QuicCryptoDecodeServerTicket(
     }
     Offset += (uint16_t)TPLength;
 
-    if (TicketLength == Offset + AppTicketLength) {
+    if (TicketLength == Offset + AppTicketLength + QUIC_SERVER_TICKET_REPLAY_INFO_LENGTH) {
         Status = QUIC_STATUS_SUCCESS;
         *AppDataLength = (uint32_t)AppTicketLength;
         if (AppTicketLength > 0) {
@@ -2411,6 +2475,21 @@ Error:
     return Status;
 }
 
+void
+QuicCryptoGetServerTicketReplayInfo(
+    _In_ uint16_t TicketLength,
+    _In_reads_bytes_(TicketLength)
+        const uint8_t* Ticket,
+    _Out_ uint64_t* Nonce,
+    _Out_ uint64_t* IssueTime
+    )
+{
+    CXPLAT_DBG_ASSERT(TicketLength >= QUIC_SERVER_TICKET_REPLAY_INFO_LENGTH);
+    const uint8_t* Trailer = Ticket + TicketLength - QUIC_SERVER_TICKET_REPLAY_INFO_LENGTH;
+    CxPlatCopyMemory(Nonce, Trailer, sizeof(*Nonce));
+    CxPlatCopyMemory(IssueTime, Trailer + sizeof(*Nonce), sizeof(*IssueTime));
+}
+
 QUIC_STATUS
 QuicCryptoEncodeClientTicket(
     _In_opt_ QUIC_CONNECTION* Connection,
@@ -140,6 +140,26 @@ QuicCryptoUninitialize(
     _In_ QUIC_CRYPTO* Crypto
     );
 
+//
+// Frees the TLS send and receive buffers of an idle connection, if they don't
+// hold any data. QuicCryptoRehydrate must be called before the crypto state is
+// used again.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicCryptoHibernate(
+    _In_ QUIC_CRYPTO* Crypto
+    );
+
+//
+// Reallocates any buffers freed by QuicCryptoHibernate.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+QuicCryptoRehydrate(
+    _In_ QUIC_CRYPTO* Crypto
+    );
+
 //
 // Initializes the TLS state.
 //
@@ -393,6 +413,19 @@ QuicCryptoDecodeServerTicket(
     _Out_ uint32_t* AppDataLength
     );
 
+//
+// Reads the replay detection nonce and issue time from a server resumption
+// ticket already validated by QuicCryptoDecodeServerTicket.
+//
+void
+QuicCryptoGetServerTicketReplayInfo(
+    _In_ uint16_t TicketLength,
+    _In_reads_bytes_(TicketLength)
+        const uint8_t* Ticket,
+    _Out_ uint64_t* Nonce,
+    _Out_ uint64_t* IssueTime
+    );
+
 //
 // Encodes necessary data into the client ticket to enable connection resumption.
 // The pointer held by ClientTicket needs to be freed by CXPLAT_FREE().
@@ -175,6 +175,8 @@ QuicLibraryInitializePartitions(
     uint8_t ResetHashKey[20];
     CxPlatRandom(sizeof(ResetHashKey), ResetHashKey);
     CxPlatRandom(sizeof(MsQuicLib.BaseRetrySecret), MsQuicLib.BaseRetrySecret);
+    CxPlatRandom(
+        sizeof(MsQuicLib.RetryTokenPreFilterKey), MsQuicLib.RetryTokenPreFilterKey);
 
     uint16_t i;
     QUIC_STATUS Status;
@@ -186,7 +188,8 @@ QuicLibraryInitializePartitions(
                 ProcessorList ? ProcessorList[i] : i,
                 CXPLAT_HASH_SHA256,
                 ResetHashKey,
-                sizeof(ResetHashKey));
+                sizeof(ResetHashKey),
+                MsQuicLib.Settings.ObjectArenaEnabled);
         if (QUIC_FAILED(Status)) {
             goto Error;
         }
@@ -234,6 +237,17 @@ QuicLibrarySumPerfCounters(
         }
     }
 
+    //
+    // The datapath buffer counters are kept by the datapath itself.
+    //
+    if (MsQuicLib.Datapath != NULL &&
+        CountersPerBuffer > QUIC_PERF_COUNTER_DATAPATH_CROSS_NODE_SENDS) {
+        CXPLAT_DATAPATH_BUFFER_STATISTICS Statistics;
+        CxPlatDataPathGetBufferStatistics(MsQuicLib.Datapath, &Statistics);
+        Counters[QUIC_PERF_COUNTER_DATAPATH_REMOTE_FREES] = (int64_t)Statistics.RemoteFrees;
+        Counters[QUIC_PERF_COUNTER_DATAPATH_CROSS_NODE_SENDS] = (int64_t)Statistics.CrossNodeSends;
+    }
+
     //
     // Zero any counters that are still negative after summation.
     //
@@ -665,6 +679,7 @@ QuicLibraryLazyInitialize(
     const CXPLAT_UDP_DATAPATH_CALLBACKS DatapathCallbacks = {
         QuicBindingReceive,
         QuicBindingUnreachable,
+        QuicBindingReceiveFilter,
     };
 
     QUIC_STATUS Status = QUIC_STATUS_SUCCESS;
@@ -1379,6 +1394,32 @@ QuicLibraryGetGlobalParam(
         Status = QUIC_STATUS_SUCCESS;
         break;
 
+    case QUIC_PARAM_GLOBAL_POOL_STATS: {
+#ifndef _KERNEL_MODE
+        if (MsQuicLib.WorkerPool == NULL) {
+            Status = QUIC_STATUS_INVALID_STATE;
+            break;
+        }
+
+        const uint32_t PoolCount =
+            CxPlatWorkerPoolGetPoolStats(
+                MsQuicLib.WorkerPool,
+                Buffer == NULL ? 0 : *BufferLength / sizeof(QUIC_POOL_STATS),
+                (QUIC_POOL_STATS*)Buffer);
+        if (*BufferLength < PoolCount * sizeof(QUIC_POOL_STATS) || Buffer == NULL) {
+            *BufferLength = PoolCount * sizeof(QUIC_POOL_STATS);
+            Status = QUIC_STATUS_BUFFER_TOO_SMALL;
+            break;
+        }
+
+        *BufferLength = PoolCount * sizeof(QUIC_POOL_STATS);
+        Status = QUIC_STATUS_SUCCESS;
+#else
+        Status = QUIC_STATUS_NOT_SUPPORTED;
+#endif
+        break;
+    }
+
     case QUIC_PARAM_GLOBAL_DATAPATH_FEATURES:
         if (*BufferLength < sizeof(uint32_t)) {
             *BufferLength = sizeof(uint32_t);
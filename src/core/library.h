@@ -203,6 +203,11 @@ typedef struct QUIC_LIBRARY {
     //
     uint8_t BaseRetrySecret[CXPLAT_AEAD_AES_256_GCM_SIZE];
 
+    //
+    // The SipHash key used for the pre-filter tag of stateless retry tokens.
+    //
+    uint64_t RetryTokenPreFilterKey[2];
+
     //
     // The Toeplitz hash used for hashing received long header packets.
     //
@@ -322,6 +322,9 @@ MsQuicListenerStart(
     UdpConfig.CibirIdLength = Listener->CibirId[0];
     UdpConfig.CibirIdOffsetSrc = MsQuicLib.CidServerIdLength + 2;
     UdpConfig.CibirIdOffsetDst = MsQuicLib.CidServerIdLength + 2;
+    UdpConfig.CidPartitionIdOffset = MsQuicLib.CidServerIdLength;
+    UdpConfig.CidPartitionIdMask = MsQuicLib.PartitionMask;
+    UdpConfig.CidPartitionCount = MsQuicLib.PartitionCount;
     if (UdpConfig.CibirIdLength) {
         CXPLAT_DBG_ASSERT(UdpConfig.CibirIdLength <= sizeof(UdpConfig.CibirId));
         CxPlatCopyMemory(
@@ -427,7 +430,9 @@ QuicListenerIndicateDispatchEvent(
     _Inout_ QUIC_LISTENER_EVENT* Event
     )
 {
-    CXPLAT_DBG_ASSERT(Event->Type == QUIC_LISTENER_EVENT_DOS_MODE_CHANGED);
+    CXPLAT_DBG_ASSERT(
+        Event->Type == QUIC_LISTENER_EVENT_DOS_MODE_CHANGED ||
+        Event->Type == QUIC_LISTENER_EVENT_ADMISSION_LEVEL_CHANGED);
     CXPLAT_FRE_ASSERT(Listener->ClientCallbackHandler);
     return
         Listener->ClientCallbackHandler(
@@ -613,6 +618,22 @@ QuicListenerHasAlpnOverlap(
             Listener2->AlpnList) != NULL;
 }
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+QuicListenerMatchesLocalAddress(
+    _In_ const QUIC_LISTENER* Listener,
+    _In_ const QUIC_ADDR* LocalAddress
+    )
+{
+    const QUIC_ADDRESS_FAMILY ListenerFamily = QuicAddrGetFamily(&Listener->LocalAddress);
+    if (ListenerFamily == QUIC_ADDRESS_FAMILY_UNSPEC) {
+        return TRUE;
+    }
+    return
+        QuicAddrGetFamily(LocalAddress) == ListenerFamily &&
+        (Listener->WildCard || QuicAddrCompareIp(LocalAddress, &Listener->LocalAddress));
+}
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 BOOLEAN
 QuicListenerMatchesAlpn(
@@ -630,6 +651,134 @@ QuicListenerMatchesAlpn(
     return FALSE;
 }
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+uint32_t
+QuicListenerAdmissionPressure(
+    _In_ const QUIC_LISTENER_ADMISSION_CONTROL* Control,
+    _In_ uint32_t QueueDelayUs,
+    _In_ uint32_t HandshakeBacklog
+    )
+{
+    uint64_t Pressure = 0;
+    if (Control->QueueDelayTargetUs != 0) {
+        Pressure = ((uint64_t)QueueDelayUs * 100) / Control->QueueDelayTargetUs;
+    }
+    if (Control->HandshakeBacklogTarget != 0) {
+        const uint64_t BacklogPressure =
+            ((uint64_t)HandshakeBacklog * 100) / Control->HandshakeBacklogTarget;
+        if (BacklogPressure > Pressure) {
+            Pressure = BacklogPressure;
+        }
+    }
+    return (uint32_t)CXPLAT_MIN(Pressure, UINT32_MAX);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_LISTENER_ADMISSION_LEVEL
+QuicListenerAdmissionLevel(
+    _In_ uint32_t Pressure
+    )
+{
+    if (Pressure >= QUIC_ADMISSION_REJECT_PRESSURE) {
+        return QUIC_LISTENER_ADMISSION_LEVEL_REJECT;
+    }
+    if (Pressure >= QUIC_ADMISSION_SHED_PRESSURE) {
+        return QUIC_LISTENER_ADMISSION_LEVEL_SHED;
+    }
+    if (Pressure >= QUIC_ADMISSION_RETRY_PRESSURE) {
+        return QUIC_LISTENER_ADMISSION_LEVEL_RETRY;
+    }
+    return QUIC_LISTENER_ADMISSION_LEVEL_NORMAL;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+uint32_t
+QuicListenerUpdateAdmission(
+    _In_ QUIC_LISTENER* Listener,
+    _In_ uint16_t PartitionIndex
+    )
+{
+    //
+    // The queue delay is measured on the registration's worker that new
+    // connections from this partition end up on, as that is where the app's
+    // established connections would see the latency.
+    //
+    const QUIC_WORKER_POOL* WorkerPool = Listener->Registration->WorkerPool;
+    const QUIC_WORKER* Worker =
+        &WorkerPool->Workers[
+            Listener->Registration->NoPartitioning ?
+                0 : PartitionIndex % WorkerPool->WorkerCount];
+    const uint32_t QueueDelayUs = Worker->AverageQueueDelay;
+    const uint32_t HandshakeBacklog =
+        (uint32_t)CXPLAT_MIN(
+            MsQuicLib.CurrentHandshakeMemoryUsage / QUIC_CONN_HANDSHAKE_MEMORY_USAGE,
+            UINT32_MAX);
+
+    const uint32_t Pressure =
+        QuicListenerAdmissionPressure(
+            &Listener->AdmissionControl, QueueDelayUs, HandshakeBacklog);
+    const short Level = (short)QuicListenerAdmissionLevel(Pressure);
+    const short PrevLevel = Listener->AdmissionLevel;
+
+    //
+    // Only the thread that actually changes the level indicates the event.
+    //
+    if (Level != PrevLevel &&
+        InterlockedCompareExchange16(
+            &Listener->AdmissionLevel, Level, PrevLevel) == PrevLevel) {
+        QUIC_LISTENER_EVENT Event;
+        Event.Type = QUIC_LISTENER_EVENT_ADMISSION_LEVEL_CHANGED;
+        Event.ADMISSION_LEVEL_CHANGED.Level = (QUIC_LISTENER_ADMISSION_LEVEL)Level;
+        Event.ADMISSION_LEVEL_CHANGED.QueueDelayUs = QueueDelayUs;
+        Event.ADMISSION_LEVEL_CHANGED.HandshakeBacklog = HandshakeBacklog;
+
+        QuicListenerAttachSilo(Listener);
+
+        (void)QuicListenerIndicateDispatchEvent(Listener, &Event);
+
+        QuicListenerDetachSilo();
+    }
+
+    return Pressure;
+}
+
+//
+// Returns FALSE if the listener's admission control sheds the new connection.
+// Address validation (the retry level) is enforced by the binding before the
+// connection is even created.
+//
+static
+_IRQL_requires_max_(PASSIVE_LEVEL)
+BOOLEAN
+QuicListenerAdmitConnection(
+    _In_ QUIC_LISTENER* Listener,
+    _In_ const QUIC_CONNECTION* Connection
+    )
+{
+    const uint32_t Pressure =
+        QuicListenerUpdateAdmission(
+            Listener, QuicPartitionIdGetIndex(Connection->PartitionID));
+
+    switch (QuicListenerAdmissionLevel(Pressure)) {
+    case QUIC_LISTENER_ADMISSION_LEVEL_REJECT:
+        return FALSE;
+    case QUIC_LISTENER_ADMISSION_LEVEL_SHED: {
+        //
+        // Reject with a probability that grows linearly from zero at the shed
+        // level to one at the reject level.
+        //
+        const uint32_t RejectThreshold =
+            ((Pressure - QUIC_ADMISSION_SHED_PRESSURE) * 0x10000) /
+            (QUIC_ADMISSION_REJECT_PRESSURE - QUIC_ADMISSION_SHED_PRESSURE);
+        uint16_t Random;
+        CxPlatRandom(sizeof(Random), &Random);
+        return Random >= RejectThreshold;
+    }
+    default:
+        return TRUE;
+    }
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 BOOLEAN
 QuicListenerClaimConnection(
@@ -707,6 +856,21 @@ QuicListenerAcceptConnection(
     _In_ const QUIC_NEW_CONNECTION_INFO* Info
     )
 {
+    if (QuicListenerHasAdmissionControl(Listener) &&
+        !QuicListenerAdmitConnection(Listener, Connection)) {
+        QuicTraceEvent(
+            ConnError,
+            "[conn][%p] ERROR, %s.",
+            Connection,
+            "Connection rejected by listener admission control");
+        QuicConnTransportError(
+            Connection,
+            QUIC_ERROR_CONNECTION_REFUSED);
+        Listener->TotalRejectedConnections++;
+        QuicPerfCounterIncrement(Connection->Partition, QUIC_PERF_COUNTER_CONN_LOAD_REJECT);
+        return;
+    }
+
     if (!QuicRegistrationAcceptConnection(
             Listener->Registration,
             Connection)) {
@@ -800,6 +964,17 @@ QuicListenerParamSet(
         }
     }
 
+    if (Param == QUIC_PARAM_LISTENER_ADMISSION_CONTROL) {
+        if (BufferLength != sizeof(QUIC_LISTENER_ADMISSION_CONTROL) || Buffer == NULL) {
+            return QUIC_STATUS_INVALID_PARAMETER;
+        }
+        Listener->AdmissionControl = *(const QUIC_LISTENER_ADMISSION_CONTROL*)Buffer;
+        if (!QuicListenerHasAdmissionControl(Listener)) {
+            Listener->AdmissionLevel = QUIC_LISTENER_ADMISSION_LEVEL_NORMAL;
+        }
+        return QUIC_STATUS_SUCCESS;
+    }
+
     return QUIC_STATUS_INVALID_PARAMETER;
 }
 
@@ -902,6 +1077,22 @@ QuicListenerParamGet(
         Status = QUIC_STATUS_SUCCESS;
         break;
 
+    case QUIC_PARAM_LISTENER_ADMISSION_CONTROL:
+
+        if (*BufferLength < sizeof(QUIC_LISTENER_ADMISSION_CONTROL)) {
+            *BufferLength = sizeof(QUIC_LISTENER_ADMISSION_CONTROL);
+            return QUIC_STATUS_BUFFER_TOO_SMALL;
+        }
+
+        if (Buffer == NULL) {
+            return QUIC_STATUS_INVALID_PARAMETER;
+        }
+
+        *BufferLength = sizeof(QUIC_LISTENER_ADMISSION_CONTROL);
+        CxPlatCopyMemory(Buffer, &Listener->AdmissionControl, sizeof(QUIC_LISTENER_ADMISSION_CONTROL));
+        Status = QUIC_STATUS_SUCCESS;
+        break;
+
     default:
         Status = QUIC_STATUS_INVALID_PARAMETER;
         break;
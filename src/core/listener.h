@@ -5,6 +5,10 @@
 
 --*/
 
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
 //
 // Represents the Listener specific state.
 //
@@ -41,6 +45,12 @@ typedef struct QUIC_LISTENER {
     //
     BOOLEAN DosModeEventsEnabled;
 
+    //
+    // The current QUIC_LISTENER_ADMISSION_LEVEL. Updated on any thread that
+    // evaluates admission for the listener.
+    //
+    short AdmissionLevel;
+
     //
     // The thread ID that the listener is actively indicating a stop compelete
     // callback on.
@@ -114,6 +124,12 @@ typedef struct QUIC_LISTENER {
     // the ID in the CID and the rest payload of the identifier.
     //
     uint8_t CibirId[2 + QUIC_MAX_CIBIR_LENGTH];
+
+    //
+    // App configured targets for graded admission control. Disabled if both
+    // are zero.
+    //
+    QUIC_LISTENER_ADMISSION_CONTROL AdmissionControl;
 } QUIC_LISTENER;
 
 #ifdef QUIC_SILO
@@ -163,6 +179,16 @@ QuicListenerHasAlpnOverlap(
     _In_ const QUIC_LISTENER* Listener2
     );
 
+//
+// Returns TRUE if the listener accepts connections on the local address.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+QuicListenerMatchesLocalAddress(
+    _In_ const QUIC_LISTENER* Listener,
+    _In_ const QUIC_ADDR* LocalAddress
+    );
+
 //
 // Returns TRUE if the listener has a matching ALPN. Also updates the new
 // connection info with the matching ALPN.
@@ -174,6 +200,46 @@ QuicListenerMatchesAlpn(
     _In_ QUIC_NEW_CONNECTION_INFO* Info
     );
 
+//
+// Returns TRUE if the app configured admission control on the listener.
+//
+#define QuicListenerHasAdmissionControl(Listener) \
+    ((Listener)->AdmissionControl.QueueDelayTargetUs != 0 || \
+     (Listener)->AdmissionControl.HandshakeBacklogTarget != 0)
+
+//
+// Calculates the admission pressure, in percent of the listener's targets, for
+// the given worker queue delay and handshake backlog.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+uint32_t
+QuicListenerAdmissionPressure(
+    _In_ const QUIC_LISTENER_ADMISSION_CONTROL* Control,
+    _In_ uint32_t QueueDelayUs,
+    _In_ uint32_t HandshakeBacklog
+    );
+
+//
+// Maps an admission pressure to the admission level.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_LISTENER_ADMISSION_LEVEL
+QuicListenerAdmissionLevel(
+    _In_ uint32_t Pressure
+    );
+
+//
+// Evaluates the current load on the partition's worker (and the library's
+// handshake backlog) against the listener's admission targets, indicates the
+// new level to the app if it changed, and returns the pressure.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+uint32_t
+QuicListenerUpdateAdmission(
+    _In_ QUIC_LISTENER* Listener,
+    _In_ uint16_t PartitionIndex
+    );
+
 //
 // Passes the connection to the listener to (possibly) accept it.
 //
@@ -220,3 +286,7 @@ QuicListenerHandleDosModeStateChange(
     _In_ QUIC_LISTENER* Listener,
     _In_ BOOLEAN DosModeEnabled
     );
+
+#if defined(__cplusplus)
+}
+#endif
@@ -0,0 +1,145 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Large page backed allocation of connection and stream objects.
+
+    Each partition has one arena per object type. Objects are bump allocated
+    out of the arena's most recent region, and a new region is only added when
+    it is exhausted and no freed object is available. Regions are never given
+    back until the arena is uninitialized, so the memory footprint tracks the
+    peak number of objects (see object_arena.h for the bound).
+
+--*/
+
+#include "precomp.h"
+#ifdef QUIC_CLOG
+#include "object_arena.c.clog.h"
+#endif
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicObjectArenaInitialize(
+    _Out_ QUIC_OBJECT_ARENA* Arena,
+    _In_ uint32_t ObjectSize,
+    _In_ uint16_t Processor,
+    _In_ uint32_t Tag
+    )
+{
+    CxPlatZeroMemory(Arena, sizeof(*Arena));
+    CxPlatDispatchLockInitialize(&Arena->Lock);
+    Arena->Stride =
+        (ObjectSize + sizeof(QUIC_OBJECT_ARENA_HEADER) + QUIC_OBJECT_ARENA_ALIGNMENT - 1) &
+        ~(uint32_t)(QUIC_OBJECT_ARENA_ALIGNMENT - 1);
+    Arena->Tag = Tag;
+    Arena->Processor = Processor;
+    CXPLAT_FRE_ASSERT(
+        Arena->Stride <= QUIC_OBJECT_ARENA_REGION_SIZE - QUIC_OBJECT_ARENA_ALIGNMENT);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicObjectArenaUninitialize(
+    _Inout_ QUIC_OBJECT_ARENA* Arena
+    )
+{
+    while (Arena->Regions != NULL) {
+        QUIC_OBJECT_ARENA_REGION* Region = Arena->Regions;
+        Arena->Regions = Region->Next;
+        CxPlatLargePageFree(Region, QUIC_OBJECT_ARENA_REGION_SIZE, Arena->Tag);
+    }
+    CxPlatDispatchLockUninitialize(&Arena->Lock);
+}
+
+//
+// Adds a new region to carve objects from. Called with the lock held.
+//
+static
+BOOLEAN
+QuicObjectArenaGrow(
+    _Inout_ QUIC_OBJECT_ARENA* Arena
+    )
+{
+    BOOLEAN IsLargePage;
+    QUIC_OBJECT_ARENA_REGION* Region =
+        CxPlatLargePageAlloc(
+            QUIC_OBJECT_ARENA_REGION_SIZE,
+            Arena->Processor,
+            Arena->Tag,
+            &IsLargePage);
+    if (Region == NULL) {
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "object arena region",
+            QUIC_OBJECT_ARENA_REGION_SIZE);
+        return FALSE;
+    }
+
+    Region->Next = Arena->Regions;
+    Region->IsLargePage = IsLargePage;
+    Arena->Regions = Region;
+    Arena->RegionCount++;
+    if (IsLargePage) {
+        Arena->LargePageRegionCount++;
+    }
+
+    //
+    // The region header takes up the first cache line.
+    //
+    Arena->Next = (uint8_t*)Region + QUIC_OBJECT_ARENA_ALIGNMENT;
+    Arena->End = (uint8_t*)Region + QUIC_OBJECT_ARENA_REGION_SIZE;
+    return TRUE;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+_Ret_maybenull_
+void*
+QuicObjectArenaAlloc(
+    _Inout_ QUIC_OBJECT_ARENA* Arena
+    )
+{
+    QUIC_OBJECT_ARENA_HEADER* Header;
+
+    CxPlatDispatchLockAcquire(&Arena->Lock);
+    if (Arena->FreeList != NULL) {
+        Header = Arena->FreeList;
+        Arena->FreeList = Header->Next;
+        CXPLAT_DBG_ASSERT(Header->SpecialFlag == QUIC_OBJECT_ARENA_FREE_FLAG);
+    } else if ((size_t)(Arena->End - Arena->Next) >= Arena->Stride ||
+               QuicObjectArenaGrow(Arena)) {
+        Header = (QUIC_OBJECT_ARENA_HEADER*)Arena->Next;
+        Arena->Next += Arena->Stride;
+    } else {
+        Header = NULL;
+    }
+    CxPlatDispatchLockRelease(&Arena->Lock);
+
+    if (Header == NULL) {
+        return NULL;
+    }
+
+    Header->Owner = Arena;
+    Header->SpecialFlag = QUIC_OBJECT_ARENA_ALLOC_FLAG;
+    return Header + 1;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicObjectArenaFree(
+    _In_ void* Object
+    )
+{
+    QUIC_OBJECT_ARENA_HEADER* Header = (QUIC_OBJECT_ARENA_HEADER*)Object - 1;
+    QUIC_OBJECT_ARENA* Arena = Header->Owner;
+    CXPLAT_DBG_ASSERT(Header->SpecialFlag == QUIC_OBJECT_ARENA_ALLOC_FLAG);
+    Header->SpecialFlag = QUIC_OBJECT_ARENA_FREE_FLAG;
+
+    CxPlatDispatchLockAcquire(&Arena->Lock);
+    Header->Next = Arena->FreeList;
+    Arena->FreeList = Header;
+    CxPlatDispatchLockRelease(&Arena->Lock);
+}
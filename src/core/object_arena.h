@@ -0,0 +1,146 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+--*/
+
+#pragma once
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+//
+// The size of each region objects are carved out of.
+//
+#define QUIC_OBJECT_ARENA_REGION_SIZE   CXPLAT_LARGE_PAGE_SIZE
+
+//
+// Objects start on cache line boundaries, so that two objects never share a
+// line.
+//
+#define QUIC_OBJECT_ARENA_ALIGNMENT     64
+
+typedef struct QUIC_OBJECT_ARENA QUIC_OBJECT_ARENA;
+
+//
+// Precedes each object in the arena. Padded to a full cache line so the object
+// after it stays aligned.
+//
+typedef struct QUIC_OBJECT_ARENA_HEADER {
+    union {
+        QUIC_OBJECT_ARENA* Owner;                   // While allocated
+        struct QUIC_OBJECT_ARENA_HEADER* Next;      // While free
+    };
+    uint64_t SpecialFlag;
+    uint8_t Reserved[QUIC_OBJECT_ARENA_ALIGNMENT - sizeof(void*) - sizeof(uint64_t)];
+} QUIC_OBJECT_ARENA_HEADER;
+
+CXPLAT_STATIC_ASSERT(
+    sizeof(QUIC_OBJECT_ARENA_HEADER) == QUIC_OBJECT_ARENA_ALIGNMENT,
+    "Objects must stay cache line aligned");
+
+#define QUIC_OBJECT_ARENA_FREE_FLAG     0xAAAAAAAAAAAAAAAAull
+#define QUIC_OBJECT_ARENA_ALLOC_FLAG    0xE9E9E9E9E9E9E9E9ull
+
+//
+// Precedes the objects in each region.
+//
+typedef struct QUIC_OBJECT_ARENA_REGION {
+    struct QUIC_OBJECT_ARENA_REGION* Next;
+    BOOLEAN IsLargePage;
+} QUIC_OBJECT_ARENA_REGION;
+
+//
+// An allocator for fixed size objects, carved out of large page regions.
+//
+// Objects allocated from the same arena (e.g. all the connections of one
+// partition) are packed densely into a few large pages instead of being
+// scattered across the heap, so walking many of them needs far fewer TLB
+// entries. Regions are placed on the NUMA node of the partition's processor.
+// Freed objects are kept on a free list and reused most recently freed first.
+//
+// Regions are never returned to the OS before the arena is uninitialized (i.e.
+// when the library is cleaned up), because any live object pins its region and
+// objects of one region are freed in no particular order. The footprint of an
+// arena is therefore bounded by its peak number of live objects: at most
+// ceil(Peak / (QUIC_OBJECT_ARENA_REGION_SIZE / Stride)) regions, plus one for
+// the partly used most recent region.
+//
+typedef struct QUIC_OBJECT_ARENA {
+
+    CXPLAT_DISPATCH_LOCK Lock;
+
+    //
+    // The distance between objects, including the header.
+    //
+    uint32_t Stride;
+
+    //
+    // The memory tag for the regions.
+    //
+    uint32_t Tag;
+
+    //
+    // The processor whose NUMA node regions are allocated on.
+    //
+    uint16_t Processor;
+
+    //
+    // Objects that were freed and can be reused.
+    //
+    QUIC_OBJECT_ARENA_HEADER* FreeList;
+
+    //
+    // The unused part of the most recent region.
+    //
+    uint8_t* Next;
+    uint8_t* End;
+
+    //
+    // All regions, most recent first.
+    //
+    QUIC_OBJECT_ARENA_REGION* Regions;
+    uint32_t RegionCount;
+    uint32_t LargePageRegionCount;
+
+} QUIC_OBJECT_ARENA;
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicObjectArenaInitialize(
+    _Out_ QUIC_OBJECT_ARENA* Arena,
+    _In_ uint32_t ObjectSize,
+    _In_ uint16_t Processor,
+    _In_ uint32_t Tag
+    );
+
+//
+// All objects must have been freed.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicObjectArenaUninitialize(
+    _Inout_ QUIC_OBJECT_ARENA* Arena
+    );
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+_Ret_maybenull_
+void*
+QuicObjectArenaAlloc(
+    _Inout_ QUIC_OBJECT_ARENA* Arena
+    );
+
+//
+// Returns the object to the arena it was allocated from.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicObjectArenaFree(
+    _In_ void* Object
+    );
+
+#if defined(__cplusplus)
+}
+#endif
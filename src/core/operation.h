@@ -183,6 +183,7 @@ typedef enum QUIC_CONN_TIMER_TYPE {
     QUIC_CONN_TIMER_LOSS_DETECTION,
     QUIC_CONN_TIMER_KEEP_ALIVE,
     QUIC_CONN_TIMER_IDLE,
+    QUIC_CONN_TIMER_HIBERNATE,
     QUIC_CONN_TIMER_SHUTDOWN,
 
     QUIC_CONN_TIMER_COUNT
@@ -197,6 +198,7 @@ typedef struct QUIC_STATELESS_CONTEXT {
     CXPLAT_HASHTABLE_ENTRY TableEntry;
     QUIC_RX_PACKET* Packet;
     uint32_t CreationTimeMs;
+    uint16_t ShardIndex;
     uint8_t HasBindingRef : 1;
     uint8_t IsProcessed : 1;
     uint8_t IsExpired : 1;
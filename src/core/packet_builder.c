@@ -1069,7 +1069,8 @@ QuicPacketBuilderSendBatch(
         &Builder->Path->Route,
         Builder->SendData,
         Builder->TotalDatagramsLength,
-        Builder->TotalCountDatagrams);
+        Builder->TotalCountDatagrams,
+        Builder->Connection);
 
     Builder->PacketBatchSent = TRUE;
     Builder->SendData = NULL;
@@ -73,3 +73,127 @@ QuicPacketSpaceReset(
 {
     QuicAckTrackerReset(&Packets->AckTracker);
 }
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+QuicPacketSpaceFreeze(
+    _In_ QUIC_PACKET_SPACE* Packets,
+    _Out_ QUIC_PACKET_SPACE_FROZEN** Frozen
+    )
+{
+    QUIC_ACK_TRACKER* Tracker = &Packets->AckTracker;
+    CXPLAT_DBG_ASSERT(Packets->DeferredPackets == NULL);
+    CXPLAT_DBG_ASSERT(Tracker->AckElicitingPacketsToAcknowledge == 0);
+
+    const uint32_t ReceivedCount = QuicRangeSize(&Tracker->PacketNumbersReceived);
+    const uint32_t ToAckCount = QuicRangeSize(&Tracker->PacketNumbersToAck);
+    const size_t AllocSize =
+        sizeof(QUIC_PACKET_SPACE_FROZEN) +
+        (ReceivedCount + ToAckCount) * sizeof(QUIC_SUBRANGE);
+
+    QUIC_PACKET_SPACE_FROZEN* State =
+        CXPLAT_ALLOC_NONPAGED(AllocSize, QUIC_POOL_PACKET_SPACE_FROZEN);
+    if (State == NULL) {
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "frozen packet space",
+            AllocSize);
+        return QUIC_STATUS_OUT_OF_MEMORY;
+    }
+
+    CxPlatZeroMemory(State, sizeof(QUIC_PACKET_SPACE_FROZEN));
+    State->EncryptLevel = Packets->EncryptLevel;
+    State->PacketNumbersReceivedCount = ReceivedCount;
+    State->PacketNumbersToAckCount = ToAckCount;
+    State->NextRecvPacketNumber = Packets->NextRecvPacketNumber;
+    State->EcnEctCounter = Packets->EcnEctCounter;
+    State->EcnCeCounter = Packets->EcnCeCounter;
+    State->ReceivedECN = Tracker->ReceivedECN;
+    State->LargestPacketNumberAcknowledged = Tracker->LargestPacketNumberAcknowledged;
+    State->LargestPacketNumberRecvTime = Tracker->LargestPacketNumberRecvTime;
+    State->WriteKeyPhaseStartPacketNumber = Packets->WriteKeyPhaseStartPacketNumber;
+    State->ReadKeyPhaseStartPacketNumber = Packets->ReadKeyPhaseStartPacketNumber;
+    State->CurrentKeyPhaseBytesSent = Packets->CurrentKeyPhaseBytesSent;
+    State->AlreadyWrittenAckFrame = Tracker->AlreadyWrittenAckFrame;
+    State->NonZeroRecvECN = Tracker->NonZeroRecvECN;
+    State->CurrentKeyPhase = Packets->CurrentKeyPhase;
+    State->AwaitingKeyPhaseConfirmation = Packets->AwaitingKeyPhaseConfirmation;
+
+    for (uint32_t i = 0; i < ReceivedCount; ++i) {
+        State->SubRanges[i] = *QuicRangeGet(&Tracker->PacketNumbersReceived, i);
+    }
+    for (uint32_t i = 0; i < ToAckCount; ++i) {
+        State->SubRanges[ReceivedCount + i] =
+            *QuicRangeGet(&Tracker->PacketNumbersToAck, i);
+    }
+
+    QuicPacketSpaceUninitialize(Packets);
+    *Frozen = State;
+
+    return QUIC_STATUS_SUCCESS;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+QuicPacketSpaceThaw(
+    _In_ QUIC_CONNECTION* Connection,
+    _In_ QUIC_PACKET_SPACE_FROZEN* Frozen,
+    _Out_ QUIC_PACKET_SPACE** NewPackets
+    )
+{
+    QUIC_PACKET_SPACE* Packets;
+    QUIC_STATUS Status =
+        QuicPacketSpaceInitialize(Connection, Frozen->EncryptLevel, &Packets);
+    if (QUIC_FAILED(Status)) {
+        return Status;
+    }
+
+    QUIC_ACK_TRACKER* Tracker = &Packets->AckTracker;
+    BOOLEAN RangeUpdated;
+    for (uint32_t i = 0; i < Frozen->PacketNumbersReceivedCount; ++i) {
+        const QUIC_SUBRANGE* Sub = &Frozen->SubRanges[i];
+        if (QuicRangeAddRange(
+                &Tracker->PacketNumbersReceived,
+                Sub->Low,
+                Sub->Count,
+                &RangeUpdated) == NULL) {
+            goto Error;
+        }
+    }
+    for (uint32_t i = 0; i < Frozen->PacketNumbersToAckCount; ++i) {
+        const QUIC_SUBRANGE* Sub =
+            &Frozen->SubRanges[Frozen->PacketNumbersReceivedCount + i];
+        if (QuicRangeAddRange(
+                &Tracker->PacketNumbersToAck,
+                Sub->Low,
+                Sub->Count,
+                &RangeUpdated) == NULL) {
+            goto Error;
+        }
+    }
+
+    Packets->NextRecvPacketNumber = Frozen->NextRecvPacketNumber;
+    Packets->EcnEctCounter = Frozen->EcnEctCounter;
+    Packets->EcnCeCounter = Frozen->EcnCeCounter;
+    Tracker->ReceivedECN = Frozen->ReceivedECN;
+    Tracker->LargestPacketNumberAcknowledged = Frozen->LargestPacketNumberAcknowledged;
+    Tracker->LargestPacketNumberRecvTime = Frozen->LargestPacketNumberRecvTime;
+    Packets->WriteKeyPhaseStartPacketNumber = Frozen->WriteKeyPhaseStartPacketNumber;
+    Packets->ReadKeyPhaseStartPacketNumber = Frozen->ReadKeyPhaseStartPacketNumber;
+    Packets->CurrentKeyPhaseBytesSent = Frozen->CurrentKeyPhaseBytesSent;
+    Tracker->AlreadyWrittenAckFrame = Frozen->AlreadyWrittenAckFrame;
+    Tracker->NonZeroRecvECN = Frozen->NonZeroRecvECN;
+    Packets->CurrentKeyPhase = Frozen->CurrentKeyPhase;
+    Packets->AwaitingKeyPhaseConfirmation = Frozen->AwaitingKeyPhaseConfirmation;
+
+    CXPLAT_FREE(Frozen, QUIC_POOL_PACKET_SPACE_FROZEN);
+    *NewPackets = Packets;
+
+    return QUIC_STATUS_SUCCESS;
+
+Error:
+
+    QuicPacketSpaceUninitialize(Packets);
+    return QUIC_STATUS_OUT_OF_MEMORY;
+}
@@ -151,3 +151,76 @@ void
 QuicPacketSpaceReset(
     _In_ QUIC_PACKET_SPACE* Packets
     );
+
+//
+// The compact form of a packet space kept by a hibernated connection. Only the
+// state needed to resume receiving, acknowledging and key updates is kept, and
+// the received and to-be-acknowledged packet number ranges are stored back to
+// back after the structure.
+//
+typedef struct QUIC_PACKET_SPACE_FROZEN {
+
+    QUIC_ENCRYPT_LEVEL EncryptLevel;
+
+    uint32_t PacketNumbersReceivedCount;
+    uint32_t PacketNumbersToAckCount;
+
+    uint64_t NextRecvPacketNumber;
+    uint64_t EcnEctCounter;
+    uint64_t EcnCeCounter;
+
+    QUIC_ACK_ECN_EX ReceivedECN;
+    uint64_t LargestPacketNumberAcknowledged;
+    uint64_t LargestPacketNumberRecvTime;
+
+    uint64_t WriteKeyPhaseStartPacketNumber;
+    uint64_t ReadKeyPhaseStartPacketNumber;
+    uint64_t CurrentKeyPhaseBytesSent;
+
+    BOOLEAN AlreadyWrittenAckFrame : 1;
+    BOOLEAN NonZeroRecvECN : 1;
+    BOOLEAN CurrentKeyPhase : 1;
+    BOOLEAN AwaitingKeyPhaseConfirmation : 1;
+
+    QUIC_SUBRANGE SubRanges[0];
+
+} QUIC_PACKET_SPACE_FROZEN;
+
+//
+// The number of bytes allocated for a frozen packet space.
+//
+inline
+uint32_t
+QuicPacketSpaceFrozenSize(
+    _In_ const QUIC_PACKET_SPACE_FROZEN* Frozen
+    )
+{
+    return
+        sizeof(QUIC_PACKET_SPACE_FROZEN) +
+        (Frozen->PacketNumbersReceivedCount + Frozen->PacketNumbersToAckCount) *
+            sizeof(QUIC_SUBRANGE);
+}
+
+//
+// Converts an idle packet space into its compact form. On success, the packet
+// space is freed. It must not have any deferred packets or unacknowledged
+// ack eliciting packets.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+QuicPacketSpaceFreeze(
+    _In_ QUIC_PACKET_SPACE* Packets,
+    _Out_ QUIC_PACKET_SPACE_FROZEN** Frozen
+    );
+
+//
+// Recreates a packet space from its compact form. On success, the frozen
+// state is freed.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+QuicPacketSpaceThaw(
+    _In_ QUIC_CONNECTION* Connection,
+    _In_ QUIC_PACKET_SPACE_FROZEN* Frozen,
+    _Out_ QUIC_PACKET_SPACE** NewPackets
+    );
@@ -18,7 +18,8 @@ QuicPartitionInitialize(
     _In_ CXPLAT_HASH_TYPE HashType,
     _In_reads_(ResetHashKeyLength)
         const uint8_t* const ResetHashKey,
-    _In_ uint32_t ResetHashKeyLength
+    _In_ uint32_t ResetHashKeyLength,
+    _In_ BOOLEAN UseObjectArenas
     )
 {
     QUIC_STATUS Status =
@@ -33,6 +34,7 @@ QuicPartitionInitialize(
 
     Partition->Index = Index;
     Partition->Processor = Processor;
+    CxPlatRandom(sizeof(Partition->InitialFilterSeed), &Partition->InitialFilterSeed);
     CxPlatPoolInitialize(FALSE, sizeof(QUIC_CONNECTION), QUIC_POOL_CONN, &Partition->ConnectionPool);
     CxPlatPoolInitialize(FALSE, sizeof(QUIC_TRANSPORT_PARAMETERS), QUIC_POOL_TP, &Partition->TransportParamPool);
     CxPlatPoolInitialize(FALSE, sizeof(QUIC_PACKET_SPACE), QUIC_POOL_TP, &Partition->PacketSpacePool);
@@ -44,8 +46,14 @@ QuicPartitionInitialize(
     CxPlatPoolInitialize(FALSE, sizeof(QUIC_STATELESS_CONTEXT), QUIC_POOL_STATELESS_CTX, &Partition->StatelessContextPool);
     CxPlatPoolInitialize(FALSE, sizeof(QUIC_OPERATION), QUIC_POOL_OPER, &Partition->OperPool);
     CxPlatPoolInitialize(FALSE, sizeof(QUIC_RECV_CHUNK), QUIC_POOL_APP_BUFFER_CHUNK, &Partition->AppBufferChunkPool);
+    Partition->UseObjectArenas = UseObjectArenas;
+    if (UseObjectArenas) {
+        QuicObjectArenaInitialize(&Partition->ConnectionArena, sizeof(QUIC_CONNECTION), Processor, QUIC_POOL_OBJECT_ARENA);
+        QuicObjectArenaInitialize(&Partition->StreamArena, sizeof(QUIC_STREAM), Processor, QUIC_POOL_OBJECT_ARENA);
+    }
     CxPlatLockInitialize(&Partition->ResetTokenLock);
     CxPlatDispatchLockInitialize(&Partition->StatelessRetryKeysLock);
+    CxPlatDispatchLockInitialize(&Partition->AntiReplayLock);
 
     return QUIC_STATUS_SUCCESS;
 }
@@ -69,8 +77,16 @@ QuicPartitionUninitialize(
     CxPlatPoolUninitialize(&Partition->StatelessContextPool);
     CxPlatPoolUninitialize(&Partition->OperPool);
     CxPlatPoolUninitialize(&Partition->AppBufferChunkPool);
+    if (Partition->UseObjectArenas) {
+        QuicObjectArenaUninitialize(&Partition->ConnectionArena);
+        QuicObjectArenaUninitialize(&Partition->StreamArena);
+    }
     CxPlatLockUninitialize(&Partition->ResetTokenLock);
     CxPlatDispatchLockUninitialize(&Partition->StatelessRetryKeysLock);
+    if (Partition->AntiReplayFilter != NULL) {
+        QuicAntiReplayFilterUninitialize(Partition->AntiReplayFilter);
+    }
+    CxPlatDispatchLockUninitialize(&Partition->AntiReplayLock);
     CxPlatHashFree(Partition->ResetTokenHash);
 }
 
@@ -156,3 +172,92 @@ QuicPartitionGetStatelessRetryKeyForTimestamp(
 
     return QuicPartitioGetStatelessRetryKey(Partition, KeyIndex);
 }
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+QuicPartitionAntiReplayInsert(
+    _In_ QUIC_PARTITION* Partition,
+    _In_ uint64_t Nonce,
+    _In_ uint64_t TimeNowMs
+    )
+{
+    const uint32_t WindowMs = MsQuicLib.Settings.AntiReplayWindowMs;
+    const uint32_t Capacity =
+        (MsQuicLib.Settings.AntiReplayCapacity + MsQuicLib.PartitionCount - 1) /
+        MsQuicLib.PartitionCount;
+    CXPLAT_DBG_ASSERT(WindowMs != 0);
+
+    BOOLEAN Result = FALSE;
+    CxPlatDispatchLockAcquire(&Partition->AntiReplayLock);
+
+    QUIC_ANTI_REPLAY_FILTER* Filter = Partition->AntiReplayFilter;
+    if (Filter != NULL &&
+        (Filter->WindowMs != WindowMs || Filter->Capacity != Capacity)) {
+        //
+        // The settings changed. Start over with a new filter.
+        //
+        QuicAntiReplayFilterUninitialize(Filter);
+        Partition->AntiReplayFilter = Filter = NULL;
+    }
+
+    if (Filter == NULL &&
+        QUIC_SUCCEEDED(QuicAntiReplayFilterInitialize(WindowMs, Capacity, &Filter))) {
+        Partition->AntiReplayFilter = Filter;
+    }
+
+    if (Filter != NULL) {
+        Result = QuicAntiReplayFilterInsert(Filter, Nonce, TimeNowMs);
+    }
+
+    CxPlatDispatchLockRelease(&Partition->AntiReplayLock);
+    return Result;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+QuicPartitionInitialFilterAllow(
+    _In_ QUIC_PARTITION* Partition,
+    _In_ const QUIC_ADDR* RemoteAddress,
+    _In_ uint32_t TimeNowMs
+    )
+{
+    //
+    // Hash the /24 (IPv4) or /48 (IPv6) prefix, with a random seed so the
+    // bucket assignment can't be predicted by an attacker.
+    //
+    uint64_t Prefix = 0;
+    if (QuicAddrGetFamily(RemoteAddress) == QUIC_ADDRESS_FAMILY_INET) {
+        CxPlatCopyMemory(&Prefix, ((uint8_t*)RemoteAddress) + QUIC_ADDR_V4_IP_OFFSET, 3);
+    } else {
+        CxPlatCopyMemory(&Prefix, ((uint8_t*)RemoteAddress) + QUIC_ADDR_V6_IP_OFFSET, 6);
+        Prefix |= 1ull << 63;
+    }
+    const uint64_t Hash = (Prefix ^ Partition->InitialFilterSeed) * 0x9E3779B97F4A7C15ull;
+    QUIC_INITIAL_FILTER_BUCKET* Bucket =
+        &Partition->InitialFilterBuckets[
+            (Hash >> 32) & (QUIC_INITIAL_FILTER_BUCKET_COUNT - 1)];
+
+    //
+    // Refill for the time elapsed. An unused bucket starts out full. Partial
+    // tokens are kept by not moving the refill time until a whole one is due.
+    //
+    uint32_t Tokens = Bucket->Tokens;
+    const uint32_t ElapsedMs = TimeNowMs - Bucket->LastRefillTimeMs;
+    const uint64_t NewTokens =
+        ((uint64_t)ElapsedMs * QUIC_INITIAL_FILTER_PREFIX_RATE) / 1000;
+    if (NewTokens != 0) {
+        Tokens =
+            (uint32_t)CXPLAT_MIN(
+                (uint64_t)Tokens + NewTokens,
+                QUIC_INITIAL_FILTER_PREFIX_BURST);
+        Bucket->LastRefillTimeMs = TimeNowMs;
+    }
+
+    if (Tokens == 0) {
+        Bucket->Tokens = 0;
+        return FALSE;
+    }
+
+    Bucket->Tokens = Tokens - 1;
+    return TRUE;
+}
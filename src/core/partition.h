@@ -48,6 +48,14 @@ typedef struct QUIC_RETRY_KEY {
     int64_t Index;
 } QUIC_RETRY_KEY;
 
+//
+// Token bucket used to rate limit Initial packets from a source prefix.
+//
+typedef struct QUIC_INITIAL_FILTER_BUCKET {
+    uint32_t LastRefillTimeMs;
+    uint32_t Tokens;
+} QUIC_INITIAL_FILTER_BUCKET;
+
 typedef struct QUIC_CACHEALIGN QUIC_PARTITION {
 
     //
@@ -79,6 +87,15 @@ typedef struct QUIC_CACHEALIGN QUIC_PARTITION {
     CXPLAT_DISPATCH_LOCK StatelessRetryKeysLock;
     QUIC_RETRY_KEY StatelessRetryKeys[2];
 
+    //
+    // Filter for detecting replayed 0-RTT resumption tickets. Tickets are
+    // assigned to a partition by their nonce (not by the connection's
+    // partition) so that a replay is always checked against the same filter.
+    // Created on first use.
+    //
+    CXPLAT_DISPATCH_LOCK AntiReplayLock;
+    QUIC_ANTI_REPLAY_FILTER* AntiReplayFilter;
+
     //
     // Pools for allocations.
     //
@@ -94,11 +111,30 @@ typedef struct QUIC_CACHEALIGN QUIC_PARTITION {
     CXPLAT_POOL OperPool;                   // QUIC_OPERATION
     CXPLAT_POOL AppBufferChunkPool;         // QUIC_RECV_CHUNK
 
+    //
+    // When the ObjectArenaEnabled global setting is set as the partitions are
+    // created, connections and streams come from these large page arenas
+    // instead of the pools above. The same choice is made for all partitions,
+    // so objects can be freed via any partition.
+    //
+    BOOLEAN UseObjectArenas;
+    QUIC_OBJECT_ARENA ConnectionArena;      // QUIC_CONNECTION
+    QUIC_OBJECT_ARENA StreamArena;          // QUIC_STREAM
+
     //
     // Per-processor performance counters.
     //
     int64_t PerfCounters[QUIC_PERF_COUNTER_MAX];
 
+    //
+    // Per source prefix rate limiting of Initial packets by the datapath
+    // receive filter while in DoS mode. Updated without a lock from the
+    // datapath threads delivering to this partition; the occasional lost
+    // update only makes the limit approximate.
+    //
+    uint64_t InitialFilterSeed;
+    QUIC_INITIAL_FILTER_BUCKET InitialFilterBuckets[QUIC_INITIAL_FILTER_BUCKET_COUNT];
+
 } QUIC_PARTITION;
 
 //
@@ -112,7 +148,8 @@ QuicPartitionInitialize(
     _In_ CXPLAT_HASH_TYPE HashType,
     _In_reads_(ResetHashKeyLength)
         const uint8_t* const ResetHashKey,
-    _In_ uint32_t ResetHashKeyLength
+    _In_ uint32_t ResetHashKeyLength,
+    _In_ BOOLEAN UseObjectArenas
     );
 
 void
@@ -141,6 +178,31 @@ QuicPartitionGetStatelessRetryKeyForTimestamp(
     _In_ int64_t Timestamp
     );
 
+//
+// Records the resumption ticket nonce in the partition's anti-replay filter.
+// Returns FALSE if the nonce was already seen (or the filter couldn't be
+// created), in which case resumption must be rejected.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+QuicPartitionAntiReplayInsert(
+    _In_ QUIC_PARTITION* Partition,
+    _In_ uint64_t Nonce,
+    _In_ uint64_t TimeNowMs
+    );
+
+//
+// Takes a token from the Initial packet rate limit bucket for the address's
+// prefix. Returns FALSE if the prefix is over its limit.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+QuicPartitionInitialFilterAllow(
+    _In_ QUIC_PARTITION* Partition,
+    _In_ const QUIC_ADDR* RemoteAddress,
+    _In_ uint32_t TimeNowMs
+    );
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 inline
 QUIC_STATUS
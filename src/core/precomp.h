@@ -50,11 +50,15 @@
 #include "timer_wheel.h"
 #include "settings.h"
 #include "sent_packet_metadata.h"
+#include "anti_replay.h"
+#include "alpn_index.h"
+#include "object_arena.h"
 #include "partition.h"
 #include "library.h"
 #include "operation.h"
 #include "binding.h"
 #include "api.h"
+#include "resumption_cache.h"
 #include "registration.h"
 #include "configuration.h"
 #include "range.h"
@@ -165,6 +165,26 @@ typedef struct QUIC_RX_PACKET QUIC_RX_PACKET;
 //
 #define QUIC_MAX_BINDING_STATELESS_OPERATIONS   100
 
+//
+// While in DoS mode (i.e. sending retries), the datapath receive filter rate
+// limits client Initial packets per source address prefix (/24 for IPv4, /48
+// for IPv6). Each partition tracks the prefixes in a fixed number of token
+// buckets; prefixes that hash to the same bucket share its budget.
+//
+#define QUIC_INITIAL_FILTER_BUCKET_COUNT        1024    // Must be a power of 2
+#define QUIC_INITIAL_FILTER_PREFIX_RATE         1000    // Packets per second
+#define QUIC_INITIAL_FILTER_PREFIX_BURST        2000    // Packets
+
+//
+// Listener admission control grades the load on the server by its pressure: the
+// larger of the worker queue delay and handshake backlog, as a percentage of
+// the listener's targets. New connections are first sent a Retry, then
+// rejected with a probability that grows linearly up to the hard reject level.
+//
+#define QUIC_ADMISSION_RETRY_PRESSURE           100     // Percent of target
+#define QUIC_ADMISSION_SHED_PRESSURE            200     // Percent of target
+#define QUIC_ADMISSION_REJECT_PRESSURE          400     // Percent of target
+
 //
 // The number of milliseconds we keep an entry in the binding stateless
 // operation table before removing it.
@@ -200,6 +220,22 @@ typedef struct QUIC_RX_PACKET QUIC_RX_PACKET;
 //
 #define QUIC_MAX_CRYPTO_BATCH_COUNT             8
 
+//
+// The maximum number of destination CIDs (connections) the datagrams of a
+// single receive indication are grouped by before they are delivered. The
+// hash table indexing the groups must be a power of two, larger than that.
+//
+#define QUIC_MAX_RECEIVE_GROUP_COUNT            8
+#define QUIC_RECEIVE_GROUP_HASH_SIZE            16
+
+//
+// The maximum number of connections a worker processes before it hands the
+// sends it has batched from them to the datapath. The held sends leave the
+// host later, so RTT samples and pacing are delayed by up to this many
+// connections' worth of processing.
+//
+#define QUIC_MAX_SEND_BATCH_CONNECTIONS         8
+
 //
 // The maximum number of received packets that may be processed in a single
 // flush operation.
@@ -427,6 +463,24 @@ CXPLAT_STATIC_ASSERT(
 //
 #define QUIC_DEFAULT_LOAD_BALANCING_MODE        QUIC_LOAD_BALANCING_DISABLED
 
+//
+// The default window (in ms) over which 0-RTT resumption tickets are checked
+// for replay. Zero disables the anti-replay filter.
+//
+#define QUIC_DEFAULT_ANTI_REPLAY_WINDOW_MS      0
+
+//
+// The default number of resumptions per anti-replay window the filter is sized
+// for (across all partitions).
+//
+#define QUIC_DEFAULT_ANTI_REPLAY_CAPACITY       (1024 * 1024)
+
+//
+// The default value for allocating connections and streams from large page
+// arenas.
+//
+#define QUIC_DEFAULT_OBJECT_ARENA_ENABLED       FALSE
+
 //
 // The default value for datagrams being enabled or not.
 //
@@ -448,7 +502,13 @@ CXPLAT_STATIC_ASSERT(
 // Version of the wire-format for resumption tickets.
 // This needs to be incremented for each change in order or count of fields.
 //
-#define CXPLAT_TLS_RESUMPTION_TICKET_VERSION      1
+#define CXPLAT_TLS_RESUMPTION_TICKET_VERSION      2
+
+//
+// Length of the trailer (nonce and issue time) at the end of a server
+// resumption ticket, used for 0-RTT replay detection.
+//
+#define QUIC_SERVER_TICKET_REPLAY_INFO_LENGTH     (sizeof(uint64_t) * 2)
 
 //
 // Version of the blob for client resumption tickets.
@@ -498,6 +558,12 @@ CXPLAT_STATIC_ASSERT(
 //
 #define QUIC_DEFAULT_DEST_CID_UPDATE_IDLE_TIMEOUT_MS 20000
 
+//
+// The default idle period after which a connection releases its packet space,
+// crypto and receive buffer memory until it is next used. Zero disables it.
+//
+#define QUIC_DEFAULT_IDLE_HIBERNATION_TIMEOUT_MS     0
+
 //
 // The default value for enabling grease quic bit extension.
 //
@@ -632,6 +698,9 @@ CXPLAT_STATIC_ASSERT(
 #define QUIC_SETTING_RETRY_MEMORY_FRACTION          "RetryMemoryFraction"
 #define QUIC_SETTING_LOAD_BALANCING_MODE            "LoadBalancingMode"
 #define QUIC_SETTING_FIXED_SERVER_ID                "FixedServerID"
+#define QUIC_SETTING_ANTI_REPLAY_WINDOW_MS          "AntiReplayWindowMs"
+#define QUIC_SETTING_ANTI_REPLAY_CAPACITY           "AntiReplayCapacity"
+#define QUIC_SETTING_OBJECT_ARENA_ENABLED           "ObjectArenaEnabled"
 #define QUIC_SETTING_MAX_WORKER_QUEUE_DELAY         "MaxWorkerQueueDelayMs"
 #define QUIC_SETTING_MAX_STATELESS_OPERATIONS       "MaxStatelessOperations"
 #define QUIC_SETTING_MAX_BINDING_STATELESS_OPERATIONS "MaxBindingStatelessOperations"
@@ -655,6 +724,7 @@ CXPLAT_STATIC_ASSERT(
 #define QUIC_SETTING_INITIAL_WINDOW_PACKETS         "InitialWindowPackets"
 #define QUIC_SETTING_SEND_IDLE_TIMEOUT_MS           "SendIdleTimeoutMs"
 #define QUIC_SETTING_DEST_CID_UPDATE_IDLE_TIMEOUT_MS "DestCidUpdateIdleTimeoutMs"
+#define QUIC_SETTING_IDLE_HIBERNATION_TIMEOUT_MS    "IdleHibernationTimeoutMs"
 
 #define QUIC_SETTING_INITIAL_RTT                    "InitialRttMs"
 #define QUIC_SETTING_MAX_ACK_DELAY                  "MaxAckDelayMs"
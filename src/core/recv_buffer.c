@@ -197,6 +197,105 @@ QuicRecvBufferHasUnreadData(
     return ContiguousLength > RecvBuffer->ReadPendingLength;
 }
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+QuicRecvBufferRelease(
+    _Inout_ QUIC_RECV_BUFFER* RecvBuffer
+    )
+{
+    if (RecvBuffer->RecvMode == QUIC_RECV_BUF_MODE_APP_OWNED ||
+        RecvBuffer->RetiredChunk != NULL ||
+        RecvBuffer->ReadPendingLength != 0 ||
+        CxPlatListIsEmpty(&RecvBuffer->Chunks) ||
+        RecvBuffer->Chunks.Flink != RecvBuffer->Chunks.Blink ||
+        QuicRecvBufferGetSpan(RecvBuffer) != 0) {
+        return FALSE;
+    }
+
+    QUIC_RECV_CHUNK* Chunk =
+        CXPLAT_CONTAINING_RECORD(
+            RecvBuffer->Chunks.Flink,
+            QUIC_RECV_CHUNK,
+            Link);
+    if (Chunk->ExternalReference) {
+        return FALSE;
+    }
+
+    CxPlatListEntryRemove(&Chunk->Link);
+    QuicRecvChunkFree(RecvBuffer, Chunk);
+    RecvBuffer->ReadStart = 0;
+    RecvBuffer->ReadLength = 0;
+    RecvBuffer->Capacity = 0;
+
+    return TRUE;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+QuicRecvBufferIsReleased(
+    _In_ const QUIC_RECV_BUFFER* RecvBuffer
+    )
+{
+    return
+        RecvBuffer->RecvMode != QUIC_RECV_BUF_MODE_APP_OWNED &&
+        CxPlatListIsEmpty(&RecvBuffer->Chunks);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+QuicRecvBufferRestore(
+    _Inout_ QUIC_RECV_BUFFER* RecvBuffer,
+    _In_ uint32_t AllocBufferLength,
+    _In_opt_ QUIC_RECV_CHUNK* PreallocatedChunk
+    )
+{
+    CXPLAT_DBG_ASSERT(QuicRecvBufferIsReleased(RecvBuffer));
+    CXPLAT_DBG_ASSERT(AllocBufferLength <= RecvBuffer->VirtualBufferLength);
+
+    QUIC_RECV_CHUNK* Chunk;
+    if (PreallocatedChunk != NULL) {
+        Chunk = PreallocatedChunk;
+    } else {
+        Chunk = CXPLAT_ALLOC_NONPAGED(sizeof(QUIC_RECV_CHUNK) + AllocBufferLength, QUIC_POOL_RECVBUF);
+        if (Chunk == NULL) {
+            QuicTraceEvent(
+                AllocFailure,
+                "Allocation of '%s' failed. (%llu bytes)",
+                "recv_buffer",
+                sizeof(QUIC_RECV_CHUNK) + AllocBufferLength);
+            return QUIC_STATUS_OUT_OF_MEMORY;
+        }
+        QuicRecvChunkInitialize(Chunk, AllocBufferLength, (uint8_t*)(Chunk + 1), FALSE);
+    }
+
+    RecvBuffer->PreallocatedChunk = PreallocatedChunk;
+    CxPlatListInsertHead(&RecvBuffer->Chunks, &Chunk->Link);
+    RecvBuffer->Capacity = Chunk->AllocLength;
+
+    return QUIC_STATUS_SUCCESS;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+uint32_t
+QuicRecvBufferGetAllocatedSize(
+    _In_ QUIC_RECV_BUFFER* RecvBuffer
+    )
+{
+    uint32_t Size = 0;
+    for (CXPLAT_LIST_ENTRY* Link = RecvBuffer->Chunks.Flink;
+         Link != &RecvBuffer->Chunks;
+         Link = Link->Flink) {
+        QUIC_RECV_CHUNK* Chunk = CXPLAT_CONTAINING_RECORD(Link, QUIC_RECV_CHUNK, Link);
+        if (!Chunk->AppOwnedBuffer) {
+            Size += sizeof(QUIC_RECV_CHUNK) + Chunk->AllocLength;
+        }
+    }
+    if (RecvBuffer->RetiredChunk != NULL && !RecvBuffer->RetiredChunk->AppOwnedBuffer) {
+        Size += sizeof(QUIC_RECV_CHUNK) + RecvBuffer->RetiredChunk->AllocLength;
+    }
+    return Size;
+}
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 void
 QuicRecvBufferIncreaseVirtualBufferLength(
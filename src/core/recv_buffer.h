@@ -128,6 +128,50 @@ QuicRecvBufferUninitialize(
     _In_ QUIC_RECV_BUFFER* RecvBuffer
     );
 
+//
+// Frees the buffer's backing memory while it holds no data, for example while
+// the connection is hibernated. Returns FALSE, leaving the buffer untouched,
+// if the buffer can't be released. A preallocated chunk isn't freed; it's up
+// to the caller to release it and to provide it again in
+// QuicRecvBufferRestore.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+QuicRecvBufferRelease(
+    _Inout_ QUIC_RECV_BUFFER* RecvBuffer
+    );
+
+//
+// Returns TRUE if the buffer was released by QuicRecvBufferRelease and not
+// yet restored.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+QuicRecvBufferIsReleased(
+    _In_ const QUIC_RECV_BUFFER* RecvBuffer
+    );
+
+//
+// Gives a released buffer a new chunk to receive into.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+QuicRecvBufferRestore(
+    _Inout_ QUIC_RECV_BUFFER* RecvBuffer,
+    _In_ uint32_t AllocBufferLength,
+    _In_opt_ QUIC_RECV_CHUNK* PreallocatedChunk
+    );
+
+//
+// Returns the number of bytes of chunks currently allocated by the buffer,
+// excluding app-owned buffers.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+uint32_t
+QuicRecvBufferGetAllocatedSize(
+    _In_ QUIC_RECV_BUFFER* RecvBuffer
+    );
+
 //
 // Get the buffer's total length from offset 0. This does not necessarily mean
 // all of this buffer is available to be read, as some of it may have already
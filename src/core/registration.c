@@ -175,6 +175,9 @@ MsQuicRegistrationClose(
         CxPlatRundownReleaseAndWait(&Registration->Rundown);
 
         QuicWorkerPoolUninitialize(Registration->WorkerPool);
+        if (Registration->ResumptionCache != NULL) {
+            QuicResumptionCacheUninitialize(Registration->ResumptionCache);
+        }
         CxPlatRundownUninitialize(&Registration->Rundown);
         CxPlatDispatchLockUninitialize(&Registration->ConnectionLock);
         CxPlatLockUninitialize(&Registration->ConfigLock);
@@ -366,11 +369,53 @@ QuicRegistrationParamSet(
         const void* Buffer
     )
 {
-    UNREFERENCED_PARAMETER(Registration);
-    UNREFERENCED_PARAMETER(Param);
-    UNREFERENCED_PARAMETER(BufferLength);
-    UNREFERENCED_PARAMETER(Buffer);
-    return QUIC_STATUS_INVALID_PARAMETER;
+    QUIC_STATUS Status;
+
+    switch (Param) {
+
+    case QUIC_PARAM_REGISTRATION_RESUMPTION_CACHE: {
+
+        if (BufferLength != sizeof(QUIC_RESUMPTION_CACHE_CONFIG) ||
+            Buffer == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        const QUIC_RESUMPTION_CACHE_CONFIG* Config =
+            (const QUIC_RESUMPTION_CACHE_CONFIG*)Buffer;
+        if (Config->MaxEntryCount == 0) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        //
+        // The cache may only be configured once. Connections read the pointer
+        // without synchronization, so it must never change once set.
+        //
+        CxPlatLockAcquire(&Registration->ConfigLock);
+        if (Registration->ResumptionCache != NULL) {
+            Status = QUIC_STATUS_INVALID_STATE;
+        } else {
+            QUIC_RESUMPTION_CACHE* Cache;
+            Status =
+                QuicResumptionCacheInitialize(
+                    Config->MaxEntryCount,
+                    Config->EntryTimeoutMs,
+                    &Cache);
+            if (QUIC_SUCCEEDED(Status)) {
+                Registration->ResumptionCache = Cache;
+            }
+        }
+        CxPlatLockRelease(&Registration->ConfigLock);
+        break;
+    }
+
+    default:
+        Status = QUIC_STATUS_INVALID_PARAMETER;
+        break;
+    }
+
+    return Status;
 }
 
 _IRQL_requires_max_(PASSIVE_LEVEL)
@@ -383,9 +428,44 @@ QuicRegistrationParamGet(
         void* Buffer
     )
 {
-    UNREFERENCED_PARAMETER(Registration);
-    UNREFERENCED_PARAMETER(Param);
-    UNREFERENCED_PARAMETER(BufferLength);
-    UNREFERENCED_PARAMETER(Buffer);
-    return QUIC_STATUS_INVALID_PARAMETER;
+    QUIC_STATUS Status;
+
+    switch (Param) {
+
+    case QUIC_PARAM_REGISTRATION_RESUMPTION_CACHE: {
+
+        if (*BufferLength < sizeof(QUIC_RESUMPTION_CACHE_CONFIG)) {
+            *BufferLength = sizeof(QUIC_RESUMPTION_CACHE_CONFIG);
+            Status = QUIC_STATUS_BUFFER_TOO_SMALL;
+            break;
+        }
+
+        if (Buffer == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        QUIC_RESUMPTION_CACHE_CONFIG* Config =
+            (QUIC_RESUMPTION_CACHE_CONFIG*)Buffer;
+        CxPlatLockAcquire(&Registration->ConfigLock);
+        if (Registration->ResumptionCache != NULL) {
+            Config->MaxEntryCount = Registration->ResumptionCache->MaxEntryCount;
+            Config->EntryTimeoutMs = Registration->ResumptionCache->EntryTimeoutMs;
+        } else {
+            Config->MaxEntryCount = 0;
+            Config->EntryTimeoutMs = 0;
+        }
+        CxPlatLockRelease(&Registration->ConfigLock);
+
+        *BufferLength = sizeof(QUIC_RESUMPTION_CACHE_CONFIG);
+        Status = QUIC_STATUS_SUCCESS;
+        break;
+    }
+
+    default:
+        Status = QUIC_STATUS_INVALID_PARAMETER;
+        break;
+    }
+
+    return Status;
 }
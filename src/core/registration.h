@@ -105,6 +105,13 @@ typedef struct QUIC_REGISTRATION {
     //
     uint64_t ShutdownErrorCode;
 
+    //
+    // Optional cache of client resumption tickets, shared by all connections
+    // in the registration. Set at most once via
+    // QUIC_PARAM_REGISTRATION_RESUMPTION_CACHE.
+    //
+    QUIC_RESUMPTION_CACHE* ResumptionCache;
+
     //
     // Name of the application layer.
     //
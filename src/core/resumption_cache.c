@@ -0,0 +1,314 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    A bounded, sharded cache of client resumption tickets, keyed by the server
+    name and ALPN list of the connection that received them.
+
+    The cache is split into a power of two number of shards (no more than the
+    number of partitions), each with its own lock, hash table and LRU list.
+    Tickets are single use: a lookup removes the entry from the cache. Because
+    of this, "recently used" and "recently inserted" are the same thing and the
+    LRU list simply orders entries by insertion time. Expired entries are lazily
+    removed from the tail of the list on insert and skipped (and removed) on
+    lookup.
+
+--*/
+
+#include "precomp.h"
+#ifdef QUIC_CLOG
+#include "resumption_cache.c.clog.h"
+#endif
+
+static
+uint32_t
+QuicResumptionCacheHash(
+    _In_ uint16_t ServerNameLength,
+    _In_reads_(ServerNameLength)
+        const char* ServerName,
+    _In_ uint16_t AlpnListLength,
+    _In_reads_(AlpnListLength)
+        const uint8_t* AlpnList
+    )
+{
+    //
+    // Same as CxPlatHashSimple, but continued across both parts of the key.
+    //
+    uint32_t Hash = 5387;
+    for (uint16_t i = 0; i < ServerNameLength; ++i) {
+        Hash = ((Hash << 5) - Hash) + (uint8_t)ServerName[i];
+    }
+    Hash = ((Hash << 5) - Hash); // Separator between the two parts.
+    for (uint16_t i = 0; i < AlpnListLength; ++i) {
+        Hash = ((Hash << 5) - Hash) + AlpnList[i];
+    }
+    return Hash;
+}
+
+static
+BOOLEAN
+QuicResumptionCacheEntryIsExpired(
+    _In_ const QUIC_RESUMPTION_CACHE* Cache,
+    _In_ const QUIC_RESUMPTION_CACHE_ENTRY* Entry,
+    _In_ uint64_t TimeNow
+    )
+{
+    return
+        Cache->EntryTimeoutMs != 0 &&
+        CxPlatTimeDiff64(Entry->InsertTime, TimeNow) >= MS_TO_US((uint64_t)Cache->EntryTimeoutMs);
+}
+
+static
+void
+QuicResumptionCacheShardRemove(
+    _In_ QUIC_RESUMPTION_CACHE_SHARD* Shard,
+    _In_ QUIC_RESUMPTION_CACHE_ENTRY* Entry
+    )
+{
+    CxPlatHashtableRemove(&Shard->Table, &Entry->TableEntry, NULL);
+    CxPlatListEntryRemove(&Entry->LruLink);
+    CXPLAT_DBG_ASSERT(Shard->EntryCount > 0);
+    Shard->EntryCount--;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+QuicResumptionCacheInitialize(
+    _In_ uint32_t MaxEntryCount,
+    _In_ uint32_t EntryTimeoutMs,
+    _Outptr_ _At_(*NewCache, __drv_allocatesMem(Mem))
+        QUIC_RESUMPTION_CACHE** NewCache
+    )
+{
+    CXPLAT_DBG_ASSERT(MaxEntryCount != 0);
+
+    uint32_t ShardCount = 1;
+    while (ShardCount * 2 <= MsQuicLib.PartitionCount &&
+           ShardCount * 2 <= MaxEntryCount) {
+        ShardCount *= 2;
+    }
+
+    const size_t CacheSize =
+        sizeof(QUIC_RESUMPTION_CACHE) +
+        ShardCount * sizeof(QUIC_RESUMPTION_CACHE_SHARD);
+    QUIC_RESUMPTION_CACHE* Cache =
+        CXPLAT_ALLOC_NONPAGED(CacheSize, QUIC_POOL_RESUMPTION_CACHE);
+    if (Cache == NULL) {
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "resumption cache",
+            CacheSize);
+        return QUIC_STATUS_OUT_OF_MEMORY;
+    }
+
+    CxPlatZeroMemory(Cache, CacheSize);
+    Cache->MaxEntryCount = MaxEntryCount;
+    Cache->EntryTimeoutMs = EntryTimeoutMs;
+    Cache->ShardCapacity = MaxEntryCount / ShardCount;
+    Cache->ShardMask = ShardCount - 1;
+
+    for (uint32_t i = 0; i < ShardCount; ++i) {
+        QUIC_RESUMPTION_CACHE_SHARD* Shard = &Cache->Shards[i];
+        if (!CxPlatHashtableInitializeEx(&Shard->Table, CXPLAT_HASH_MIN_SIZE)) {
+            QuicTraceEvent(
+                AllocFailure,
+                "Allocation of '%s' failed. (%llu bytes)",
+                "resumption cache shard table",
+                0);
+            for (uint32_t j = 0; j < i; ++j) {
+                CxPlatHashtableUninitialize(&Cache->Shards[j].Table);
+                CxPlatDispatchLockUninitialize(&Cache->Shards[j].Lock);
+            }
+            CXPLAT_FREE(Cache, QUIC_POOL_RESUMPTION_CACHE);
+            return QUIC_STATUS_OUT_OF_MEMORY;
+        }
+        CxPlatDispatchLockInitialize(&Shard->Lock);
+        CxPlatListInitializeHead(&Shard->LruList);
+    }
+
+    *NewCache = Cache;
+    return QUIC_STATUS_SUCCESS;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicResumptionCacheUninitialize(
+    _In_ __drv_freesMem(Mem) QUIC_RESUMPTION_CACHE* Cache
+    )
+{
+    for (uint32_t i = 0; i <= Cache->ShardMask; ++i) {
+        QUIC_RESUMPTION_CACHE_SHARD* Shard = &Cache->Shards[i];
+        while (!CxPlatListIsEmpty(&Shard->LruList)) {
+            QUIC_RESUMPTION_CACHE_ENTRY* Entry =
+                CXPLAT_CONTAINING_RECORD(
+                    Shard->LruList.Flink, QUIC_RESUMPTION_CACHE_ENTRY, LruLink);
+            QuicResumptionCacheShardRemove(Shard, Entry);
+            QuicResumptionCacheEntryFree(Entry);
+        }
+        CxPlatHashtableUninitialize(&Shard->Table);
+        CxPlatDispatchLockUninitialize(&Shard->Lock);
+    }
+    CXPLAT_FREE(Cache, QUIC_POOL_RESUMPTION_CACHE);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicResumptionCacheInsert(
+    _In_ QUIC_RESUMPTION_CACHE* Cache,
+    _In_ uint16_t ServerNameLength,
+    _In_reads_(ServerNameLength)
+        const char* ServerName,
+    _In_ uint16_t AlpnListLength,
+    _In_reads_(AlpnListLength)
+        const uint8_t* AlpnList,
+    _In_ uint32_t TicketLength,
+    _In_reads_(TicketLength)
+        const uint8_t* Ticket,
+    _In_ uint64_t TimeNow
+    )
+{
+    if (TicketLength == 0 || TicketLength > UINT16_MAX) {
+        return; // Can't be decoded later anyways.
+    }
+
+    const size_t EntrySize =
+        sizeof(QUIC_RESUMPTION_CACHE_ENTRY) +
+        ServerNameLength + AlpnListLength + TicketLength;
+    QUIC_RESUMPTION_CACHE_ENTRY* Entry =
+        CXPLAT_ALLOC_NONPAGED(EntrySize, QUIC_POOL_RESUMPTION_CACHE);
+    if (Entry == NULL) {
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "resumption cache entry",
+            EntrySize);
+        return;
+    }
+
+    Entry->InsertTime = TimeNow;
+    Entry->ServerNameLength = ServerNameLength;
+    Entry->AlpnListLength = AlpnListLength;
+    Entry->TicketLength = (uint16_t)TicketLength;
+    CxPlatCopyMemory(Entry->Buffer, ServerName, ServerNameLength);
+    CxPlatCopyMemory(Entry->Buffer + ServerNameLength, AlpnList, AlpnListLength);
+    Entry->Ticket = Entry->Buffer + ServerNameLength + AlpnListLength;
+    CxPlatCopyMemory((uint8_t*)Entry->Ticket, Ticket, TicketLength);
+
+    const uint32_t Hash =
+        QuicResumptionCacheHash(ServerNameLength, ServerName, AlpnListLength, AlpnList);
+    QUIC_RESUMPTION_CACHE_SHARD* Shard = &Cache->Shards[Hash & Cache->ShardMask];
+
+    CXPLAT_LIST_ENTRY Evicted;
+    CxPlatListInitializeHead(&Evicted);
+
+    CxPlatDispatchLockAcquire(&Shard->Lock);
+
+    //
+    // Drop anything that has expired, then the least recently inserted
+    // entries until there is room for the new one.
+    //
+    while (!CxPlatListIsEmpty(&Shard->LruList)) {
+        QUIC_RESUMPTION_CACHE_ENTRY* Oldest =
+            CXPLAT_CONTAINING_RECORD(
+                Shard->LruList.Blink, QUIC_RESUMPTION_CACHE_ENTRY, LruLink);
+        if (Shard->EntryCount < Cache->ShardCapacity &&
+            !QuicResumptionCacheEntryIsExpired(Cache, Oldest, TimeNow)) {
+            break;
+        }
+        QuicResumptionCacheShardRemove(Shard, Oldest);
+        CxPlatListInsertTail(&Evicted, &Oldest->LruLink);
+    }
+
+    CxPlatHashtableInsert(&Shard->Table, &Entry->TableEntry, Hash, NULL);
+    CxPlatListInsertHead(&Shard->LruList, &Entry->LruLink);
+    Shard->EntryCount++;
+
+    CxPlatDispatchLockRelease(&Shard->Lock);
+
+    while (!CxPlatListIsEmpty(&Evicted)) {
+        QuicResumptionCacheEntryFree(
+            CXPLAT_CONTAINING_RECORD(
+                CxPlatListRemoveHead(&Evicted), QUIC_RESUMPTION_CACHE_ENTRY, LruLink));
+    }
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_RESUMPTION_CACHE_ENTRY*
+QuicResumptionCacheTake(
+    _In_ QUIC_RESUMPTION_CACHE* Cache,
+    _In_ uint16_t ServerNameLength,
+    _In_reads_(ServerNameLength)
+        const char* ServerName,
+    _In_ uint16_t AlpnListLength,
+    _In_reads_(AlpnListLength)
+        const uint8_t* AlpnList,
+    _In_ uint64_t TimeNow
+    )
+{
+    const uint32_t Hash =
+        QuicResumptionCacheHash(ServerNameLength, ServerName, AlpnListLength, AlpnList);
+    QUIC_RESUMPTION_CACHE_SHARD* Shard = &Cache->Shards[Hash & Cache->ShardMask];
+    QUIC_RESUMPTION_CACHE_ENTRY* Result = NULL;
+
+    CXPLAT_LIST_ENTRY Expired;
+    CxPlatListInitializeHead(&Expired);
+
+    CxPlatDispatchLockAcquire(&Shard->Lock);
+
+    do {
+        CXPLAT_HASHTABLE_LOOKUP_CONTEXT Context;
+        CXPLAT_HASHTABLE_ENTRY* TableEntry =
+            CxPlatHashtableLookup(&Shard->Table, Hash, &Context);
+        while (TableEntry != NULL) {
+            QUIC_RESUMPTION_CACHE_ENTRY* Entry =
+                CXPLAT_CONTAINING_RECORD(TableEntry, QUIC_RESUMPTION_CACHE_ENTRY, TableEntry);
+            if (Entry->ServerNameLength == ServerNameLength &&
+                Entry->AlpnListLength == AlpnListLength &&
+                memcmp(Entry->Buffer, ServerName, ServerNameLength) == 0 &&
+                memcmp(Entry->Buffer + ServerNameLength, AlpnList, AlpnListLength) == 0) {
+                Result = Entry;
+                break;
+            }
+            TableEntry = CxPlatHashtableLookupNext(&Shard->Table, &Context);
+        }
+
+        if (Result == NULL) {
+            break;
+        }
+
+        //
+        // Tickets are single use, so always remove the match. If it expired,
+        // look again (from the start, since removal invalidates the lookup
+        // context).
+        //
+        QuicResumptionCacheShardRemove(Shard, Result);
+        if (QuicResumptionCacheEntryIsExpired(Cache, Result, TimeNow)) {
+            CxPlatListInsertTail(&Expired, &Result->LruLink);
+            Result = NULL;
+            continue;
+        }
+    } while (Result == NULL);
+
+    CxPlatDispatchLockRelease(&Shard->Lock);
+
+    while (!CxPlatListIsEmpty(&Expired)) {
+        QuicResumptionCacheEntryFree(
+            CXPLAT_CONTAINING_RECORD(
+                CxPlatListRemoveHead(&Expired), QUIC_RESUMPTION_CACHE_ENTRY, LruLink));
+    }
+
+    return Result;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicResumptionCacheEntryFree(
+    _In_ __drv_freesMem(Mem) QUIC_RESUMPTION_CACHE_ENTRY* Entry
+    )
+{
+    CXPLAT_FREE(Entry, QUIC_POOL_RESUMPTION_CACHE);
+}
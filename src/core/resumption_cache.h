@@ -0,0 +1,177 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+--*/
+
+#pragma once
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+//
+// A single cached (encoded) client resumption ticket.
+//
+typedef struct QUIC_RESUMPTION_CACHE_ENTRY {
+
+    //
+    // Link in the shard's hash table. Signature is the hash of the key.
+    //
+    CXPLAT_HASHTABLE_ENTRY TableEntry;
+
+    //
+    // Link in the shard's LRU list.
+    //
+    CXPLAT_LIST_ENTRY LruLink;
+
+    //
+    // The time (in us) the ticket was inserted into the cache.
+    //
+    uint64_t InsertTime;
+
+    uint16_t ServerNameLength;
+    uint16_t AlpnListLength;
+    uint16_t TicketLength;
+
+    //
+    // Points into Buffer, after the key.
+    //
+    const uint8_t* Ticket;
+
+    //
+    // ServerName, followed by the AlpnList, followed by the ticket.
+    //
+    uint8_t Buffer[0];
+
+} QUIC_RESUMPTION_CACHE_ENTRY;
+
+typedef struct QUIC_CACHEALIGN QUIC_RESUMPTION_CACHE_SHARD {
+
+    //
+    // Protects the table and LRU list.
+    //
+    CXPLAT_DISPATCH_LOCK Lock;
+
+    //
+    // Number of entries currently in the shard.
+    //
+    uint32_t EntryCount;
+
+    //
+    // Entries, keyed by server name and ALPN list.
+    //
+    CXPLAT_HASHTABLE Table;
+
+    //
+    // Entries, ordered from most (head) to least (tail) recently inserted.
+    //
+    CXPLAT_LIST_ENTRY LruList;
+
+} QUIC_RESUMPTION_CACHE_SHARD;
+
+//
+// Registration-wide cache of client resumption tickets. Tickets are stored
+// when the server sends them and consumed (single use) when a new connection
+// to the same server name and ALPN list is started without an app-provided
+// ticket. The cache is split into independently locked shards to minimize
+// contention between workers.
+//
+typedef struct QUIC_RESUMPTION_CACHE {
+
+    //
+    // Configured total capacity.
+    //
+    uint32_t MaxEntryCount;
+
+    //
+    // Configured lifetime of each entry, in milliseconds. Zero indicates
+    // entries don't expire (other than via the TLS ticket lifetime).
+    //
+    uint32_t EntryTimeoutMs;
+
+    //
+    // Capacity of each shard.
+    //
+    uint32_t ShardCapacity;
+
+    //
+    // Number of shards minus one (shard count is a power of two).
+    //
+    uint32_t ShardMask;
+
+    QUIC_RESUMPTION_CACHE_SHARD Shards[0];
+
+} QUIC_RESUMPTION_CACHE;
+
+//
+// Creates a new resumption ticket cache.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+QuicResumptionCacheInitialize(
+    _In_ uint32_t MaxEntryCount,
+    _In_ uint32_t EntryTimeoutMs,
+    _Outptr_ _At_(*NewCache, __drv_allocatesMem(Mem))
+        QUIC_RESUMPTION_CACHE** NewCache
+    );
+
+//
+// Frees the cache and all remaining entries.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicResumptionCacheUninitialize(
+    _In_ __drv_freesMem(Mem) QUIC_RESUMPTION_CACHE* Cache
+    );
+
+//
+// Adds a copy of the encoded client ticket to the cache, evicting expired
+// and least recently inserted entries as necessary.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicResumptionCacheInsert(
+    _In_ QUIC_RESUMPTION_CACHE* Cache,
+    _In_ uint16_t ServerNameLength,
+    _In_reads_(ServerNameLength)
+        const char* ServerName,
+    _In_ uint16_t AlpnListLength,
+    _In_reads_(AlpnListLength)
+        const uint8_t* AlpnList,
+    _In_ uint32_t TicketLength,
+    _In_reads_(TicketLength)
+        const uint8_t* Ticket,
+    _In_ uint64_t TimeNow
+    );
+
+//
+// Removes and returns an unexpired ticket for the given key, if any. The
+// returned entry must be freed with QuicResumptionCacheEntryFree.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_RESUMPTION_CACHE_ENTRY*
+QuicResumptionCacheTake(
+    _In_ QUIC_RESUMPTION_CACHE* Cache,
+    _In_ uint16_t ServerNameLength,
+    _In_reads_(ServerNameLength)
+        const char* ServerName,
+    _In_ uint16_t AlpnListLength,
+    _In_reads_(AlpnListLength)
+        const uint8_t* AlpnList,
+    _In_ uint64_t TimeNow
+    );
+
+//
+// Frees an entry previously returned by QuicResumptionCacheTake.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicResumptionCacheEntryFree(
+    _In_ __drv_freesMem(Mem) QUIC_RESUMPTION_CACHE_ENTRY* Entry
+    );
+
+#if defined(__cplusplus)
+}
+#endif
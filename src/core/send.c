@@ -1296,6 +1296,21 @@ QuicSendFlush(
             break;
         }
 
+        if (CxPlatSocketIsSendBlocked(Path->Binding->Socket, &Path->Route)) {
+            //
+            // The datapath already has plenty queued for the socket, so stop
+            // building packets and retry on the pacing timer instead.
+            //
+            QuicConnAddOutFlowBlockedReason(
+                Connection, QUIC_FLOW_BLOCKED_PACING);
+            QuicConnTimerSet(
+                Connection,
+                QUIC_CONN_TIMER_PACING,
+                QUIC_SEND_PACING_INTERVAL);
+            Result = QUIC_SEND_DELAYED_PACING;
+            break;
+        }
+
         uint32_t SendFlags = Send->SendFlags;
         if (Connection->Crypto.TlsState.WriteKey < QUIC_PACKET_KEY_1_RTT) {
             SendFlags &= QUIC_CONN_SEND_FLAG_ALLOWED_HANDSHAKE;
@@ -51,6 +51,15 @@ QuicSettingsSetDefault(
     if (!Settings->IsSet.FixedServerID) {
         Settings->FixedServerID = 0;
     }
+    if (!Settings->IsSet.AntiReplayWindowMs) {
+        Settings->AntiReplayWindowMs = QUIC_DEFAULT_ANTI_REPLAY_WINDOW_MS;
+    }
+    if (!Settings->IsSet.AntiReplayCapacity) {
+        Settings->AntiReplayCapacity = QUIC_DEFAULT_ANTI_REPLAY_CAPACITY;
+    }
+    if (!Settings->IsSet.ObjectArenaEnabled) {
+        Settings->ObjectArenaEnabled = QUIC_DEFAULT_OBJECT_ARENA_ENABLED;
+    }
     if (!Settings->IsSet.MaxWorkerQueueDelayUs) {
         Settings->MaxWorkerQueueDelayUs = MS_TO_US(QUIC_MAX_WORKER_QUEUE_DELAY);
     }
@@ -144,6 +153,9 @@ QuicSettingsSetDefault(
     if (!Settings->IsSet.DestCidUpdateIdleTimeoutMs) {
         Settings->DestCidUpdateIdleTimeoutMs = QUIC_DEFAULT_DEST_CID_UPDATE_IDLE_TIMEOUT_MS;
     }
+    if (!Settings->IsSet.IdleHibernationTimeoutMs) {
+        Settings->IdleHibernationTimeoutMs = QUIC_DEFAULT_IDLE_HIBERNATION_TIMEOUT_MS;
+    }
     if (!Settings->IsSet.GreaseQuicBitEnabled) {
         Settings->GreaseQuicBitEnabled = QUIC_DEFAULT_GREASE_QUIC_BIT_ENABLED;
     }
@@ -204,6 +216,15 @@ QuicSettingsCopy(
     if (!Destination->IsSet.FixedServerID) {
         Destination->FixedServerID = Source->FixedServerID;
     }
+    if (!Destination->IsSet.AntiReplayWindowMs) {
+        Destination->AntiReplayWindowMs = Source->AntiReplayWindowMs;
+    }
+    if (!Destination->IsSet.AntiReplayCapacity) {
+        Destination->AntiReplayCapacity = Source->AntiReplayCapacity;
+    }
+    if (!Destination->IsSet.ObjectArenaEnabled) {
+        Destination->ObjectArenaEnabled = Source->ObjectArenaEnabled;
+    }
     if (!Destination->IsSet.MaxWorkerQueueDelayUs) {
         Destination->MaxWorkerQueueDelayUs = Source->MaxWorkerQueueDelayUs;
     }
@@ -315,6 +336,9 @@ QuicSettingsCopy(
     if (!Destination->IsSet.DestCidUpdateIdleTimeoutMs) {
         Destination->DestCidUpdateIdleTimeoutMs = Source->DestCidUpdateIdleTimeoutMs;
     }
+    if (!Destination->IsSet.IdleHibernationTimeoutMs) {
+        Destination->IdleHibernationTimeoutMs = Source->IdleHibernationTimeoutMs;
+    }
     if (!Destination->IsSet.GreaseQuicBitEnabled) {
         Destination->GreaseQuicBitEnabled = Source->GreaseQuicBitEnabled;
     }
@@ -458,6 +482,21 @@ QuicSettingApply(
         Destination->FixedServerID = Source->FixedServerID;
         Destination->IsSet.FixedServerID = TRUE;
     }
+    if (Source->IsSet.AntiReplayWindowMs && (!Destination->IsSet.AntiReplayWindowMs || OverWrite)) {
+        Destination->AntiReplayWindowMs = Source->AntiReplayWindowMs;
+        Destination->IsSet.AntiReplayWindowMs = TRUE;
+    }
+    if (Source->IsSet.AntiReplayCapacity && (!Destination->IsSet.AntiReplayCapacity || OverWrite)) {
+        if (Source->AntiReplayCapacity == 0) {
+            return FALSE;
+        }
+        Destination->AntiReplayCapacity = Source->AntiReplayCapacity;
+        Destination->IsSet.AntiReplayCapacity = TRUE;
+    }
+    if (Source->IsSet.ObjectArenaEnabled && (!Destination->IsSet.ObjectArenaEnabled || OverWrite)) {
+        Destination->ObjectArenaEnabled = Source->ObjectArenaEnabled;
+        Destination->IsSet.ObjectArenaEnabled = TRUE;
+    }
     if (Source->IsSet.MaxWorkerQueueDelayUs && (!Destination->IsSet.MaxWorkerQueueDelayUs || OverWrite)) {
         Destination->MaxWorkerQueueDelayUs = Source->MaxWorkerQueueDelayUs;
         Destination->IsSet.MaxWorkerQueueDelayUs = TRUE;
@@ -682,6 +721,11 @@ QuicSettingApply(
         Destination->IsSet.DestCidUpdateIdleTimeoutMs = TRUE;
     }
 
+    if (Source->IsSet.IdleHibernationTimeoutMs && (!Destination->IsSet.IdleHibernationTimeoutMs || OverWrite)) {
+        Destination->IdleHibernationTimeoutMs = Source->IdleHibernationTimeoutMs;
+        Destination->IsSet.IdleHibernationTimeoutMs = TRUE;
+    }
+
     if (Source->IsSet.GreaseQuicBitEnabled && (!Destination->IsSet.GreaseQuicBitEnabled || OverWrite)) {
         Destination->GreaseQuicBitEnabled = Source->GreaseQuicBitEnabled;
         Destination->IsSet.GreaseQuicBitEnabled = TRUE;
@@ -851,6 +895,39 @@ QuicSettingsLoad(
             &ValueLen);
     }
 
+    if (!Settings->IsSet.AntiReplayWindowMs) {
+        ValueLen = sizeof(Settings->AntiReplayWindowMs);
+        CxPlatStorageReadValue(
+            Storage,
+            QUIC_SETTING_ANTI_REPLAY_WINDOW_MS,
+            (uint8_t*)&Settings->AntiReplayWindowMs,
+            &ValueLen);
+    }
+
+    if (!Settings->IsSet.AntiReplayCapacity) {
+        Value = QUIC_DEFAULT_ANTI_REPLAY_CAPACITY;
+        ValueLen = sizeof(Value);
+        CxPlatStorageReadValue(
+            Storage,
+            QUIC_SETTING_ANTI_REPLAY_CAPACITY,
+            (uint8_t*)&Value,
+            &ValueLen);
+        if (Value > 0) {
+            Settings->AntiReplayCapacity = Value;
+        }
+    }
+
+    if (!Settings->IsSet.ObjectArenaEnabled) {
+        Value = QUIC_DEFAULT_OBJECT_ARENA_ENABLED;
+        ValueLen = sizeof(Value);
+        CxPlatStorageReadValue(
+            Storage,
+            QUIC_SETTING_OBJECT_ARENA_ENABLED,
+            (uint8_t*)&Value,
+            &ValueLen);
+        Settings->ObjectArenaEnabled = !!Value;
+    }
+
     if (!Settings->IsSet.MaxWorkerQueueDelayUs) {
         Value = QUIC_MAX_WORKER_QUEUE_DELAY;
         ValueLen = sizeof(Value);
@@ -1313,6 +1390,16 @@ VersionSettingsFail:
             &ValueLen);
         Settings->DestCidUpdateIdleTimeoutMs = Value;
     }
+    if (!Settings->IsSet.IdleHibernationTimeoutMs) {
+        Value = QUIC_DEFAULT_IDLE_HIBERNATION_TIMEOUT_MS;
+        ValueLen = sizeof(Value);
+        CxPlatStorageReadValue(
+            Storage,
+            QUIC_SETTING_IDLE_HIBERNATION_TIMEOUT_MS,
+            (uint8_t*)&Value,
+            &ValueLen);
+        Settings->IdleHibernationTimeoutMs = Value;
+    }
     if (!Settings->IsSet.GreaseQuicBitEnabled) {
         Value = QUIC_DEFAULT_GREASE_QUIC_BIT_ENABLED;
         ValueLen = sizeof(Value);
@@ -1691,6 +1778,27 @@ QuicSettingsGlobalSettingsToInternal(
         SettingsSize,
         InternalSettings);
 
+    SETTING_COPY_TO_INTERNAL_SIZED(
+        AntiReplayWindowMs,
+        QUIC_GLOBAL_SETTINGS,
+        Settings,
+        SettingsSize,
+        InternalSettings);
+
+    SETTING_COPY_TO_INTERNAL_SIZED(
+        AntiReplayCapacity,
+        QUIC_GLOBAL_SETTINGS,
+        Settings,
+        SettingsSize,
+        InternalSettings);
+
+    SETTING_COPY_TO_INTERNAL_SIZED(
+        ObjectArenaEnabled,
+        QUIC_GLOBAL_SETTINGS,
+        Settings,
+        SettingsSize,
+        InternalSettings);
+
     return QUIC_STATUS_SUCCESS;
 }
 
@@ -1912,6 +2020,13 @@ QuicSettingsSettingsToInternal(
         SettingsSize,
         InternalSettings);
 
+    SETTING_COPY_TO_INTERNAL_SIZED(
+        IdleHibernationTimeoutMs,
+        QUIC_SETTINGS,
+        Settings,
+        SettingsSize,
+        InternalSettings);
+
     return QUIC_STATUS_SUCCESS;
 }
 
@@ -2089,6 +2204,13 @@ QuicSettingsGetSettings(
         *SettingsLength,
         InternalSettings);
 
+    SETTING_COPY_FROM_INTERNAL_SIZED(
+        IdleHibernationTimeoutMs,
+        QUIC_SETTINGS,
+        Settings,
+        *SettingsLength,
+        InternalSettings);
+
     *SettingsLength = CXPLAT_MIN(*SettingsLength, sizeof(QUIC_SETTINGS));
 
     return QUIC_STATUS_SUCCESS;
@@ -2133,6 +2255,27 @@ QuicSettingsGetGlobalSettings(
         *SettingsLength,
         InternalSettings);
 
+    SETTING_COPY_FROM_INTERNAL_SIZED(
+        AntiReplayWindowMs,
+        QUIC_GLOBAL_SETTINGS,
+        Settings,
+        *SettingsLength,
+        InternalSettings);
+
+    SETTING_COPY_FROM_INTERNAL_SIZED(
+        AntiReplayCapacity,
+        QUIC_GLOBAL_SETTINGS,
+        Settings,
+        *SettingsLength,
+        InternalSettings);
+
+    SETTING_COPY_FROM_INTERNAL_SIZED(
+        ObjectArenaEnabled,
+        QUIC_GLOBAL_SETTINGS,
+        Settings,
+        *SettingsLength,
+        InternalSettings);
+
     *SettingsLength = CXPLAT_MIN(*SettingsLength, sizeof(QUIC_GLOBAL_SETTINGS));
 
     return QUIC_STATUS_SUCCESS;
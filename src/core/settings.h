@@ -63,7 +63,11 @@ typedef struct QUIC_SETTINGS_INTERNAL {
             uint64_t NetStatsEventEnabled                   : 1;
             uint64_t StreamMultiReceiveEnabled              : 1;
             uint64_t QTIPEnabled                            : 1;
-            uint64_t RESERVED                               : 15;
+            uint64_t AntiReplayWindowMs                     : 1;
+            uint64_t AntiReplayCapacity                     : 1;
+            uint64_t ObjectArenaEnabled                     : 1;
+            uint64_t IdleHibernationTimeoutMs               : 1;
+            uint64_t RESERVED                               : 11;
         } IsSet;
     };
 
@@ -89,7 +93,10 @@ typedef struct QUIC_SETTINGS_INTERNAL {
     uint32_t DisconnectTimeoutMs;
     uint32_t KeepAliveIntervalMs;
     uint32_t DestCidUpdateIdleTimeoutMs;
+    uint32_t IdleHibernationTimeoutMs;
     uint32_t FixedServerID;                 // Global only
+    uint32_t AntiReplayWindowMs;            // Global only
+    uint32_t AntiReplayCapacity;            // Global only
     uint16_t PeerBidiStreamCount;
     uint16_t PeerUnidiStreamCount;
     uint16_t RetryMemoryLimit;              // Global only
@@ -115,6 +122,7 @@ typedef struct QUIC_SETTINGS_INTERNAL {
     uint8_t NetStatsEventEnabled            : 1;
     uint8_t StreamMultiReceiveEnabled       : 1;
     uint8_t QTIPEnabled                     : 1;
+    uint8_t ObjectArenaEnabled              : 1;    // Global only
     uint8_t MtuDiscoveryMissingProbeCount;
 } QUIC_SETTINGS_INTERNAL;
 
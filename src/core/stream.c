@@ -29,7 +29,10 @@ QuicStreamInitialize(
     QUIC_STREAM* Stream;
     QUIC_RECV_CHUNK* PreallocatedRecvChunk = NULL;
 
-    Stream = CxPlatPoolAlloc(&Connection->Partition->StreamPool);
+    Stream =
+        Connection->Partition->UseObjectArenas ?
+            QuicObjectArenaAlloc(&Connection->Partition->StreamArena) :
+            CxPlatPoolAlloc(&Connection->Partition->StreamPool);
     if (Stream == NULL) {
         Status = QUIC_STATUS_OUT_OF_MEMORY;
         goto Exit;
@@ -180,7 +183,11 @@ Exit:
         QuicPerfCounterDecrement(Connection->Partition, QUIC_PERF_COUNTER_STRM_ACTIVE);
         CxPlatDispatchLockUninitialize(&Stream->ApiSendRequestLock);
         Stream->Flags.Freed = TRUE;
-        CxPlatPoolFree(Stream);
+        if (Connection->Partition->UseObjectArenas) {
+            QuicObjectArenaFree(Stream);
+        } else {
+            CxPlatPoolFree(Stream);
+        }
     }
     if (PreallocatedRecvChunk) {
         CxPlatPoolFree(PreallocatedRecvChunk);
@@ -228,7 +235,11 @@ QuicStreamFree(
     }
 
     Stream->Flags.Freed = TRUE;
-    CxPlatPoolFree(Stream);
+    if (Connection->Partition->UseObjectArenas) {
+        QuicObjectArenaFree(Stream);
+    } else {
+        CxPlatPoolFree(Stream);
+    }
 
     if (WasStarted) {
 #pragma warning(push)
@@ -453,6 +464,58 @@ QuicStreamTraceRundown(
     // TODO - More state dump.
 }
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicStreamHibernate(
+    _In_ QUIC_STREAM* Stream
+    )
+{
+    if (QuicRecvBufferRelease(&Stream->RecvBuffer) &&
+        Stream->RecvBuffer.PreallocatedChunk != NULL) {
+        CxPlatPoolFree(Stream->RecvBuffer.PreallocatedChunk);
+        Stream->RecvBuffer.PreallocatedChunk = NULL;
+    }
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+QuicStreamRehydrate(
+    _In_ QUIC_STREAM* Stream
+    )
+{
+    if (!QuicRecvBufferIsReleased(&Stream->RecvBuffer)) {
+        return QUIC_STATUS_SUCCESS;
+    }
+
+    QUIC_CONNECTION* Connection = Stream->Connection;
+    const uint32_t InitialRecvBufferLength = Connection->Settings.StreamRecvBufferDefault;
+    QUIC_RECV_CHUNK* PreallocatedRecvChunk = NULL;
+
+    if (InitialRecvBufferLength == QUIC_DEFAULT_STREAM_RECV_BUFFER_SIZE) {
+        PreallocatedRecvChunk =
+            CxPlatPoolAlloc(&Connection->Partition->DefaultReceiveBufferPool);
+        if (PreallocatedRecvChunk == NULL) {
+            return QUIC_STATUS_OUT_OF_MEMORY;
+        }
+        QuicRecvChunkInitialize(
+            PreallocatedRecvChunk,
+            InitialRecvBufferLength,
+            (uint8_t *)(PreallocatedRecvChunk + 1),
+            FALSE);
+    }
+
+    QUIC_STATUS Status =
+        QuicRecvBufferRestore(
+            &Stream->RecvBuffer,
+            InitialRecvBufferLength,
+            PreallocatedRecvChunk);
+    if (QUIC_FAILED(Status) && PreallocatedRecvChunk != NULL) {
+        CxPlatPoolFree(PreallocatedRecvChunk);
+    }
+
+    return Status;
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 QUIC_STATUS
 QuicStreamIndicateEvent(
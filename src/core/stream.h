@@ -616,6 +616,25 @@ QuicStreamTraceRundown(
     _In_ QUIC_STREAM* Stream
     );
 
+//
+// Releases the stream's receive buffer memory while the connection is
+// hibernated and the buffer is empty.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicStreamHibernate(
+    _In_ QUIC_STREAM* Stream
+    );
+
+//
+// Restores the stream's receive buffer when the connection wakes up.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+QuicStreamRehydrate(
+    _In_ QUIC_STREAM* Stream
+    );
+
 //
 // Indicates an event to the application layer.
 //
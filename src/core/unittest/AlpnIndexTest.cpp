@@ -0,0 +1,213 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Unit test and benchmark for the binding's ALPN to listener index.
+
+--*/
+
+#include "main.h"
+#ifdef QUIC_CLOG
+#include "AlpnIndexTest.cpp.clog.h"
+#endif
+
+#define ALPN_INDEX_BENCH_LOOKUPS    200000
+
+//
+// A set of listeners, in the order a binding would keep them.
+//
+struct AlpnIndexListeners {
+    CXPLAT_LIST_ENTRY List;
+    std::vector<QUIC_LISTENER*> Listeners;
+    QUIC_ALPN_INDEX* Index {nullptr};
+    AlpnIndexListeners() {
+        CxPlatListInitializeHead(&List);
+    }
+    ~AlpnIndexListeners() {
+        QuicAlpnIndexFree(Index);
+        for (auto Listener : Listeners) {
+            delete [] Listener->AlpnList;
+            delete Listener;
+        }
+    }
+    QUIC_LISTENER* Add(const char* Address, std::initializer_list<const char*> Alpns) {
+        QUIC_LISTENER* Listener = new QUIC_LISTENER;
+        CxPlatZeroMemory(Listener, sizeof(*Listener));
+        Listener->RefCount = 1;
+        if (Address != nullptr) {
+            EXPECT_TRUE(QuicAddrFromString(Address, 0, &Listener->LocalAddress));
+            Listener->WildCard = QuicAddrIsWildCard(&Listener->LocalAddress);
+        } else {
+            Listener->WildCard = TRUE;
+        }
+        Listener->AlpnList = new uint8_t[256];
+        for (auto Alpn : Alpns) {
+            const uint8_t Length = (uint8_t)strlen(Alpn);
+            Listener->AlpnList[Listener->AlpnListLength] = Length;
+            memcpy(Listener->AlpnList + Listener->AlpnListLength + 1, Alpn, Length);
+            Listener->AlpnListLength += Length + 1;
+        }
+        CxPlatListInsertTail(&List, &Listener->Link);
+        Listeners.push_back(Listener);
+        return Listener;
+    }
+    void Build() {
+        QuicAlpnIndexFree(Index);
+        Index = QuicAlpnIndexCreate(&List);
+        ASSERT_NE(nullptr, Index);
+    }
+};
+
+static
+std::vector<uint8_t>
+EncodeAlpnList(
+    std::initializer_list<const char*> Alpns
+    )
+{
+    std::vector<uint8_t> List;
+    for (auto Alpn : Alpns) {
+        List.push_back((uint8_t)strlen(Alpn));
+        List.insert(List.end(), Alpn, Alpn + strlen(Alpn));
+    }
+    return List;
+}
+
+//
+// The listener and ALPN the binding would pick by walking the list.
+//
+static
+QUIC_LISTENER*
+LinearLookup(
+    _In_ const CXPLAT_LIST_ENTRY* List,
+    _In_ const QUIC_ADDR* LocalAddress,
+    _In_ QUIC_NEW_CONNECTION_INFO* Info
+    )
+{
+    for (const CXPLAT_LIST_ENTRY* Link = List->Flink; Link != List; Link = Link->Flink) {
+        QUIC_LISTENER* Listener = CXPLAT_CONTAINING_RECORD(Link, QUIC_LISTENER, Link);
+        if (QuicListenerMatchesLocalAddress(Listener, LocalAddress) &&
+            QuicListenerMatchesAlpn(Listener, Info)) {
+            return Listener;
+        }
+    }
+    return nullptr;
+}
+
+static
+QUIC_LISTENER*
+IndexLookup(
+    _In_ const AlpnIndexListeners& Listeners,
+    _In_z_ const char* LocalAddress,
+    _In_ const std::vector<uint8_t>& ClientAlpns,
+    _Out_ std::string* NegotiatedAlpn
+    )
+{
+    QUIC_ADDR Addr;
+    EXPECT_TRUE(QuicAddrFromString(LocalAddress, 0, &Addr));
+    const uint8_t* Alpn = nullptr;
+    QUIC_LISTENER* Listener =
+        QuicAlpnIndexLookup(
+            Listeners.Index, &Addr, (uint16_t)ClientAlpns.size(), ClientAlpns.data(), &Alpn);
+
+    QUIC_NEW_CONNECTION_INFO Info;
+    CxPlatZeroMemory(&Info, sizeof(Info));
+    Info.ClientAlpnList = ClientAlpns.data();
+    Info.ClientAlpnListLength = (uint16_t)ClientAlpns.size();
+    EXPECT_EQ(LinearLookup(&Listeners.List, &Addr, &Info), Listener);
+
+    NegotiatedAlpn->clear();
+    if (Listener != nullptr) {
+        NegotiatedAlpn->assign((const char*)Alpn + 1, Alpn[0]);
+        EXPECT_EQ(Info.NegotiatedAlpn, Alpn + 1);
+    }
+    return Listener;
+}
+
+TEST(AlpnIndexTest, Lookup)
+{
+    AlpnIndexListeners Listeners;
+    QUIC_LISTENER* Specific = Listeners.Add("10.0.0.1", {"h3", "h3-29"});
+    QUIC_LISTENER* WildCard = Listeners.Add("0.0.0.0", {"h3", "smb"});
+    QUIC_LISTENER* Unspec = Listeners.Add(nullptr, {"hq-interop", "h3"});
+    Listeners.Build();
+
+    std::string Alpn;
+    ASSERT_EQ(Specific, IndexLookup(Listeners, "10.0.0.1", EncodeAlpnList({"h3"}), &Alpn));
+    ASSERT_EQ("h3", Alpn);
+    ASSERT_EQ(WildCard, IndexLookup(Listeners, "10.0.0.2", EncodeAlpnList({"h3"}), &Alpn));
+    ASSERT_EQ("h3", Alpn);
+    ASSERT_EQ(Unspec, IndexLookup(Listeners, "::1", EncodeAlpnList({"h3"}), &Alpn));
+    ASSERT_EQ("h3", Alpn);
+
+    //
+    // The server's (listener's) preference order wins over the client's.
+    //
+    ASSERT_EQ(Specific, IndexLookup(Listeners, "10.0.0.1", EncodeAlpnList({"h3-29", "h3"}), &Alpn));
+    ASSERT_EQ("h3", Alpn);
+
+    //
+    // And the first listener in the list (specific addresses first) wins.
+    //
+    ASSERT_EQ(Specific, IndexLookup(Listeners, "10.0.0.1", EncodeAlpnList({"hq-interop", "h3"}), &Alpn));
+    ASSERT_EQ("h3", Alpn);
+    ASSERT_EQ(WildCard, IndexLookup(Listeners, "10.0.0.1", EncodeAlpnList({"smb"}), &Alpn));
+    ASSERT_EQ(Unspec, IndexLookup(Listeners, "10.0.0.1", EncodeAlpnList({"hq-interop"}), &Alpn));
+    ASSERT_EQ("hq-interop", Alpn);
+
+    ASSERT_EQ(nullptr, IndexLookup(Listeners, "10.0.0.1", EncodeAlpnList({"h2"}), &Alpn));
+    ASSERT_EQ(nullptr, IndexLookup(Listeners, "10.0.0.1", EncodeAlpnList({"h"}), &Alpn));
+    ASSERT_EQ(nullptr, IndexLookup(Listeners, "10.0.0.1", EncodeAlpnList({"h3-2"}), &Alpn));
+    ASSERT_EQ(nullptr, IndexLookup(Listeners, "::1", EncodeAlpnList({"smb"}), &Alpn));
+}
+
+//
+// Measures the cost of finding the listener for a new connection as the number
+// of ALPNs (one listener each) on the binding grows. The client offers the ALPN
+// of the last listener, which is the worst case for walking the list. Not run
+// by default (use --gtest_also_run_disabled_tests), since it asserts nothing.
+//
+TEST(AlpnIndexTest, DISABLED_BenchmarkDispatch)
+{
+    const uint32_t ListenerCounts[] = { 1, 4, 16, 64, 256 };
+    QUIC_ADDR Addr;
+    ASSERT_TRUE(QuicAddrFromString("10.0.0.1", 4433, &Addr));
+
+    for (auto Count : ListenerCounts) {
+        AlpnIndexListeners Listeners;
+        std::vector<std::string> Names;
+        for (uint32_t i = 0; i < Count; ++i) {
+            Names.push_back("alpn-protocol-" + std::to_string(i));
+            Listeners.Add("0.0.0.0", {Names.back().c_str()});
+        }
+        Listeners.Build();
+        auto ClientAlpns = EncodeAlpnList({"h3", Names.back().c_str()});
+
+        QUIC_NEW_CONNECTION_INFO Info;
+        CxPlatZeroMemory(&Info, sizeof(Info));
+        Info.ClientAlpnList = ClientAlpns.data();
+        Info.ClientAlpnListLength = (uint16_t)ClientAlpns.size();
+
+        uint64_t Start = CxPlatTimeUs64();
+        for (uint32_t i = 0; i < ALPN_INDEX_BENCH_LOOKUPS; ++i) {
+            ASSERT_EQ(Listeners.Listeners.back(), LinearLookup(&Listeners.List, &Addr, &Info));
+        }
+        const uint64_t LinearUs = CXPLAT_MAX(1, CxPlatTimeDiff64(Start, CxPlatTimeUs64()));
+
+        const uint8_t* Alpn;
+        Start = CxPlatTimeUs64();
+        for (uint32_t i = 0; i < ALPN_INDEX_BENCH_LOOKUPS; ++i) {
+            ASSERT_EQ(
+                Listeners.Listeners.back(),
+                QuicAlpnIndexLookup(
+                    Listeners.Index, &Addr, Info.ClientAlpnListLength, Info.ClientAlpnList, &Alpn));
+        }
+        const uint64_t IndexUs = CXPLAT_MAX(1, CxPlatTimeDiff64(Start, CxPlatTimeUs64()));
+
+        std::cout << Count << " ALPNs: list "
+            << (ALPN_INDEX_BENCH_LOOKUPS * 1000000ull) / LinearUs << " lookups/sec, index "
+            << (ALPN_INDEX_BENCH_LOOKUPS * 1000000ull) / IndexUs << " lookups/sec" << std::endl;
+    }
+}
@@ -0,0 +1,126 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Unit test for the 0-RTT anti-replay filter.
+
+--*/
+
+#include "main.h"
+#ifdef QUIC_CLOG
+#include "AntiReplayTest.cpp.clog.h"
+#endif
+
+struct AntiReplayFilterScope {
+    QUIC_ANTI_REPLAY_FILTER* Filter {nullptr};
+    AntiReplayFilterScope(uint32_t WindowMs, uint32_t Capacity) {
+        EXPECT_EQ(QUIC_STATUS_SUCCESS, QuicAntiReplayFilterInitialize(WindowMs, Capacity, &Filter));
+    }
+    ~AntiReplayFilterScope() {
+        if (Filter) {
+            QuicAntiReplayFilterUninitialize(Filter);
+        }
+    }
+    operator QUIC_ANTI_REPLAY_FILTER* () const { return Filter; }
+};
+
+TEST(AntiReplayTest, FreshAndReplay)
+{
+    AntiReplayFilterScope Filter(1000, 1024);
+    ASSERT_NE(nullptr, Filter.Filter);
+
+    ASSERT_TRUE(QuicAntiReplayFilterInsert(Filter, 0x0123456789abcdefull, 5000));
+    ASSERT_TRUE(QuicAntiReplayFilterInsert(Filter, 0xfedcba9876543210ull, 5000));
+    ASSERT_FALSE(QuicAntiReplayFilterInsert(Filter, 0x0123456789abcdefull, 5000));
+    ASSERT_FALSE(QuicAntiReplayFilterInsert(Filter, 0xfedcba9876543210ull, 5999));
+}
+
+TEST(AntiReplayTest, RememberedForOneWindow)
+{
+    AntiReplayFilterScope Filter(1000, 1024);
+    ASSERT_NE(nullptr, Filter.Filter);
+
+    const uint64_t Nonce = 0x1111222233334444ull;
+    ASSERT_TRUE(QuicAntiReplayFilterInsert(Filter, Nonce, 5999));
+
+    //
+    // Rotating into the next generation must not forget the nonce.
+    //
+    ASSERT_FALSE(QuicAntiReplayFilterInsert(Filter, Nonce, 6000));
+    ASSERT_FALSE(QuicAntiReplayFilterInsert(Filter, Nonce, 6999));
+}
+
+TEST(AntiReplayTest, ForgottenAfterTwoWindows)
+{
+    AntiReplayFilterScope Filter(1000, 1024);
+    ASSERT_NE(nullptr, Filter.Filter);
+
+    const uint64_t Nonce = 0x5555666677778888ull;
+    ASSERT_TRUE(QuicAntiReplayFilterInsert(Filter, Nonce, 5000));
+    ASSERT_TRUE(QuicAntiReplayFilterInsert(Filter, Nonce, 7000));
+
+    //
+    // Long idle periods clear both generations.
+    //
+    ASSERT_TRUE(QuicAntiReplayFilterInsert(Filter, Nonce, 100000));
+}
+
+TEST(AntiReplayTest, ClockGoesBackwards)
+{
+    AntiReplayFilterScope Filter(1000, 1024);
+    ASSERT_NE(nullptr, Filter.Filter);
+
+    const uint64_t Nonce = 0x9999aaaabbbbccccull;
+    ASSERT_TRUE(QuicAntiReplayFilterInsert(Filter, Nonce, 9000));
+    ASSERT_FALSE(QuicAntiReplayFilterInsert(Filter, Nonce, 1000));
+}
+
+TEST(AntiReplayTest, FalsePositiveRate)
+{
+    const uint32_t Capacity = 4096;
+    AntiReplayFilterScope Filter(1000, Capacity);
+    ASSERT_NE(nullptr, Filter.Filter);
+
+    uint32_t Rejected = 0;
+    for (uint32_t i = 0; i < Capacity; ++i) {
+        uint64_t Nonce;
+        CxPlatRandom(sizeof(Nonce), &Nonce);
+        if (!QuicAntiReplayFilterInsert(Filter, Nonce, 1000)) {
+            ++Rejected;
+        }
+    }
+
+    //
+    // Expected rate is about 0.1%; allow plenty of slack.
+    //
+    ASSERT_LE(Rejected, Capacity / 100);
+}
+
+TEST(AntiReplayTest, ShardIndexUsesWholeNonce)
+{
+    //
+    // Nonces that share their low 32 bits (the filter's first probe) must
+    // still spread over every shard, as must nonces that share their high
+    // 32 bits.
+    //
+    const uint32_t ShardCount = 4;
+    uint32_t SeenLow[ShardCount] = {0};
+    uint32_t SeenHigh[ShardCount] = {0};
+    for (uint64_t i = 0; i < 256; ++i) {
+        const uint32_t IndexLow =
+            QuicAntiReplayShardIndex((i << 32) | 0x12345678ull, ShardCount);
+        const uint32_t IndexHigh =
+            QuicAntiReplayShardIndex(0x12345678ull << 32 | i, ShardCount);
+        ASSERT_LT(IndexLow, ShardCount);
+        ASSERT_LT(IndexHigh, ShardCount);
+        SeenLow[IndexLow]++;
+        SeenHigh[IndexHigh]++;
+    }
+    for (uint32_t i = 0; i < ShardCount; ++i) {
+        ASSERT_NE(0u, SeenLow[i]);
+        ASSERT_NE(0u, SeenHigh[i]);
+    }
+}
@@ -0,0 +1,127 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Unit test for the listener's graded admission control.
+
+--*/
+
+#include "main.h"
+#ifdef QUIC_CLOG
+#include "ListenerAdmissionTest.cpp.clog.h"
+#endif
+
+//
+// A listener on a registration with a single worker, and the admission level
+// events indicated on it.
+//
+struct AdmissionListener {
+    QUIC_LISTENER Listener;
+    QUIC_REGISTRATION Registration;
+    QUIC_WORKER_POOL* WorkerPool;
+    std::vector<QUIC_LISTENER_ADMISSION_LEVEL> Events;
+    AdmissionListener(uint32_t QueueDelayTargetUs, uint32_t HandshakeBacklogTarget) {
+        CxPlatZeroMemory(&Listener, sizeof(Listener));
+        CxPlatZeroMemory(&Registration, sizeof(Registration));
+        WorkerPool = (QUIC_WORKER_POOL*)new uint8_t[sizeof(QUIC_WORKER_POOL) + sizeof(QUIC_WORKER)];
+        CxPlatZeroMemory(WorkerPool, sizeof(QUIC_WORKER_POOL) + sizeof(QUIC_WORKER));
+        WorkerPool->WorkerCount = 1;
+        Registration.WorkerPool = WorkerPool;
+        Registration.NoPartitioning = TRUE;
+        Listener.Registration = &Registration;
+        Listener.ClientCallbackHandler = ListenerCallback;
+        Listener._.ClientContext = this;
+        Listener.AdmissionControl.QueueDelayTargetUs = QueueDelayTargetUs;
+        Listener.AdmissionControl.HandshakeBacklogTarget = HandshakeBacklogTarget;
+    }
+    ~AdmissionListener() {
+        MsQuicLib.CurrentHandshakeMemoryUsage = 0;
+        delete [] (uint8_t*)WorkerPool;
+    }
+    QUIC_LISTENER_ADMISSION_LEVEL Update(uint32_t QueueDelayUs, uint32_t HandshakeBacklog = 0) {
+        WorkerPool->Workers[0].AverageQueueDelay = QueueDelayUs;
+        MsQuicLib.CurrentHandshakeMemoryUsage =
+            (uint64_t)HandshakeBacklog * QUIC_CONN_HANDSHAKE_MEMORY_USAGE;
+        return QuicListenerAdmissionLevel(QuicListenerUpdateAdmission(&Listener, 0));
+    }
+    static
+    _IRQL_requires_max_(DISPATCH_LEVEL)
+    _Function_class_(QUIC_LISTENER_CALLBACK)
+    QUIC_STATUS
+    QUIC_API
+    ListenerCallback(
+        _In_ HQUIC /* Listener */,
+        _In_opt_ void* Context,
+        _Inout_ QUIC_LISTENER_EVENT* Event
+        )
+    {
+        EXPECT_EQ(QUIC_LISTENER_EVENT_ADMISSION_LEVEL_CHANGED, Event->Type);
+        ((AdmissionListener*)Context)->Events.push_back(Event->ADMISSION_LEVEL_CHANGED.Level);
+        return QUIC_STATUS_SUCCESS;
+    }
+};
+
+TEST(ListenerAdmissionTest, Pressure)
+{
+    QUIC_LISTENER_ADMISSION_CONTROL Control = { 1000, 0 };
+    ASSERT_EQ(0u, QuicListenerAdmissionPressure(&Control, 0, 1000000));
+    ASSERT_EQ(50u, QuicListenerAdmissionPressure(&Control, 500, 1000000));
+    ASSERT_EQ(250u, QuicListenerAdmissionPressure(&Control, 2500, 0));
+
+    Control = { 0, 100 };
+    ASSERT_EQ(0u, QuicListenerAdmissionPressure(&Control, UINT32_MAX, 0));
+    ASSERT_EQ(150u, QuicListenerAdmissionPressure(&Control, UINT32_MAX, 150));
+
+    //
+    // The larger of the two signals wins.
+    //
+    Control = { 1000, 100 };
+    ASSERT_EQ(300u, QuicListenerAdmissionPressure(&Control, 3000, 150));
+    ASSERT_EQ(150u, QuicListenerAdmissionPressure(&Control, 500, 150));
+
+    Control = { 1, 0 };
+    ASSERT_EQ(UINT32_MAX, QuicListenerAdmissionPressure(&Control, UINT32_MAX, 0));
+}
+
+TEST(ListenerAdmissionTest, Levels)
+{
+    ASSERT_EQ(QUIC_LISTENER_ADMISSION_LEVEL_NORMAL, QuicListenerAdmissionLevel(0));
+    ASSERT_EQ(QUIC_LISTENER_ADMISSION_LEVEL_NORMAL, QuicListenerAdmissionLevel(QUIC_ADMISSION_RETRY_PRESSURE - 1));
+    ASSERT_EQ(QUIC_LISTENER_ADMISSION_LEVEL_RETRY, QuicListenerAdmissionLevel(QUIC_ADMISSION_RETRY_PRESSURE));
+    ASSERT_EQ(QUIC_LISTENER_ADMISSION_LEVEL_SHED, QuicListenerAdmissionLevel(QUIC_ADMISSION_SHED_PRESSURE));
+    ASSERT_EQ(QUIC_LISTENER_ADMISSION_LEVEL_SHED, QuicListenerAdmissionLevel(QUIC_ADMISSION_REJECT_PRESSURE - 1));
+    ASSERT_EQ(QUIC_LISTENER_ADMISSION_LEVEL_REJECT, QuicListenerAdmissionLevel(QUIC_ADMISSION_REJECT_PRESSURE));
+    ASSERT_EQ(QUIC_LISTENER_ADMISSION_LEVEL_REJECT, QuicListenerAdmissionLevel(UINT32_MAX));
+}
+
+TEST(ListenerAdmissionTest, Events)
+{
+    AdmissionListener Listener(1000, 100);
+
+    ASSERT_EQ(QUIC_LISTENER_ADMISSION_LEVEL_NORMAL, Listener.Update(500, 10));
+    ASSERT_TRUE(Listener.Events.empty());
+
+    //
+    // The level ramps up with the load and an event is indicated only when it
+    // changes.
+    //
+    ASSERT_EQ(QUIC_LISTENER_ADMISSION_LEVEL_RETRY, Listener.Update(1000));
+    ASSERT_EQ(QUIC_LISTENER_ADMISSION_LEVEL_RETRY, Listener.Update(1500));
+    ASSERT_EQ(QUIC_LISTENER_ADMISSION_LEVEL_SHED, Listener.Update(0, 300));
+    ASSERT_EQ(QUIC_LISTENER_ADMISSION_LEVEL_REJECT, Listener.Update(4000, 300));
+    ASSERT_EQ(QUIC_LISTENER_ADMISSION_LEVEL_NORMAL, Listener.Update(100, 1));
+
+    const QUIC_LISTENER_ADMISSION_LEVEL Expected[] = {
+        QUIC_LISTENER_ADMISSION_LEVEL_RETRY,
+        QUIC_LISTENER_ADMISSION_LEVEL_SHED,
+        QUIC_LISTENER_ADMISSION_LEVEL_REJECT,
+        QUIC_LISTENER_ADMISSION_LEVEL_NORMAL,
+    };
+    ASSERT_EQ(ARRAYSIZE(Expected), Listener.Events.size());
+    for (size_t i = 0; i < ARRAYSIZE(Expected); ++i) {
+        ASSERT_EQ(Expected[i], Listener.Events[i]);
+    }
+}
@@ -0,0 +1,249 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Unit test and benchmark for the large page object arena.
+
+--*/
+
+#include "main.h"
+#ifdef QUIC_CLOG
+#include "ObjectArenaTest.cpp.clog.h"
+#endif
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#define ARENA_TEST_OBJECT_COUNT     16384
+#define ARENA_TEST_WALK_PASSES      32
+
+struct ObjectArenaScope {
+    QUIC_OBJECT_ARENA Arena;
+    ObjectArenaScope(uint32_t ObjectSize) {
+        QuicObjectArenaInitialize(&Arena, ObjectSize, 0, QUIC_POOL_TEST);
+    }
+    ~ObjectArenaScope() {
+        QuicObjectArenaUninitialize(&Arena);
+    }
+    operator QUIC_OBJECT_ARENA* () { return &Arena; }
+};
+
+//
+// Counts data TLB misses of the calling thread, where the hardware and the OS
+// allow it.
+//
+struct TlbMissCounter {
+#if defined(__linux__)
+    int Fd {-1};
+    TlbMissCounter() {
+        struct perf_event_attr Attr;
+        CxPlatZeroMemory(&Attr, sizeof(Attr));
+        Attr.type = PERF_TYPE_HW_CACHE;
+        Attr.size = sizeof(Attr);
+        Attr.config =
+            PERF_COUNT_HW_CACHE_DTLB |
+            (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+            (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        Attr.disabled = 1;
+        Attr.exclude_kernel = 1;
+        Attr.exclude_hv = 1;
+        Fd = (int)syscall(SYS_perf_event_open, &Attr, 0, -1, -1, 0);
+    }
+    ~TlbMissCounter() {
+        if (Fd >= 0) {
+            close(Fd);
+        }
+    }
+    bool Available() const { return Fd >= 0; }
+    void Start() {
+        if (Fd >= 0) {
+            ioctl(Fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(Fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+    uint64_t Stop() {
+        uint64_t Count = 0;
+        if (Fd >= 0) {
+            ioctl(Fd, PERF_EVENT_IOC_DISABLE, 0);
+            if (read(Fd, &Count, sizeof(Count)) != sizeof(Count)) {
+                Count = 0;
+            }
+        }
+        return Count;
+    }
+#else
+    bool Available() const { return false; }
+    void Start() { }
+    uint64_t Stop() { return 0; }
+#endif
+};
+
+//
+// Touches the first cache line of every object, in the given order, as a
+// worker does when it goes over its connections.
+//
+static
+uint64_t
+WalkObjects(
+    _In_reads_(Count) void** Objects,
+    _In_reads_(Count) const uint32_t* Order,
+    _In_ uint32_t Count
+    )
+{
+    uint64_t Sum = 0;
+    for (uint32_t Pass = 0; Pass < ARENA_TEST_WALK_PASSES; ++Pass) {
+        for (uint32_t i = 0; i < Count; ++i) {
+            volatile uint64_t* Object = (volatile uint64_t*)Objects[Order[i]];
+            Sum += *Object;
+            *Object = Sum;
+        }
+    }
+    return Sum;
+}
+
+static
+void
+PrintWalk(
+    _In_z_ const char* Name,
+    _In_ uint64_t ElapsedUs,
+    _In_ const TlbMissCounter& Counter,
+    _In_ uint64_t TlbMisses
+    )
+{
+    std::cout << Name << ": " << ElapsedUs << " us";
+    if (Counter.Available()) {
+        std::cout << ", " << TlbMisses << " dTLB misses";
+    }
+    std::cout << std::endl;
+}
+
+TEST(ObjectArenaTest, AllocFree)
+{
+    ObjectArenaScope Arena(sizeof(QUIC_STREAM));
+    const uint32_t Count = 4 * (QUIC_OBJECT_ARENA_REGION_SIZE / Arena.Arena.Stride);
+    void** Objects = new void*[Count];
+    for (uint32_t i = 0; i < Count; ++i) {
+        Objects[i] = QuicObjectArenaAlloc(Arena);
+        ASSERT_NE(nullptr, Objects[i]);
+        ASSERT_EQ(0u, (size_t)Objects[i] % QUIC_OBJECT_ARENA_ALIGNMENT);
+        memset(Objects[i], (uint8_t)i, sizeof(QUIC_STREAM));
+    }
+    for (uint32_t i = 0; i < Count; ++i) {
+        ASSERT_EQ((uint8_t)i, ((uint8_t*)Objects[i])[sizeof(QUIC_STREAM) - 1]);
+    }
+    const uint32_t RegionCount = Arena.Arena.RegionCount;
+    ASSERT_GE(RegionCount, 4u);
+    ASSERT_LE(RegionCount, 5u);
+
+    for (uint32_t i = 0; i < Count; ++i) {
+        QuicObjectArenaFree(Objects[i]);
+    }
+
+    //
+    // Freed objects are reused before the arena grows again.
+    //
+    void* Object = QuicObjectArenaAlloc(Arena);
+    ASSERT_EQ(Objects[Count - 1], Object);
+    QuicObjectArenaFree(Object);
+    for (uint32_t i = 0; i < Count; ++i) {
+        Objects[i] = QuicObjectArenaAlloc(Arena);
+        ASSERT_NE(nullptr, Objects[i]);
+    }
+    ASSERT_EQ(RegionCount, Arena.Arena.RegionCount);
+    for (uint32_t i = 0; i < Count; ++i) {
+        QuicObjectArenaFree(Objects[i]);
+    }
+    delete [] Objects;
+}
+
+//
+// Compares walking many connection sized objects from the arena against the
+// same objects from a regular pool, with other allocations of varying size
+// interleaved (as the rest of a connection's state would be). Only prints its
+// results, so it's disabled; run it with --gtest_also_run_disabled_tests.
+//
+TEST(ObjectArenaTest, DISABLED_BenchmarkWalk)
+{
+    const uint32_t Count = ARENA_TEST_OBJECT_COUNT;
+    const uint32_t ObjectSize = sizeof(QUIC_CONNECTION);
+    void** Objects = new void*[Count];
+    void** Others = new void*[Count];
+    uint32_t* Order = new uint32_t[Count];
+    uint16_t* OtherSizes = new uint16_t[Count];
+    for (uint32_t i = 0; i < Count; ++i) {
+        Order[i] = i;
+        CxPlatRandom(sizeof(OtherSizes[i]), &OtherSizes[i]);
+        OtherSizes[i] = 64 + (OtherSizes[i] % 4096);
+    }
+    for (uint32_t i = Count - 1; i > 0; --i) {
+        uint32_t j;
+        CxPlatRandom(sizeof(j), &j);
+        j %= i + 1;
+        const uint32_t Temp = Order[i];
+        Order[i] = Order[j];
+        Order[j] = Temp;
+    }
+
+    TlbMissCounter Counter;
+    uint64_t Start, Elapsed, TlbMisses;
+
+    {
+        CXPLAT_POOL Pool;
+        CxPlatPoolInitialize(FALSE, ObjectSize, QUIC_POOL_TEST, &Pool);
+        for (uint32_t i = 0; i < Count; ++i) {
+            Objects[i] = CxPlatPoolAlloc(&Pool);
+            Others[i] = CXPLAT_ALLOC_NONPAGED(OtherSizes[i], QUIC_POOL_TEST);
+            ASSERT_NE(nullptr, Objects[i]);
+            ASSERT_NE(nullptr, Others[i]);
+            CxPlatZeroMemory(Objects[i], ObjectSize);
+            CxPlatZeroMemory(Others[i], OtherSizes[i]);
+        }
+        Counter.Start();
+        Start = CxPlatTimeUs64();
+        WalkObjects(Objects, Order, Count);
+        Elapsed = CxPlatTimeDiff64(Start, CxPlatTimeUs64());
+        TlbMisses = Counter.Stop();
+        PrintWalk("Pool", Elapsed, Counter, TlbMisses);
+        for (uint32_t i = 0; i < Count; ++i) {
+            CxPlatPoolFree(Objects[i]);
+            CXPLAT_FREE(Others[i], QUIC_POOL_TEST);
+        }
+        CxPlatPoolUninitialize(&Pool);
+    }
+
+    {
+        ObjectArenaScope Arena(ObjectSize);
+        for (uint32_t i = 0; i < Count; ++i) {
+            Objects[i] = QuicObjectArenaAlloc(Arena);
+            Others[i] = CXPLAT_ALLOC_NONPAGED(OtherSizes[i], QUIC_POOL_TEST);
+            ASSERT_NE(nullptr, Objects[i]);
+            ASSERT_NE(nullptr, Others[i]);
+            CxPlatZeroMemory(Objects[i], ObjectSize);
+            CxPlatZeroMemory(Others[i], OtherSizes[i]);
+        }
+        Counter.Start();
+        Start = CxPlatTimeUs64();
+        WalkObjects(Objects, Order, Count);
+        Elapsed = CxPlatTimeDiff64(Start, CxPlatTimeUs64());
+        TlbMisses = Counter.Stop();
+        PrintWalk("Arena", Elapsed, Counter, TlbMisses);
+        std::cout << "Arena regions: " << Arena.Arena.RegionCount
+            << " (" << Arena.Arena.LargePageRegionCount << " large page)" << std::endl;
+        for (uint32_t i = 0; i < Count; ++i) {
+            QuicObjectArenaFree(Objects[i]);
+            CXPLAT_FREE(Others[i], QUIC_POOL_TEST);
+        }
+    }
+
+    delete [] OtherSizes;
+    delete [] Order;
+    delete [] Others;
+    delete [] Objects;
+}
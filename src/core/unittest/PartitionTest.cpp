@@ -5,7 +5,8 @@
 
 Abstract:
 
-    Unit test for the partition ID and index logic.
+    Unit test for the partition ID and index logic, the per partition Initial
+    packet rate limiting, and the per partition stateless operation limits.
 
 --*/
 
@@ -44,3 +45,167 @@ TEST(PartitionTest, RandomPartitionId)
         }
     }
 }
+
+TEST(PartitionTest, InitialFilterRateLimit)
+{
+    QUIC_PARTITION* Partition = new QUIC_PARTITION;
+    CxPlatZeroMemory(Partition, sizeof(*Partition));
+
+    QUIC_ADDR Addr, SamePrefix, OtherPrefix, Addr6, SamePrefix6;
+    ASSERT_TRUE(QuicAddrFromString("10.1.2.3:4433", 0, &Addr));
+    ASSERT_TRUE(QuicAddrFromString("10.1.2.200:50000", 0, &SamePrefix));
+    ASSERT_TRUE(QuicAddrFromString("10.1.3.3:4433", 0, &OtherPrefix));
+    ASSERT_TRUE(QuicAddrFromString("[2001:db8:1::1]:4433", 0, &Addr6));
+    ASSERT_TRUE(QuicAddrFromString("[2001:db8:1:ffff::2]:4433", 0, &SamePrefix6));
+
+    //
+    // A new prefix gets the full burst, and then nothing more until time
+    // passes. The whole prefix shares the same budget.
+    //
+    uint32_t TimeMs = 1000000;
+    for (uint32_t i = 0; i < QUIC_INITIAL_FILTER_PREFIX_BURST; ++i) {
+        ASSERT_TRUE(QuicPartitionInitialFilterAllow(Partition, &Addr, TimeMs));
+    }
+    ASSERT_FALSE(QuicPartitionInitialFilterAllow(Partition, &Addr, TimeMs));
+    ASSERT_FALSE(QuicPartitionInitialFilterAllow(Partition, &SamePrefix, TimeMs));
+    ASSERT_TRUE(QuicPartitionInitialFilterAllow(Partition, &OtherPrefix, TimeMs));
+
+    //
+    // Tokens come back at the configured rate.
+    //
+    TimeMs += 10;
+    const uint32_t Refill = (10 * QUIC_INITIAL_FILTER_PREFIX_RATE) / 1000;
+    for (uint32_t i = 0; i < Refill; ++i) {
+        ASSERT_TRUE(QuicPartitionInitialFilterAllow(Partition, &SamePrefix, TimeMs));
+    }
+    ASSERT_FALSE(QuicPartitionInitialFilterAllow(Partition, &Addr, TimeMs));
+
+    for (uint32_t i = 0; i < QUIC_INITIAL_FILTER_PREFIX_BURST; ++i) {
+        ASSERT_TRUE(QuicPartitionInitialFilterAllow(Partition, &Addr6, TimeMs));
+    }
+    ASSERT_FALSE(QuicPartitionInitialFilterAllow(Partition, &SamePrefix6, TimeMs));
+
+    delete Partition;
+}
+
+#define STATELESS_TEST_PARTITION_COUNT  64
+
+//
+// Floods one partition's shard of a binding's stateless operation table, and
+// checks that it neither takes more than its share of the binding wide limit
+// nor keeps the other partitions from creating their own operations.
+//
+TEST(PartitionTest, StatelessOperationShardIsolation)
+{
+    const uint16_t ShardCount = STATELESS_TEST_PARTITION_COUNT;
+    const uint16_t SavedMaxOperations = MsQuicLib.Settings.MaxBindingStatelessOperations;
+    const uint16_t SavedExpirationMs = MsQuicLib.Settings.StatelessOperationExpirationMs;
+    MsQuicLib.Settings.MaxBindingStatelessOperations = QUIC_MAX_BINDING_STATELESS_OPERATIONS;
+    MsQuicLib.Settings.StatelessOperationExpirationMs = 60 * 1000; // Nothing ages out
+
+    uint8_t ResetHashKey[20] = {0};
+    QUIC_PARTITION* Partitions = new QUIC_PARTITION[ShardCount];
+    for (uint16_t i = 0; i < ShardCount; ++i) {
+        CxPlatZeroMemory(&Partitions[i], sizeof(Partitions[i]));
+        ASSERT_EQ(
+            QUIC_STATUS_SUCCESS,
+            QuicPartitionInitialize(
+                &Partitions[i], i, 0, CXPLAT_HASH_SHA256, ResetHashKey, sizeof(ResetHashKey), FALSE));
+    }
+    MsQuicLib.Partitions = Partitions;
+    MsQuicLib.PartitionCount = ShardCount;
+
+    const size_t BindingSize =
+        sizeof(QUIC_BINDING) + ShardCount * sizeof(QUIC_STATELESS_OPER_SHARD);
+    QUIC_BINDING* Binding = (QUIC_BINDING*)CXPLAT_ALLOC_NONPAGED(BindingSize, QUIC_POOL_TEST);
+    ASSERT_NE(nullptr, Binding);
+    CxPlatZeroMemory(Binding, BindingSize);
+    Binding->RefCount = 1;
+    Binding->StatelessOperShardCount = ShardCount;
+    for (uint16_t i = 0; i < ShardCount; ++i) {
+        QUIC_STATELESS_OPER_SHARD* Shard = &Binding->StatelessOperShards[i];
+        ASSERT_TRUE(CxPlatHashtableInitializeEx(&Shard->Table, CXPLAT_HASH_MIN_SIZE));
+        CxPlatDispatchLockInitialize(&Shard->Lock);
+        CxPlatListInitializeHead(&Shard->List);
+    }
+
+    QUIC_WORKER* Worker = new QUIC_WORKER;
+    CxPlatZeroMemory(Worker, sizeof(*Worker));
+    QUIC_RX_PACKET Packet;
+    CXPLAT_ROUTE Route;
+    CxPlatZeroMemory(&Packet, sizeof(Packet));
+    CxPlatZeroMemory(&Route, sizeof(Route));
+    Packet._.Route = &Route;
+    ASSERT_TRUE(QuicAddrFromString("10.0.0.1:1000", 0, &Route.RemoteAddress));
+
+    //
+    // The shards add up to exactly the binding wide limit.
+    //
+    uint32_t TotalMax = 0;
+    for (uint16_t i = 0; i < ShardCount; ++i) {
+        const uint32_t ShardMax = QuicBindingGetMaxStatelessOperationsPerShard(Binding, i);
+        ASSERT_GE(ShardMax, 1u);
+        TotalMax += ShardMax;
+    }
+    ASSERT_EQ((uint32_t)QUIC_MAX_BINDING_STATELESS_OPERATIONS, TotalMax);
+
+    //
+    // Flood partition 0 from many source ports. Only its share gets through.
+    //
+    Worker->Partition = &Partitions[0];
+    Packet._.PartitionIndex = 0;
+    uint32_t Accepted = 0;
+    for (uint16_t Port = 1; Port <= 4 * QUIC_MAX_BINDING_STATELESS_OPERATIONS; ++Port) {
+        QuicAddrSetPort(&Route.RemoteAddress, Port);
+        if (QuicBindingCreateStatelessOperation(Binding, Worker, &Packet) != NULL) {
+            Accepted++;
+        }
+    }
+    ASSERT_EQ(QuicBindingGetMaxStatelessOperationsPerShard(Binding, 0), Accepted);
+    ASSERT_EQ(Accepted, Binding->StatelessOperShards[0].Count);
+
+    //
+    // Every other partition can still fill its own share, and the binding as a
+    // whole never goes over the limit.
+    //
+    uint32_t Total = Accepted;
+    for (uint16_t i = 1; i < ShardCount; ++i) {
+        Worker->Partition = &Partitions[i];
+        Packet._.PartitionIndex = i;
+        const uint32_t ShardMax = QuicBindingGetMaxStatelessOperationsPerShard(Binding, i);
+        for (uint32_t j = 0; j < ShardMax; ++j) {
+            QuicAddrSetPort(&Route.RemoteAddress, (uint16_t)(10000 + i * 16 + j));
+            ASSERT_NE(nullptr, QuicBindingCreateStatelessOperation(Binding, Worker, &Packet));
+            Total++;
+        }
+        QuicAddrSetPort(&Route.RemoteAddress, (uint16_t)(20000 + i));
+        ASSERT_EQ(nullptr, QuicBindingCreateStatelessOperation(Binding, Worker, &Packet));
+    }
+    ASSERT_EQ((uint32_t)QUIC_MAX_BINDING_STATELESS_OPERATIONS, Total);
+
+    for (uint16_t i = 0; i < ShardCount; ++i) {
+        QUIC_STATELESS_OPER_SHARD* Shard = &Binding->StatelessOperShards[i];
+        while (!CxPlatListIsEmpty(&Shard->List)) {
+            QUIC_STATELESS_CONTEXT* StatelessCtx =
+                CXPLAT_CONTAINING_RECORD(
+                    CxPlatListRemoveHead(&Shard->List),
+                    QUIC_STATELESS_CONTEXT,
+                    ListEntry);
+            CxPlatHashtableRemove(&Shard->Table, &StatelessCtx->TableEntry, NULL);
+            CxPlatPoolFree(StatelessCtx);
+        }
+        CxPlatHashtableUninitialize(&Shard->Table);
+        CxPlatDispatchLockUninitialize(&Shard->Lock);
+    }
+    CXPLAT_FREE(Binding, QUIC_POOL_TEST);
+    delete Worker;
+
+    for (uint16_t i = 0; i < ShardCount; ++i) {
+        QuicPartitionUninitialize(&Partitions[i]);
+    }
+    delete [] Partitions;
+    MsQuicLib.Partitions = nullptr;
+    MsQuicLib.PartitionCount = 0;
+    MsQuicLib.Settings.MaxBindingStatelessOperations = SavedMaxOperations;
+    MsQuicLib.Settings.StatelessOperationExpirationMs = SavedExpirationMs;
+}
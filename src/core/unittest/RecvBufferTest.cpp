@@ -2029,6 +2029,53 @@ TEST(AppOwnedBuffersTest, FreeBufferBeforeDrain)
     RecvBuf.Drain(8);
 }
 
+TEST_P(WithMode, ReleaseAndRestore)
+{
+    RecvBuffer RecvBuf;
+    auto Mode = GetParam();
+    ASSERT_EQ(QUIC_STATUS_SUCCESS, RecvBuf.Initialize(Mode));
+    uint64_t InOutWriteLength = DEF_TEST_BUFFER_LENGTH;
+    BOOLEAN NewDataReady = FALSE;
+    ASSERT_EQ(QUIC_STATUS_SUCCESS, RecvBuf.Write(0, 30, &InOutWriteLength, &NewDataReady));
+    ASSERT_FALSE(QuicRecvBufferRelease(&RecvBuf.RecvBuf)); // Holds unread data
+
+    uint64_t ReadOffset;
+    QUIC_BUFFER ReadBuffers[3];
+    uint32_t BufferCount = ARRAYSIZE(ReadBuffers);
+    RecvBuf.Read(&ReadOffset, &BufferCount, ReadBuffers);
+    ASSERT_FALSE(QuicRecvBufferRelease(&RecvBuf.RecvBuf)); // Read still pending
+    ASSERT_TRUE(RecvBuf.Drain(30));
+
+    if (Mode == QUIC_RECV_BUF_MODE_APP_OWNED) {
+        ASSERT_FALSE(QuicRecvBufferRelease(&RecvBuf.RecvBuf)); // Memory belongs to the app
+        return;
+    }
+
+    ASSERT_TRUE(QuicRecvBufferRelease(&RecvBuf.RecvBuf));
+    ASSERT_TRUE(QuicRecvBufferIsReleased(&RecvBuf.RecvBuf));
+    ASSERT_EQ(0u, QuicRecvBufferGetAllocatedSize(&RecvBuf.RecvBuf));
+
+    ASSERT_EQ(
+        QUIC_STATUS_SUCCESS,
+        QuicRecvBufferRestore(&RecvBuf.RecvBuf, DEF_TEST_BUFFER_LENGTH, nullptr));
+    ASSERT_FALSE(QuicRecvBufferIsReleased(&RecvBuf.RecvBuf));
+    ASSERT_EQ(
+        sizeof(QUIC_RECV_CHUNK) + DEF_TEST_BUFFER_LENGTH,
+        QuicRecvBufferGetAllocatedSize(&RecvBuf.RecvBuf));
+
+    //
+    // The buffer picks up where it left off.
+    //
+    ASSERT_EQ(QUIC_STATUS_SUCCESS, RecvBuf.Write(30, 20, &InOutWriteLength, &NewDataReady));
+    ASSERT_TRUE(NewDataReady);
+    BufferCount = ARRAYSIZE(ReadBuffers);
+    RecvBuf.Read(&ReadOffset, &BufferCount, ReadBuffers);
+    ASSERT_EQ(30ull, ReadOffset);
+    ASSERT_EQ(1ul, BufferCount);
+    ASSERT_EQ(20u, ReadBuffers[0].Length);
+    ASSERT_TRUE(RecvBuf.Drain(20));
+}
+
 INSTANTIATE_TEST_SUITE_P(
     RecvBufferTest,
     WithMode,
@@ -0,0 +1,169 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Unit test for the client resumption ticket cache.
+
+--*/
+
+#include "main.h"
+#ifdef QUIC_CLOG
+#include "ResumptionCacheTest.cpp.clog.h"
+#endif
+
+struct ResumptionCacheScope {
+    QUIC_RESUMPTION_CACHE* Cache {nullptr};
+    uint16_t PrevPartitionCount;
+    ResumptionCacheScope(uint32_t MaxEntryCount, uint32_t EntryTimeoutMs, uint16_t PartitionCount = 1)
+        : PrevPartitionCount(MsQuicLib.PartitionCount) {
+        MsQuicLib.PartitionCount = PartitionCount;
+        EXPECT_EQ(QUIC_STATUS_SUCCESS, QuicResumptionCacheInitialize(MaxEntryCount, EntryTimeoutMs, &Cache));
+    }
+    ~ResumptionCacheScope() {
+        if (Cache) {
+            QuicResumptionCacheUninitialize(Cache);
+        }
+        MsQuicLib.PartitionCount = PrevPartitionCount;
+    }
+    operator QUIC_RESUMPTION_CACHE* () const { return Cache; }
+};
+
+static const uint8_t TestAlpn[] = { 2, 'h', '3' };
+
+static
+void
+InsertTicket(
+    _In_ QUIC_RESUMPTION_CACHE* Cache,
+    _In_z_ const char* ServerName,
+    _In_ uint8_t TicketByte,
+    _In_ uint64_t TimeNow
+    )
+{
+    uint8_t Ticket[32];
+    memset(Ticket, TicketByte, sizeof(Ticket));
+    QuicResumptionCacheInsert(
+        Cache,
+        (uint16_t)strlen(ServerName),
+        ServerName,
+        sizeof(TestAlpn),
+        TestAlpn,
+        sizeof(Ticket),
+        Ticket,
+        TimeNow);
+}
+
+//
+// Returns the first byte of the ticket taken from the cache, or -1 if none.
+//
+static
+int
+TakeTicket(
+    _In_ QUIC_RESUMPTION_CACHE* Cache,
+    _In_z_ const char* ServerName,
+    _In_ uint64_t TimeNow,
+    _In_ uint16_t AlpnLength = sizeof(TestAlpn),
+    _In_reads_(AlpnLength) const uint8_t* Alpn = TestAlpn
+    )
+{
+    QUIC_RESUMPTION_CACHE_ENTRY* Entry =
+        QuicResumptionCacheTake(
+            Cache,
+            (uint16_t)strlen(ServerName),
+            ServerName,
+            AlpnLength,
+            Alpn,
+            TimeNow);
+    if (Entry == nullptr) {
+        return -1;
+    }
+    EXPECT_EQ(32u, Entry->TicketLength);
+    int Result = Entry->Ticket[0];
+    QuicResumptionCacheEntryFree(Entry);
+    return Result;
+}
+
+TEST(ResumptionCacheTest, InsertTake)
+{
+    ResumptionCacheScope Cache(16, 0);
+    ASSERT_NE(nullptr, Cache.Cache);
+
+    ASSERT_EQ(-1, TakeTicket(Cache, "a.example", 0));
+    InsertTicket(Cache, "a.example", 1, 0);
+    InsertTicket(Cache, "b.example", 2, 0);
+
+    //
+    // Different ALPN or server name must not match.
+    //
+    const uint8_t OtherAlpn[] = { 2, 'h', '2' };
+    ASSERT_EQ(-1, TakeTicket(Cache, "a.example", 0, sizeof(OtherAlpn), OtherAlpn));
+    ASSERT_EQ(-1, TakeTicket(Cache, "a.example.com", 0));
+
+    //
+    // Tickets are single use.
+    //
+    ASSERT_EQ(1, TakeTicket(Cache, "a.example", 0));
+    ASSERT_EQ(-1, TakeTicket(Cache, "a.example", 0));
+    ASSERT_EQ(2, TakeTicket(Cache, "b.example", 0));
+    ASSERT_EQ(-1, TakeTicket(Cache, "b.example", 0));
+}
+
+TEST(ResumptionCacheTest, MultipleTicketsPerKey)
+{
+    ResumptionCacheScope Cache(16, 0);
+
+    InsertTicket(Cache, "a.example", 1, 0);
+    InsertTicket(Cache, "a.example", 2, 0);
+
+    int First = TakeTicket(Cache, "a.example", 0);
+    int Second = TakeTicket(Cache, "a.example", 0);
+    ASSERT_TRUE((First == 1 && Second == 2) || (First == 2 && Second == 1));
+    ASSERT_EQ(-1, TakeTicket(Cache, "a.example", 0));
+}
+
+TEST(ResumptionCacheTest, Expiration)
+{
+    ResumptionCacheScope Cache(16, 100);
+
+    InsertTicket(Cache, "a.example", 1, 0);
+    InsertTicket(Cache, "b.example", 2, MS_TO_US(50));
+    ASSERT_EQ(-1, TakeTicket(Cache, "a.example", MS_TO_US(100)));
+    ASSERT_EQ(2, TakeTicket(Cache, "b.example", MS_TO_US(100)));
+}
+
+TEST(ResumptionCacheTest, CapacityEviction)
+{
+    ResumptionCacheScope Cache(4, 0);
+
+    InsertTicket(Cache, "a.example", 1, 0);
+    InsertTicket(Cache, "b.example", 2, 0);
+    InsertTicket(Cache, "c.example", 3, 0);
+    InsertTicket(Cache, "d.example", 4, 0);
+    InsertTicket(Cache, "e.example", 5, 0); // Evicts the oldest.
+
+    ASSERT_EQ(-1, TakeTicket(Cache, "a.example", 0));
+    ASSERT_EQ(2, TakeTicket(Cache, "b.example", 0));
+    ASSERT_EQ(3, TakeTicket(Cache, "c.example", 0));
+    ASSERT_EQ(4, TakeTicket(Cache, "d.example", 0));
+    ASSERT_EQ(5, TakeTicket(Cache, "e.example", 0));
+}
+
+TEST(ResumptionCacheTest, Sharded)
+{
+    ResumptionCacheScope Cache(1024, 0, 8);
+    ASSERT_NE(nullptr, Cache.Cache);
+    ASSERT_EQ(7u, Cache.Cache->ShardMask);
+    ASSERT_EQ(128u, Cache.Cache->ShardCapacity);
+
+    char ServerName[32];
+    for (uint32_t i = 0; i < 64; ++i) {
+        snprintf(ServerName, sizeof(ServerName), "%u.example", i);
+        InsertTicket(Cache, ServerName, (uint8_t)i, 0);
+    }
+    for (uint32_t i = 0; i < 64; ++i) {
+        snprintf(ServerName, sizeof(ServerName), "%u.example", i);
+        ASSERT_EQ((int)i, TakeTicket(Cache, ServerName, 0));
+    }
+}
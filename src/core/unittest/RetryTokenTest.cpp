@@ -0,0 +1,283 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Unit test and benchmark for stateless retry token validation.
+
+--*/
+
+#include "main.h"
+#ifdef QUIC_CLOG
+#include "RetryTokenTest.cpp.clog.h"
+#endif
+
+#define RETRY_TOKEN_TEST_CID_LENGTH     8
+#define RETRY_TOKEN_BENCH_COUNT         100000
+
+//
+// Sets up just enough of the library (a single partition and the retry
+// secrets) for retry tokens to be generated and validated.
+//
+struct RetryTokenLibScope {
+    QUIC_PARTITION Partition;
+    RetryTokenLibScope() {
+        uint8_t ResetHashKey[20] = {0};
+        CxPlatZeroMemory(&Partition, sizeof(Partition));
+        EXPECT_EQ(
+            QUIC_STATUS_SUCCESS,
+            QuicPartitionInitialize(
+                &Partition, 0, 0, CXPLAT_HASH_SHA256, ResetHashKey, sizeof(ResetHashKey), FALSE));
+        MsQuicLib.Partitions = &Partition;
+        MsQuicLib.PartitionCount = 1;
+        MsQuicLib.CidTotalLength = RETRY_TOKEN_TEST_CID_LENGTH;
+        CxPlatRandom(sizeof(MsQuicLib.BaseRetrySecret), MsQuicLib.BaseRetrySecret);
+        CxPlatRandom(
+            sizeof(MsQuicLib.RetryTokenPreFilterKey), MsQuicLib.RetryTokenPreFilterKey);
+    }
+    ~RetryTokenLibScope() {
+        QuicPartitionUninitialize(&Partition);
+        MsQuicLib.Partitions = nullptr;
+        MsQuicLib.PartitionCount = 0;
+        MsQuicLib.CidTotalLength = 0;
+    }
+};
+
+//
+// A received Initial packet carrying a retry token.
+//
+struct RetryTokenPacket {
+    QUIC_RX_PACKET Packet;
+    CXPLAT_ROUTE Route;
+    uint8_t DestCid[RETRY_TOKEN_TEST_CID_LENGTH];
+    RetryTokenPacket(const char* RemoteAddress) {
+        CxPlatZeroMemory(&Packet, sizeof(Packet));
+        CxPlatZeroMemory(&Route, sizeof(Route));
+        EXPECT_TRUE(QuicAddrFromString(RemoteAddress, 0, &Route.RemoteAddress));
+        CxPlatRandom(sizeof(DestCid), DestCid);
+        Packet._.Route = &Route;
+        Packet._.PartitionIndex = 0;
+        Packet.DestCid = DestCid;
+        Packet.DestCidLen = sizeof(DestCid);
+    }
+};
+
+//
+// Generates a token the same way the binding does when sending a Retry.
+//
+static
+void
+GenerateToken(
+    _In_ const RetryTokenPacket& Packet,
+    _Out_ QUIC_TOKEN_CONTENTS* Token
+    )
+{
+    CxPlatZeroMemory(Token, sizeof(*Token));
+    Token->Authenticated.Timestamp = (uint64_t)CxPlatTimeEpochMs64();
+    Token->Authenticated.PreFilterTag =
+        QuicRetryTokenComputePreFilterTag(
+            &Packet.Route.RemoteAddress, (uint64_t)Token->Authenticated.Timestamp);
+    Token->Encrypted.RemoteAddress = Packet.Route.RemoteAddress;
+    Token->Encrypted.OrigConnIdLength = 8;
+    CxPlatRandom(8, Token->Encrypted.OrigConnId);
+
+    uint8_t Iv[CXPLAT_MAX_IV_LENGTH] = {0};
+    CxPlatCopyMemory(Iv, Packet.DestCid, RETRY_TOKEN_TEST_CID_LENGTH);
+
+    QUIC_PARTITION* Partition = &MsQuicLib.Partitions[0];
+    CxPlatDispatchLockAcquire(&Partition->StatelessRetryKeysLock);
+    CXPLAT_KEY* Key = QuicPartitionGetCurrentStatelessRetryKey(Partition);
+    EXPECT_NE(nullptr, Key);
+    if (Key != nullptr) {
+        EXPECT_EQ(
+            QUIC_STATUS_SUCCESS,
+            CxPlatEncrypt(
+                Key,
+                Iv,
+                sizeof(Token->Authenticated),
+                (uint8_t*)&Token->Authenticated,
+                sizeof(Token->Encrypted) + sizeof(Token->EncryptionTag),
+                (uint8_t*)&Token->Encrypted));
+    }
+    CxPlatDispatchLockRelease(&Partition->StatelessRetryKeysLock);
+}
+
+static
+uint64_t
+ValidateTokens(
+    _In_ const RetryTokenPacket& Packet,
+    _In_ const QUIC_TOKEN_CONTENTS* Token,
+    _In_ uint32_t Count,
+    _Out_ uint32_t* ValidCount
+    )
+{
+    QUIC_TOKEN_CONTENTS Decrypted;
+    *ValidCount = 0;
+    const uint64_t Start = CxPlatTimeUs64();
+    for (uint32_t i = 0; i < Count; ++i) {
+        if (QuicRetryTokenDecrypt(&Packet.Packet, (const uint8_t*)Token, &Decrypted)) {
+            ++*ValidCount;
+        }
+    }
+    return CXPLAT_MAX(1, CxPlatTimeDiff64(Start, CxPlatTimeUs64()));
+}
+
+TEST(RetryTokenTest, Valid)
+{
+    RetryTokenLibScope Lib;
+    RetryTokenPacket Packet("192.168.1.10:4433");
+    QUIC_TOKEN_CONTENTS Token;
+    GenerateToken(Packet, &Token);
+
+    QUIC_TOKEN_CONTENTS Decrypted;
+    ASSERT_TRUE(QuicRetryTokenDecrypt(&Packet.Packet, (const uint8_t*)&Token, &Decrypted));
+    ASSERT_TRUE(QuicAddrCompare(&Packet.Route.RemoteAddress, &Decrypted.Encrypted.RemoteAddress));
+    ASSERT_EQ(8, Decrypted.Encrypted.OrigConnIdLength);
+}
+
+TEST(RetryTokenTest, PreFilterRejectsOtherAddress)
+{
+    RetryTokenLibScope Lib;
+    RetryTokenPacket Packet("192.168.1.10:4433");
+    QUIC_TOKEN_CONTENTS Token;
+    GenerateToken(Packet, &Token);
+
+    //
+    // The same token sent from a different address (or port) doesn't make it
+    // past the pre-filter.
+    //
+    QUIC_TOKEN_CONTENTS Decrypted;
+    RetryTokenPacket Spoofed("192.168.1.11:4433");
+    Spoofed.Packet.DestCid = Packet.DestCid;
+    ASSERT_FALSE(QuicRetryTokenDecrypt(&Spoofed.Packet, (const uint8_t*)&Token, &Decrypted));
+    Spoofed.Route.RemoteAddress = Packet.Route.RemoteAddress;
+    QuicAddrSetPort(&Spoofed.Route.RemoteAddress, 4434);
+    ASSERT_FALSE(QuicRetryTokenDecrypt(&Spoofed.Packet, (const uint8_t*)&Token, &Decrypted));
+}
+
+TEST(RetryTokenTest, Tampered)
+{
+    RetryTokenLibScope Lib;
+    RetryTokenPacket Packet("[fe80::1]:4433");
+    QUIC_TOKEN_CONTENTS Token;
+    GenerateToken(Packet, &Token);
+
+    QUIC_TOKEN_CONTENTS Decrypted;
+    QUIC_TOKEN_CONTENTS Modified = Token;
+    Modified.Authenticated.PreFilterTag ^= 1;
+    ASSERT_FALSE(QuicRetryTokenDecrypt(&Packet.Packet, (const uint8_t*)&Modified, &Decrypted));
+
+    Modified = Token;
+    Modified.Encrypted.OrigConnIdLength ^= 1;
+    ASSERT_FALSE(QuicRetryTokenDecrypt(&Packet.Packet, (const uint8_t*)&Modified, &Decrypted));
+
+    ASSERT_TRUE(QuicRetryTokenDecrypt(&Packet.Packet, (const uint8_t*)&Token, &Decrypted));
+}
+
+TEST(RetryTokenTest, PreFilterKnownAnswer)
+{
+    //
+    // With the SipHash reference key, and an address and timestamp that
+    // serialize to the bytes 00..0d, the tag is the low 16 bits of the
+    // reference output for that input (0xf723ca908e7af2ee).
+    //
+    RetryTokenLibScope Lib;
+    MsQuicLib.RetryTokenPreFilterKey[0] = 0x0706050403020100ull;
+    MsQuicLib.RetryTokenPreFilterKey[1] = 0x0f0e0d0c0b0a0908ull;
+    QUIC_ADDR Address;
+    ASSERT_TRUE(QuicAddrFromString("10.11.12.13:2057", 0, &Address));
+    ASSERT_EQ(
+        0xf2ee,
+        QuicRetryTokenComputePreFilterTag(&Address, 0x0706050403020100ull));
+}
+
+TEST(RetryTokenTest, PreFilterForgery)
+{
+    //
+    // An attacker who has seen the tags of valid tokens for some addresses and
+    // timestamps tries to derive the tag for another one. If the tag were
+    // linear in its input (as a Toeplitz hash is), the XOR of three tags would
+    // be the tag of the XOR of their inputs, every time. A PRF only matches by
+    // chance, about once in 2^16 tries.
+    //
+    RetryTokenLibScope Lib;
+    const uint32_t Trials = 64;
+    uint32_t AddressForged = 0, TimestampForged = 0;
+    for (uint32_t i = 0; i < Trials; ++i) {
+        uint32_t Ip[3];
+        uint16_t Port[3];
+        uint64_t Timestamp[3];
+        CxPlatRandom(sizeof(Ip), Ip);
+        CxPlatRandom(sizeof(Port), Port);
+        CxPlatRandom(sizeof(Timestamp), Timestamp);
+
+        QUIC_ADDR Address[4];
+        uint16_t Tag = 0;
+        for (uint32_t j = 0; j < 4; ++j) {
+            CxPlatZeroMemory(&Address[j], sizeof(Address[j]));
+            QuicAddrSetFamily(&Address[j], QUIC_ADDRESS_FAMILY_INET);
+        }
+        uint32_t ForgedIp = 0;
+        uint16_t ForgedPort = 0;
+        for (uint32_t j = 0; j < 3; ++j) {
+            CxPlatCopyMemory(
+                ((uint8_t*)&Address[j]) + QUIC_ADDR_V4_IP_OFFSET, &Ip[j], sizeof(Ip[j]));
+            QuicAddrSetPort(&Address[j], Port[j]);
+            Tag ^= QuicRetryTokenComputePreFilterTag(&Address[j], Timestamp[0]);
+            ForgedIp ^= Ip[j];
+            ForgedPort ^= Port[j];
+        }
+        CxPlatCopyMemory(
+            ((uint8_t*)&Address[3]) + QUIC_ADDR_V4_IP_OFFSET, &ForgedIp, sizeof(ForgedIp));
+        QuicAddrSetPort(&Address[3], ForgedPort);
+        if (Tag == QuicRetryTokenComputePreFilterTag(&Address[3], Timestamp[0])) {
+            ++AddressForged;
+        }
+
+        Tag = 0;
+        for (uint32_t j = 0; j < 3; ++j) {
+            Tag ^= QuicRetryTokenComputePreFilterTag(&Address[0], Timestamp[j]);
+        }
+        if (Tag ==
+            QuicRetryTokenComputePreFilterTag(
+                &Address[0], Timestamp[0] ^ Timestamp[1] ^ Timestamp[2])) {
+            ++TimestampForged;
+        }
+    }
+    ASSERT_LT(AddressForged, 4u);
+    ASSERT_LT(TimestampForged, 4u);
+}
+
+//
+// Measures validations per second on a single core, both for valid tokens
+// (pre-filter plus AEAD) and for random tokens (pre-filter only). Disabled,
+// as it only reports a rate; run with --gtest_also_run_disabled_tests.
+//
+TEST(RetryTokenTest, DISABLED_BenchmarkValidate)
+{
+    RetryTokenLibScope Lib;
+    RetryTokenPacket Packet("10.0.0.1:50000");
+    QUIC_TOKEN_CONTENTS Token;
+    GenerateToken(Packet, &Token);
+
+    uint32_t ValidCount;
+    uint64_t ElapsedUs =
+        ValidateTokens(Packet, &Token, RETRY_TOKEN_BENCH_COUNT, &ValidCount);
+    ASSERT_EQ((uint32_t)RETRY_TOKEN_BENCH_COUNT, ValidCount);
+    std::cout << "Valid: " << (RETRY_TOKEN_BENCH_COUNT * 1000000ull) / ElapsedUs
+        << " validations/sec" << std::endl;
+
+    QUIC_TOKEN_CONTENTS Forged;
+    CxPlatRandom(sizeof(Forged), &Forged);
+    Forged.Authenticated.IsNewToken = FALSE;
+    Forged.Authenticated.PreFilterTag =
+        (uint16_t)~QuicRetryTokenComputePreFilterTag(
+            &Packet.Route.RemoteAddress, (uint64_t)Forged.Authenticated.Timestamp);
+    ElapsedUs =
+        ValidateTokens(Packet, &Forged, RETRY_TOKEN_BENCH_COUNT, &ValidCount);
+    ASSERT_EQ(0u, ValidCount);
+    std::cout << "Forged: " << (RETRY_TOKEN_BENCH_COUNT * 1000000ull) / ElapsedUs
+        << " validations/sec" << std::endl;
+}
@@ -126,6 +126,7 @@ TEST(SettingsTest, TestAllSettingsFieldsSet)
     SETTINGS_FEATURE_SET_TEST(OneWayDelayEnabled, QuicSettingsSettingsToInternal);
     SETTINGS_FEATURE_SET_TEST(NetStatsEventEnabled, QuicSettingsSettingsToInternal);
     SETTINGS_FEATURE_SET_TEST(StreamMultiReceiveEnabled, QuicSettingsSettingsToInternal);
+    SETTINGS_FEATURE_SET_TEST(IdleHibernationTimeoutMs, QuicSettingsSettingsToInternal);
 
     Settings.IsSetFlags = 0;
     Settings.IsSet.RESERVED = ~Settings.IsSet.RESERVED;
@@ -141,6 +142,11 @@ TEST(SettingsTest, TestAllGlobalSettingsFieldsSet)
     SETTINGS_FEATURE_SET_TEST(RetryMemoryLimit, QuicSettingsGlobalSettingsToInternal);
     SETTINGS_FEATURE_SET_TEST(LoadBalancingMode, QuicSettingsGlobalSettingsToInternal);
     SETTINGS_FEATURE_SET_TEST(FixedServerID, QuicSettingsGlobalSettingsToInternal);
+#ifdef QUIC_API_ENABLE_PREVIEW_FEATURES
+    SETTINGS_FEATURE_SET_TEST(AntiReplayWindowMs, QuicSettingsGlobalSettingsToInternal);
+    SETTINGS_FEATURE_SET_TEST(AntiReplayCapacity, QuicSettingsGlobalSettingsToInternal);
+    SETTINGS_FEATURE_SET_TEST(ObjectArenaEnabled, QuicSettingsGlobalSettingsToInternal);
+#endif
 
     Settings.IsSetFlags = 0;
     Settings.IsSet.RESERVED = ~Settings.IsSet.RESERVED;
@@ -213,6 +219,7 @@ TEST(SettingsTest, TestAllSettingsFieldsGet)
     SETTINGS_FEATURE_GET_TEST(OneWayDelayEnabled, QuicSettingsGetSettings);
     SETTINGS_FEATURE_GET_TEST(NetStatsEventEnabled, QuicSettingsGetSettings);
     SETTINGS_FEATURE_GET_TEST(StreamMultiReceiveEnabled, QuicSettingsGetSettings);
+    SETTINGS_FEATURE_GET_TEST(IdleHibernationTimeoutMs, QuicSettingsGetSettings);
 
     Settings.IsSetFlags = 0;
     Settings.IsSet.RESERVED = ~Settings.IsSet.RESERVED;
@@ -229,6 +236,11 @@ TEST(SettingsTest, TestAllGlobalSettingsFieldsGet)
     SETTINGS_FEATURE_GET_TEST(RetryMemoryLimit, QuicSettingsGetGlobalSettings);
     SETTINGS_FEATURE_GET_TEST(LoadBalancingMode, QuicSettingsGetGlobalSettings);
     SETTINGS_FEATURE_GET_TEST(FixedServerID, QuicSettingsGetGlobalSettings);
+#ifdef QUIC_API_ENABLE_PREVIEW_FEATURES
+    SETTINGS_FEATURE_GET_TEST(AntiReplayWindowMs, QuicSettingsGetGlobalSettings);
+    SETTINGS_FEATURE_GET_TEST(AntiReplayCapacity, QuicSettingsGetGlobalSettings);
+    SETTINGS_FEATURE_GET_TEST(ObjectArenaEnabled, QuicSettingsGetGlobalSettings);
+#endif
 
     Settings.IsSetFlags = 0;
     Settings.IsSet.RESERVED = ~Settings.IsSet.RESERVED;
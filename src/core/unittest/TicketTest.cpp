@@ -601,7 +601,7 @@ TEST(ResumptionTicketTest, ServerDecFail)
     CxPlatZeroMemory(&Connection, sizeof(Connection));
     Connection.Stats.QuicVersion = QUIC_VERSION_1;
 
-    uint8_t InputTicketBuffer[8 + TransportParametersLength + sizeof(Alpn) + sizeof(AppData)] = {
+    uint8_t InputTicketBuffer[8 + TransportParametersLength + sizeof(Alpn) + sizeof(AppData) + QUIC_SERVER_TICKET_REPLAY_INFO_LENGTH] = {
         CXPLAT_TLS_RESUMPTION_TICKET_VERSION,
         0,0,0,1,                    // QUIC version
         4,                          // ALPN length
@@ -656,7 +656,7 @@ TEST(ResumptionTicketTest, ServerDecFail)
     TEST_QUIC_SUCCEEDED(
         QuicCryptoDecodeServerTicket(
             &Connection,
-            8 + (uint16_t)sizeof(Alpn) + (uint16_t)(EncodedTPLength - CxPlatTlsTPHeaderSize) + (uint16_t)sizeof(AppData),
+            8 + (uint16_t)sizeof(Alpn) + (uint16_t)(EncodedTPLength - CxPlatTlsTPHeaderSize) + (uint16_t)sizeof(AppData) + QUIC_SERVER_TICKET_REPLAY_INFO_LENGTH,
             InputTicketBuffer,
             AlpnList,
             sizeof(AlpnList),
@@ -818,13 +818,37 @@ TEST(ResumptionTicketTest, ServerDecFail)
             &DecodedAppData,
             &DecodedAppDataLength));
 
+    // Not enough room for replay info
+    ASSERT_EQ(
+        QUIC_STATUS_INVALID_PARAMETER,
+        QuicCryptoDecodeServerTicket(
+            &Connection,
+            8 + (uint16_t)sizeof(Alpn) + (uint16_t)(EncodedTPLength - CxPlatTlsTPHeaderSize) + (uint16_t)sizeof(AppData),
+            InputTicketBuffer,
+            AlpnList,
+            sizeof(AlpnList),
+            &DecodedTP,
+            &DecodedAppData,
+            &DecodedAppDataLength));
+    ASSERT_EQ(
+        QUIC_STATUS_INVALID_PARAMETER,
+        QuicCryptoDecodeServerTicket(
+            &Connection,
+            8 + (uint16_t)sizeof(Alpn) + (uint16_t)(EncodedTPLength - CxPlatTlsTPHeaderSize) + (uint16_t)sizeof(AppData) + QUIC_SERVER_TICKET_REPLAY_INFO_LENGTH - 1,
+            InputTicketBuffer,
+            AlpnList,
+            sizeof(AlpnList),
+            &DecodedTP,
+            &DecodedAppData,
+            &DecodedAppDataLength));
+
     //
     // Invalidate some of the fields of the ticket to ensure
     // decoding fails
     //
 
     const uint16_t ActualEncodedTicketLength =
-        8 + (uint16_t)sizeof(Alpn) + (uint16_t)(EncodedTPLength - CxPlatTlsTPHeaderSize) + (uint16_t)sizeof(AppData);
+        8 + (uint16_t)sizeof(Alpn) + (uint16_t)(EncodedTPLength - CxPlatTlsTPHeaderSize) + (uint16_t)sizeof(AppData) + QUIC_SERVER_TICKET_REPLAY_INFO_LENGTH;
 
     // Incorrect ticket version
     InputTicketBuffer[0] = CXPLAT_TLS_RESUMPTION_TICKET_VERSION + 1;
@@ -839,7 +863,7 @@ TEST(ResumptionTicketTest, ServerDecFail)
             &DecodedTP,
             &DecodedAppData,
             &DecodedAppDataLength));
-    InputTicketBuffer[0] = CXPLAT_TLS_RESUMPTION_CLIENT_TICKET_VERSION;
+    InputTicketBuffer[0] = CXPLAT_TLS_RESUMPTION_TICKET_VERSION;
 
     // Unsupported QUIC version
     InputTicketBuffer[1] = 1;
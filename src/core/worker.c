@@ -40,6 +40,7 @@ QuicWorkerThreadWake(
     _In_ QUIC_WORKER* Worker
     )
 {
+    QuicPerfCounterIncrement(Worker->Partition, QUIC_PERF_COUNTER_WORK_WAKES);
     Worker->ExecutionContext.Ready = TRUE; // Run the execution context
     if (Worker->IsExternal) {
         CxPlatWakeExecutionContext(&Worker->ExecutionContext);
@@ -463,6 +464,40 @@ QuicWorkerGetNextOperation(
     return Operation;
 }
 
+//
+// Hands the sends batched from the connections processed since the last flush
+// to the datapath.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicWorkerFlushSends(
+    _In_ QUIC_WORKER* Worker
+    )
+{
+    QuicSendBatchFlush(&Worker->SendBatch);
+    Worker->SendBatchConnectionCount = 0;
+}
+
+//
+// Lets the connection queue its sends in the worker's batch. A batch only holds
+// sends for one binding, so if the connection is about to send on another one,
+// the batch is flushed here, rather than from inside QuicBindingSend.
+//
+static
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicWorkerAttachSendBatch(
+    _In_ QUIC_WORKER* Worker,
+    _In_ QUIC_CONNECTION* Connection
+    )
+{
+    if (Worker->SendBatch.Binding != NULL &&
+        Worker->SendBatch.Binding != Connection->Paths[0].Binding) {
+        QuicWorkerFlushSends(Worker);
+    }
+    Connection->SendBatch = &Worker->SendBatch;
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
 QuicWorkerProcessTimers(
@@ -489,9 +524,11 @@ QuicWorkerProcessTimers(
             CXPLAT_CONTAINING_RECORD(Entry, QUIC_CONNECTION, TimerLink);
 
         Connection->WorkerThreadID = ThreadID;
+        QuicWorkerAttachSendBatch(Worker, Connection);
         QuicConfigurationAttachSilo(Connection->Configuration);
         QuicConnTimerExpired(Connection, TimeNow);
         QuicConfigurationDetachSilo();
+        Connection->SendBatch = NULL;
         Connection->WorkerThreadID = 0;
         QuicConnRelease(Connection, QUIC_CONN_REF_WORKER);
     }
@@ -534,6 +571,7 @@ QuicWorkerProcessConnection(
     // Set the thread ID so reentrant API calls will execute inline.
     //
     Connection->WorkerThreadID = ThreadID;
+    QuicWorkerAttachSendBatch(Worker, Connection);
     Connection->Stats.Schedule.DrainCount++;
 
     if (Connection->State.UpdateWorker) {
@@ -567,6 +605,7 @@ QuicWorkerProcessConnection(
     BOOLEAN StillHasPriorityWork = FALSE;
     BOOLEAN StillHasWorkToDo =
         QuicConnDrainOperations(Connection, &StillHasPriorityWork) | Connection->State.UpdateWorker;
+    Connection->SendBatch = NULL;
     Connection->WorkerThreadID = 0;
 
     //
@@ -691,6 +730,7 @@ QuicWorkerLoop(
     QUIC_WORKER* Worker = (QUIC_WORKER*)Context;
 
     if (!Worker->Enabled) {
+        QuicWorkerFlushSends(Worker);
         QuicWorkerLoopCleanup(Worker);
         CxPlatEventSet(Worker->Done);
         return FALSE;
@@ -730,6 +770,14 @@ QuicWorkerLoop(
         QuicWorkerProcessConnection(Worker, Connection, State->ThreadID, &State->TimeNow);
         Worker->ExecutionContext.Ready = TRUE;
         State->NoWorkCount = 0;
+
+        //
+        // Sends are batched across connections, but not for too many, so that
+        // a busy worker doesn't hold them back for long.
+        //
+        if (++Worker->SendBatchConnectionCount >= QUIC_MAX_SEND_BATCH_CONNECTIONS) {
+            QuicWorkerFlushSends(Worker);
+        }
     }
 
     QUIC_OPERATION* Operation = QuicWorkerGetNextOperation(Worker);
@@ -750,6 +798,11 @@ QuicWorkerLoop(
         return TRUE;
     }
 
+    //
+    // Out of work for now, so send everything batched so far.
+    //
+    QuicWorkerFlushSends(Worker);
+
     if (MsQuicLib.ExecutionConfig &&
         (uint64_t)MsQuicLib.ExecutionConfig->PollingIdleTimeoutUs >
             CxPlatTimeDiff64(State->LastWorkTime, State->TimeNow)) {
@@ -79,6 +79,13 @@ typedef struct QUIC_CACHEALIGN QUIC_WORKER {
     uint32_t OperationCount;
     uint64_t DroppedOperationCount;
 
+    //
+    // Sends from the connections processed since the last flush, so that the
+    // ones on the same binding go to the datapath together.
+    //
+    QUIC_SEND_BATCH SendBatch;
+    uint32_t SendBatchConnectionCount;
+
 } QUIC_WORKER;
 
 //
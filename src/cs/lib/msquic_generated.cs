@@ -221,6 +221,8 @@ namespace Microsoft.Quic
         NO_IDEAL_PROC = 0x0008,
         HIGH_PRIORITY = 0x0010,
         AFFINITIZE = 0x0020,
+        LOOPBACK = 0x0040,
+        CID_STEERING = 0x0080,
     }
 
     internal unsafe partial struct QUIC_EXECUTION_CONFIG
@@ -908,6 +910,23 @@ namespace Microsoft.Quic
         internal ulong BindingRecvDroppedPackets;
     }
 
+    internal enum QUIC_LISTENER_ADMISSION_LEVEL
+    {
+        NORMAL = 0,
+        RETRY = 1,
+        SHED = 2,
+        REJECT = 3,
+    }
+
+    internal partial struct QUIC_LISTENER_ADMISSION_CONTROL
+    {
+        [NativeTypeName("uint32_t")]
+        internal uint QueueDelayTargetUs;
+
+        [NativeTypeName("uint32_t")]
+        internal uint HandshakeBacklogTarget;
+    }
+
     internal enum QUIC_PERFORMANCE_COUNTERS
     {
         CONN_CREATED,
@@ -942,6 +961,12 @@ namespace Microsoft.Quic
         SEND_STATELESS_RESET,
         SEND_STATELESS_RETRY,
         CONN_LOAD_REJECT,
+        CONN_HIBERNATED,
+        CONN_HIBERNATED_BYTES,
+        CONN_RECV_QUEUED,
+        WORK_WAKES,
+        DATAPATH_REMOTE_FREES,
+        DATAPATH_CROSS_NODE_SENDS,
         MAX,
     }
 
@@ -980,6 +1005,15 @@ namespace Microsoft.Quic
         [NativeTypeName("uint32_t")]
         internal uint FixedServerID;
 
+        [NativeTypeName("uint32_t")]
+        internal uint AntiReplayWindowMs;
+
+        [NativeTypeName("uint32_t")]
+        internal uint AntiReplayCapacity;
+
+        [NativeTypeName("uint8_t")]
+        internal byte ObjectArenaEnabled;
+
         internal ref ulong IsSetFlags
         {
             get
@@ -1053,17 +1087,59 @@ namespace Microsoft.Quic
                     }
                 }
 
-                [NativeTypeName("uint64_t : 61")]
+                [NativeTypeName("uint64_t : 1")]
+                internal ulong AntiReplayWindowMs
+                {
+                    get
+                    {
+                        return (_bitfield >> 3) & 0x1UL;
+                    }
+
+                    set
+                    {
+                        _bitfield = (_bitfield & ~(0x1UL << 3)) | ((value & 0x1UL) << 3);
+                    }
+                }
+
+                [NativeTypeName("uint64_t : 1")]
+                internal ulong AntiReplayCapacity
+                {
+                    get
+                    {
+                        return (_bitfield >> 4) & 0x1UL;
+                    }
+
+                    set
+                    {
+                        _bitfield = (_bitfield & ~(0x1UL << 4)) | ((value & 0x1UL) << 4);
+                    }
+                }
+
+                [NativeTypeName("uint64_t : 1")]
+                internal ulong ObjectArenaEnabled
+                {
+                    get
+                    {
+                        return (_bitfield >> 5) & 0x1UL;
+                    }
+
+                    set
+                    {
+                        _bitfield = (_bitfield & ~(0x1UL << 5)) | ((value & 0x1UL) << 5);
+                    }
+                }
+
+                [NativeTypeName("uint64_t : 58")]
                 internal ulong RESERVED
                 {
                     get
                     {
-                        return (_bitfield >> 3) & 0x1FFFFFFFUL;
+                        return (_bitfield >> 6) & 0x3FFFFFFUL;
                     }
 
                     set
                     {
-                        _bitfield = (_bitfield & ~(0x1FFFFFFFUL << 3)) | ((value & 0x1FFFFFFFUL) << 3);
+                        _bitfield = (_bitfield & ~(0x3FFFFFFUL << 6)) | ((value & 0x3FFFFFFUL) << 6);
                     }
                 }
             }
@@ -1268,6 +1344,9 @@ namespace Microsoft.Quic
         [NativeTypeName("uint32_t")]
         internal uint StreamRecvWindowUnidiDefault;
 
+        [NativeTypeName("uint32_t")]
+        internal uint IdleHibernationTimeoutMs;
+
         internal ref ulong IsSetFlags
         {
             get
@@ -2027,17 +2106,31 @@ namespace Microsoft.Quic
                     }
                 }
 
-                [NativeTypeName("uint64_t : 20")]
+                [NativeTypeName("uint64_t : 1")]
+                internal ulong IdleHibernationTimeoutMs
+                {
+                    get
+                    {
+                        return (_bitfield >> 44) & 0x1UL;
+                    }
+
+                    set
+                    {
+                        _bitfield = (_bitfield & ~(0x1UL << 44)) | ((value & 0x1UL) << 44);
+                    }
+                }
+
+                [NativeTypeName("uint64_t : 19")]
                 internal ulong RESERVED
                 {
                     get
                     {
-                        return (_bitfield >> 44) & 0xFFFFFUL;
+                        return (_bitfield >> 45) & 0x7FFFFUL;
                     }
 
                     set
                     {
-                        _bitfield = (_bitfield & ~(0xFFFFFUL << 44)) | ((value & 0xFFFFFUL) << 44);
+                        _bitfield = (_bitfield & ~(0x7FFFFUL << 45)) | ((value & 0x7FFFFUL) << 45);
                     }
                 }
             }
@@ -2316,6 +2409,39 @@ namespace Microsoft.Quic
         internal ulong StreamBlockedByAppUs;
     }
 
+    internal partial struct QUIC_POOL_STATS
+    {
+        [NativeTypeName("uint32_t")]
+        internal uint PartitionIndex;
+
+        [NativeTypeName("uint32_t")]
+        internal uint EntrySize;
+
+        [NativeTypeName("uint32_t")]
+        internal uint Depth;
+
+        [NativeTypeName("uint32_t")]
+        internal uint TargetDepth;
+
+        [NativeTypeName("uint64_t")]
+        internal ulong AllocCount;
+
+        [NativeTypeName("uint64_t")]
+        internal ulong MissCount;
+
+        [NativeTypeName("uint64_t")]
+        internal ulong BytesHeld;
+    }
+
+    internal partial struct QUIC_RESUMPTION_CACHE_CONFIG
+    {
+        [NativeTypeName("uint32_t")]
+        internal uint MaxEntryCount;
+
+        [NativeTypeName("uint32_t")]
+        internal uint EntryTimeoutMs;
+    }
+
     internal unsafe partial struct QUIC_SCHANNEL_CREDENTIAL_ATTRIBUTE_W
     {
         [NativeTypeName("unsigned long")]
@@ -2351,6 +2477,7 @@ namespace Microsoft.Quic
         NEW_CONNECTION = 0,
         STOP_COMPLETE = 1,
         DOS_MODE_CHANGED = 2,
+        ADMISSION_LEVEL_CHANGED = 3,
     }
 
     internal partial struct QUIC_LISTENER_EVENT
@@ -2384,6 +2511,14 @@ namespace Microsoft.Quic
             }
         }
 
+        internal ref _Anonymous_e__Union._ADMISSION_LEVEL_CHANGED_e__Struct ADMISSION_LEVEL_CHANGED
+        {
+            get
+            {
+                return ref MemoryMarshal.GetReference(MemoryMarshal.CreateSpan(ref Anonymous.ADMISSION_LEVEL_CHANGED, 1));
+            }
+        }
+
         [StructLayout(LayoutKind.Explicit)]
         internal partial struct _Anonymous_e__Union
         {
@@ -2399,6 +2534,10 @@ namespace Microsoft.Quic
             [NativeTypeName("struct (anonymous struct)")]
             internal _DOS_MODE_CHANGED_e__Struct DOS_MODE_CHANGED;
 
+            [FieldOffset(0)]
+            [NativeTypeName("struct (anonymous struct)")]
+            internal _ADMISSION_LEVEL_CHANGED_e__Struct ADMISSION_LEVEL_CHANGED;
+
             internal unsafe partial struct _NEW_CONNECTION_e__Struct
             {
                 [NativeTypeName("const QUIC_NEW_CONNECTION_INFO *")]
@@ -2473,6 +2612,17 @@ namespace Microsoft.Quic
                     }
                 }
             }
+
+            internal partial struct _ADMISSION_LEVEL_CHANGED_e__Struct
+            {
+                internal QUIC_LISTENER_ADMISSION_LEVEL Level;
+
+                [NativeTypeName("uint32_t")]
+                internal uint QueueDelayUs;
+
+                [NativeTypeName("uint32_t")]
+                internal uint HandshakeBacklog;
+            }
         }
     }
 
@@ -3491,6 +3641,12 @@ namespace Microsoft.Quic
         [NativeTypeName("#define QUIC_PARAM_GLOBAL_STATELESS_RESET_KEY 0x0100000B")]
         internal const uint QUIC_PARAM_GLOBAL_STATELESS_RESET_KEY = 0x0100000B;
 
+        [NativeTypeName("#define QUIC_PARAM_GLOBAL_POOL_STATS 0x0100000C")]
+        internal const uint QUIC_PARAM_GLOBAL_POOL_STATS = 0x0100000C;
+
+        [NativeTypeName("#define QUIC_PARAM_REGISTRATION_RESUMPTION_CACHE 0x02000000")]
+        internal const uint QUIC_PARAM_REGISTRATION_RESUMPTION_CACHE = 0x02000000;
+
         [NativeTypeName("#define QUIC_PARAM_CONFIGURATION_SETTINGS 0x03000000")]
         internal const uint QUIC_PARAM_CONFIGURATION_SETTINGS = 0x03000000;
 
@@ -3515,6 +3671,9 @@ namespace Microsoft.Quic
         [NativeTypeName("#define QUIC_PARAM_DOS_MODE_EVENTS 0x04000004")]
         internal const uint QUIC_PARAM_DOS_MODE_EVENTS = 0x04000004;
 
+        [NativeTypeName("#define QUIC_PARAM_LISTENER_ADMISSION_CONTROL 0x04000005")]
+        internal const uint QUIC_PARAM_LISTENER_ADMISSION_CONTROL = 0x04000005;
+
         [NativeTypeName("#define QUIC_PARAM_CONN_QUIC_VERSION 0x05000000")]
         internal const uint QUIC_PARAM_CONN_QUIC_VERSION = 0x05000000;
 
@@ -278,6 +278,8 @@ typedef enum QUIC_EXECUTION_CONFIG_FLAGS {
     QUIC_EXECUTION_CONFIG_FLAG_NO_IDEAL_PROC    = 0x0008,
     QUIC_EXECUTION_CONFIG_FLAG_HIGH_PRIORITY    = 0x0010,
     QUIC_EXECUTION_CONFIG_FLAG_AFFINITIZE       = 0x0020,
+    QUIC_EXECUTION_CONFIG_FLAG_LOOPBACK         = 0x0040,
+    QUIC_EXECUTION_CONFIG_FLAG_CID_STEERING     = 0x0080,
 #endif
 } QUIC_EXECUTION_CONFIG_FLAGS;
 
@@ -583,6 +585,20 @@ typedef struct QUIC_LISTENER_STATISTICS {
 
 } QUIC_LISTENER_STATISTICS;
 
+#ifdef QUIC_API_ENABLE_PREVIEW_FEATURES
+typedef enum QUIC_LISTENER_ADMISSION_LEVEL {
+    QUIC_LISTENER_ADMISSION_LEVEL_NORMAL    = 0,    // All new connections are accepted.
+    QUIC_LISTENER_ADMISSION_LEVEL_RETRY     = 1,    // New connections must validate their address with a Retry first.
+    QUIC_LISTENER_ADMISSION_LEVEL_SHED      = 2,    // A growing fraction of new connections is rejected.
+    QUIC_LISTENER_ADMISSION_LEVEL_REJECT    = 3,    // All new connections are rejected.
+} QUIC_LISTENER_ADMISSION_LEVEL;
+
+typedef struct QUIC_LISTENER_ADMISSION_CONTROL {
+    uint32_t QueueDelayTargetUs;    // Worker queue delay at which admission starts being restricted. Zero to ignore.
+    uint32_t HandshakeBacklogTarget;// Connections in the handshake at which admission starts being restricted. Zero to ignore.
+} QUIC_LISTENER_ADMISSION_CONTROL;
+#endif
+
 typedef enum QUIC_PERFORMANCE_COUNTERS {
     QUIC_PERF_COUNTER_CONN_CREATED,         // Total connections ever allocated.
     QUIC_PERF_COUNTER_CONN_HANDSHAKE_FAIL,  // Total connections that failed during handshake.
@@ -616,6 +632,12 @@ typedef enum QUIC_PERFORMANCE_COUNTERS {
     QUIC_PERF_COUNTER_SEND_STATELESS_RESET, // Total stateless reset packets sent ever.
     QUIC_PERF_COUNTER_SEND_STATELESS_RETRY, // Total stateless retry packets sent ever.
     QUIC_PERF_COUNTER_CONN_LOAD_REJECT,     // Total connections rejected due to worker load.
+    QUIC_PERF_COUNTER_CONN_HIBERNATED,      // Current connections hibernated while idle.
+    QUIC_PERF_COUNTER_CONN_HIBERNATED_BYTES,// Current memory held by hibernated connections.
+    QUIC_PERF_COUNTER_CONN_RECV_QUEUED,     // Total received datagram chains queued to connections.
+    QUIC_PERF_COUNTER_WORK_WAKES,           // Total times a worker was woken up for new work.
+    QUIC_PERF_COUNTER_DATAPATH_REMOTE_FREES,// Total receive buffers freed on a different NUMA node than their pool.
+    QUIC_PERF_COUNTER_DATAPATH_CROSS_NODE_SENDS, // Total send buffers allocated on a different NUMA node than their socket.
     QUIC_PERF_COUNTER_MAX,
 } QUIC_PERFORMANCE_COUNTERS;
 
@@ -639,12 +661,24 @@ typedef struct QUIC_GLOBAL_SETTINGS {
             uint64_t RetryMemoryLimit                       : 1;
             uint64_t LoadBalancingMode                      : 1;
             uint64_t FixedServerID                          : 1;
+#ifdef QUIC_API_ENABLE_PREVIEW_FEATURES
+            uint64_t AntiReplayWindowMs                     : 1;
+            uint64_t AntiReplayCapacity                     : 1;
+            uint64_t ObjectArenaEnabled                     : 1;
+            uint64_t RESERVED                               : 58;
+#else
             uint64_t RESERVED                               : 61;
+#endif
         } IsSet;
     };
     uint16_t RetryMemoryLimit;
     uint16_t LoadBalancingMode;
     uint32_t FixedServerID;
+#ifdef QUIC_API_ENABLE_PREVIEW_FEATURES
+    uint32_t AntiReplayWindowMs;    // 0-RTT replay protection window. Zero disables.
+    uint32_t AntiReplayCapacity;    // Expected number of resumptions per window.
+    uint8_t ObjectArenaEnabled;     // Allocate connections and streams from large page arenas.
+#endif
 } QUIC_GLOBAL_SETTINGS;
 
 typedef struct QUIC_SETTINGS {
@@ -697,7 +731,8 @@ typedef struct QUIC_SETTINGS {
             uint64_t NetStatsEventEnabled                   : 1;
             uint64_t StreamMultiReceiveEnabled              : 1;
             uint64_t QTIPEnabled                            : 1;
-            uint64_t RESERVED                               : 20;
+            uint64_t IdleHibernationTimeoutMs               : 1;
+            uint64_t RESERVED                               : 19;
 #else
             uint64_t RESERVED                               : 26;
 #endif
@@ -758,6 +793,9 @@ typedef struct QUIC_SETTINGS {
     uint32_t StreamRecvWindowBidiLocalDefault;
     uint32_t StreamRecvWindowBidiRemoteDefault;
     uint32_t StreamRecvWindowUnidiDefault;
+#ifdef QUIC_API_ENABLE_PREVIEW_FEATURES
+    uint32_t IdleHibernationTimeoutMs;
+#endif
 
 } QUIC_SETTINGS;
 
@@ -867,9 +905,28 @@ void
 #endif
 #define QUIC_PARAM_GLOBAL_TLS_PROVIDER                  0x0100000A  // QUIC_TLS_PROVIDER
 #define QUIC_PARAM_GLOBAL_STATELESS_RESET_KEY           0x0100000B  // uint8_t[] - Array size is QUIC_STATELESS_RESET_KEY_LENGTH
+#ifdef QUIC_API_ENABLE_PREVIEW_FEATURES
+typedef struct QUIC_POOL_STATS {
+    uint32_t PartitionIndex;    // Index of the worker that manages the pool.
+    uint32_t EntrySize;         // In bytes, including per-entry overhead.
+    uint32_t Depth;             // Free entries currently held by the pool.
+    uint32_t TargetDepth;       // Free entries the pool is currently sized for.
+    uint64_t AllocCount;        // Allocations from the pool.
+    uint64_t MissCount;         // Allocations that found the pool empty.
+    uint64_t BytesHeld;         // Memory held by free entries.
+} QUIC_POOL_STATS;
+#define QUIC_PARAM_GLOBAL_POOL_STATS                    0x0100000C  // QUIC_POOL_STATS[]
+#endif
 //
 // Parameters for Registration.
 //
+#ifdef QUIC_API_ENABLE_PREVIEW_FEATURES
+typedef struct QUIC_RESUMPTION_CACHE_CONFIG {
+    uint32_t MaxEntryCount;     // Total number of tickets cached. Must be non-zero.
+    uint32_t EntryTimeoutMs;    // Zero indicates no additional expiration.
+} QUIC_RESUMPTION_CACHE_CONFIG;
+#define QUIC_PARAM_REGISTRATION_RESUMPTION_CACHE        0x02000000  // QUIC_RESUMPTION_CACHE_CONFIG
+#endif
 
 //
 // Parameters for Configuration.
@@ -896,6 +953,9 @@ typedef struct QUIC_SCHANNEL_CREDENTIAL_ATTRIBUTE_W {
 #define QUIC_PARAM_LISTENER_CIBIR_ID                    0x04000002  // uint8_t[] {offset, id[]}
 #endif
 #define QUIC_PARAM_DOS_MODE_EVENTS                      0x04000004  // BOOLEAN
+#ifdef QUIC_API_ENABLE_PREVIEW_FEATURES
+#define QUIC_PARAM_LISTENER_ADMISSION_CONTROL           0x04000005  // QUIC_LISTENER_ADMISSION_CONTROL
+#endif
 
 //
 // Parameters for Connection.
@@ -1086,6 +1146,9 @@ typedef enum QUIC_LISTENER_EVENT_TYPE {
     QUIC_LISTENER_EVENT_NEW_CONNECTION      = 0,
     QUIC_LISTENER_EVENT_STOP_COMPLETE       = 1,
     QUIC_LISTENER_EVENT_DOS_MODE_CHANGED    = 2,
+#ifdef QUIC_API_ENABLE_PREVIEW_FEATURES
+    QUIC_LISTENER_EVENT_ADMISSION_LEVEL_CHANGED = 3,    // Only indicated if QUIC_PARAM_LISTENER_ADMISSION_CONTROL is set.
+#endif
 } QUIC_LISTENER_EVENT_TYPE;
 
 typedef struct QUIC_LISTENER_EVENT {
@@ -1103,16 +1166,34 @@ typedef struct QUIC_LISTENER_EVENT {
             BOOLEAN DosModeEnabled : 1;
             BOOLEAN RESERVED       : 7;
         } DOS_MODE_CHANGED;
+#ifdef QUIC_API_ENABLE_PREVIEW_FEATURES
+        struct {
+            QUIC_LISTENER_ADMISSION_LEVEL Level;
+            uint32_t QueueDelayUs;          // The worker queue delay that triggered the change.
+            uint32_t HandshakeBacklog;      // The number of connections in the handshake.
+        } ADMISSION_LEVEL_CHANGED;
+#endif
     };
 } QUIC_LISTENER_EVENT;
 
 typedef
+#ifdef QUIC_API_ENABLE_PREVIEW_FEATURES
+_When_(
+    Event->Type != QUIC_LISTENER_EVENT_DOS_MODE_CHANGED &&
+    Event->Type != QUIC_LISTENER_EVENT_ADMISSION_LEVEL_CHANGED,
+    _IRQL_requires_max_(PASSIVE_LEVEL))
+_When_(
+    Event->Type == QUIC_LISTENER_EVENT_DOS_MODE_CHANGED ||
+    Event->Type == QUIC_LISTENER_EVENT_ADMISSION_LEVEL_CHANGED,
+    _IRQL_requires_max_(DISPATCH_LEVEL))
+#else
 _When_(
     Event->Type != QUIC_LISTENER_EVENT_DOS_MODE_CHANGED,
     _IRQL_requires_max_(PASSIVE_LEVEL))
 _When_(
     Event->Type == QUIC_LISTENER_EVENT_DOS_MODE_CHANGED,
     _IRQL_requires_max_(DISPATCH_LEVEL))
+#endif
 _Function_class_(QUIC_LISTENER_CALLBACK)
 QUIC_STATUS
 (QUIC_API QUIC_LISTENER_CALLBACK)(
@@ -200,6 +200,12 @@ DumpMsQuicPerfCounters(
     printf("  SEND_STATELESS_RESET:  %llu\n", (unsigned long long)Counters[QUIC_PERF_COUNTER_SEND_STATELESS_RESET]);
     printf("  SEND_STATELESS_RETRY:  %llu\n", (unsigned long long)Counters[QUIC_PERF_COUNTER_SEND_STATELESS_RETRY]);
     printf("  CONN_LOAD_REJECT:      %llu\n", (unsigned long long)Counters[QUIC_PERF_COUNTER_CONN_LOAD_REJECT]);
+    printf("  CONN_HIBERNATED:       %llu\n", (unsigned long long)Counters[QUIC_PERF_COUNTER_CONN_HIBERNATED]);
+    printf("  CONN_HIBERNATED_BYTES: %llu\n", (unsigned long long)Counters[QUIC_PERF_COUNTER_CONN_HIBERNATED_BYTES]);
+    printf("  CONN_RECV_QUEUED:      %llu\n", (unsigned long long)Counters[QUIC_PERF_COUNTER_CONN_RECV_QUEUED]);
+    printf("  WORK_WAKES:            %llu\n", (unsigned long long)Counters[QUIC_PERF_COUNTER_WORK_WAKES]);
+    printf("  DATAPATH_REMOTE_FREES: %llu\n", (unsigned long long)Counters[QUIC_PERF_COUNTER_DATAPATH_REMOTE_FREES]);
+    printf("  DATAPATH_CROSS_NODE_SENDS: %llu\n", (unsigned long long)Counters[QUIC_PERF_COUNTER_DATAPATH_CROSS_NODE_SENDS]);
 }
 
 //
@@ -0,0 +1,64 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+--*/
+
+#pragma once
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+//
+// Computes the 16-bit one's complement sum (RFC 1071) of the buffer, added to
+// InitialChecksum, with all carries folded in. The sum is in the same byte
+// order as the data; complement it to get the Internet checksum. Uses the
+// widest vector instructions the processor supports.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+uint16_t
+CxPlatChecksum(
+    _In_reads_(Length)
+        const uint8_t* Data,
+    _In_ uint32_t Length,
+    _In_ uint64_t InitialChecksum
+    );
+
+//
+// The portable version of CxPlatChecksum, which sums one 32-bit word at a
+// time. Exposed for testing.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+uint16_t
+CxPlatChecksumScalar(
+    _In_reads_(Length)
+        const uint8_t* Data,
+    _In_ uint32_t Length,
+    _In_ uint64_t InitialChecksum
+    );
+
+//
+// Incrementally updates an Internet checksum (as stored in the header) when a
+// 16-bit field it covers changes from OldValue to NewValue (RFC 1624, eqn. 3).
+// For instance, the UDP and IPv4 length fields of segments that only differ in
+// their length. Values are in the same byte order as in the packet.
+//
+inline
+uint16_t
+CxPlatChecksumUpdate16(
+    _In_ uint16_t Checksum,
+    _In_ uint16_t OldValue,
+    _In_ uint16_t NewValue
+    )
+{
+    uint32_t Sum = (uint32_t)(uint16_t)~Checksum + (uint16_t)~OldValue + NewValue;
+    Sum = (Sum & 0xffff) + (Sum >> 16);
+    Sum = (Sum & 0xffff) + (Sum >> 16);
+    return (uint16_t)~Sum;
+}
+
+#if defined(__cplusplus)
+}
+#endif
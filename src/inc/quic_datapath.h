@@ -268,7 +268,8 @@ typedef struct CXPLAT_RECV_DATA {
     uint16_t QueuedOnConnection : 1; // Used for debugging.
     uint16_t DatapathType : 2;       // CXPLAT_DATAPATH_TYPE
     uint16_t Reserved : 4;           // PACKET_TYPE (at least 3 bits)
-    uint16_t ReservedEx : 8;         // Header length
+    uint16_t ReservedEx : 7;         // Header length
+    uint16_t Coalesced : 1;          // Not the first segment of a coalesced (GRO/URO) receive
 
     //
     // Variable length data (of size `ClientRecvContextLength` passed into
@@ -399,6 +400,27 @@ void
 
 typedef CXPLAT_DATAPATH_UNREACHABLE_CALLBACK *CXPLAT_DATAPATH_UNREACHABLE_CALLBACK_HANDLER;
 
+//
+// Function pointer type for the datapath receive filter callback. Called
+// inline on the receive path for each datagram, before any receive data is
+// built for it. Returns FALSE if the datagram should be dropped.
+//
+typedef
+_IRQL_requires_max_(DISPATCH_LEVEL)
+_Function_class_(CXPLAT_DATAPATH_RECEIVE_FILTER_CALLBACK)
+BOOLEAN
+(CXPLAT_DATAPATH_RECEIVE_FILTER_CALLBACK)(
+    _In_ CXPLAT_SOCKET* Socket,
+    _In_ void* Context,
+    _In_ uint16_t PartitionIndex,
+    _In_ const QUIC_ADDR* RemoteAddress,
+    _In_reads_(BufferLength)
+        const uint8_t* Buffer,
+    _In_ uint16_t BufferLength
+    );
+
+typedef CXPLAT_DATAPATH_RECEIVE_FILTER_CALLBACK *CXPLAT_DATAPATH_RECEIVE_FILTER_CALLBACK_HANDLER;
+
 //
 // UDP Callback function pointers used by the datapath.
 //
@@ -407,6 +429,11 @@ typedef struct CXPLAT_UDP_DATAPATH_CALLBACKS {
     CXPLAT_DATAPATH_RECEIVE_CALLBACK_HANDLER Receive;
     CXPLAT_DATAPATH_UNREACHABLE_CALLBACK_HANDLER Unreachable;
 
+    //
+    // Optional. Not all datapaths call it.
+    //
+    CXPLAT_DATAPATH_RECEIVE_FILTER_CALLBACK_HANDLER ReceiveFilter;
+
 } CXPLAT_UDP_DATAPATH_CALLBACKS;
 
 //
@@ -489,6 +516,28 @@ CxPlatDataPathGetSupportedFeatures(
     _In_ CXPLAT_DATAPATH* Datapath
     );
 
+typedef struct CXPLAT_DATAPATH_BUFFER_STATISTICS {
+    //
+    // Receive buffers returned to their pool from another NUMA node.
+    //
+    uint64_t RemoteFrees;
+
+    //
+    // Send buffers allocated on a different NUMA node than their socket.
+    //
+    uint64_t CrossNodeSends;
+} CXPLAT_DATAPATH_BUFFER_STATISTICS;
+
+//
+// Queries the cross NUMA node buffer traffic of the datapath.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+CxPlatDataPathGetBufferStatistics(
+    _In_ CXPLAT_DATAPATH* Datapath,
+    _Out_ CXPLAT_DATAPATH_BUFFER_STATISTICS* Statistics
+    );
+
 //
 // Gets whether the datapath prefers UDP datagrams padded to path MTU.
 //
@@ -586,6 +635,12 @@ typedef struct CXPLAT_UDP_CONFIG {
     uint8_t CibirIdOffsetSrc;           // CIBIR ID offset in source CID
     uint8_t CibirIdOffsetDst;           // CIBIR ID offset in destination CID
     uint8_t CibirId[6];                 // CIBIR ID data
+
+    // Server-only. Where the partition ID is in the server's CIDs, for steering
+    // short header packets to the socket of the owning partition.
+    uint8_t CidPartitionIdOffset;       // Offset of the (2 byte) partition ID in the CID
+    uint16_t CidPartitionIdMask;        // Mask applied to the partition ID. 0 means unused
+    uint16_t CidPartitionCount;         // Partition index = (ID & Mask) % Count
 } CXPLAT_UDP_CONFIG;
 
 //
@@ -777,6 +832,56 @@ CxPlatSocketSend(
     _In_ CXPLAT_SEND_DATA* SendData
     );
 
+//
+// The maximum number of send contexts a send batch can hold.
+//
+#define CXPLAT_SEND_BATCH_SIZE 32
+
+//
+// Returns TRUE if enough sends are already waiting on the socket, for the
+// given route, that the caller should hold off building more until later.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+CxPlatSocketIsSendBlocked(
+    _In_ CXPLAT_SOCKET* Socket,
+    _In_ const CXPLAT_ROUTE* Route
+    );
+
+//
+// A set of sends, for a single socket, collected from different callers on
+// one thread so that the datapath can submit them together.
+//
+typedef struct CXPLAT_SEND_BATCH {
+    CXPLAT_SOCKET* Socket;
+    uint32_t Count;
+    CXPLAT_SEND_DATA* Sends[CXPLAT_SEND_BATCH_SIZE];
+} CXPLAT_SEND_BATCH;
+
+//
+// Queues the data to be sent over the socket with the rest of the batch. The
+// batch is flushed first if it is full. Returns FALSE if the datapath can't
+// batch the send, in which case it must be sent with CxPlatSocketSend instead.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+CxPlatSocketSendBatched(
+    _In_ CXPLAT_SOCKET* Socket,
+    _In_ const CXPLAT_ROUTE* Route,
+    _In_ CXPLAT_SEND_DATA* SendData,
+    _Inout_ CXPLAT_SEND_BATCH* Batch
+    );
+
+//
+// Sends all the data queued in the batch, using as few system calls as the
+// datapath allows, and empties the batch.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+CxPlatSendBatchFlush(
+    _Inout_ CXPLAT_SEND_BATCH* Batch
+    );
+
 typedef struct CXPLAT_TCP_STATISTICS { // Mostly copied from TCP_INFO_v1 for now
     uint32_t Mss;
     uint64_t ConnectionTimeMs;
@@ -908,6 +1013,58 @@ CxPlatDataPathRssConfigFree(
     _In_ CXPLAT_RSS_CONFIG* RssConfig
     );
 
+#if defined(CX_PLATFORM_LINUX)
+
+//
+// Settings for the Linux XDP datapath, read from xdp.ini in the working
+// directory.
+//
+typedef struct CXPLAT_XDP_CONFIG {
+    uint32_t FrameSize;     // UMEM frame size, 2K or 4K.
+    uint32_t FrameCount;    // Frames per UMEM.
+    uint32_t RxRingSize;
+    uint32_t TxRingSize;
+    uint32_t FillRingSize;
+    uint32_t CompRingSize;
+    BOOLEAN SharedUmem;     // One UMEM per interface instead of per queue.
+    BOOLEAN MultiBuffer;    // Receive frames larger than a UMEM frame as chains.
+    BOOLEAN TxAlwaysPoke;
+    BOOLEAN SkipXsum;
+} CXPLAT_XDP_CONFIG;
+
+//
+// Applies the "Name=Value" lines of the file (if any) over the defaults and
+// then replaces invalid values with their defaults. Only built with XDP
+// support (QUIC_LINUX_XDP_ENABLED).
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+CxPlatXdpParseConfig(
+    _In_opt_ FILE* File,
+    _Out_ CXPLAT_XDP_CONFIG* Config
+    );
+
+//
+// Hooks for tests to force epoll datapath code paths that otherwise depend on
+// the machine they run on. Only to be changed while no datapath exists.
+//
+typedef struct CXPLAT_DATAPATH_TEST_HOOKS {
+    //
+    // Free receive buffers as if on another NUMA node than their partition.
+    //
+    BOOLEAN ForceRemoteFrees;
+
+    //
+    // Don't attach the CID steering BPF program, so that all CID steering is
+    // done by the receive path.
+    //
+    BOOLEAN SkipCidSteeringProgram;
+} CXPLAT_DATAPATH_TEST_HOOKS;
+
+extern CXPLAT_DATAPATH_TEST_HOOKS CxPlatDataPathTestHooks;
+
+#endif // CX_PLATFORM_LINUX
+
 #if defined(__cplusplus)
 }
 #endif
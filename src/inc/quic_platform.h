@@ -151,6 +151,11 @@ typedef struct CXPLAT_SLIST_ENTRY {
 #define QUIC_POOL_APP_BUFFER_CHUNK          'D4cQ' // Qc4D - QUIC receive chunk for app buffers
 #define QUIC_POOL_CONN_POOL_API_TABLE       'E4cQ' // Qc4E - QUIC Connection Pool API table
 #define QUIC_POOL_DATAPATH_RSS_CONFIG       'F4cQ' // Qc4F - QUIC Datapath RSS configuration
+#define QUIC_POOL_RESUMPTION_CACHE          '05cQ' // Qc50 - QUIC resumption ticket cache
+#define QUIC_POOL_ANTI_REPLAY               '15cQ' // Qc51 - QUIC 0-RTT anti-replay filter
+#define QUIC_POOL_OBJECT_ARENA              '25cQ' // Qc52 - QUIC connection/stream arena
+#define QUIC_POOL_PACKET_SPACE_FROZEN       '35cQ' // Qc53 - QUIC hibernated packet space
+#define QUIC_POOL_ALPN_INDEX                '45cQ' // Qc54 - QUIC binding ALPN index
 
 typedef enum CXPLAT_THREAD_FLAGS {
     CXPLAT_THREAD_FLAG_NONE               = 0x0000,
@@ -421,6 +426,7 @@ CxPlatListPopEntry(
 
 #include "quic_hashtable.h"
 #include "quic_toeplitz.h"
+#include "quic_checksum.h"
 
 #ifdef DEBUG
 void
@@ -439,12 +445,46 @@ CxPlatGetAllocFailDenominator(
 #define CxPlatIsRandomMemoryFailureEnabled() (FALSE)
 #endif
 
+//
+// Large page allocation interface. Used for regions holding many objects that
+// are frequently walked together, to reduce TLB pressure.
+//
+
+#define CXPLAT_LARGE_PAGE_SIZE  (2 * 1024 * 1024)
+
+//
+// Allocates a zeroed region of Size bytes (a multiple of CXPLAT_LARGE_PAGE_SIZE)
+// on the NUMA node of the given processor. The region is backed by large pages
+// if the system allows it, as indicated by IsLargePage; otherwise regular pages
+// are used. IsLargePage is only set when the backing is guaranteed, so a region
+// of regular pages the OS may still promote (e.g. Linux transparent huge pages)
+// reports FALSE.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+_Ret_maybenull_
+void*
+CxPlatLargePageAlloc(
+    _In_ size_t Size,
+    _In_ uint16_t Processor,
+    _In_ uint32_t Tag,
+    _Out_ BOOLEAN* IsLargePage
+    );
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+CxPlatLargePageFree(
+    _In_ void* Memory,
+    _In_ size_t Size,
+    _In_ uint32_t Tag
+    );
+
 //
 // General purpose execution context abstraction layer. Used for driving worker
 // loops.
 //
 
 typedef struct QUIC_EXECUTION_CONFIG QUIC_EXECUTION_CONFIG;
+typedef struct QUIC_POOL_STATS QUIC_POOL_STATS;
 
 typedef struct CXPLAT_EXECUTION_CONTEXT CXPLAT_EXECUTION_CONTEXT;
 
@@ -496,6 +536,12 @@ CxPlatWorkerPoolGetEventQ(
     _In_ uint16_t Index // Into the config processor array
     );
 
+uint16_t
+CxPlatWorkerPoolGetIdealProcessor(
+    _In_ CXPLAT_WORKER_POOL* WorkerPool,
+    _In_ uint16_t Index // Into the config processor array
+    );
+
 void
 CxPlatWorkerPoolAddExecutionContext(
     _In_ CXPLAT_WORKER_POOL* WorkerPool,
@@ -507,12 +553,56 @@ CxPlatWorkerPoolAddExecutionContext(
 // Supports more dynamic operations, but must be submitted to the platform worker
 // to manage.
 //
+// The worker periodically resizes the pool to fit recent demand: the number of
+// entries drawn from the pool during a period (its allocation high-water mark)
+// plus any allocations the pool couldn't satisfy. The target depth grows to
+// the demand immediately and decays slowly once demand drops off, and free
+// entries above the target are returned to the system.
+//
 typedef struct CXPLAT_POOL_EX {
     CXPLAT_POOL Base;
     CXPLAT_LIST_ENTRY Link;
     void* Owner;
+
+    //
+    // Statistics, updated without synchronization by the allocating thread
+    // (usually the owning worker), so only approximate.
+    //
+    uint64_t AllocCount;
+    uint64_t MissCount;     // Allocations that found the pool empty.
+
+    //
+    // The lowest depth seen by an allocation in the current period. Depths
+    // here are as seen by the allocating thread (CxPlatPoolGetLocalDepth),
+    // so that an allocation that finds the depth at zero is a real miss.
+    //
+    uint32_t MinDepth;
+
+    //
+    // Adaptive sizing state, only used by the owning worker.
+    //
+    uint32_t PeriodStartDepth;
+    uint32_t TargetDepth;
+    uint64_t LastMissCount;
 } CXPLAT_POOL_EX;
 
+inline
+void*
+CxPlatPoolExAlloc(
+    _Inout_ CXPLAT_POOL_EX* Pool
+    )
+{
+    const uint32_t Depth = CxPlatPoolGetLocalDepth(&Pool->Base);
+    if (Depth < Pool->MinDepth) {
+        Pool->MinDepth = Depth;
+    }
+    if (Depth == 0) {
+        Pool->MissCount++;
+    }
+    Pool->AllocCount++;
+    return CxPlatPoolAlloc(&Pool->Base);
+}
+
 void
 CxPlatAddDynamicPoolAllocator(
     _In_ CXPLAT_WORKER_POOL* WorkerPool,
@@ -525,6 +615,17 @@ CxPlatRemoveDynamicPoolAllocator(
     _Inout_ CXPLAT_POOL_EX* Pool
     );
 
+//
+// Fills in statistics for up to StatsCount dynamic pools, across all workers.
+// Returns the total number of dynamic pools.
+//
+uint32_t
+CxPlatWorkerPoolGetPoolStats(
+    _In_ CXPLAT_WORKER_POOL* WorkerPool,
+    _In_ uint32_t StatsCount,
+    _Out_writes_(StatsCount) QUIC_POOL_STATS* Stats
+    );
+
 #endif // !_KERNEL_MODE
 
 //
@@ -206,6 +206,17 @@ InterlockedExchangePointer(
     return __sync_lock_test_and_set(Target, Value);
 }
 
+inline
+void*
+InterlockedCompareExchangePointer(
+    _Inout_ _Interlocked_operand_ void* volatile *Destination,
+    _In_opt_ void* ExChange,
+    _In_opt_ void* Comperand
+    )
+{
+    return __sync_val_compare_and_swap(Destination, Comperand, ExChange);
+}
+
 inline
 void*
 InterlockedFetchAndClearPointer(
@@ -443,7 +454,39 @@ CxPlatListPopEntry(
     _Inout_ CXPLAT_SLIST_ENTRY* ListHead
     );
 
-typedef struct CXPLAT_POOL {
+//
+// The pool is implemented as a set of per-thread caches ("magazines") of free
+// entries, backed by a shared "depot" of fixed size batches of free entries.
+//
+// Allocations and frees only touch the calling thread's magazine (no locks or
+// atomics), regardless of which thread allocated the entry. When a magazine
+// overflows, a batch is moved to the depot; when it runs dry, a batch is taken
+// from the depot. The depot is a lock-free stack of batches: batches are
+// pushed with compare-exchange and only ever removed all at once (exchange),
+// so it isn't susceptible to ABA.
+//
+// Each magazine's capacity adapts: it grows when the depot can't satisfy a
+// refill and shrinks when the depot is full and entries have to be returned to
+// the system allocator. A thread's magazines are freed when it exits.
+//
+// Only pools with a dynamic depth (CXPLAT_POOL_EX) are pruned periodically.
+// Any other pool caches at most MaxDepotBatches batches in the depot plus up
+// to CXPLAT_POOL_MAXIMUM_DEPTH entries per thread that uses it, until that
+// thread exits or the pool is uninitialized.
+//
+
+#define CXPLAT_POOL_BATCH_SIZE          32
+#define CXPLAT_POOL_MAX_DEPOT_BATCHES   16
+
+typedef struct CXPLAT_POOL_HEADER CXPLAT_POOL_HEADER;
+
+typedef struct CXPLAT_POOL_MAGAZINE {
+
+    //
+    // Link in the pool's list of magazines.
+    //
+
+    struct CXPLAT_POOL_MAGAZINE* Next;
 
     //
     // List of free entries.
@@ -455,15 +498,78 @@ typedef struct CXPLAT_POOL {
     // Number of free entries in the list.
     //
 
-    uint16_t ListDepth;
+    uint16_t Depth;
+
+    //
+    // Current maximum number of free entries in the list.
+    //
+
+    uint16_t Capacity;
+
+    //
+    // The thread that owns (and is the only user of) this magazine.
+    //
+
+    uint32_t ThreadId;
+
+    //
+    // Set by CxPlatPoolPrune on another thread to have the owner free all the
+    // magazine's entries the next time it uses the pool.
+    //
+
+    BOOLEAN volatile DrainRequested;
+
+} CXPLAT_POOL_MAGAZINE;
+
+typedef struct CXPLAT_POOL {
+
+    //
+    // Process-wide unique identifier for the pool. Used to find the calling
+    // thread's magazine.
+    //
+
+    uint64_t Id;
+
+    //
+    // One more than the index of the pool's entry in each thread's magazine
+    // cache, or zero if the pool has no entry (including a zeroed pool that
+    // was never initialized). Slots are reused once a pool is uninitialized,
+    // so there are only as many as there are live pools.
+    //
+
+    uint32_t Slot;
+
+    //
+    // Stack of batches of free entries, shared by all threads.
+    //
+
+    CXPLAT_POOL_HEADER* volatile Depot;
 
     //
-    // Lock to synchronize access to the List.
-    // LINUX_TODO: Check how to make this lock free?
+    // Number of batches in the depot.
+    //
+
+    long volatile DepotBatchCount;
+
+    //
+    // Number of batches the depot may hold before flushed batches are returned
+    // to the system allocator.
+    //
+
+    uint32_t MaxDepotBatches;
+
+    //
+    // Lock to synchronize access to the list of magazines.
     //
 
     CXPLAT_LOCK Lock;
 
+    //
+    // List of all per-thread magazines for this pool.
+    //
+
+    CXPLAT_POOL_MAGAZINE* Magazines;
+
     //
     // Size of entries.
     //
@@ -478,15 +584,20 @@ typedef struct CXPLAT_POOL {
 
 } CXPLAT_POOL;
 
-typedef struct __attribute__((aligned(16))) CXPLAT_POOL_HEADER {
+struct __attribute__((aligned(16))) CXPLAT_POOL_HEADER {
     union {
     CXPLAT_POOL* Owner;
     CXPLAT_SLIST_ENTRY Entry;
     };
+    //
+    // Only valid for the first entry of a batch in the depot. Links to the
+    // next batch.
+    //
+    CXPLAT_POOL_HEADER* NextBatch;
 #if DEBUG
     uint64_t SpecialFlag;
 #endif
-} CXPLAT_POOL_HEADER;
+};
 
 #define CXPLAT_POOL_FREE_FLAG   0xAAAAAAAAAAAAAAAAull
 #define CXPLAT_POOL_ALLOC_FLAG  0xE9E9E9E9E9E9E9E9ull
@@ -497,41 +608,154 @@ typedef struct __attribute__((aligned(16))) CXPLAT_POOL_HEADER {
 #define CXPLAT_POOL_MAXIMUM_DEPTH   0   // TODO - Optimize this scenario better
 #endif
 
+//
+// Per-thread cache of the thread's magazines, indexed by pool slot and grown
+// on demand. Each entry is tagged with the ID of the pool it was created for,
+// so an entry left behind by a pool whose slot has since been reused doesn't
+// match.
+//
+
+typedef struct CXPLAT_POOL_TLS_ENTRY {
+    uint64_t PoolId;
+    CXPLAT_POOL_MAGAZINE* Magazine;
+} CXPLAT_POOL_TLS_ENTRY;
+
+extern __thread CXPLAT_POOL_TLS_ENTRY* CxPlatPoolTlsCache;
+extern __thread uint32_t CxPlatPoolTlsCacheSize;
+
 #if DEBUG
 int32_t
 CxPlatGetAllocFailDenominator(
     );
 #endif
 
-inline
 void
 CxPlatPoolInitialize(
     _In_ BOOLEAN IsPaged,
     _In_ uint32_t Size,
     _In_ uint32_t Tag,
     _Inout_ CXPLAT_POOL* Pool
+    );
+
+//
+// All threads must be done using the pool.
+//
+void
+CxPlatPoolUninitialize(
+    _Inout_ CXPLAT_POOL* Pool
+    );
+
+//
+// Finds (or creates) the calling thread's magazine. Returns NULL on
+// allocation failure, in which case the pool is bypassed.
+//
+CXPLAT_POOL_MAGAZINE*
+CxPlatPoolGetMagazineSlow(
+    _Inout_ CXPLAT_POOL* Pool
+    );
+
+//
+// Moves a batch from the depot into the (empty) magazine.
+//
+void
+CxPlatPoolMagazineRefill(
+    _Inout_ CXPLAT_POOL* Pool,
+    _Inout_ CXPLAT_POOL_MAGAZINE* Magazine
+    );
+
+//
+// Moves a batch from the (full) magazine into the depot.
+//
+void
+CxPlatPoolMagazineFlush(
+    _Inout_ CXPLAT_POOL* Pool,
+    _Inout_ CXPLAT_POOL_MAGAZINE* Magazine
+    );
+
+//
+// Frees all the entries in the calling thread's magazine.
+//
+void
+CxPlatPoolMagazineDrain(
+    _Inout_ CXPLAT_POOL* Pool,
+    _Inout_ CXPLAT_POOL_MAGAZINE* Magazine
+    );
+
+//
+// Frees one batch of entries from the depot. Once the depot is empty, frees
+// the calling thread's magazine and has every other thread free its magazine
+// the next time it uses the pool. Returns FALSE if nothing was freed.
+//
+BOOLEAN
+CxPlatPoolPrune(
+    _Inout_ CXPLAT_POOL* Pool
+    );
+
+//
+// Returns the number of free entries cached by the pool, in the depot and in
+// every thread's magazine. Other threads' magazines are read without
+// synchronization, so the result is approximate. Takes the pool lock, so
+// it isn't meant for the allocation path.
+//
+uint32_t
+CxPlatPoolGetDepth(
+    _In_ CXPLAT_POOL* Pool
+    );
+
+//
+// Returns the number of free entries the calling thread can allocate before
+// having to fall back to the system allocator: those in the depot and in its
+// own magazine.
+//
+inline
+uint32_t
+CxPlatPoolGetLocalDepth(
+    _In_ const CXPLAT_POOL* Pool
     )
 {
-    Pool->Size = Size + sizeof(CXPLAT_POOL_HEADER); // Add space for the pool header
-    Pool->Tag = Tag;
-    CxPlatLockInitialize(&Pool->Lock);
-    Pool->ListDepth = 0;
-    CxPlatZeroMemory(&Pool->ListHead, sizeof(Pool->ListHead));
-    UNREFERENCED_PARAMETER(IsPaged);
+    uint32_t Depth = (uint32_t)Pool->DepotBatchCount * CXPLAT_POOL_BATCH_SIZE;
+    const uint32_t Index = Pool->Slot - 1; // UINT32_MAX without a slot
+    if (Index < CxPlatPoolTlsCacheSize) {
+        const CXPLAT_POOL_TLS_ENTRY* Entry = &CxPlatPoolTlsCache[Index];
+        if (Entry->PoolId == Pool->Id) {
+            Depth += Entry->Magazine->Depth;
+        }
+    }
+    return Depth;
 }
 
+//
+// Sets the (approximate) number of free entries the depot, and each thread's
+// magazine, may hold.
+//
 inline
 void
-CxPlatPoolUninitialize(
+CxPlatPoolSetMaxDepth(
+    _Inout_ CXPLAT_POOL* Pool,
+    _In_ uint32_t MaxDepth
+    )
+{
+    Pool->MaxDepotBatches =
+        (MaxDepth + CXPLAT_POOL_BATCH_SIZE - 1) / CXPLAT_POOL_BATCH_SIZE;
+}
+
+inline
+CXPLAT_POOL_MAGAZINE*
+CxPlatPoolGetMagazine(
     _Inout_ CXPLAT_POOL* Pool
     )
 {
-    CXPLAT_POOL_HEADER* Entry;
-    while ((Entry = (CXPLAT_POOL_HEADER*)CxPlatListPopEntry(&Pool->ListHead)) != NULL) {
-        CXPLAT_DBG_ASSERT(Entry->SpecialFlag == CXPLAT_POOL_FREE_FLAG);
-        CxPlatFree(Entry, Pool->Tag);
+    const uint32_t Index = Pool->Slot - 1; // UINT32_MAX without a slot
+    if (Index < CxPlatPoolTlsCacheSize) {
+        CXPLAT_POOL_TLS_ENTRY* Entry = &CxPlatPoolTlsCache[Index];
+        if (Entry->PoolId == Pool->Id) {
+            if (Entry->Magazine->DrainRequested) {
+                CxPlatPoolMagazineDrain(Pool, Entry->Magazine);
+            }
+            return Entry->Magazine;
+        }
     }
-    CxPlatLockUninitialize(&Pool->Lock);
+    return CxPlatPoolGetMagazineSlow(Pool);
 }
 
 inline
@@ -540,18 +764,26 @@ CxPlatPoolAlloc(
     _Inout_ CXPLAT_POOL* Pool
     )
 {
-    CxPlatLockAcquire(&Pool->Lock);
-    CXPLAT_POOL_HEADER* Header =
-    #if DEBUG
-        CxPlatGetAllocFailDenominator() ? NULL : // No pool when using simulated alloc failures
-    #endif
-        (CXPLAT_POOL_HEADER*)CxPlatListPopEntry(&Pool->ListHead);
-    if (Header != NULL) {
-        CXPLAT_DBG_ASSERT(Pool->ListDepth > 0);
-        CXPLAT_DBG_ASSERT(Header->SpecialFlag == CXPLAT_POOL_FREE_FLAG);
-        Pool->ListDepth--;
+    CXPLAT_POOL_HEADER* Header = NULL;
+#if CXPLAT_POOL_MAXIMUM_DEPTH > 0
+#if DEBUG
+    if (!CxPlatGetAllocFailDenominator()) // No pool when using simulated alloc failures
+#endif
+    {
+        CXPLAT_POOL_MAGAZINE* Magazine = CxPlatPoolGetMagazine(Pool);
+        if (Magazine != NULL) {
+            if (Magazine->Depth == 0) {
+                CxPlatPoolMagazineRefill(Pool, Magazine);
+            }
+            Header = (CXPLAT_POOL_HEADER*)CxPlatListPopEntry(&Magazine->ListHead);
+            if (Header != NULL) {
+                CXPLAT_DBG_ASSERT(Magazine->Depth > 0);
+                CXPLAT_DBG_ASSERT(Header->SpecialFlag == CXPLAT_POOL_FREE_FLAG);
+                Magazine->Depth--;
+            }
+        }
     }
-    CxPlatLockRelease(&Pool->Lock);
+#endif
     if (Header == NULL) {
         Header = (CXPLAT_POOL_HEADER*)CxPlatAlloc(Pool->Size, Pool->Tag);
         if (Header == NULL) {
@@ -581,34 +813,18 @@ CxPlatPoolFree(
     }
     Header->SpecialFlag = CXPLAT_POOL_FREE_FLAG;
 #endif
-    if (Pool->ListDepth >= CXPLAT_POOL_MAXIMUM_DEPTH) {
-        CxPlatFree(Header, Pool->Tag);
-    } else {
-        CxPlatLockAcquire(&Pool->Lock);
-        CxPlatListPushEntry(&Pool->ListHead, &Header->Entry);
-        Pool->ListDepth++;
-        CxPlatLockRelease(&Pool->Lock);
-    }
-}
-
-inline
-BOOLEAN
-CxPlatPoolPrune(
-    _Inout_ CXPLAT_POOL* Pool
-    )
-{
-    CxPlatLockAcquire(&Pool->Lock);
-    void* Entry = CxPlatListPopEntry(&Pool->ListHead);
-    if (Entry != NULL) {
-        CXPLAT_FRE_ASSERT(Pool->ListDepth > 0);
-        Pool->ListDepth--;
-    }
-    CxPlatLockRelease(&Pool->Lock);
-    if (Entry == NULL) {
-        return FALSE;
+#if CXPLAT_POOL_MAXIMUM_DEPTH > 0
+    CXPLAT_POOL_MAGAZINE* Magazine = CxPlatPoolGetMagazine(Pool);
+    if (Magazine != NULL) {
+        if (Magazine->Depth >= Magazine->Capacity) {
+            CxPlatPoolMagazineFlush(Pool, Magazine);
+        }
+        CxPlatListPushEntry(&Magazine->ListHead, &Header->Entry);
+        Magazine->Depth++;
+        return;
     }
-    CxPlatFree(Entry, Pool->Tag);
-    return TRUE;
+#endif
+    CxPlatFree(Header, Pool->Tag);
 }
 
 //
@@ -1414,6 +1630,14 @@ CxPlatProcCurrentNumber(
     void
     );
 
+//
+// Returns the NUMA node of the processor, or 0 if NUMA isn't supported.
+//
+uint32_t
+CxPlatProcNumaNode(
+    _In_ uint32_t Processor
+    );
+
 //
 // Rundown Protection Interfaces.
 //
@@ -474,6 +474,38 @@ CxPlatPoolFree(
     }
 }
 
+inline
+uint32_t
+CxPlatPoolGetDepth(
+    _In_ CXPLAT_POOL* Pool
+    )
+{
+    return QueryDepthSList(&Pool->ListHead);
+}
+
+//
+// All threads share the pool's list, so every free entry is available to the
+// calling thread.
+//
+inline
+uint32_t
+CxPlatPoolGetLocalDepth(
+    _In_ CXPLAT_POOL* Pool
+    )
+{
+    return QueryDepthSList(&Pool->ListHead);
+}
+
+inline
+void
+CxPlatPoolSetMaxDepth(
+    _Inout_ CXPLAT_POOL* Pool,
+    _In_ uint32_t MaxDepth
+    )
+{
+    Pool->MaxDepth = CXPLAT_MIN(MaxDepth, CXPLAT_POOL_MAXIMUM_DEPTH);
+}
+
 inline
 BOOLEAN
 CxPlatPoolPrune(
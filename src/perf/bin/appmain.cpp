@@ -315,7 +315,11 @@ main(
     const char* FileName = nullptr;
     TryGetValue(argc, argv, "extraOutputFile", &FileName);
 
-    if (!TryGetTarget(argc, argv)) { // Only create certificate on server
+    const char* IoMode = nullptr;
+    TryGetValue(argc, argv, "io", &IoMode);
+    bool Loopback = IoMode && IsValue(IoMode, "loopback");
+
+    if (!TryGetTarget(argc, argv) || Loopback) { // Only create certificate on server
         SelfSignedCredConfig =
             CxPlatGetSelfSignedCert(CXPLAT_SELF_SIGN_CERT_USER, FALSE, NULL);
         if (!SelfSignedCredConfig) {
@@ -15,6 +15,10 @@ Abstract:
 #include "PerfClient.cpp.clog.h"
 #endif
 
+#ifndef _KERNEL_MODE
+#include <random>
+#endif
+
 QUIC_STATUS
 PerfClient::Init(
     _In_ int argc,
@@ -195,6 +199,44 @@ PerfClient::Init(
         return QUIC_STATUS_INVALID_PARAMETER;
     }
 
+    TryGetValue(argc, argv, "rate", &RequestRate);
+    const char* ArrivalStr = nullptr;
+    if (TryGetValue(argc, argv, "arrival", &ArrivalStr)) {
+        if (IsValue(ArrivalStr, "poisson")) {
+#ifndef _KERNEL_MODE
+            ArrivalType = PERF_ARRIVAL_POISSON;
+#else
+            WriteOutput("Kernel mode supports only the constant arrival type\n");
+            return QUIC_STATUS_INVALID_PARAMETER;
+#endif
+        } else if (!IsValue(ArrivalStr, "constant")) {
+            WriteOutput("Failed to parse arrival[%s] parameter!\n", ArrivalStr);
+            return QUIC_STATUS_INVALID_PARAMETER;
+        }
+    }
+
+    if (RequestRate) {
+        if (!RunTime) {
+            WriteOutput("Must specify a 'runtime' if using 'rate'!\n");
+            return QUIC_STATUS_INVALID_PARAMETER;
+        }
+        if (RepeatStreams) {
+            WriteOutput("'rate' (open-loop) and 'rstream' (closed-loop) are exclusive!\n");
+            return QUIC_STATUS_INVALID_PARAMETER;
+        }
+        //
+        // Each worker issues its share of the total rate on its own schedule.
+        // Connections are spread round-robin across the workers, so only the
+        // first min(conns, workers) of them ever have any to issue on.
+        //
+        const uint32_t RateWorkerCount =
+            CXPLAT_MAX(1u, CXPLAT_MIN(WorkerCount, ConnectionCount));
+        RequestIntervalNs = (1000ull * 1000 * 1000 * RateWorkerCount) / RequestRate;
+        if (RequestIntervalNs == 0) {
+            RequestIntervalNs = 1;
+        }
+    }
+
     if (UseTCP) {
         if (!UseEncryption) {
             WriteOutput("TCP mode doesn't support disabling encryption!\n");
@@ -204,6 +246,10 @@ PerfClient::Init(
             WriteOutput("TCP mode doesn't support CIBIR!\n");
             return QUIC_STATUS_INVALID_PARAMETER;
         }
+        if (RequestRate) {
+            WriteOutput("TCP mode doesn't support open-loop 'rate'!\n");
+            return QUIC_STATUS_INVALID_PARAMETER;
+        }
     }
 
     if ((Upload || Download) && !StreamCount) {
@@ -257,7 +303,17 @@ PerfClient::Init(
 
     RequestBuffer.Init(IoSize, Timed ? UINT64_MAX : Download);
     if (PrintLatency) {
-        if (RunTime) {
+        if (RequestRate) {
+            //
+            // The open-loop schedule bounds how many requests can be issued.
+            //
+            MaxLatencyIndex = ((uint64_t)RunTime / (1000 * 1000) + 1) * RequestRate + WorkerCount;
+            if (MaxLatencyIndex > (UINT32_MAX / sizeof(uint32_t))) {
+                MaxLatencyIndex = UINT32_MAX / sizeof(uint32_t);
+                WriteOutput("Warning! Limiting request latency tracking to %llu requests\n",
+                    (unsigned long long)MaxLatencyIndex);
+            }
+        } else if (RunTime) {
             MaxLatencyIndex = ((uint64_t)RunTime / (1000 * 1000)) * PERF_MAX_REQUESTS_PER_SECOND;
             if (MaxLatencyIndex > (UINT32_MAX / sizeof(uint32_t))) {
                 MaxLatencyIndex = UINT32_MAX / sizeof(uint32_t);
@@ -455,10 +511,108 @@ PerfClientWorker::WorkerThread() {
         while (Client->Running && ConnectionsCreated < ConnectionsQueued) {
             StartNewConnection();
         }
-        WakeEvent.WaitForever();
+        if (Client->RequestRate) {
+            const uint32_t WaitMs = IssueOpenLoopRequests();
+            if (WaitMs == UINT32_MAX) {
+                WakeEvent.WaitForever(); // No connections to issue requests on yet.
+            } else if (WaitMs != 0) {
+                WakeEvent.WaitTimeout(WaitMs);
+            } else {
+                CxPlatSchedulerYield();
+            }
+        } else {
+            WakeEvent.WaitForever();
+        }
     }
 }
 
+uint64_t
+PerfClientWorker::GetNextArrivalDelayNs() {
+#ifndef _KERNEL_MODE
+    if (Client->ArrivalType == PERF_ARRIVAL_POISSON) {
+        //
+        // Exponentially distributed inter-arrival times produce a Poisson
+        // arrival process with the configured mean rate. Only this worker's
+        // thread draws from the generator.
+        //
+        static thread_local std::mt19937_64 Generator(CxPlatTimeUs64() ^ (uint64_t)this);
+        std::exponential_distribution<double> Distribution(1.0 / (double)Client->RequestIntervalNs);
+        return (uint64_t)Distribution(Generator);
+    }
+#endif
+    return Client->RequestIntervalNs;
+}
+
+//
+// Issues all open-loop requests whose intended send time has passed. Requests
+// are never skipped when the worker falls behind; they are issued back to back
+// with their original intended send time so that the latency recorded includes
+// any queuing delay (i.e. no coordinated omission). Returns how long to wait
+// (in ms) before the next request is due, 0 if it is due in less than a
+// millisecond, or UINT32_MAX if there are no connected connections.
+//
+uint32_t
+PerfClientWorker::IssueOpenLoopRequests() {
+    uint64_t NowNs = CxPlatTimeUs64() * 1000;
+
+    Lock.Acquire();
+    if (CxPlatListIsEmpty(&OpenLoopConnections)) {
+        Lock.Release();
+        return UINT32_MAX;
+    }
+
+    if (NextRequestTimeNs == 0) {
+        NextRequestTimeNs = NowNs; // Start the schedule with the first connection.
+    }
+
+    uint32_t Issued = 0;
+    while (Client->Running && NextRequestTimeNs <= NowNs &&
+           !CxPlatListIsEmpty(&OpenLoopConnections)) {
+        //
+        // Round-robin the requests across the worker's connections.
+        //
+        CXPLAT_LIST_ENTRY* Entry = CxPlatListRemoveHead(&OpenLoopConnections);
+        CxPlatListInsertTail(&OpenLoopConnections, Entry);
+        auto Connection =
+            CXPLAT_CONTAINING_RECORD(Entry, PerfOpenLoopEntry, Link)->Connection;
+        Connection->StartNewStream(NextRequestTimeNs / 1000);
+        NextRequestTimeNs += GetNextArrivalDelayNs();
+
+        if (++Issued % 64 == 0) {
+            NowNs = CxPlatTimeUs64() * 1000; // Refresh for long backlogs.
+        }
+    }
+    Lock.Release();
+
+    if (NextRequestTimeNs <= NowNs) {
+        return 0;
+    }
+    return (uint32_t)((NextRequestTimeNs - NowNs) / (1000 * 1000));
+}
+
+void
+PerfClientWorker::AddOpenLoopConnection(
+    _In_ PerfClientConnection* Connection
+    ) {
+    Lock.Acquire();
+    CxPlatListInsertTail(&OpenLoopConnections, &Connection->OpenLoopEntry.Link);
+    Connection->InOpenLoopList = true;
+    Lock.Release();
+    WakeEvent.Set();
+}
+
+void
+PerfClientWorker::RemoveOpenLoopConnection(
+    _In_ PerfClientConnection* Connection
+    ) {
+    Lock.Acquire();
+    if (Connection->InOpenLoopList) {
+        CxPlatListEntryRemove(&Connection->OpenLoopEntry.Link);
+        Connection->InOpenLoopList = false;
+    }
+    Lock.Release();
+}
+
 void
 PerfClientWorker::StartNewConnection() {
     InterlockedIncrement64((int64_t*)&ConnectionsCreated);
@@ -622,7 +776,9 @@ PerfClientConnection::Initialize() {
 void
 PerfClientConnection::OnHandshakeComplete() {
     InterlockedIncrement64((int64_t*)&Worker.ConnectionsConnected);
-    if (!Client.StreamCount) {
+    if (Client.RequestRate) {
+        Worker.AddOpenLoopConnection(this); // Worker issues requests on its schedule
+    } else if (!Client.StreamCount) {
         WorkerConnComplete = true;
         Worker.OnConnectionComplete();
         Shutdown();
@@ -650,6 +806,10 @@ PerfClientConnection::OnShutdownComplete() {
         StreamTable.EnumEnd(&Enum);
     }
 
+    if (Client.RequestRate) {
+        Worker.RemoveOpenLoopConnection(this);
+    }
+
     if (!WorkerConnComplete) {
         Worker.OnConnectionComplete();
     }
@@ -657,10 +817,11 @@ PerfClientConnection::OnShutdownComplete() {
 }
 
 void
-PerfClientConnection::StartNewStream() {
+PerfClientConnection::StartNewStream(uint64_t IntendedStartTime) {
     StreamsCreated++;
-    StreamsActive++;
+    InterlockedIncrement64((int64_t*)&StreamsActive);
     auto Stream = Worker.StreamPool.Alloc(*this);
+    Stream->IntendedStartTime = IntendedStartTime; // Open-loop latency is from the scheduled time
     if (Client.UseTCP) {
         Stream->Entry.Signature = (uint32_t)Worker.StreamsStarted;
         StreamTable.Insert(&Stream->Entry);
@@ -695,17 +856,19 @@ PerfClientConnection::GetTcpStream(uint32_t ID) {
 
 void
 PerfClientConnection::OnStreamShutdown() {
-    StreamsActive--;
+    const auto Active = InterlockedDecrement64((int64_t*)&StreamsActive);
     if (!Client.Running) {
-        if (!StreamsActive) {
+        if (!Active) {
             Shutdown();
         }
+    } else if (Client.RequestRate) {
+        // Open-loop requests are issued by the worker, independent of completions.
     } else if (Client.RepeatStreams) {
-        while (StreamsActive < Client.StreamCount) {
+        for (auto i = (uint64_t)Active; i < Client.StreamCount; ++i) {
             StartNewStream();
         }
     } else {
-        if (!StreamsActive && StreamsCreated == Client.StreamCount) {
+        if (!Active && StreamsCreated == Client.StreamCount) {
             Shutdown();
         }
     }
@@ -1009,7 +1172,8 @@ PerfClientStream::OnShutdown() {
         if (Client.Running) {
             const auto Index = (uint64_t)InterlockedIncrement64((int64_t*)&Connection.Client.CurLatencyIndex) - 1;
             if (Index < Client.MaxLatencyIndex) {
-                const auto Latency = CxPlatTimeDiff64(StartTime, RecvEndTime);
+                const auto Latency =
+                    CxPlatTimeDiff64(IntendedStartTime ? IntendedStartTime : StartTime, RecvEndTime);
                 Client.LatencyValues[(size_t)Index] = Latency > UINT32_MAX ? UINT32_MAX : (uint32_t)Latency;
                 InterlockedIncrement64((int64_t*)&Connection.Client.LatencyCount);
             }
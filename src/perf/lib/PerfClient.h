@@ -14,6 +14,16 @@ Abstract:
 #include "SecNetPerf.h"
 #include "Tcp.h"
 
+typedef enum PERF_ARRIVAL_TYPE {
+    PERF_ARRIVAL_CONSTANT,
+    PERF_ARRIVAL_POISSON
+} PERF_ARRIVAL_TYPE;
+
+struct PerfOpenLoopEntry {
+    CXPLAT_LIST_ENTRY Link; // To Worker OpenLoopConnections (must be first)
+    struct PerfClientConnection* Connection;
+};
+
 struct PerfClientConnection {
     struct PerfClient& Client;
     struct PerfClientWorker& Worker;
@@ -22,13 +32,15 @@ struct PerfClientConnection {
     TcpConnection* TcpConn;
     };
     CxPlatHashTable StreamTable;
+    PerfOpenLoopEntry OpenLoopEntry {{nullptr, nullptr}, this};
     uint64_t StreamsCreated {0};
     uint64_t StreamsActive {0};
     bool WorkerConnComplete {false}; // Indicated completion to worker
+    bool InOpenLoopList {false};
     PerfClientConnection(_In_ PerfClient& Client, _In_ PerfClientWorker& Worker) : Client(Client), Worker(Worker) { }
     ~PerfClientConnection();
     void Initialize();
-    void StartNewStream();
+    void StartNewStream(uint64_t IntendedStartTime = 0);
     void OnHandshakeComplete();
     void OnShutdownComplete();
     void OnStreamShutdown();
@@ -62,6 +74,7 @@ struct PerfClientStream {
     PerfClientConnection& Connection;
     HQUIC Handle {nullptr};
     uint64_t StartTime {CxPlatTimeUs64()};
+    uint64_t IntendedStartTime {0}; // Open-loop scheduled send time, for latency only
     uint64_t RecvStartTime {0};
     uint64_t SendEndTime {0};
     uint64_t RecvEndTime {0};
@@ -100,11 +113,13 @@ struct QUIC_CACHEALIGN PerfClientWorker {
     UniquePtr<char[]> Target;
     QuicAddr LocalAddr;
     QuicAddr RemoteAddr;
+    CXPLAT_LIST_ENTRY OpenLoopConnections; // Connected connections, protected by Lock
+    uint64_t NextRequestTimeNs {0}; // Intended send time of the next open-loop request
     CxPlatPoolT<PerfClientConnection> ConnectionPool;
     CxPlatPoolT<PerfClientStream> StreamPool;
     CxPlatPoolT<TcpConnection> TcpConnectionPool;
     CxPlatPoolT<TcpSendData> TcpSendDataPool;
-    PerfClientWorker() { }
+    PerfClientWorker() { CxPlatListInitializeHead(&OpenLoopConnections); }
     ~PerfClientWorker() { WaitForThread(); }
     void Uninitialize() { WaitForThread(); }
     void QueueNewConnection() {
@@ -112,6 +127,8 @@ struct QUIC_CACHEALIGN PerfClientWorker {
         WakeEvent.Set();
     }
     void OnConnectionComplete();
+    void AddOpenLoopConnection(_In_ PerfClientConnection* Connection);
+    void RemoveOpenLoopConnection(_In_ PerfClientConnection* Connection);
     static CXPLAT_THREAD_CALLBACK(s_WorkerThread, Context) {
         ((PerfClientWorker*)Context)->WorkerThread();
         CXPLAT_THREAD_RETURN(QUIC_STATUS_SUCCESS);
@@ -126,6 +143,8 @@ private:
         }
     }
     void StartNewConnection();
+    uint32_t IssueOpenLoopRequests();
+    uint64_t GetNextArrivalDelayNs();
     void WorkerThread();
 };
 
@@ -210,6 +229,10 @@ struct PerfClient {
     uint8_t RepeatConnections {FALSE};
     uint8_t RepeatStreams {FALSE};
     uint64_t RunTime {0};
+    // Open-loop parameters
+    uint32_t RequestRate {0}; // Target requests per second (0 = closed-loop)
+    PERF_ARRIVAL_TYPE ArrivalType {PERF_ARRIVAL_CONSTANT};
+    uint64_t RequestIntervalNs {0}; // Mean per-worker interval between requests
 
     struct PerfIoBuffer {
         QUIC_BUFFER* Buffer {nullptr};
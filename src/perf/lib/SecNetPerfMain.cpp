@@ -123,6 +123,9 @@ PrintHelp(
         "  -rconn:<0/1>             Repeat the scenario at the connection level. (def:0)\n"
         "  -rstream:<0/1>           Repeat the scenario at the stream level. (def:0)\n"
         "  -runtime:<####>[unit]    The total runtime, with an optional unit (def unit is us). Only relevant for repeat scenarios. (def:0)\n"
+        "  -rate:<####>             Open-loop target request rate (requests/sec) across all workers. Latency is measured from the intended send time. Requires 'runtime'. (def:0)\n"
+        "  -arrival:<type>          Open-loop request arrival distribution used with 'rate'.\n"
+        "                            - {constant, poisson (user mode only)}. (def:constant)\n"
         "\n"
         "Both (client & server) options:\n"
         "  -exec:<profile>          Execution profile to use.\n"
@@ -134,7 +137,9 @@ PrintHelp(
         "  -qeo:<0/1>               Allows/disallowes QUIC encryption offload. (def:0)\n"
 #ifndef _KERNEL_MODE
         "  -io:<mode>               Configures a requested network IO model to be used.\n"
-        "                            - {iocp, rio, xdp, qtip, epoll, kqueue}\n"
+        "                            - {iocp, rio, xdp, qtip, epoll, kqueue, loopback}\n"
+        "                            'loopback' runs server and client in-process over an\n"
+        "                            in-memory datapath (Linux only).\n"
 #else
         "  -io:<mode>               Configures a requested network IO model to be used.\n"
         "                            - {wsk}\n"
@@ -142,6 +147,8 @@ PrintHelp(
         "  -cpu:<cpu_index>         Specify the processor(s) to use.\n"
         "  -cipher:<value>          Decimal value of 1 or more QUIC_ALLOWED_CIPHER_SUITE_FLAGS.\n"
         "  -highpri:<0/1>           Configures MsQuic to run threads at high priority. (def:0)\n"
+        "  -cidsteer:<0/1>          Steers received packets to the socket of the partition\n"
+        "                            that owns their connection ID (Linux only). (def:0)\n"
         "\n",
         PERF_DEFAULT_PORT,
         PERF_DEFAULT_PORT
@@ -181,6 +188,7 @@ QuicMainStart(
     QUIC_EXECUTION_CONFIG* Config = (QUIC_EXECUTION_CONFIG*)RawConfig;
     Config->PollingIdleTimeoutUs = 0; // Default to no polling.
     bool SetConfig = false;
+    bool Loopback = false;
     const char* IoMode = GetValue(argc, argv, "io");
 
 #ifndef _KERNEL_MODE
@@ -190,6 +198,20 @@ QuicMainStart(
         SetConfig = true;
     }
 
+    //
+    // Loopback mode runs both the server and the client in this process, with
+    // all packets exchanged in memory. Useful for profiling CPU per byte
+    // without any kernel networking overhead.
+    //
+    if (IoMode && IsValue(IoMode, "loopback")) {
+        Config->Flags |= QUIC_EXECUTION_CONFIG_FLAG_LOOPBACK;
+        SetConfig = true;
+        Loopback = true;
+        if (!Target) {
+            Target = "localhost";
+        }
+    }
+
 #endif // _KERNEL_MODE
 
     if (IoMode && IsValue(IoMode, "xdp")) {
@@ -225,6 +247,12 @@ QuicMainStart(
         SetConfig = true;
     }
 
+    uint8_t CidSteering = 0;
+    if (TryGetValue(argc, argv, "cidsteer", &CidSteering) && CidSteering) {
+        Config->Flags |= QUIC_EXECUTION_CONFIG_FLAG_CID_STEERING;
+        SetConfig = true;
+    }
+
     if (TryGetValue(argc, argv, "pollidle", &Config->PollingIdleTimeoutUs)) {
         SetConfig = true;
     }
@@ -314,6 +342,16 @@ QuicMainStart(
         return Status;
     }
 
+    if (Loopback) {
+        CXPLAT_FRE_ASSERT(SelfSignedCredConfig);
+        Server = new(std::nothrow) PerfServer(SelfSignedCredConfig);
+        if (QUIC_FAILED(Status = Server->Init(argc, argv)) ||
+            QUIC_FAILED(Status = Server->Start(StopEvent))) {
+            WriteOutput("\nPlease run 'secnetperf -help' for command line options.\n");
+            return Status; // QuicMainFree is called on failure
+        }
+    }
+
     if (Target) {
         Client = new(std::nothrow) PerfClient;
         if ((QUIC_SUCCEEDED(Status = Client->Init(argc, argv, Target)) &&
@@ -0,0 +1,270 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Internet (one's complement) checksum, as used by the raw datapath to fill
+    in IP and UDP/TCP checksums when the NIC doesn't offload them.
+
+    The one's complement sum is commutative and associative, so it can be
+    computed over wider words than 16 bits and folded at the end. The portable
+    version adds 32-bit words into a 64-bit accumulator. The vector versions do
+    the same over 128 or 256 bits at a time, widening the 32-bit words into
+    64-bit lanes so that no carries are lost, and then finish the tail with the
+    portable version. The best version for the processor is picked the first
+    time a checksum is computed.
+
+--*/
+
+#include "platform_internal.h"
+#ifdef QUIC_CLOG
+#include "checksum.c.clog.h"
+#endif
+
+#if !defined(_KERNEL_MODE)
+#if defined(_M_X64) || defined(__x86_64__)
+#define CXPLAT_CHECKSUM_X64 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define CXPLAT_TARGET_AVX2
+#else
+#define CXPLAT_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#elif defined(_M_ARM64) || defined(__aarch64__)
+#define CXPLAT_CHECKSUM_NEON 1
+#include <arm_neon.h>
+#endif
+#endif // !_KERNEL_MODE
+
+//
+// Buffers shorter than this (e.g. the IP pseudo header) aren't worth the cost
+// of setting up the vector registers.
+//
+#define CXPLAT_CHECKSUM_VECTOR_MIN_LENGTH   64
+
+typedef
+uint16_t
+(CXPLAT_CHECKSUM_FN)(
+    _In_reads_(Length)
+        const uint8_t* Data,
+    _In_ uint32_t Length,
+    _In_ uint64_t InitialChecksum
+    );
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+uint16_t
+CxPlatChecksumScalar(
+    _In_reads_(Length)
+        const uint8_t* Data,
+    _In_ uint32_t Length,
+    _In_ uint64_t InitialChecksum
+    )
+{
+    //
+    // Add up all bytes in 3 steps:
+    // 1. Add the odd byte to the checksum if the length is odd.
+    // 2. If the length is divisible by 2 but not 4, add the last 2 bytes.
+    // 3. Sum up the rest as 32-bit words.
+    //
+
+    if ((Length & 1) != 0) {
+        --Length;
+        InitialChecksum += Data[Length];
+    }
+
+    if ((Length & 2) != 0) {
+        Length -= 2;
+        InitialChecksum += *((const uint16_t*)(&Data[Length]));
+    }
+
+    for (uint32_t i = 0; i < Length; i += 4) {
+        InitialChecksum += *((const uint32_t*)(&Data[i]));
+    }
+
+    //
+    // Fold all carries into the final checksum.
+    //
+    while (InitialChecksum >> 16) {
+        InitialChecksum = (InitialChecksum & 0xffff) + (InitialChecksum >> 16);
+    }
+
+    return (uint16_t)InitialChecksum;
+}
+
+#ifdef CXPLAT_CHECKSUM_X64
+
+static
+uint16_t
+CxPlatChecksumSse2(
+    _In_reads_(Length)
+        const uint8_t* Data,
+    _In_ uint32_t Length,
+    _In_ uint64_t InitialChecksum
+    )
+{
+    const __m128i Zero = _mm_setzero_si128();
+    __m128i Sum0 = Zero;
+    __m128i Sum1 = Zero;
+
+    while (Length >= 32) {
+        const __m128i A = _mm_loadu_si128((const __m128i*)Data);
+        const __m128i B = _mm_loadu_si128((const __m128i*)(Data + 16));
+        Sum0 = _mm_add_epi64(Sum0, _mm_unpacklo_epi32(A, Zero));
+        Sum1 = _mm_add_epi64(Sum1, _mm_unpackhi_epi32(A, Zero));
+        Sum0 = _mm_add_epi64(Sum0, _mm_unpacklo_epi32(B, Zero));
+        Sum1 = _mm_add_epi64(Sum1, _mm_unpackhi_epi32(B, Zero));
+        Data += 32;
+        Length -= 32;
+    }
+
+    Sum0 = _mm_add_epi64(Sum0, Sum1);
+    uint64_t Lanes[2];
+    _mm_storeu_si128((__m128i*)Lanes, Sum0);
+
+    return CxPlatChecksumScalar(Data, Length, InitialChecksum + Lanes[0] + Lanes[1]);
+}
+
+static
+CXPLAT_TARGET_AVX2
+uint16_t
+CxPlatChecksumAvx2(
+    _In_reads_(Length)
+        const uint8_t* Data,
+    _In_ uint32_t Length,
+    _In_ uint64_t InitialChecksum
+    )
+{
+    const __m256i Zero = _mm256_setzero_si256();
+    __m256i Sum0 = Zero;
+    __m256i Sum1 = Zero;
+
+    while (Length >= 64) {
+        const __m256i A = _mm256_loadu_si256((const __m256i*)Data);
+        const __m256i B = _mm256_loadu_si256((const __m256i*)(Data + 32));
+        Sum0 = _mm256_add_epi64(Sum0, _mm256_unpacklo_epi32(A, Zero));
+        Sum1 = _mm256_add_epi64(Sum1, _mm256_unpackhi_epi32(A, Zero));
+        Sum0 = _mm256_add_epi64(Sum0, _mm256_unpacklo_epi32(B, Zero));
+        Sum1 = _mm256_add_epi64(Sum1, _mm256_unpackhi_epi32(B, Zero));
+        Data += 64;
+        Length -= 64;
+    }
+
+    Sum0 = _mm256_add_epi64(Sum0, Sum1);
+    const __m128i Sum =
+        _mm_add_epi64(
+            _mm256_castsi256_si128(Sum0),
+            _mm256_extracti128_si256(Sum0, 1));
+    uint64_t Lanes[2];
+    _mm_storeu_si128((__m128i*)Lanes, Sum);
+
+    //
+    // Avoid the AVX to SSE transition penalty in the caller.
+    //
+    _mm256_zeroupper();
+
+    return CxPlatChecksumSse2(Data, Length, InitialChecksum + Lanes[0] + Lanes[1]);
+}
+
+static
+BOOLEAN
+CxPlatChecksumAvx2Supported(
+    void
+    )
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    int CpuInfo[4];
+    __cpuid(CpuInfo, 1);
+    const BOOLEAN OsXSave = (CpuInfo[2] & (1 << 27)) != 0;
+    const BOOLEAN Avx = (CpuInfo[2] & (1 << 28)) != 0;
+    if (!OsXSave || !Avx || (_xgetbv(0) & 0x6) != 0x6) {
+        return FALSE; // The OS doesn't save the YMM registers.
+    }
+    __cpuidex(CpuInfo, 7, 0);
+    return (CpuInfo[1] & (1 << 5)) != 0;
+#else
+    return __builtin_cpu_supports("avx2") != 0;
+#endif
+}
+
+#endif // CXPLAT_CHECKSUM_X64
+
+#ifdef CXPLAT_CHECKSUM_NEON
+
+static
+uint16_t
+CxPlatChecksumNeon(
+    _In_reads_(Length)
+        const uint8_t* Data,
+    _In_ uint32_t Length,
+    _In_ uint64_t InitialChecksum
+    )
+{
+    uint64x2_t Sum0 = vdupq_n_u64(0);
+    uint64x2_t Sum1 = vdupq_n_u64(0);
+
+    while (Length >= 32) {
+        //
+        // Pairwise add the 32-bit words into the 64-bit accumulators.
+        //
+        Sum0 = vpadalq_u32(Sum0, vreinterpretq_u32_u8(vld1q_u8(Data)));
+        Sum1 = vpadalq_u32(Sum1, vreinterpretq_u32_u8(vld1q_u8(Data + 16)));
+        Data += 32;
+        Length -= 32;
+    }
+
+    Sum0 = vaddq_u64(Sum0, Sum1);
+
+    return
+        CxPlatChecksumScalar(
+            Data,
+            Length,
+            InitialChecksum + vgetq_lane_u64(Sum0, 0) + vgetq_lane_u64(Sum0, 1));
+}
+
+#endif // CXPLAT_CHECKSUM_NEON
+
+static CXPLAT_CHECKSUM_FN CxPlatChecksumResolve;
+
+//
+// The version of the checksum to use for larger buffers. Starts out as the
+// resolver, which replaces itself on first use. Racing resolvers all store the
+// same value.
+//
+static CXPLAT_CHECKSUM_FN* volatile CxPlatChecksumVector = CxPlatChecksumResolve;
+
+static
+uint16_t
+CxPlatChecksumResolve(
+    _In_reads_(Length)
+        const uint8_t* Data,
+    _In_ uint32_t Length,
+    _In_ uint64_t InitialChecksum
+    )
+{
+    CXPLAT_CHECKSUM_FN* Checksum = CxPlatChecksumScalar;
+#if defined(CXPLAT_CHECKSUM_X64)
+    Checksum = CxPlatChecksumAvx2Supported() ? CxPlatChecksumAvx2 : CxPlatChecksumSse2;
+#elif defined(CXPLAT_CHECKSUM_NEON)
+    Checksum = CxPlatChecksumNeon;
+#endif
+    CxPlatChecksumVector = Checksum;
+    return Checksum(Data, Length, InitialChecksum);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+uint16_t
+CxPlatChecksum(
+    _In_reads_(Length)
+        const uint8_t* Data,
+    _In_ uint32_t Length,
+    _In_ uint64_t InitialChecksum
+    )
+{
+    if (Length < CXPLAT_CHECKSUM_VECTOR_MIN_LENGTH) {
+        return CxPlatChecksumScalar(Data, Length, InitialChecksum);
+    }
+    return CxPlatChecksumVector(Data, Length, InitialChecksum);
+}
@@ -45,6 +45,22 @@ CXPLAT_STATIC_ASSERT((SIZEOF_STRUCT_MEMBER(QUIC_BUFFER, Buffer) == sizeof(void*)
 const uint16_t CXPLAT_MAX_IO_BATCH_SIZE =
     (CXPLAT_LARGE_IO_BUFFER_SIZE / (1280 - CXPLAT_MIN_IPV6_HEADER_SIZE - CXPLAT_UDP_HEADER_SIZE));
 
+//
+// The first ephemeral port handed out to loopback sockets.
+//
+#define CXPLAT_LOOPBACK_PORT_START          49152
+
+//
+// The hop limit/TTL reported for packets delivered over loopback.
+//
+#define CXPLAT_LOOPBACK_HOP_LIMIT           64
+
+//
+// The maximum number of datagrams queued to a socket context by CID steering.
+// Datagrams steered beyond this are dropped, like a full socket receive buffer.
+//
+#define CXPLAT_STEER_QUEUE_MAX_DATAGRAMS    4096
+
 //
 // Contains all the info for a single RX IO operation. Multiple RX packets may
 // come from a single IO operation.
@@ -60,6 +76,16 @@ typedef struct __attribute__((aligned(16))) DATAPATH_RX_IO_BLOCK {
     //
     long RefCount;
 
+    //
+    // The partition whose pool the block was allocated from.
+    //
+    CXPLAT_DATAPATH_PARTITION* Partition;
+
+    //
+    // Link in the partition's remote free list.
+    //
+    struct DATAPATH_RX_IO_BLOCK* RemoteFreeNext;
+
     //
     // An array of packets to represent the datagram and metadata returned to
     // the app.
@@ -97,11 +123,6 @@ typedef struct CXPLAT_SEND_DATA {
     //
     struct CXPLAT_SOCKET_CONTEXT* SocketContext;
 
-    //
-    // Entry in the pending send list.
-    //
-    CXPLAT_LIST_ENTRY TxEntry;
-
     //
     // The local address to bind to.
     //
@@ -204,6 +225,10 @@ typedef struct CXPLAT_RECV_MSG_CONTROL_BUFFER {
 CXPLAT_EVENT_COMPLETION CxPlatSocketContextUninitializeEventComplete;
 CXPLAT_EVENT_COMPLETION CxPlatSocketContextFlushTxEventComplete;
 CXPLAT_EVENT_COMPLETION CxPlatSocketContextIoEventComplete;
+CXPLAT_EVENT_COMPLETION CxPlatSocketContextSteerEventComplete;
+CXPLAT_EVENT_COMPLETION CxPlatSocketContextLoopbackRxEventComplete;
+
+CXPLAT_DATAPATH_TEST_HOOKS CxPlatDataPathTestHooks;
 
 void
 CxPlatDataPathCalculateFeatureSupport(
@@ -308,6 +333,16 @@ Error:
     if (SendSocket != INVALID_SOCKET) { close(SendSocket); }
 #endif // UDP_SEGMENT
 
+    if (Datapath->Loopback) {
+        //
+        // Loopback sends are copied directly into receive blocks, so send
+        // segmentation and receive coalescing are always available.
+        //
+        Datapath->Features |=
+            CXPLAT_DATAPATH_FEATURE_SEND_SEGMENTATION |
+            CXPLAT_DATAPATH_FEATURE_RECV_COALESCING;
+    }
+
     if (Datapath->Features & CXPLAT_DATAPATH_FEATURE_SEND_SEGMENTATION) {
         Datapath->SendDataSize = sizeof(CXPLAT_SEND_DATA);
         Datapath->SendIoVecCount = 1;
@@ -338,6 +373,84 @@ Error:
     Datapath->Features |= CXPLAT_DATAPATH_FEATURE_SEND_DSCP;
 }
 
+//
+// Returns the NUMA node of the current processor.
+//
+static
+uint16_t
+CxPlatDataPathCurrentNumaNode(
+    _In_ const CXPLAT_DATAPATH* Datapath
+    )
+{
+    const uint32_t Proc = CxPlatProcCurrentNumber();
+    return Proc < Datapath->ProcCount ? Datapath->ProcNumaNodes[Proc] : 0;
+}
+
+//
+// Returns the receive blocks freed on other NUMA nodes to the partition's pool,
+// from the partition's own thread so they land in its local cache.
+//
+static
+void
+CxPlatDataPathDrainRemoteFrees(
+    _In_ CXPLAT_DATAPATH_PARTITION* DatapathPartition
+    )
+{
+    DATAPATH_RX_IO_BLOCK* IoBlock =
+        (DATAPATH_RX_IO_BLOCK*)InterlockedExchangePointer(
+            (void* volatile*)&DatapathPartition->RemoteFreeBlocks, NULL);
+    while (IoBlock != NULL) {
+        DATAPATH_RX_IO_BLOCK* Next = IoBlock->RemoteFreeNext;
+        CxPlatPoolFree(IoBlock);
+        InterlockedIncrement64(&DatapathPartition->RemoteFreeCount);
+        IoBlock = Next;
+    }
+}
+
+static
+DATAPATH_RX_IO_BLOCK*
+CxPlatDataPathAllocRecvBlock(
+    _In_ CXPLAT_DATAPATH_PARTITION* DatapathPartition
+    )
+{
+    if (DatapathPartition->RemoteFreeBlocks != NULL) {
+        CxPlatDataPathDrainRemoteFrees(DatapathPartition);
+    }
+    DATAPATH_RX_IO_BLOCK* IoBlock = CxPlatPoolExAlloc(&DatapathPartition->RecvBlockPool);
+    if (IoBlock != NULL) {
+        IoBlock->Partition = DatapathPartition;
+    }
+    return IoBlock;
+}
+
+static
+void
+CxPlatDataPathFreeRecvBlock(
+    _In_ DATAPATH_RX_IO_BLOCK* IoBlock
+    )
+{
+    CXPLAT_DATAPATH_PARTITION* DatapathPartition = IoBlock->Partition;
+    if ((!DatapathPartition->Datapath->NumaAware ||
+         CxPlatDataPathCurrentNumaNode(DatapathPartition->Datapath) == DatapathPartition->NumaNode) &&
+        !CxPlatDataPathTestHooks.ForceRemoteFrees) {
+        CxPlatPoolFree(IoBlock);
+        return;
+    }
+
+    //
+    // Freed on another NUMA node. Queue the block for the owning partition to
+    // return to its pool in a batch, instead of caching it on this node.
+    //
+    DATAPATH_RX_IO_BLOCK* Head;
+    do {
+        Head = DatapathPartition->RemoteFreeBlocks;
+        IoBlock->RemoteFreeNext = Head;
+    } while (InterlockedCompareExchangePointer(
+                (void* volatile*)&DatapathPartition->RemoteFreeBlocks,
+                IoBlock,
+                Head) != Head);
+}
+
 void
 CxPlatProcessorContextInitialize(
     _In_ CXPLAT_DATAPATH* Datapath,
@@ -349,9 +462,50 @@ CxPlatProcessorContextInitialize(
     DatapathPartition->Datapath = Datapath;
     DatapathPartition->PartitionIndex = PartitionIndex;
     DatapathPartition->EventQ = CxPlatWorkerPoolGetEventQ(Datapath->WorkerPool, PartitionIndex);
+    DatapathPartition->NumaNode =
+        (uint16_t)CxPlatProcNumaNode(
+            CxPlatWorkerPoolGetIdealProcessor(Datapath->WorkerPool, PartitionIndex));
     CxPlatRefInitialize(&DatapathPartition->RefCount);
-    CxPlatPoolInitialize(TRUE, Datapath->RecvBlockSize, QUIC_POOL_DATA, &DatapathPartition->RecvBlockPool);
-    CxPlatPoolInitialize(TRUE, Datapath->SendDataSize, QUIC_POOL_DATA, &DatapathPartition->SendBlockPool);
+    CxPlatPoolInitialize(TRUE, Datapath->RecvBlockSize, QUIC_POOL_DATA, &DatapathPartition->RecvBlockPool.Base);
+    CxPlatPoolInitialize(TRUE, Datapath->SendDataSize, QUIC_POOL_DATA, &DatapathPartition->SendBlockPool.Base);
+    CxPlatAddDynamicPoolAllocator(
+        Datapath->WorkerPool, &DatapathPartition->RecvBlockPool, PartitionIndex);
+    CxPlatAddDynamicPoolAllocator(
+        Datapath->WorkerPool, &DatapathPartition->SendBlockPool, PartitionIndex);
+}
+
+//
+// Builds the per-processor tables used to keep buffers on the NUMA node of the
+// processor using them. Processors are mapped to the partition running on them,
+// or else the first partition on the same node.
+//
+static
+void
+CxPlatDataPathInitializeNumaTables(
+    _In_ CXPLAT_DATAPATH* Datapath,
+    _In_ uint32_t ProcCount
+    )
+{
+    Datapath->ProcCount = ProcCount;
+    Datapath->ProcNumaNodes =
+        (uint16_t*)(Datapath->Partitions + Datapath->PartitionCount);
+    Datapath->ProcPartitions = Datapath->ProcNumaNodes + ProcCount;
+
+    for (uint32_t Proc = 0; Proc < ProcCount; ++Proc) {
+        const uint16_t NumaNode = (uint16_t)CxPlatProcNumaNode(Proc);
+        Datapath->ProcNumaNodes[Proc] = NumaNode;
+        Datapath->ProcPartitions[Proc] = UINT16_MAX;
+        for (uint16_t i = 0; i < Datapath->PartitionCount; ++i) {
+            if (CxPlatWorkerPoolGetIdealProcessor(Datapath->WorkerPool, i) == Proc) {
+                Datapath->ProcPartitions[Proc] = i;
+                break;
+            }
+            if (Datapath->ProcPartitions[Proc] == UINT16_MAX &&
+                Datapath->Partitions[i].NumaNode == NumaNode) {
+                Datapath->ProcPartitions[Proc] = i;
+            }
+        }
+    }
 }
 
 QUIC_STATUS
@@ -365,7 +519,6 @@ DataPathInitialize(
     )
 {
     UNREFERENCED_PARAMETER(TcpCallbacks);
-    UNREFERENCED_PARAMETER(Config);
 
     if (NewDatapath == NULL) {
         return QUIC_STATUS_INVALID_PARAMETER;
@@ -387,9 +540,11 @@ DataPathInitialize(
         return QUIC_STATUS_INVALID_PARAMETER;
     }
 
+    const uint32_t ProcCount = CxPlatProcCount();
     const size_t DatapathLength =
         sizeof(CXPLAT_DATAPATH) +
-        CxPlatWorkerPoolGetCount(WorkerPool) * sizeof(CXPLAT_DATAPATH_PARTITION);
+        CxPlatWorkerPoolGetCount(WorkerPool) * sizeof(CXPLAT_DATAPATH_PARTITION) +
+        2 * ProcCount * sizeof(uint16_t);
 
     CXPLAT_DATAPATH* Datapath =
         (CXPLAT_DATAPATH*)CXPLAT_ALLOC_PAGED(DatapathLength, QUIC_POOL_DATAPATH);
@@ -413,6 +568,21 @@ DataPathInitialize(
 
     Datapath->PartitionCount = (uint16_t)CxPlatWorkerPoolGetCount(WorkerPool);
     Datapath->Features = CXPLAT_DATAPATH_FEATURE_LOCAL_PORT_SHARING;
+    Datapath->Loopback = Config && !!(Config->Flags & QUIC_EXECUTION_CONFIG_FLAG_LOOPBACK);
+    Datapath->CidSteering = Config && !!(Config->Flags & QUIC_EXECUTION_CONFIG_FLAG_CID_STEERING);
+    if (Datapath->Loopback) {
+        if (!CxPlatHashtableInitializeEx(&Datapath->LoopbackSockets, CXPLAT_HASH_MIN_SIZE)) {
+            QuicTraceEvent(
+                AllocFailure,
+                "Allocation of '%s' failed. (%llu bytes)",
+                "LoopbackSockets",
+                0);
+            CXPLAT_FREE(Datapath, QUIC_POOL_DATAPATH);
+            return QUIC_STATUS_OUT_OF_MEMORY;
+        }
+        CxPlatRwLockInitialize(&Datapath->LoopbackLock);
+        Datapath->LoopbackNextPort = CXPLAT_LOOPBACK_PORT_START;
+    }
     CxPlatRefInitializeEx(&Datapath->RefCount, Datapath->PartitionCount);
     CxPlatDataPathCalculateFeatureSupport(Datapath, ClientRecvDataLength);
 
@@ -422,6 +592,13 @@ DataPathInitialize(
     for (uint32_t i = 0; i < Datapath->PartitionCount; i++) {
         CxPlatProcessorContextInitialize(
             Datapath, i, &Datapath->Partitions[i]);
+        if (Datapath->Partitions[i].NumaNode != Datapath->Partitions[0].NumaNode) {
+            Datapath->NumaAware = TRUE;
+        }
+    }
+
+    if (Datapath->NumaAware) {
+        CxPlatDataPathInitializeNumaTables(Datapath, ProcCount);
     }
 
     CXPLAT_FRE_ASSERT(CxPlatWorkerPoolAddRef(WorkerPool));
@@ -442,6 +619,23 @@ CxPlatDataPathRelease(
         CXPLAT_DBG_ASSERT(Datapath->Uninitialized);
         Datapath->Freed = TRUE;
 #endif
+        if (Datapath->Loopback) {
+            CxPlatRwLockUninitialize(&Datapath->LoopbackLock);
+            CxPlatHashtableUninitialize(&Datapath->LoopbackSockets);
+        }
+        //
+        // The pools are only cleaned up once all partitions are released,
+        // because send contexts and receive blocks may be freed to the pool
+        // of a partition other than their socket's.
+        //
+        for (uint32_t i = 0; i < Datapath->PartitionCount; i++) {
+            CXPLAT_DATAPATH_PARTITION* DatapathPartition = &Datapath->Partitions[i];
+            CxPlatDataPathDrainRemoteFrees(DatapathPartition);
+            CxPlatRemoveDynamicPoolAllocator(&DatapathPartition->SendBlockPool);
+            CxPlatRemoveDynamicPoolAllocator(&DatapathPartition->RecvBlockPool);
+            CxPlatPoolUninitialize(&DatapathPartition->SendBlockPool.Base);
+            CxPlatPoolUninitialize(&DatapathPartition->RecvBlockPool.Base);
+        }
         CxPlatWorkerPoolRelease(Datapath->WorkerPool);
         CXPLAT_FREE(Datapath, QUIC_POOL_DATAPATH);
     }
@@ -458,8 +652,6 @@ CxPlatProcessorContextRelease(
         CXPLAT_DBG_ASSERT(!DatapathPartition->Uninitialized);
         DatapathPartition->Uninitialized = TRUE;
 #endif
-        CxPlatPoolUninitialize(&DatapathPartition->SendBlockPool);
-        CxPlatPoolUninitialize(&DatapathPartition->RecvBlockPool);
         CxPlatDataPathRelease(DatapathPartition->Datapath);
     }
 }
@@ -501,6 +693,23 @@ DataPathGetSupportedFeatures(
     return Datapath->Features;
 }
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+DataPathGetBufferStatistics(
+    _In_ CXPLAT_DATAPATH* Datapath,
+    _Out_ CXPLAT_DATAPATH_BUFFER_STATISTICS* Statistics
+    )
+{
+    Statistics->RemoteFrees = 0;
+    Statistics->CrossNodeSends = 0;
+    for (uint32_t i = 0; i < Datapath->PartitionCount; i++) {
+        Statistics->RemoteFrees +=
+            (uint64_t)Datapath->Partitions[i].RemoteFreeCount;
+        Statistics->CrossNodeSends +=
+            (uint64_t)Datapath->Partitions[i].CrossNodeSendCount;
+    }
+}
+
 BOOLEAN
 DataPathIsPaddingPreferred(
     _In_ CXPLAT_DATAPATH* Datapath
@@ -509,6 +718,112 @@ DataPathIsPaddingPreferred(
     return !!(Datapath->Features & CXPLAT_DATAPATH_FEATURE_SEND_SEGMENTATION);
 }
 
+static
+void
+CxPlatIoRingInitialize(
+    _Out_ CXPLAT_IO_RING* Ring
+    )
+{
+    Ring->Tail = 0;
+    Ring->Head = 0;
+    for (long i = 0; i < CXPLAT_IO_RING_SIZE; i++) {
+        Ring->Slots[i].Sequence = i;
+        Ring->Slots[i].Entry = NULL;
+    }
+}
+
+static
+BOOLEAN
+CxPlatIoRingIsEmpty(
+    _In_ const CXPLAT_IO_RING* Ring
+    )
+{
+    return Ring->Head == Ring->Tail;
+}
+
+static
+uint32_t
+CxPlatIoRingCount(
+    _In_ const CXPLAT_IO_RING* Ring
+    )
+{
+    return (uint32_t)(Ring->Tail - Ring->Head);
+}
+
+//
+// Appends the entry to the ring. Safe to call from any thread. Returns FALSE if
+// the ring is full. AtHead is set if the entry went in as the next one for the
+// consumer, which may already have found the ring empty and stopped.
+//
+static
+BOOLEAN
+CxPlatIoRingPush(
+    _Inout_ CXPLAT_IO_RING* Ring,
+    _In_ void* Entry,
+    _Out_ BOOLEAN* AtHead
+    )
+{
+    CXPLAT_IO_RING_SLOT* Slot;
+    long Position = Ring->Tail;
+    for (;;) {
+        Slot = &Ring->Slots[Position & (CXPLAT_IO_RING_SIZE - 1)];
+        const long Difference = Slot->Sequence - Position;
+        if (Difference == 0) {
+            const long Previous =
+                InterlockedCompareExchange(&Ring->Tail, Position + 1, Position);
+            if (Previous == Position) {
+                break;
+            }
+            Position = Previous;
+        } else if (Difference < 0) {
+            return FALSE; // The consumer hasn't freed this slot yet.
+        } else {
+            Position = Ring->Tail; // Another producer took this slot.
+        }
+    }
+
+    Slot->Entry = Entry;
+    InterlockedIncrement(&Slot->Sequence); // Publish to the consumer.
+    *AtHead = Ring->Head == Position;
+    return TRUE;
+}
+
+//
+// Returns the oldest published entry without removing it, or NULL. Only called
+// by the consumer.
+//
+static
+void*
+CxPlatIoRingPeek(
+    _In_ const CXPLAT_IO_RING* Ring
+    )
+{
+    const long Head = Ring->Head;
+    const CXPLAT_IO_RING_SLOT* Slot =
+        &Ring->Slots[Head & (CXPLAT_IO_RING_SIZE - 1)];
+    return Slot->Sequence == Head + 1 ? Slot->Entry : NULL;
+}
+
+//
+// Removes the entry last returned by CxPlatIoRingPeek and hands its slot
+// back to the producers. Only called by the consumer.
+//
+static
+void
+CxPlatIoRingPop(
+    _Inout_ CXPLAT_IO_RING* Ring
+    )
+{
+    const long Head = Ring->Head;
+    CXPLAT_IO_RING_SLOT* Slot =
+        &Ring->Slots[Head & (CXPLAT_IO_RING_SIZE - 1)];
+    CXPLAT_DBG_ASSERT(Slot->Sequence == Head + 1);
+    Slot->Entry = NULL;
+    InterlockedCompareExchange(
+        &Slot->Sequence, Head + CXPLAT_IO_RING_SIZE, Head + 1);
+    InterlockedIncrement(&Ring->Head);
+}
+
 QUIC_STATUS
 CxPlatSocketConfigureRss(
     _In_ CXPLAT_SOCKET_CONTEXT* SocketContext,
@@ -554,6 +869,85 @@ CxPlatSocketConfigureRss(
 #endif
 }
 
+//
+// Attaches a program to the SO_REUSEPORT group that picks the socket from the
+// partition ID in the destination CID of short header packets. The server's
+// CIDs encode the index of the partition that owns the connection, and the
+// per-processor sockets are created (and so joined the group) in partition
+// order, so each packet is received on the owning partition's socket. Long
+// header packets (whose CIDs are usually picked by the client) fall back to
+// the receiving CPU, like CxPlatSocketConfigureRss.
+//
+QUIC_STATUS
+CxPlatSocketConfigureCidSteering(
+    _In_ CXPLAT_SOCKET_CONTEXT* SocketContext,
+    _In_ const CXPLAT_UDP_CONFIG* Config,
+    _In_ uint32_t SocketCount
+    )
+{
+#ifdef SO_ATTACH_REUSEPORT_CBPF
+    QUIC_STATUS Status = QUIC_STATUS_SUCCESS;
+    int Result = 0;
+
+    //
+    // The partition ID is copied into the CID in host byte order, right after
+    // the first byte (flags) of a short header.
+    //
+    const uint32_t PidOffset = 1 + Config->CidPartitionIdOffset;
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    const uint32_t PidLowOffset = PidOffset;
+    const uint32_t PidHighOffset = PidOffset + 1;
+#else
+    const uint32_t PidLowOffset = PidOffset + 1;
+    const uint32_t PidHighOffset = PidOffset;
+#endif
+
+    struct sock_filter BpfCode[] = {
+        {BPF_LD | BPF_B | BPF_ABS, 0, 0, 0},                        // Load first byte
+        {BPF_JMP | BPF_JSET | BPF_K, 8, 0, 0x80},                   // Long header? Goto CPU
+        {BPF_LD | BPF_B | BPF_ABS, 0, 0, PidHighOffset},            // Load PID high byte
+        {BPF_ALU | BPF_LSH | BPF_K, 0, 0, 8},                       // Shift it up
+        {BPF_MISC | BPF_TAX, 0, 0, 0},                              // Save in X
+        {BPF_LD | BPF_B | BPF_ABS, 0, 0, PidLowOffset},             // Load PID low byte
+        {BPF_ALU | BPF_OR | BPF_X, 0, 0, 0},                        // Combine with X
+        {BPF_ALU | BPF_AND | BPF_K, 0, 0, Config->CidPartitionIdMask}, // AND by mask
+        {BPF_ALU | BPF_MOD | BPF_K, 0, 0, Config->CidPartitionCount}, // MOD by PartitionCount
+        {BPF_RET | BPF_A, 0, 0, 0},                                 // Return
+        {BPF_LD | BPF_W | BPF_ABS, 0, 0, SKF_AD_OFF | SKF_AD_CPU},  // CPU: Load CPU number
+        {BPF_ALU | BPF_MOD, 0, 0, SocketCount},                     // MOD by SocketCount
+        {BPF_RET | BPF_A, 0, 0, 0}                                  // Return
+    };
+
+    struct sock_fprog BpfConfig = {0};
+    BpfConfig.len = ARRAYSIZE(BpfCode);
+    BpfConfig.filter = BpfCode;
+
+    Result =
+        setsockopt(
+            SocketContext->SocketFd,
+            SOL_SOCKET,
+            SO_ATTACH_REUSEPORT_CBPF,
+            (const void*)&BpfConfig,
+            sizeof(BpfConfig));
+    if (Result == SOCKET_ERROR) {
+        Status = errno;
+        QuicTraceEvent(
+            DatapathErrorStatus,
+            "[data][%p] ERROR, %u, %s.",
+            SocketContext->Binding,
+            Status,
+            "setsockopt(SO_ATTACH_REUSEPORT_CBPF) failed");
+    }
+
+    return Status;
+#else
+    UNREFERENCED_PARAMETER(SocketContext);
+    UNREFERENCED_PARAMETER(Config);
+    UNREFERENCED_PARAMETER(SocketCount);
+    return QUIC_STATUS_NOT_SUPPORTED;
+#endif
+}
+
 QUIC_STATUS
 CxPlatSocketContextSqeInitialize(
     _Inout_ CXPLAT_SOCKET_CONTEXT* SocketContext
@@ -563,6 +957,7 @@ CxPlatSocketContextSqeInitialize(
     CXPLAT_SOCKET* Binding = SocketContext->Binding;
     BOOLEAN ShutdownSqeInitialized = FALSE;
     BOOLEAN IoSqeInitialized = FALSE;
+    BOOLEAN FlushTxSqeInitialized = FALSE;
 
     if (!CxPlatSqeInitialize(
             SocketContext->DatapathPartition->EventQ,
@@ -607,6 +1002,22 @@ CxPlatSocketContextSqeInitialize(
             "CxPlatSqeInitialize failed");
         goto Exit;
     }
+    FlushTxSqeInitialized = TRUE;
+
+    if (Binding->CidSteering &&
+        !CxPlatSqeInitialize(
+            SocketContext->DatapathPartition->EventQ,
+            CxPlatSocketContextSteerEventComplete,
+            &SocketContext->SteerSqe)) {
+        Status = errno;
+        QuicTraceEvent(
+            DatapathErrorStatus,
+            "[data][%p] ERROR, %u, %s.",
+            Binding,
+            Status,
+            "CxPlatSqeInitialize failed");
+        goto Exit;
+    }
 
     SocketContext->SqeInitialized = TRUE;
     return QUIC_STATUS_SUCCESS;
@@ -619,6 +1030,209 @@ Exit:
     if (IoSqeInitialized) {
         CxPlatSqeCleanup(SocketContext->DatapathPartition->EventQ, &SocketContext->IoSqe);
     }
+    if (FlushTxSqeInitialized) {
+        CxPlatSqeCleanup(SocketContext->DatapathPartition->EventQ, &SocketContext->FlushTxSqe);
+    }
+
+    return Status;
+}
+
+//
+// Returns TRUE if the (mapped V6) loopback address is bound to the wildcard
+// address.
+//
+static
+BOOLEAN
+CxPlatLoopbackIsWildCard(
+    _In_ const QUIC_ADDR* Address
+    )
+{
+    return IN6_IS_ADDR_UNSPECIFIED(&Address->Ipv6.sin6_addr);
+}
+
+//
+// Finds the loopback socket context that receives datagrams sent to the
+// address: the one bound to that exact IP address, or else the one bound to
+// the wildcard address on the port. Must be called with the loopback lock held.
+//
+static
+CXPLAT_SOCKET_CONTEXT*
+CxPlatDataPathLookupLoopbackSocket(
+    _In_ CXPLAT_DATAPATH* Datapath,
+    _In_ const QUIC_ADDR* Address
+    )
+{
+    QUIC_ADDR MappedAddress;
+    CxPlatConvertToMappedV6(Address, &MappedAddress);
+
+    CXPLAT_SOCKET_CONTEXT* WildCard = NULL;
+    CXPLAT_HASHTABLE_LOOKUP_CONTEXT Context;
+    CXPLAT_HASHTABLE_ENTRY* Entry =
+        CxPlatHashtableLookup(
+            &Datapath->LoopbackSockets, MappedAddress.Ipv6.sin6_port, &Context);
+    while (Entry != NULL) {
+        CXPLAT_SOCKET_CONTEXT* SocketContext =
+            CXPLAT_CONTAINING_RECORD(Entry, CXPLAT_SOCKET_CONTEXT, LoopbackEntry);
+        if (CxPlatLoopbackIsWildCard(&SocketContext->LoopbackAddress)) {
+            WildCard = SocketContext;
+        } else if (memcmp(
+                &SocketContext->LoopbackAddress.Ipv6.sin6_addr,
+                &MappedAddress.Ipv6.sin6_addr,
+                sizeof(MappedAddress.Ipv6.sin6_addr)) == 0) {
+            return SocketContext;
+        }
+        Entry = CxPlatHashtableLookupNext(&Datapath->LoopbackSockets, &Context);
+    }
+    return WildCard;
+}
+
+//
+// Returns TRUE if binding the (mapped V6) address would conflict with a
+// loopback socket context already bound to its port. Must be called with the
+// loopback lock held.
+//
+static
+BOOLEAN
+CxPlatDataPathLoopbackAddressInUse(
+    _In_ CXPLAT_DATAPATH* Datapath,
+    _In_ const QUIC_ADDR* MappedAddress
+    )
+{
+    CXPLAT_HASHTABLE_LOOKUP_CONTEXT Context;
+    CXPLAT_HASHTABLE_ENTRY* Entry =
+        CxPlatHashtableLookup(
+            &Datapath->LoopbackSockets, MappedAddress->Ipv6.sin6_port, &Context);
+    while (Entry != NULL) {
+        const CXPLAT_SOCKET_CONTEXT* SocketContext =
+            CXPLAT_CONTAINING_RECORD(Entry, CXPLAT_SOCKET_CONTEXT, LoopbackEntry);
+        if (CxPlatLoopbackIsWildCard(&SocketContext->LoopbackAddress) ||
+            CxPlatLoopbackIsWildCard(MappedAddress) ||
+            memcmp(
+                &SocketContext->LoopbackAddress.Ipv6.sin6_addr,
+                &MappedAddress->Ipv6.sin6_addr,
+                sizeof(MappedAddress->Ipv6.sin6_addr)) == 0) {
+            return TRUE;
+        }
+        Entry = CxPlatHashtableLookupNext(&Datapath->LoopbackSockets, &Context);
+    }
+    return FALSE;
+}
+
+//
+// Assigns a local port to an in-memory loopback socket context and adds it to
+// the datapath's loopback socket table. No kernel socket is created. Datagrams
+// sent to the socket are handed over through its receive ring and indicated on
+// its own partition.
+//
+QUIC_STATUS
+CxPlatSocketContextLoopbackInitialize(
+    _Inout_ CXPLAT_SOCKET_CONTEXT* SocketContext,
+    _In_ const CXPLAT_UDP_CONFIG* Config
+    )
+{
+    QUIC_STATUS Status = QUIC_STATUS_SUCCESS;
+    CXPLAT_SOCKET* Binding = SocketContext->Binding;
+    CXPLAT_DATAPATH* Datapath = Binding->Datapath;
+    CXPLAT_HASHTABLE_LOOKUP_CONTEXT Context;
+
+    SocketContext->LoopbackRxRing =
+        CXPLAT_ALLOC_NONPAGED(sizeof(CXPLAT_IO_RING), QUIC_POOL_SOCKET);
+    if (SocketContext->LoopbackRxRing == NULL) {
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "CXPLAT_IO_RING",
+            sizeof(CXPLAT_IO_RING));
+        return QUIC_STATUS_OUT_OF_MEMORY;
+    }
+    CxPlatIoRingInitialize(SocketContext->LoopbackRxRing);
+
+    if (!CxPlatSqeInitialize(
+            SocketContext->DatapathPartition->EventQ,
+            CxPlatSocketContextLoopbackRxEventComplete,
+            &SocketContext->LoopbackRxSqe)) {
+        Status = errno;
+        QuicTraceEvent(
+            DatapathErrorStatus,
+            "[data][%p] ERROR, %u, %s.",
+            Binding,
+            Status,
+            "CxPlatSqeInitialize failed");
+        CXPLAT_FREE(SocketContext->LoopbackRxRing, QUIC_POOL_SOCKET);
+        SocketContext->LoopbackRxRing = NULL;
+        return Status;
+    }
+
+    if (Config->RemoteAddress != NULL) {
+        //
+        // Everything is local in loopback mode, so a client socket uses the
+        // remote IP address as its own local IP address.
+        //
+        uint16_t Port = Binding->LocalAddress.Ipv6.sin6_port;
+        CxPlatConvertToMappedV6(Config->RemoteAddress, &Binding->LocalAddress);
+        Binding->LocalAddress.Ipv6.sin6_port = Port;
+        Binding->Connected = TRUE;
+    }
+
+    //
+    // Keep a copy of the bound address, in mapped V6 form, for lookups. The
+    // binding's own copy is converted back once creation completes.
+    //
+    // 0.0.0.0 maps to ::ffff:0.0.0.0, which is stored as :: so that there is
+    // only one form of the wildcard address.
+    //
+    static const uint8_t MappedV4WildCard[16] = { [10] = 0xff, [11] = 0xff };
+    CxPlatConvertToMappedV6(&Binding->LocalAddress, &SocketContext->LoopbackAddress);
+    if (memcmp(
+            &SocketContext->LoopbackAddress.Ipv6.sin6_addr,
+            MappedV4WildCard,
+            sizeof(MappedV4WildCard)) == 0) {
+        CxPlatZeroMemory(
+            &SocketContext->LoopbackAddress.Ipv6.sin6_addr,
+            sizeof(SocketContext->LoopbackAddress.Ipv6.sin6_addr));
+    }
+
+    CxPlatRwLockAcquireExclusive(&Datapath->LoopbackLock);
+
+    if (SocketContext->LoopbackAddress.Ipv6.sin6_port != 0) {
+        if (CxPlatDataPathLoopbackAddressInUse(Datapath, &SocketContext->LoopbackAddress)) {
+            Status = QUIC_STATUS_ADDRESS_IN_USE;
+        }
+    } else {
+        Status = QUIC_STATUS_ADDRESS_IN_USE;
+        for (uint32_t i = 0; i < UINT16_MAX - CXPLAT_LOOPBACK_PORT_START; ++i) {
+            const uint16_t Port = htons(Datapath->LoopbackNextPort);
+            if (++Datapath->LoopbackNextPort == 0) {
+                Datapath->LoopbackNextPort = CXPLAT_LOOPBACK_PORT_START;
+            }
+            if (CxPlatHashtableLookup(&Datapath->LoopbackSockets, Port, &Context) == NULL) {
+                Binding->LocalAddress.Ipv6.sin6_port = Port;
+                SocketContext->LoopbackAddress.Ipv6.sin6_port = Port;
+                Status = QUIC_STATUS_SUCCESS;
+                break;
+            }
+        }
+    }
+
+    if (QUIC_SUCCEEDED(Status)) {
+        CxPlatHashtableInsert(
+            &Datapath->LoopbackSockets,
+            &SocketContext->LoopbackEntry,
+            SocketContext->LoopbackAddress.Ipv6.sin6_port,
+            NULL);
+        SocketContext->LoopbackInserted = TRUE;
+    }
+
+    CxPlatRwLockReleaseExclusive(&Datapath->LoopbackLock);
+
+    if (QUIC_FAILED(Status)) {
+        QuicTraceEvent(
+            DatapathErrorStatus,
+            "[data][%p] ERROR, %u, %s.",
+            Binding,
+            Status,
+            "loopback bind failed");
+    }
 
     return Status;
 }
@@ -653,6 +1267,11 @@ CxPlatSocketContextInitialize(
         goto Exit;
     }
 
+    if (Datapath->Loopback && SocketType == CXPLAT_SOCKET_UDP) {
+        Status = CxPlatSocketContextLoopbackInitialize(SocketContext, Config);
+        goto Exit;
+    }
+
     //
     // Create datagram socket.
     //
@@ -1140,6 +1759,25 @@ CxPlatSocketRelease(
     }
 }
 
+//
+// Removes a loopback socket context from the datapath's table so that no new
+// datagrams are handed to it.
+//
+static
+void
+CxPlatSocketContextLoopbackRemove(
+    _In_ CXPLAT_SOCKET_CONTEXT* SocketContext
+    )
+{
+    CXPLAT_DATAPATH* Datapath = SocketContext->Binding->Datapath;
+    CxPlatRwLockAcquireExclusive(&Datapath->LoopbackLock);
+    if (SocketContext->LoopbackInserted) {
+        CxPlatHashtableRemove(&Datapath->LoopbackSockets, &SocketContext->LoopbackEntry, NULL);
+        SocketContext->LoopbackInserted = FALSE;
+    }
+    CxPlatRwLockReleaseExclusive(&Datapath->LoopbackLock);
+}
+
 void
 CxPlatSocketContextUninitializeComplete(
     _In_ CXPLAT_SOCKET_CONTEXT* SocketContext
@@ -1150,12 +1788,10 @@ CxPlatSocketContextUninitializeComplete(
     SocketContext->Freed = TRUE;
 #endif
 
-    while (!CxPlatListIsEmpty(&SocketContext->TxQueue)) {
-        CxPlatSendDataFree(
-            CXPLAT_CONTAINING_RECORD(
-                CxPlatListRemoveHead(&SocketContext->TxQueue),
-                CXPLAT_SEND_DATA,
-                TxEntry));
+    CXPLAT_SEND_DATA* SendData;
+    while ((SendData = CxPlatIoRingPeek(&SocketContext->TxRing)) != NULL) {
+        CxPlatIoRingPop(&SocketContext->TxRing);
+        CxPlatSendDataFree(SendData);
     }
 
     CXPLAT_DBG_ASSERT(SocketContext->AcceptSocket == NULL);
@@ -1169,9 +1805,34 @@ CxPlatSocketContextUninitializeComplete(
         CxPlatSqeCleanup(SocketContext->DatapathPartition->EventQ, &SocketContext->ShutdownSqe);
         CxPlatSqeCleanup(SocketContext->DatapathPartition->EventQ, &SocketContext->IoSqe);
         CxPlatSqeCleanup(SocketContext->DatapathPartition->EventQ, &SocketContext->FlushTxSqe);
+        if (SocketContext->Binding->CidSteering) {
+            CxPlatSqeCleanup(SocketContext->DatapathPartition->EventQ, &SocketContext->SteerSqe);
+        }
+    }
+
+    if (SocketContext->Binding->CidSteering) {
+        //
+        // No more datagrams can be steered here after the upcall rundown, so
+        // anything still queued is just returned.
+        //
+        if (SocketContext->SteerHead != NULL) {
+            RecvDataReturn(SocketContext->SteerHead);
+        }
+        CxPlatLockUninitialize(&SocketContext->SteerLock);
+    }
+
+    if (SocketContext->LoopbackRxRing != NULL) {
+        CXPLAT_DBG_ASSERT(!SocketContext->LoopbackInserted);
+        CXPLAT_RECV_DATA* DatagramChain;
+        while ((DatagramChain = CxPlatIoRingPeek(SocketContext->LoopbackRxRing)) != NULL) {
+            CxPlatIoRingPop(SocketContext->LoopbackRxRing);
+            RecvDataReturn(DatagramChain);
+        }
+        CxPlatSqeCleanup(SocketContext->DatapathPartition->EventQ, &SocketContext->LoopbackRxSqe);
+        CXPLAT_FREE(SocketContext->LoopbackRxRing, QUIC_POOL_SOCKET);
+        SocketContext->LoopbackRxRing = NULL;
     }
 
-    CxPlatLockUninitialize(&SocketContext->TxQueueLock);
     CxPlatRundownUninitialize(&SocketContext->UpcallRundown);
 
     if (SocketContext->DatapathPartition) {
@@ -1201,6 +1862,13 @@ CxPlatSocketContextUninitialize(
 #endif
 
     if (!SocketContext->IoStarted) {
+        if (SocketContext->LoopbackInserted) {
+            //
+            // A loopback sender may already have found it in the table.
+            //
+            CxPlatSocketContextLoopbackRemove(SocketContext);
+            CxPlatRundownReleaseAndWait(&SocketContext->UpcallRundown);
+        }
         CxPlatSocketContextUninitializeComplete(SocketContext);
     } else {
         if (SocketContext->Binding->Type == CXPLAT_SOCKET_TCP ||
@@ -1222,12 +1890,18 @@ CxPlatSocketContextUninitialize(
             }
         }
 
+        if (SocketContext->Binding->Datapath->Loopback) {
+            CxPlatSocketContextLoopbackRemove(SocketContext); // Stop new deliveries.
+        }
+
         CxPlatRundownReleaseAndWait(&SocketContext->UpcallRundown); // Block until all upcalls complete.
 
         //
         // Cancel and clean up any pending IO.
         //
-        epoll_ctl(*SocketContext->DatapathPartition->EventQ, EPOLL_CTL_DEL, SocketContext->SocketFd, NULL);
+        if (SocketContext->SocketFd != INVALID_SOCKET) {
+            epoll_ctl(*SocketContext->DatapathPartition->EventQ, EPOLL_CTL_DEL, SocketContext->SocketFd, NULL);
+        }
 
         CXPLAT_FRE_ASSERT(
             CxPlatEventQEnqueue(
@@ -1275,7 +1949,8 @@ SocketCreateUdp(
 {
     QUIC_STATUS Status = QUIC_STATUS_SUCCESS;
     const BOOLEAN IsServerSocket = Config->RemoteAddress == NULL;
-    const BOOLEAN NumPerProcessorSockets = IsServerSocket && Datapath->PartitionCount > 1;
+    const BOOLEAN NumPerProcessorSockets =
+        IsServerSocket && Datapath->PartitionCount > 1 && !Datapath->Loopback;
     const uint16_t SocketCount = NumPerProcessorSockets ? (uint16_t)CxPlatProcCount() : 1;
 
     CXPLAT_DBG_ASSERT(Datapath->UdpHandlers.Receive != NULL || Config->Flags & CXPLAT_SOCKET_FLAG_PCP);
@@ -1318,13 +1993,28 @@ SocketCreateUdp(
     if (Config->Flags & CXPLAT_SOCKET_FLAG_PCP) {
         Binding->PcpBinding = TRUE;
     }
+    if (Datapath->CidSteering &&
+        NumPerProcessorSockets &&
+        !Binding->PcpBinding &&
+        Config->CidPartitionIdMask != 0 &&
+        Config->CidPartitionCount != 0 &&
+        Config->CidPartitionCount <= Datapath->PartitionCount &&
+        Config->CidPartitionCount <= SocketCount) {
+        Binding->CidSteering = TRUE;
+        Binding->CidPartitionIdOffset = Config->CidPartitionIdOffset;
+        Binding->CidPartitionIdMask = Config->CidPartitionIdMask;
+        Binding->CidPartitionCount = Config->CidPartitionCount;
+    }
 
     for (uint32_t i = 0; i < SocketCount; i++) {
         Binding->SocketContexts[i].Binding = Binding;
         Binding->SocketContexts[i].SocketFd = INVALID_SOCKET;
-        CxPlatListInitializeHead(&Binding->SocketContexts[i].TxQueue);
-        CxPlatLockInitialize(&Binding->SocketContexts[i].TxQueueLock);
+        CxPlatIoRingInitialize(&Binding->SocketContexts[i].TxRing);
         CxPlatRundownInitialize(&Binding->SocketContexts[i].UpcallRundown);
+        if (Binding->CidSteering) {
+            Binding->SocketContexts[i].SteerTail = &Binding->SocketContexts[i].SteerHead;
+            CxPlatLockInitialize(&Binding->SocketContexts[i].SteerLock);
+        }
     }
 
     for (uint32_t i = 0; i < SocketCount; i++) {
@@ -1339,14 +2029,21 @@ SocketCreateUdp(
         }
     }
 
-    if (IsServerSocket) {
+    if (IsServerSocket && !Datapath->Loopback) {
         //
         // The return value is being ignored here, as if a system does not support
         // bpf we still want the server to work. If this happens, the sockets will
         // round robin, but each flow will be sent to the same socket, just not
-        // based on RSS.
+        // based on RSS. With CID steering, datagrams the kernel doesn't steer
+        // to the right socket are still steered by the receive path.
         //
-        (void)CxPlatSocketConfigureRss(&Binding->SocketContexts[0], SocketCount);
+        if (!Binding->CidSteering ||
+            CxPlatDataPathTestHooks.SkipCidSteeringProgram ||
+            QUIC_FAILED(
+                CxPlatSocketConfigureCidSteering(
+                    &Binding->SocketContexts[0], Config, SocketCount))) {
+            (void)CxPlatSocketConfigureRss(&Binding->SocketContexts[0], SocketCount);
+        }
     }
 
     CxPlatConvertFromMappedV6(&Binding->LocalAddress, &Binding->LocalAddress);
@@ -1365,7 +2062,9 @@ SocketCreateUdp(
     *NewBinding = Binding;
 
     for (uint32_t i = 0; i < SocketCount; i++) {
-        CxPlatSocketContextSetEvents(&Binding->SocketContexts[i], EPOLL_CTL_ADD, EPOLLIN);
+        if (!Datapath->Loopback) {
+            CxPlatSocketContextSetEvents(&Binding->SocketContexts[i], EPOLL_CTL_ADD, EPOLLIN);
+        }
         Binding->SocketContexts[i].IoStarted = TRUE;
     }
 
@@ -1452,8 +2151,7 @@ CxPlatSocketCreateTcpInternal(
     SocketContext = &Binding->SocketContexts[0];
     SocketContext->Binding = Binding;
     SocketContext->SocketFd = INVALID_SOCKET;
-    CxPlatListInitializeHead(&SocketContext->TxQueue);
-    CxPlatLockInitialize(&SocketContext->TxQueueLock);
+    CxPlatIoRingInitialize(&SocketContext->TxRing);
     CxPlatRundownInitialize(&SocketContext->UpcallRundown);
 
     CXPLAT_UDP_CONFIG Config = {
@@ -1618,8 +2316,7 @@ SocketCreateTcpListener(
     for (uint32_t i = 0; i < SocketCount; i++) {
         Binding->SocketContexts[i].Binding = Binding;
         Binding->SocketContexts[i].SocketFd = INVALID_SOCKET;
-        CxPlatListInitializeHead(&Binding->SocketContexts[i].TxQueue);
-        CxPlatLockInitialize(&Binding->SocketContexts[i].TxQueueLock);
+        CxPlatIoRingInitialize(&Binding->SocketContexts[i].TxRing);
         CxPlatRundownInitialize(&Binding->SocketContexts[i].UpcallRundown);
     }
 
@@ -1804,6 +2501,104 @@ CxPlatSocketHandleErrors(
     }
 }
 
+//
+// Returns the index of the partition encoded in the destination CID of a short
+// header datagram, or UINT16_MAX if the datagram can't be steered by its CID.
+//
+static
+uint16_t
+CxPlatSocketGetCidPartition(
+    _In_ const CXPLAT_SOCKET* Binding,
+    _In_reads_bytes_(BufferLength) const uint8_t* Buffer,
+    _In_ uint16_t BufferLength
+    )
+{
+    //
+    // The partition ID is copied into the CID in host byte order, right after
+    // the first byte (flags) of a short header.
+    //
+    const uint32_t PidOffset = 1 + Binding->CidPartitionIdOffset;
+    if (BufferLength < PidOffset + sizeof(uint16_t) || (Buffer[0] & 0x80)) {
+        return UINT16_MAX;
+    }
+    uint16_t PartitionId;
+    CxPlatCopyMemory(&PartitionId, Buffer + PidOffset, sizeof(PartitionId));
+    return (PartitionId & Binding->CidPartitionIdMask) % Binding->CidPartitionCount;
+}
+
+typedef struct CXPLAT_STEERED_RECV {
+    CXPLAT_SOCKET_CONTEXT* Target;
+    CXPLAT_RECV_DATA* Head;
+    CXPLAT_RECV_DATA** Tail;
+    uint32_t Count;
+} CXPLAT_STEERED_RECV;
+
+//
+// Queues a chain of datagrams to be indicated on another socket context's
+// partition, and wakes that partition up if its queue was empty.
+//
+static
+void
+CxPlatSocketContextSteerRecv(
+    _In_ CXPLAT_STEERED_RECV* Steered
+    )
+{
+    CXPLAT_SOCKET_CONTEXT* Target = Steered->Target;
+    if (!CxPlatRundownAcquire(&Target->UpcallRundown)) {
+        RecvDataReturn(Steered->Head); // Being cleaned up.
+        return;
+    }
+
+    BOOLEAN Queued = FALSE, WakeTarget = FALSE;
+    CxPlatLockAcquire(&Target->SteerLock);
+    if (Target->SteerCount + Steered->Count <= CXPLAT_STEER_QUEUE_MAX_DATAGRAMS) {
+        WakeTarget = Target->SteerHead == NULL;
+        *Target->SteerTail = Steered->Head;
+        Target->SteerTail = Steered->Tail;
+        Target->SteerCount += Steered->Count;
+        Queued = TRUE;
+    }
+    CxPlatLockRelease(&Target->SteerLock);
+
+    if (!Queued) {
+        RecvDataReturn(Steered->Head);
+    } else if (WakeTarget) {
+        CXPLAT_FRE_ASSERT(
+            CxPlatEventQEnqueue(
+                Target->DatapathPartition->EventQ,
+                &Target->SteerSqe));
+    }
+
+    CxPlatRundownRelease(&Target->UpcallRundown);
+}
+
+void
+CxPlatSocketContextSteerEventComplete(
+    _In_ CXPLAT_CQE* Cqe
+    )
+{
+    CXPLAT_SOCKET_CONTEXT* SocketContext =
+        CXPLAT_CONTAINING_RECORD(CxPlatCqeGetSqe(Cqe), CXPLAT_SOCKET_CONTEXT, SteerSqe);
+
+    if (CxPlatRundownAcquire(&SocketContext->UpcallRundown)) {
+        CxPlatLockAcquire(&SocketContext->SteerLock);
+        CXPLAT_RECV_DATA* DatagramHead = SocketContext->SteerHead;
+        SocketContext->SteerHead = NULL;
+        SocketContext->SteerTail = &SocketContext->SteerHead;
+        SocketContext->SteerCount = 0;
+        CxPlatLockRelease(&SocketContext->SteerLock);
+
+        if (DatagramHead != NULL) {
+            CXPLAT_DBG_ASSERT(SocketContext->Binding->Datapath->UdpHandlers.Receive);
+            SocketContext->Binding->Datapath->UdpHandlers.Receive(
+                SocketContext->Binding,
+                SocketContext->Binding->ClientContext,
+                DatagramHead);
+        }
+        CxPlatRundownRelease(&SocketContext->UpcallRundown);
+    }
+}
+
 void
 CxPlatSocketContextRecvComplete(
     _In_ CXPLAT_SOCKET_CONTEXT* SocketContext,
@@ -1814,9 +2609,14 @@ CxPlatSocketContextRecvComplete(
 {
     CXPLAT_DBG_ASSERT(SocketContext->Binding->Datapath == SocketContext->DatapathPartition->Datapath);
 
+    CXPLAT_DATAPATH_RECEIVE_FILTER_CALLBACK_HANDLER ReceiveFilter =
+        SocketContext->Binding->PcpBinding ?
+            NULL : SocketContext->Binding->Datapath->UdpHandlers.ReceiveFilter;
     uint32_t BytesTransferred = 0;
     CXPLAT_RECV_DATA* DatagramHead = NULL;
     CXPLAT_RECV_DATA** DatagramTail = &DatagramHead;
+    CXPLAT_STEERED_RECV Steered[CXPLAT_MAX_IO_BATCH_SIZE];
+    uint32_t SteeredCount = 0;
     for (int CurrentMessage = 0; CurrentMessage < MessagesReceived; CurrentMessage++) {
         DATAPATH_RX_IO_BLOCK* IoBlock = IoBlocks[CurrentMessage];
         IoBlocks[CurrentMessage] = NULL;
@@ -1904,6 +2704,7 @@ CxPlatSocketContextRecvComplete(
         uint8_t* RecvBuffer =
             (uint8_t*)IoBlock + SocketContext->DatapathPartition->Datapath->RecvBlockBufferOffset;
         IoBlock->RefCount = 0;
+        CXPLAT_RECV_DATA** BlockHead = DatagramTail;
 
         //
         // Build up the chain of receive packets to indicate up to the app.
@@ -1911,6 +2712,23 @@ CxPlatSocketContextRecvComplete(
         uint32_t Offset = 0;
         while (Offset < RecvMsgHdr[CurrentMessage].msg_len &&
                IoBlock->RefCount < CXPLAT_MAX_IO_BATCH_SIZE) {
+            uint16_t BufferLength = SegmentLength;
+            if (RecvMsgHdr[CurrentMessage].msg_len - Offset < SegmentLength) {
+                BufferLength = (uint16_t)(RecvMsgHdr[CurrentMessage].msg_len - Offset);
+            }
+
+            if (ReceiveFilter != NULL &&
+                !ReceiveFilter(
+                    SocketContext->Binding,
+                    SocketContext->Binding->ClientContext,
+                    SocketContext->DatapathPartition->PartitionIndex,
+                    RemoteAddr,
+                    RecvBuffer + Offset,
+                    BufferLength)) {
+                Offset += BufferLength;
+                continue;
+            }
+
             IoBlock->RefCount++;
             Datagram->IoBlock = IoBlock;
 
@@ -1918,11 +2736,7 @@ CxPlatSocketContextRecvComplete(
             RecvData->Next = NULL;
             RecvData->Route = &IoBlock->Route;
             RecvData->Buffer = RecvBuffer + Offset;
-            if (RecvMsgHdr[CurrentMessage].msg_len - Offset < SegmentLength) {
-                RecvData->BufferLength = (uint16_t)(RecvMsgHdr[CurrentMessage].msg_len - Offset);
-            } else {
-                RecvData->BufferLength = SegmentLength;
-            }
+            RecvData->BufferLength = BufferLength;
             RecvData->PartitionIndex = SocketContext->DatapathPartition->PartitionIndex;
             RecvData->TypeOfService = TOS;
             RecvData->HopLimitTTL = (uint8_t)HopLimitTTL;
@@ -1930,6 +2744,7 @@ CxPlatSocketContextRecvComplete(
             RecvData->Route->DatapathType = RecvData->DatapathType = CXPLAT_DATAPATH_TYPE_NORMAL;
             RecvData->QueuedOnConnection = FALSE;
             RecvData->Reserved = FALSE;
+            RecvData->Coalesced = IoBlock->RefCount > 1;
 
             *DatagramTail = RecvData;
             DatagramTail = &RecvData->Next;
@@ -1938,13 +2753,73 @@ CxPlatSocketContextRecvComplete(
             Datagram = (DATAPATH_RX_PACKET*)
                 ((char*)Datagram + SocketContext->DatapathPartition->Datapath->RecvBlockStride);
         }
+
+        if (IoBlock->RefCount == 0) {
+            //
+            // Nothing in this block is being indicated up (everything was
+            // filtered out), so it can go straight back to the pool.
+            //
+            CxPlatPoolFree(IoBlock);
+            continue;
+        }
+
+        if (!SocketContext->Binding->CidSteering) {
+            continue;
+        }
+
+        //
+        // Steer the block to the socket context of the partition that owns the
+        // destination CID. The block's datagrams share one route, so they are
+        // all steered by the first one. With GRO, the kernel coalesces
+        // datagrams by 5-tuple only, so if a peer sends datagrams for several
+        // CIDs (e.g. right after a CID change), the rest of the block may be
+        // indicated on a partition that doesn't own their CID. They are still
+        // delivered, just not on their connection's partition.
+        //
+        const uint16_t PartitionIndex =
+            CxPlatSocketGetCidPartition(
+                SocketContext->Binding, (*BlockHead)->Buffer, (*BlockHead)->BufferLength);
+        if (PartitionIndex == UINT16_MAX ||
+            PartitionIndex == SocketContext->DatapathPartition->PartitionIndex) {
+            continue;
+        }
+
+        CXPLAT_SOCKET_CONTEXT* Target = &SocketContext->Binding->SocketContexts[PartitionIndex];
+        CXPLAT_DBG_ASSERT(Target->DatapathPartition->PartitionIndex == PartitionIndex);
+        IoBlock->Route.Queue = Target;
+        for (CXPLAT_RECV_DATA* RecvData = *BlockHead; RecvData != NULL; RecvData = RecvData->Next) {
+            RecvData->PartitionIndex = PartitionIndex;
+        }
+
+        uint32_t i = 0;
+        while (i < SteeredCount && Steered[i].Target != Target) {
+            ++i;
+        }
+        if (i == SteeredCount) {
+            Steered[i].Target = Target;
+            Steered[i].Head = NULL;
+            Steered[i].Tail = &Steered[i].Head;
+            Steered[i].Count = 0;
+            ++SteeredCount;
+        }
+        *Steered[i].Tail = *BlockHead;
+        Steered[i].Tail = DatagramTail;
+        Steered[i].Count += (uint32_t)IoBlock->RefCount;
+        *BlockHead = NULL;
+        DatagramTail = BlockHead;
+    }
+
+    for (uint32_t i = 0; i < SteeredCount; ++i) {
+        CxPlatSocketContextSteerRecv(&Steered[i]);
     }
 
-    if (BytesTransferred == 0 || DatagramHead == NULL) {
-        QuicTraceLogWarning(
-            DatapathRecvEmpty,
-            "[data][%p] Dropping datagram with empty payload.",
-            SocketContext->Binding);
+    if (DatagramHead == NULL) {
+        if (BytesTransferred == 0) {
+            QuicTraceLogWarning(
+                DatapathRecvEmpty,
+                "[data][%p] Dropping datagram with empty payload.",
+                SocketContext->Binding);
+        }
         return;
     }
 
@@ -1976,7 +2851,7 @@ CxPlatSocketReceiveCoalesced(
     do {
         uint32_t RetryCount = 0;
         do {
-            IoBlock = CxPlatPoolAlloc(&DatapathPartition->RecvBlockPool);
+            IoBlock = CxPlatDataPathAllocRecvBlock(DatapathPartition);
         } while (IoBlock == NULL && ++RetryCount < 10);
         if (IoBlock == NULL) {
             QuicTraceEvent(
@@ -2049,7 +2924,7 @@ CxPlatSocketReceiveMessages(
 
             DATAPATH_RX_IO_BLOCK* IoBlock;
             do {
-                IoBlock = CxPlatPoolAlloc(&DatapathPartition->RecvBlockPool);
+                IoBlock = CxPlatDataPathAllocRecvBlock(DatapathPartition);
             } while (IoBlock == NULL && ++RetryCount < 10);
             if (IoBlock == NULL) {
                 QuicTraceEvent(
@@ -2123,7 +2998,7 @@ CxPlatSocketReceiveTcpData(
     do {
         uint32_t RetryCount = 0;
         do {
-            IoBlock = CxPlatPoolAlloc(&DatapathPartition->RecvBlockPool);
+            IoBlock = CxPlatDataPathAllocRecvBlock(DatapathPartition);
         } while (IoBlock == NULL && ++RetryCount < 10);
         if (IoBlock == NULL) {
             QuicTraceEvent(
@@ -2174,6 +3049,7 @@ CxPlatSocketReceiveTcpData(
             Data->Allocated = TRUE;
             Data->Route->DatapathType = Data->DatapathType = CXPLAT_DATAPATH_TYPE_NORMAL;
             Data->QueuedOnConnection = FALSE;
+            Data->Coalesced = FALSE;
             IoBlock->RefCount++;
             IoBlock = NULL;
 
@@ -2217,7 +3093,7 @@ RecvDataReturn(
         DATAPATH_RX_PACKET* Packet =
             CXPLAT_CONTAINING_RECORD(Datagram, DATAPATH_RX_PACKET, Data);
         if (InterlockedDecrement(&Packet->IoBlock->RefCount) == 0) {
-            CxPlatPoolFree(Packet->IoBlock);
+            CxPlatDataPathFreeRecvBlock(Packet->IoBlock);
         }
     }
 }
@@ -2243,7 +3119,24 @@ SendDataAlloc(
     CXPLAT_SOCKET_CONTEXT* SocketContext = Config->Route->Queue;
     CXPLAT_DBG_ASSERT(SocketContext->Binding == Socket);
     CXPLAT_DBG_ASSERT(SocketContext->Binding->Datapath == SocketContext->DatapathPartition->Datapath);
-    CXPLAT_SEND_DATA* SendData = CxPlatPoolAlloc(&SocketContext->DatapathPartition->SendBlockPool);
+
+    //
+    // Allocate from a partition on the caller's NUMA node, which is the node
+    // that fills in the send buffers.
+    //
+    CXPLAT_DATAPATH* Datapath = Socket->Datapath;
+    CXPLAT_DATAPATH_PARTITION* DatapathPartition = SocketContext->DatapathPartition;
+    if (Datapath->NumaAware) {
+        const uint32_t Proc = CxPlatProcCurrentNumber();
+        if (Proc < Datapath->ProcCount &&
+            Datapath->ProcNumaNodes[Proc] != DatapathPartition->NumaNode &&
+            Datapath->ProcPartitions[Proc] != UINT16_MAX) {
+            DatapathPartition = &Datapath->Partitions[Datapath->ProcPartitions[Proc]];
+            InterlockedIncrement64(&DatapathPartition->CrossNodeSendCount);
+        }
+    }
+
+    CXPLAT_SEND_DATA* SendData = CxPlatPoolExAlloc(&DatapathPartition->SendBlockPool);
     if (SendData != NULL) {
         SendData->SocketContext = SocketContext;
         SendData->ClientBuffer.Buffer = SendData->Buffer;
@@ -2373,50 +3266,214 @@ CxPlatSendDataSend(
     _In_ CXPLAT_SEND_DATA* SendData
     );
 
+//
+// Hands the send data over to the loopback socket bound to the destination
+// address. The payload is copied into receive blocks on the sender's thread
+// and pushed onto the target's receive ring, and the target's partition
+// indicates them on its own thread, as it would datagrams from a kernel
+// socket. No system calls are made beyond waking the target partition when its
+// ring was empty. Sends to addresses without a bound socket are silently
+// dropped, as are ones that find the target's ring full.
+//
 void
-SocketSend(
-    _In_ CXPLAT_SOCKET* Socket,
-    _In_ const CXPLAT_ROUTE* Route,
-    _In_ CXPLAT_SEND_DATA* SendData
+CxPlatSendDataSendLoopback(
+    _In_ CXPLAT_SEND_DATA* SendData,
+    _In_ const CXPLAT_ROUTE* Route
     )
 {
-    UNREFERENCED_PARAMETER(Socket);
+    CXPLAT_DATAPATH_PARTITION* DatapathPartition = SendData->SocketContext->DatapathPartition;
+    CXPLAT_DATAPATH* Datapath = DatapathPartition->Datapath;
+    CxPlatRwLockAcquireShared(&Datapath->LoopbackLock);
+    CXPLAT_SOCKET_CONTEXT* Target =
+        CxPlatDataPathLookupLoopbackSocket(Datapath, &Route->RemoteAddress);
+    if (Target != NULL && !CxPlatRundownAcquire(&Target->UpcallRundown)) {
+        Target = NULL;
+    }
+    CxPlatRwLockReleaseShared(&Datapath->LoopbackLock);
 
-    //
-    // Finalize the state of the send data and log the send.
-    //
-    CxPlatSendDataFinalizeSendBuffer(SendData);
+    if (Target == NULL) {
+        return;
+    }
+
+    const uint32_t SegmentSize =
+        SendData->SegmentSize != 0 ? SendData->SegmentSize : SendData->TotalSize;
+    uint32_t Offset = 0;
+
+    while (Offset < SendData->TotalSize) {
+        DATAPATH_RX_IO_BLOCK* IoBlock = CxPlatDataPathAllocRecvBlock(DatapathPartition);
+        if (IoBlock == NULL) {
+            QuicTraceEvent(
+                AllocFailure,
+                "Allocation of '%s' failed. (%llu bytes)",
+                "DATAPATH_RX_IO_BLOCK",
+                0);
+            break;
+        }
+
+        IoBlock->Route.State = RouteResolved;
+        IoBlock->Route.Queue = Target;
+        IoBlock->Route.LocalAddress = Route->RemoteAddress;
+        IoBlock->Route.RemoteAddress = Route->LocalAddress;
+        IoBlock->RefCount = 0;
+
+        DATAPATH_RX_PACKET* Datagram = (DATAPATH_RX_PACKET*)(IoBlock + 1);
+        uint8_t* RecvBuffer = (uint8_t*)IoBlock + Datapath->RecvBlockBufferOffset;
+        CXPLAT_RECV_DATA* DatagramHead = NULL;
+        CXPLAT_RECV_DATA** DatagramTail = &DatagramHead;
+        const uint32_t BlockStart = Offset;
+
+        //
+        // Build up the chain of receive packets, one per segment.
+        //
+        while (Offset < SendData->TotalSize &&
+               IoBlock->RefCount < CXPLAT_MAX_IO_BATCH_SIZE) {
+            IoBlock->RefCount++;
+            Datagram->IoBlock = IoBlock;
+
+            CXPLAT_RECV_DATA* RecvData = &Datagram->Data;
+            RecvData->Next = NULL;
+            RecvData->Route = &IoBlock->Route;
+            RecvData->Buffer = RecvBuffer + (Offset - BlockStart);
+            RecvData->BufferLength =
+                (uint16_t)CXPLAT_MIN(SegmentSize, SendData->TotalSize - Offset);
+            RecvData->PartitionIndex = Target->DatapathPartition->PartitionIndex;
+            RecvData->TypeOfService = (uint8_t)((SendData->DSCP << 2) | SendData->ECN);
+            RecvData->HopLimitTTL = CXPLAT_LOOPBACK_HOP_LIMIT;
+            RecvData->Allocated = TRUE;
+            RecvData->Route->DatapathType = RecvData->DatapathType = CXPLAT_DATAPATH_TYPE_NORMAL;
+            RecvData->QueuedOnConnection = FALSE;
+            RecvData->Reserved = FALSE;
+            RecvData->Coalesced = IoBlock->RefCount > 1;
+
+            *DatagramTail = RecvData;
+            DatagramTail = &RecvData->Next;
+
+            Offset += RecvData->BufferLength;
+            Datagram = (DATAPATH_RX_PACKET*)((char*)Datagram + Datapath->RecvBlockStride);
+        }
+
+        CxPlatCopyMemory(RecvBuffer, SendData->Buffer + BlockStart, Offset - BlockStart);
+
+        QuicTraceEvent(
+            DatapathRecv,
+            "[data][%p] Recv %u bytes (segment=%hu) Src=%!ADDR! Dst=%!ADDR!",
+            Target->Binding,
+            Offset - BlockStart,
+            (uint16_t)SegmentSize,
+            CASTED_CLOG_BYTEARRAY(sizeof(IoBlock->Route.LocalAddress), &IoBlock->Route.LocalAddress),
+            CASTED_CLOG_BYTEARRAY(sizeof(IoBlock->Route.RemoteAddress), &IoBlock->Route.RemoteAddress));
+
+        BOOLEAN AtHead;
+        if (!CxPlatIoRingPush(Target->LoopbackRxRing, DatagramHead, &AtHead)) {
+            QuicTraceEvent(
+                DatapathErrorStatus,
+                "[data][%p] ERROR, %u, %s.",
+                Target->Binding,
+                QUIC_STATUS_BUFFER_TOO_SMALL,
+                "loopback receive ring full");
+            RecvDataReturn(DatagramHead);
+        } else if (AtHead) {
+            //
+            // The target may have drained its ring before this chain was
+            // published, so have it drain again.
+            //
+            CXPLAT_FRE_ASSERT(
+                CxPlatEventQEnqueue(
+                    Target->DatapathPartition->EventQ,
+                    &Target->LoopbackRxSqe));
+        }
+    }
+
+    CxPlatRundownRelease(&Target->UpcallRundown);
+}
+
+//
+// Indicates the datagrams loopback senders have queued on the socket context,
+// on its partition's thread.
+//
+void
+CxPlatSocketContextLoopbackRxEventComplete(
+    _In_ CXPLAT_CQE* Cqe
+    )
+{
+    CXPLAT_SOCKET_CONTEXT* SocketContext =
+        CXPLAT_CONTAINING_RECORD(CxPlatCqeGetSqe(Cqe), CXPLAT_SOCKET_CONTEXT, LoopbackRxSqe);
+
+    if (!CxPlatRundownAcquire(&SocketContext->UpcallRundown)) {
+        return; // Anything still queued is returned by the cleanup.
+    }
+
+    CXPLAT_SOCKET* Binding = SocketContext->Binding;
+    CXPLAT_RECV_DATA* DatagramChain;
+    while ((DatagramChain = CxPlatIoRingPeek(SocketContext->LoopbackRxRing)) != NULL) {
+        CxPlatIoRingPop(SocketContext->LoopbackRxRing);
+        if (!Binding->PcpBinding) {
+            Binding->Datapath->UdpHandlers.Receive(
+                Binding,
+                Binding->ClientContext,
+                DatagramChain);
+        } else {
+            CxPlatPcpRecvCallback(
+                Binding,
+                Binding->ClientContext,
+                DatagramChain);
+        }
+    }
+
+    CxPlatRundownRelease(&SocketContext->UpcallRundown);
+}
+
+//
+// Completes a send that couldn't be queued because too many sends are already
+// waiting on the socket context.
+//
+static
+void
+CxPlatSocketContextDropSend(
+    _In_ CXPLAT_SOCKET_CONTEXT* SocketContext,
+    _In_ CXPLAT_SEND_DATA* SendData
+    )
+{
     QuicTraceEvent(
-        DatapathSend,
-        "[data][%p] Send %u bytes in %hhu buffers (segment=%hu) Dst=%!ADDR!, Src=%!ADDR!",
-        Socket,
-        SendData->TotalSize,
-        SendData->BufferCount,
-        SendData->SegmentSize,
-        CASTED_CLOG_BYTEARRAY(sizeof(Route->RemoteAddress), &Route->RemoteAddress),
-        CASTED_CLOG_BYTEARRAY(sizeof(Route->LocalAddress), &Route->LocalAddress));
+        DatapathErrorStatus,
+        "[data][%p] ERROR, %u, %s.",
+        SocketContext->Binding,
+        QUIC_STATUS_OUT_OF_MEMORY,
+        "send ring full");
+    if (SocketContext->Binding->Type != CXPLAT_SOCKET_UDP) {
+        SocketContext->Binding->Datapath->TcpHandlers.SendComplete(
+            SocketContext->Binding,
+            SocketContext->Binding->ClientContext,
+            QUIC_STATUS_OUT_OF_MEMORY,
+            SendData->TotalSize);
+    }
+    CxPlatSendDataFree(SendData);
+}
 
-    //
-    // Cache the address, mapping the remote address as necessary.
-    //
-    CxPlatConvertToMappedV6(&Route->RemoteAddress, &SendData->RemoteAddress);
-    SendData->LocalAddress = Route->LocalAddress;
+//
+// Sends the data on its socket context, or queues it behind any sends already
+// waiting for the socket to become writable.
+//
+static
+void
+CxPlatSocketContextSendOrQueue(
+    _In_ CXPLAT_SEND_DATA* SendData
+    )
+{
+    CXPLAT_SOCKET_CONTEXT* SocketContext = SendData->SocketContext;
+    BOOLEAN AtHead;
 
     //
     // Check to see if we need to pend because there's already queue.
     //
-    BOOLEAN SendPending = FALSE, FlushTxQueue = FALSE;
-    CXPLAT_SOCKET_CONTEXT* SocketContext = SendData->SocketContext;
-    CxPlatLockAcquire(&SocketContext->TxQueueLock);
-    if (/*SendData->Flags & CXPLAT_SEND_FLAGS_MAX_THROUGHPUT ||*/
-        !CxPlatListIsEmpty(&SocketContext->TxQueue)) {
-        FlushTxQueue = CxPlatListIsEmpty(&SocketContext->TxQueue);
-        CxPlatListInsertTail(&SocketContext->TxQueue, &SendData->TxEntry);
-        SendPending = TRUE;
-    }
-    CxPlatLockRelease(&SocketContext->TxQueueLock);
-    if (SendPending) {
-        if (FlushTxQueue) {
+    if (!CxPlatIoRingIsEmpty(&SocketContext->TxRing)) {
+        if (!CxPlatIoRingPush(&SocketContext->TxRing, SendData, &AtHead)) {
+            CxPlatSocketContextDropSend(SocketContext, SendData);
+        } else if (AtHead) {
+            //
+            // The partition may have drained the ring before this send was
+            // published, so have it flush again.
+            //
             CXPLAT_FRE_ASSERT(
                 CxPlatEventQEnqueue(
                     SocketContext->DatapathPartition->EventQ,
@@ -2434,12 +3491,13 @@ SocketSend(
         // Couldn't send right now, so queue up the send and wait for send
         // (EPOLLOUT) to be ready.
         //
-        CxPlatLockAcquire(&SocketContext->TxQueueLock);
-        CxPlatListInsertTail(&SocketContext->TxQueue, &SendData->TxEntry);
-        CxPlatLockRelease(&SocketContext->TxQueueLock);
-        CxPlatSocketContextSetEvents(SocketContext, EPOLL_CTL_MOD, EPOLLIN | EPOLLOUT);
+        if (!CxPlatIoRingPush(&SocketContext->TxRing, SendData, &AtHead)) {
+            CxPlatSocketContextDropSend(SocketContext, SendData);
+        } else {
+            CxPlatSocketContextSetEvents(SocketContext, EPOLL_CTL_MOD, EPOLLIN | EPOLLOUT);
+        }
     } else {
-        if (Socket->Type != CXPLAT_SOCKET_UDP) {
+        if (SocketContext->Binding->Type != CXPLAT_SOCKET_UDP) {
             SocketContext->Binding->Datapath->TcpHandlers.SendComplete(
                 SocketContext->Binding,
                 SocketContext->Binding->ClientContext,
@@ -2450,6 +3508,94 @@ SocketSend(
     }
 }
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+SocketIsSendBlocked(
+    _In_ CXPLAT_SOCKET* Socket,
+    _In_ const CXPLAT_ROUTE* Route
+    )
+{
+    const CXPLAT_SOCKET_CONTEXT* SocketContext =
+        Route->Queue != NULL ? Route->Queue : &Socket->SocketContexts[0];
+    return
+        CxPlatIoRingCount(&SocketContext->TxRing) >=
+            CXPLAT_SEND_RING_BLOCKED_THRESHOLD;
+}
+
+//
+// Finalizes the state of the send data and logs the send.
+//
+static
+void
+CxPlatSendDataPrepare(
+    _In_ CXPLAT_SOCKET* Socket,
+    _In_ const CXPLAT_ROUTE* Route,
+    _In_ CXPLAT_SEND_DATA* SendData
+    )
+{
+    UNREFERENCED_PARAMETER(Socket);
+    CxPlatSendDataFinalizeSendBuffer(SendData);
+    QuicTraceEvent(
+        DatapathSend,
+        "[data][%p] Send %u bytes in %hhu buffers (segment=%hu) Dst=%!ADDR!, Src=%!ADDR!",
+        Socket,
+        SendData->TotalSize,
+        SendData->BufferCount,
+        SendData->SegmentSize,
+        CASTED_CLOG_BYTEARRAY(sizeof(Route->RemoteAddress), &Route->RemoteAddress),
+        CASTED_CLOG_BYTEARRAY(sizeof(Route->LocalAddress), &Route->LocalAddress));
+}
+
+void
+SocketSend(
+    _In_ CXPLAT_SOCKET* Socket,
+    _In_ const CXPLAT_ROUTE* Route,
+    _In_ CXPLAT_SEND_DATA* SendData
+    )
+{
+    CxPlatSendDataPrepare(Socket, Route, SendData);
+
+    if (Socket->Datapath->Loopback && Socket->Type == CXPLAT_SOCKET_UDP) {
+        CxPlatSendDataSendLoopback(SendData, Route);
+        CxPlatSendDataFree(SendData);
+        return;
+    }
+
+    //
+    // Cache the address, mapping the remote address as necessary.
+    //
+    CxPlatConvertToMappedV6(&Route->RemoteAddress, &SendData->RemoteAddress);
+    SendData->LocalAddress = Route->LocalAddress;
+
+    CxPlatSocketContextSendOrQueue(SendData);
+}
+
+BOOLEAN
+SocketSendBatched(
+    _In_ CXPLAT_SOCKET* Socket,
+    _In_ const CXPLAT_ROUTE* Route,
+    _In_ CXPLAT_SEND_DATA* SendData,
+    _Inout_ CXPLAT_SEND_BATCH* Batch
+    )
+{
+    if (Socket->Type != CXPLAT_SOCKET_UDP || Socket->Datapath->Loopback) {
+        return FALSE;
+    }
+
+    CXPLAT_DBG_ASSERT(Batch->Count == 0 || Batch->Socket == Socket);
+    if (Batch->Count == CXPLAT_SEND_BATCH_SIZE) {
+        SendBatchFlush(Batch);
+    }
+
+    CxPlatSendDataPrepare(Socket, Route, SendData);
+    CxPlatConvertToMappedV6(&Route->RemoteAddress, &SendData->RemoteAddress);
+    SendData->LocalAddress = Route->LocalAddress;
+
+    Batch->Socket = Socket;
+    Batch->Sends[Batch->Count++] = SendData;
+    return TRUE;
+}
+
 //
 // This is defined and used instead of CMSG_NXTHDR because (1) we've already
 // done the work to ensure the necessary space is available and (2) CMSG_NXTHDR
@@ -2719,27 +3865,142 @@ CxPlatSendDataSend(
 }
 
 //
-// Returns TRUE if the queue was completely drained, and FALSE if there are
-// still pending sends.
+// The maximum number of messages passed to a single sendmmsg call when sending
+// a batch.
+//
+#define CXPLAT_SEND_BATCH_MAX_MESSAGES 64
+
+//
+// Returns the number of messages (one per datagram, or one for all the
+// segments with GSO) the send data is sent as.
+//
+static
+uint16_t
+CxPlatSendDataMessageCount(
+    _In_ const CXPLAT_SEND_DATA* SendData
+    )
+{
+    return SendData->SegmentationSupported ? 1 : SendData->BufferCount;
+}
+
+//
+// Sends batched send data, all for the same socket context, with as few
+// sendmmsg calls as possible. Whatever can't be sent that way goes through the
+// normal send path, which handles errors and queues sends until the socket is
+// writable again.
 //
+static
 void
-CxPlatSocketContextFlushTxQueue(
+CxPlatSocketContextSendBatch(
     _In_ CXPLAT_SOCKET_CONTEXT* SocketContext,
-    _In_ BOOLEAN SendAlreadyPending
+    _In_reads_(Count) CXPLAT_SEND_DATA** Sends,
+    _In_ uint32_t Count
+    )
+{
+    struct mmsghdr Mhdrs[CXPLAT_SEND_BATCH_MAX_MESSAGES];
+    uint32_t Sent = 0;
+
+    //
+    // Sends already waiting for the socket to be writable go first.
+    //
+    BOOLEAN SendPending = !CxPlatIoRingIsEmpty(&SocketContext->TxRing);
+
+    while (!SendPending && Count - Sent > 1) {
+        uint32_t MessageCount = 0;
+        for (uint32_t i = Sent; i < Count && MessageCount < CXPLAT_SEND_BATCH_MAX_MESSAGES; ++i) {
+            CXPLAT_SEND_DATA* SendData = Sends[i];
+            const uint16_t SendDataMessageCount = CxPlatSendDataMessageCount(SendData);
+            for (uint16_t j = SendData->AlreadySentCount;
+                 j < SendDataMessageCount && MessageCount < CXPLAT_SEND_BATCH_MAX_MESSAGES;
+                 ++j) {
+                struct msghdr* Mhdr = &Mhdrs[MessageCount].msg_hdr;
+                Mhdrs[MessageCount++].msg_len = 0;
+                Mhdr->msg_name = (void*)&SendData->RemoteAddress;
+                Mhdr->msg_namelen = sizeof(SendData->RemoteAddress);
+                Mhdr->msg_iov = SendData->Iovs + j;
+                Mhdr->msg_iovlen = 1;
+                Mhdr->msg_flags = 0;
+                Mhdr->msg_control = SendData->ControlBuffer;
+                Mhdr->msg_controllen = SendData->ControlBufferLength;
+
+                if (SendData->ControlBufferLength == 0) {
+                    CxPlatSendDataPopulateAncillaryData(SendData, Mhdr);
+                }
+            }
+        }
+
+        int Result = cxplat_sendmmsg(SocketContext->SocketFd, Mhdrs, MessageCount, 0);
+        if (Result <= 0) {
+            break;
+        }
+
+        //
+        // Complete the send data that went out entirely, and note the progress
+        // of the one that only partly did.
+        //
+        uint32_t MessagesSent = (uint32_t)Result;
+        while (MessagesSent != 0) {
+            CXPLAT_SEND_DATA* SendData = Sends[Sent];
+            const uint16_t Remaining =
+                CxPlatSendDataMessageCount(SendData) - SendData->AlreadySentCount;
+            if (MessagesSent < Remaining) {
+                SendData->AlreadySentCount += (uint16_t)MessagesSent;
+                break;
+            }
+            MessagesSent -= Remaining;
+            CxPlatSendDataFree(SendData);
+            ++Sent;
+        }
+    }
+
+    for (; Sent < Count; ++Sent) {
+        CxPlatSocketContextSendOrQueue(Sends[Sent]);
+    }
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+SendBatchFlush(
+    _Inout_ CXPLAT_SEND_BATCH* Batch
     )
 {
-    CXPLAT_SEND_DATA* SendData = NULL;
-    CxPlatLockAcquire(&SocketContext->TxQueueLock);
-    if (!CxPlatListIsEmpty(&SocketContext->TxQueue)) {
-        SendData =
-            CXPLAT_CONTAINING_RECORD(
-                SocketContext->TxQueue.Flink,
-                CXPLAT_SEND_DATA,
-                TxEntry);
+    //
+    // Send the batch one socket context at a time, keeping the order of the
+    // sends for each.
+    //
+    uint32_t Count = Batch->Count;
+    while (Count != 0) {
+        CXPLAT_SOCKET_CONTEXT* SocketContext = Batch->Sends[0]->SocketContext;
+        CXPLAT_SEND_DATA* Sends[CXPLAT_SEND_BATCH_SIZE];
+        uint32_t SendCount = 0;
+        uint32_t Remaining = 0;
+        for (uint32_t i = 0; i < Count; ++i) {
+            if (Batch->Sends[i]->SocketContext == SocketContext) {
+                Sends[SendCount++] = Batch->Sends[i];
+            } else {
+                Batch->Sends[Remaining++] = Batch->Sends[i];
+            }
+        }
+        CxPlatSocketContextSendBatch(SocketContext, Sends, SendCount);
+        Count = Remaining;
     }
-    CxPlatLockRelease(&SocketContext->TxQueueLock);
 
-    while (SendData != NULL) {
+    Batch->Count = 0;
+    Batch->Socket = NULL;
+}
+
+//
+// Sends as much of the pending queue as the socket will take. Runs on the
+// socket context's partition thread, which is the only consumer of the ring.
+//
+void
+CxPlatSocketContextFlushTxQueue(
+    _In_ CXPLAT_SOCKET_CONTEXT* SocketContext,
+    _In_ BOOLEAN SendAlreadyPending
+    )
+{
+    CXPLAT_SEND_DATA* SendData;
+    while ((SendData = CxPlatIoRingPeek(&SocketContext->TxRing)) != NULL) {
         QUIC_STATUS Status = CxPlatSendDataSend(SendData);
         if (Status == QUIC_STATUS_PENDING) {
             if (!SendAlreadyPending) {
@@ -2751,8 +4012,7 @@ CxPlatSocketContextFlushTxQueue(
             return;
         }
 
-        CxPlatLockAcquire(&SocketContext->TxQueueLock);
-        CxPlatListRemoveHead(&SocketContext->TxQueue);
+        CxPlatIoRingPop(&SocketContext->TxRing);
         if (SocketContext->Binding->Type != CXPLAT_SOCKET_UDP) {
             SocketContext->Binding->Datapath->TcpHandlers.SendComplete(
                 SocketContext->Binding,
@@ -2761,16 +4021,6 @@ CxPlatSocketContextFlushTxQueue(
                 SendData->TotalSize);
         }
         CxPlatSendDataFree(SendData);
-        if (!CxPlatListIsEmpty(&SocketContext->TxQueue)) {
-            SendData =
-                CXPLAT_CONTAINING_RECORD(
-                    SocketContext->TxQueue.Flink,
-                    CXPLAT_SEND_DATA,
-                    TxEntry);
-        } else {
-            SendData = NULL;
-        }
-        CxPlatLockRelease(&SocketContext->TxQueueLock);
     }
 
     if (SendAlreadyPending) {
@@ -2778,6 +4028,14 @@ CxPlatSocketContextFlushTxQueue(
         // Remove the EPOLLOUT event since we don't have any more pending sends.
         //
         CxPlatSocketContextSetEvents(SocketContext, EPOLL_CTL_MOD, EPOLLIN);
+
+        //
+        // A sender that hit EAGAIN may have queued and armed EPOLLOUT just
+        // before it was removed above, so go around again for that send.
+        //
+        if (!CxPlatIoRingIsEmpty(&SocketContext->TxRing)) {
+            CxPlatSocketContextFlushTxQueue(SocketContext, FALSE);
+        }
     }
 }
 
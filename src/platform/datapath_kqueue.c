@@ -562,6 +562,17 @@ CxPlatDataPathGetSupportedFeatures(
     return Datapath->Features;
 }
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+CxPlatDataPathGetBufferStatistics(
+    _In_ CXPLAT_DATAPATH* Datapath,
+    _Out_ CXPLAT_DATAPATH_BUFFER_STATISTICS* Statistics
+    )
+{
+    UNREFERENCED_PARAMETER(Datapath);
+    CxPlatZeroMemory(Statistics, sizeof(*Statistics));
+}
+
 BOOLEAN
 CxPlatDataPathIsPaddingPreferred(
     _In_ CXPLAT_DATAPATH* Datapath,
@@ -2090,6 +2101,48 @@ CxPlatSocketSend(
         FALSE);
 }
 
+BOOLEAN
+CxPlatSocketIsSendBlocked(
+    _In_ CXPLAT_SOCKET* Socket,
+    _In_ const CXPLAT_ROUTE* Route
+    )
+{
+    //
+    // The pending send list here is unbounded, so the socket is never
+    // reported as blocked.
+    //
+    UNREFERENCED_PARAMETER(Socket);
+    UNREFERENCED_PARAMETER(Route);
+    return FALSE;
+}
+
+BOOLEAN
+CxPlatSocketSendBatched(
+    _In_ CXPLAT_SOCKET* Socket,
+    _In_ const CXPLAT_ROUTE* Route,
+    _In_ CXPLAT_SEND_DATA* SendData,
+    _Inout_ CXPLAT_SEND_BATCH* Batch
+    )
+{
+    //
+    // There's no sendmmsg here, so sends aren't batched.
+    //
+    UNREFERENCED_PARAMETER(Socket);
+    UNREFERENCED_PARAMETER(Route);
+    UNREFERENCED_PARAMETER(SendData);
+    UNREFERENCED_PARAMETER(Batch);
+    return FALSE;
+}
+
+void
+CxPlatSendBatchFlush(
+    _Inout_ CXPLAT_SEND_BATCH* Batch
+    )
+{
+    CXPLAT_DBG_ASSERT(Batch->Count == 0);
+    UNREFERENCED_PARAMETER(Batch);
+}
+
 uint16_t
 CxPlatSocketGetLocalMtu(
     _In_ CXPLAT_SOCKET* Socket,
@@ -206,6 +206,47 @@ RawSocketGetLocalMtu(
 
 }
 
+//
+// Runs the datapath receive filter (if any) over a chain of packets for the
+// socket, freeing the packets it rejects. Returns what is left of the chain.
+//
+static
+CXPLAT_RECV_DATA*
+CxPlatDpRawRxFilter(
+    _In_ const CXPLAT_DATAPATH_RAW* Datapath,
+    _In_ CXPLAT_SOCKET_RAW* Socket,
+    _In_ CXPLAT_RECV_DATA* PacketChain
+    )
+{
+    CXPLAT_DATAPATH_RECEIVE_FILTER_CALLBACK_HANDLER ReceiveFilter =
+        Datapath->ParentDataPath->UdpHandlers.ReceiveFilter;
+    if (ReceiveFilter == NULL) {
+        return PacketChain;
+    }
+
+    CXPLAT_RECV_DATA* Head = NULL;
+    CXPLAT_RECV_DATA** Tail = &Head;
+    while (PacketChain != NULL) {
+        CXPLAT_RECV_DATA* Packet = PacketChain;
+        PacketChain = Packet->Next;
+        Packet->Next = NULL;
+        if (ReceiveFilter(
+                CxPlatRawToSocket(Socket),
+                Socket->ClientContext,
+                Packet->PartitionIndex,
+                &Packet->Route->RemoteAddress,
+                Packet->Buffer,
+                Packet->BufferLength)) {
+            *Tail = Packet;
+            Tail = &Packet->Next;
+        } else {
+            CxPlatDpRawRxFree(Packet);
+        }
+    }
+
+    return Head;
+}
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 void
 CxPlatDpRawRxEthernet(
@@ -254,7 +295,10 @@ CxPlatDpRawRxEthernet(
                     CXPLAT_DBG_ASSERT(Packets[i+1]->Next == NULL);
                     i++;
                 }
-                Datapath->ParentDataPath->UdpHandlers.Receive(CxPlatRawToSocket(Socket), Socket->ClientContext, PacketChain);
+                PacketChain = CxPlatDpRawRxFilter(Datapath, Socket, PacketChain);
+                if (PacketChain != NULL) {
+                    Datapath->ParentDataPath->UdpHandlers.Receive(CxPlatRawToSocket(Socket), Socket->ClientContext, PacketChain);
+                }
             } else if (PacketChain->Reserved == L4_TYPE_TCP_SYN || PacketChain->Reserved == L4_TYPE_TCP_SYNACK) {
                 CxPlatDpRawSocketAckSyn(Socket, PacketChain);
                 CxPlatDpRawRxFree(PacketChain);
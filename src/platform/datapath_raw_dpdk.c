@@ -7,97 +7,190 @@ Abstract:
 
     QUIC DPDK Datapath Implementation (User Mode)
 
-    - Requires Clang to build
-    - Leverages Mellanox PMD (requires CX4 or CX5)
+    - Requires DPDK 20.11 or newer
+    - One Rx/Tx queue pair per partition, polled from the partition's
+      execution context on the worker pool
+    - Works with any PMD, including the net_tap, net_ring and net_null virtual
+      devices, which need no special NIC (see CxPlatDpdkReadConfig)
 
 --*/
 
-#define _CRT_SECURE_NO_WARNINGS 1 // TODO - Remove
-
-#include "datapath_raw.h"
+#include "datapath_raw_linux.h"
 #ifdef QUIC_CLOG
 #include "datapath_raw_dpdk.c.clog.h"
 #endif
 
-#include <rte_memory.h>
-#include <rte_launch.h>
+#include <rte_version.h>
 #include <rte_eal.h>
-#include <rte_per_lcore.h>
 #include <rte_lcore.h>
-#include <rte_debug.h>
 #include <rte_ethdev.h>
-#include <rte_mbuf_core.h>
+#include <rte_mbuf.h>
+#include <rte_mempool.h>
+#include <rte_ring.h>
+#include <rte_ether.h>
+#include <rte_ip.h>
+#include <rte_udp.h>
+#include <rte_tcp.h>
+
+//
+// The offload and RSS definitions were renamed in 21.11.
+//
+#if RTE_VERSION < RTE_VERSION_NUM(21, 11, 0, 0)
+#define RTE_ETH_MQ_RX_NONE              ETH_MQ_RX_NONE
+#define RTE_ETH_MQ_RX_RSS               ETH_MQ_RX_RSS
+#define RTE_ETH_RSS_IP                  ETH_RSS_IP
+#define RTE_ETH_RSS_UDP                 ETH_RSS_UDP
+#define RTE_ETH_RX_OFFLOAD_IPV4_CKSUM   DEV_RX_OFFLOAD_IPV4_CKSUM
+#define RTE_ETH_RX_OFFLOAD_UDP_CKSUM    DEV_RX_OFFLOAD_UDP_CKSUM
+#define RTE_ETH_TX_OFFLOAD_IPV4_CKSUM   DEV_TX_OFFLOAD_IPV4_CKSUM
+#define RTE_ETH_TX_OFFLOAD_UDP_CKSUM    DEV_TX_OFFLOAD_UDP_CKSUM
+#define RTE_ETH_TX_OFFLOAD_TCP_CKSUM    DEV_TX_OFFLOAD_TCP_CKSUM
+#define RTE_MBUF_F_RX_IP_CKSUM_BAD      PKT_RX_IP_CKSUM_BAD
+#define RTE_MBUF_F_RX_L4_CKSUM_BAD      PKT_RX_L4_CKSUM_BAD
+#define RTE_MBUF_F_TX_IPV4              PKT_TX_IPV4
+#define RTE_MBUF_F_TX_IPV6              PKT_TX_IPV6
+#define RTE_MBUF_F_TX_IP_CKSUM          PKT_TX_IP_CKSUM
+#define RTE_MBUF_F_TX_UDP_CKSUM         PKT_TX_UDP_CKSUM
+#define RTE_MBUF_F_TX_TCP_CKSUM         PKT_TX_TCP_CKSUM
+#endif
 
-#define NUM_MBUFS 8191
-#define MBUF_CACHE_SIZE 250
-#define RX_BURST_SIZE 16
-#define TX_BURST_SIZE 16
-#define TX_RING_SIZE 1024
+#define DEFAULT_MBUF_COUNT      8191    // Per queue.
+#define DEFAULT_DESCRIPTORS     1024
+#define MBUF_CACHE_SIZE         256
+#define RX_BURST_SIZE           32
+#define TX_BURST_SIZE           32
+#define TX_RING_SIZE            4096
 
-typedef struct DPDK_INTERFACE {
+typedef struct DPDK_DATAPATH DPDK_DATAPATH;
+typedef struct DPDK_PARTITION DPDK_PARTITION;
 
-    CXPLAT_INTERFACE;
+typedef struct DPDK_QUEUE {
+    const struct DPDK_INTERFACE* Interface;
+    DPDK_PARTITION* Partition;
+    struct DPDK_QUEUE* Next; // In the partition's list of queues.
+    uint16_t Id;
 
-    uint16_t Port;
-    CXPLAT_LOCK TxLock;
+    //
+    // Holds both the frames and, in each mbuf's private area, the Rx or Tx
+    // packet that describes it to the stack.
+    //
     struct rte_mempool* MemoryPool;
-    struct rte_ring* TxRingBuffer;
 
-    // Constants
-    char DeviceName[32];
+    //
+    // Sends enqueued from any thread, drained by the partition.
+    //
+    struct rte_ring* TxRing;
+
+    //
+    // Sends dequeued from the ring that the device didn't have room for yet.
+    // Only accessed by the partition.
+    //
+    uint16_t TxPendingCount;
+    struct rte_mbuf* TxPending[TX_BURST_SIZE];
+} DPDK_QUEUE;
+
+typedef struct DPDK_INTERFACE {
+    CXPLAT_INTERFACE;
+    uint16_t Port;
+    uint16_t QueueCount;
+    DPDK_QUEUE* Queues; // An array of queues.
+    const DPDK_DATAPATH* Dpdk;
+    BOOLEAN Started;
 } DPDK_INTERFACE;
 
-typedef struct DPDK_DATAPATH {
+typedef struct QUIC_CACHEALIGN DPDK_PARTITION {
+    CXPLAT_EXECUTION_CONTEXT Ec;
+    CXPLAT_SQE ShutdownSqe;
+    const DPDK_DATAPATH* Dpdk;
+    CXPLAT_EVENTQ* EventQ;
+    DPDK_QUEUE* Queues; // A linked list of queues, accessed by Next.
+    uint16_t PartitionIndex;
+    uint16_t Processor;
+    BOOLEAN LcoreReferenced; // Holds a reference on its thread's lcore.
+} DPDK_PARTITION;
 
-    CXPLAT_DATAPATH;
+typedef struct DPDK_DATAPATH {
+    CXPLAT_DATAPATH_RAW;
 
-    BOOLEAN Running;
-    CXPLAT_THREAD DpdkThread;
-    QUIC_STATUS StartStatus;
-    CXPLAT_EVENT StartComplete;
+    uint32_t PartitionCount;
+    uint32_t MbufCount;
+    uint16_t RxDescriptors;
+    uint16_t TxDescriptors;
+    BOOLEAN NoHuge;
+    BOOLEAN Running; // Signal to stop partitions.
 
-    CXPLAT_POOL AdditionalInfoPool;
+    char DeviceName[64];
+    char Vdev[128];
 
+    CXPLAT_RUNDOWN_REF Rundown;
     DPDK_INTERFACE Interface; // TODO: support multiple NIC interfaces.
-
+    DPDK_PARTITION Partitions[0];
 } DPDK_DATAPATH;
 
+//
+// Lives in the private area of the mbuf it was received in.
+//
 typedef struct DPDK_RX_PACKET {
-    CXPLAT_RECV_DATA;
-    CXPLAT_ROUTE RouteStorage;
     struct rte_mbuf* Mbuf;
-    CXPLAT_POOL* OwnerPool;
+    CXPLAT_ROUTE RouteStorage;
+    CXPLAT_RECV_DATA RecvData;
+    // Followed by:
+    // uint8_t ClientContext[...];
 } DPDK_RX_PACKET;
 
+//
+// Lives in the private area of the mbuf it is sent from.
+//
 typedef struct DPDK_TX_PACKET {
     CXPLAT_SEND_DATA;
     struct rte_mbuf* Mbuf;
-    DPDK_DATAPATH* Dpdk;
-    DPDK_INTERFACE* Interface;
+    DPDK_QUEUE* Queue;
 } DPDK_TX_PACKET;
 
-CXPLAT_STATIC_ASSERT(
-    sizeof(DPDK_TX_PACKET) <= sizeof(DPDK_RX_PACKET),
-    "Code assumes memory allocated for RX is enough for TX");
-
-CXPLAT_THREAD_CALLBACK(CxPlatDpdkMainThread, Context);
-static int CxPlatDpdkWorkerThread(_In_ void* Context);
+CXPLAT_EVENT_COMPLETION CxPlatDpdkPartitionShutdownEventComplete;
 
+_IRQL_requires_max_(PASSIVE_LEVEL)
+BOOLEAN
+CxPlatDpdkExecute(
+    _Inout_ void* Context,
+    _Inout_ CXPLAT_EXECUTION_STATE* State
+    );
+
+//
+// The EAL can only be initialized once per process, so it stays up, along with
+// the mbuf pools created on it, until the process exits.
+//
+static BOOLEAN CxPlatDpdkEalInitialized;
+static QUIC_STATUS CxPlatDpdkEalStatus;
+
+//
+// Number of partitions running on the calling thread that use the lcore this
+// datapath registered it as. Several partitions may share a worker thread, so
+// the registration belongs to the thread and is only dropped with the last of
+// them.
+//
+static __thread uint32_t CxPlatDpdkLcoreRefCount;
+
+//
+// Reads dpdk.ini from the working directory. For example, to test against a
+// TAP interface instead of a NIC:
+//
+//  Vdev=net_tap0,iface=dtap0
+//  NoHuge=1
+//
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
 CxPlatDpdkReadConfig(
-    _Inout_ DPDK_DATAPATH* Dpdk,
-    _In_opt_ CXPLAT_DATAPATH_CONFIG* Config
+    _Inout_ DPDK_DATAPATH* Dpdk
     )
 {
-    Dpdk->Cpu = (uint16_t)(CxPlatProcCount() - 1);
-
     //
-    // Read user-specified global config.
+    // Default config.
     //
-    if (Config != NULL && Config->DataPathProcList != NULL) {
-        Dpdk->Cpu = Config->DataPathProcList[0];
-    }
+    Dpdk->MbufCount = DEFAULT_MBUF_COUNT;
+    Dpdk->RxDescriptors = DEFAULT_DESCRIPTORS;
+    Dpdk->TxDescriptors = DEFAULT_DESCRIPTORS;
+    Dpdk->NoHuge = FALSE;
 
     FILE *File = fopen("dpdk.ini", "r");
     if (File == NULL) {
@@ -116,405 +209,599 @@ CxPlatDpdkReadConfig(
         }
 
         if (strcmp(Line, "DeviceName") == 0) {
-             strcpy(Dpdk->Interface.DeviceName, Value);
+            strncpy(Dpdk->DeviceName, Value, sizeof(Dpdk->DeviceName) - 1);
+        } else if (strcmp(Line, "Vdev") == 0) {
+            strncpy(Dpdk->Vdev, Value, sizeof(Dpdk->Vdev) - 1);
+        } else if (strcmp(Line, "NoHuge") == 0) {
+            Dpdk->NoHuge = !!strtoul(Value, NULL, 10);
+        } else if (strcmp(Line, "MbufCount") == 0) {
+            Dpdk->MbufCount = strtoul(Value, NULL, 10);
+        } else if (strcmp(Line, "RxDescriptors") == 0) {
+            Dpdk->RxDescriptors = (uint16_t)strtoul(Value, NULL, 10);
+        } else if (strcmp(Line, "TxDescriptors") == 0) {
+            Dpdk->TxDescriptors = (uint16_t)strtoul(Value, NULL, 10);
         }
     }
 
     fclose(File);
+
+    if (Dpdk->MbufCount == 0) {
+        Dpdk->MbufCount = DEFAULT_MBUF_COUNT;
+    }
+    if (Dpdk->RxDescriptors == 0) {
+        Dpdk->RxDescriptors = DEFAULT_DESCRIPTORS;
+    }
+    if (Dpdk->TxDescriptors == 0) {
+        Dpdk->TxDescriptors = DEFAULT_DESCRIPTORS;
+    }
 }
 
-_IRQL_requires_max_(PASSIVE_LEVEL)
-size_t
-CxPlatDpRawGetDatapathSize(
-    _In_opt_ const QUIC_EXECUTION_CONFIG* Config
-    )
+//
+// Initializes the EAL on its own thread, because the EAL pins the thread that
+// initializes it to the main lcore.
+//
+CXPLAT_THREAD_CALLBACK(CxPlatDpdkEalThread, Context)
 {
-    UNREFERENCED_PARAMETER(Config);
-    return sizeof(DPDK_DATAPATH);
+    const DPDK_DATAPATH* Dpdk = (const DPDK_DATAPATH*)Context;
+
+    char MainCore[16];
+    snprintf(MainCore, sizeof(MainCore), "%hu", Dpdk->Partitions[0].Processor);
+
+    const char* Argv[16];
+    int Argc = 0;
+    Argv[Argc++] = "msquic";
+    Argv[Argc++] = "-l";
+    Argv[Argc++] = MainCore;
+    Argv[Argc++] = "--in-memory";
+    if (Dpdk->NoHuge) {
+        Argv[Argc++] = "--no-huge";
+    }
+    if (Dpdk->Vdev[0] != '\0') {
+        Argv[Argc++] = "--vdev";
+        Argv[Argc++] = Dpdk->Vdev;
+        if (Dpdk->DeviceName[0] == '\0') {
+            Argv[Argc++] = "--no-pci"; // Only the virtual device is used.
+        }
+    }
+
+    int Ret = rte_eal_init(Argc, (char**)Argv);
+    if (Ret < 0) {
+        QuicTraceEvent(
+            LibraryErrorStatus,
+            "[ lib] ERROR, %u, %s.",
+            rte_errno,
+            "rte_eal_init");
+        CxPlatDpdkEalStatus = QUIC_STATUS_INTERNAL_ERROR;
+    } else {
+        CxPlatDpdkEalStatus = QUIC_STATUS_SUCCESS;
+    }
+
+    CXPLAT_THREAD_RETURN(0);
 }
 
 _IRQL_requires_max_(PASSIVE_LEVEL)
 QUIC_STATUS
-CxPlatDpRawInitialize(
-    _Inout_ CXPLAT_DATAPATH* Datapath,
-    _In_ uint32_t ClientRecvContextLength,
-    _In_ CXPLAT_WORKER_POOL* WorkerPool,
-    _In_opt_ const QUIC_EXECUTION_CONFIG* Config
+CxPlatDpdkEalInitialize(
+    _In_ DPDK_DATAPATH* Dpdk
     )
 {
-    UNREFERENCED_PARAMETER(WorkerPool);
-    DPDK_DATAPATH* Dpdk = (DPDK_DATAPATH*)Datapath;
-    CXPLAT_THREAD_CONFIG Config = {
-        0, 0, "DpdkMain", CxPlatDpdkMainThread, Dpdk
-    };
-    const uint32_t AdditionalBufferSize =
-        sizeof(DPDK_RX_PACKET) + ClientRecvContextLength;
-
-    CxPlatDpdkReadConfig(Dpdk, Config);
-
-    BOOLEAN CleanUpThread = FALSE;
-    CxPlatEventInitialize(&Dpdk->StartComplete, TRUE, FALSE);
-    CxPlatPoolInitialize(FALSE, AdditionalBufferSize, QUIC_POOL_DATAPATH, &Dpdk->AdditionalInfoPool);
-    CxPlatLockInitialize(&Dpdk->Interface.TxLock);
-    CxPlatListInitializeHead(&Dpdk->Interfaces);
-    CxPlatListInsertTail(&Dpdk->Interfaces, &Dpdk->Interface.Link);
-
-    //
-    // This starts a new thread to do all the DPDK initialization because DPDK
-    // effectively takes that thread over. It waits for the initialization part
-    // to complete before returning. After that, the DPDK main thread starts
-    // running the DPDK main loop until clean up.
-    //
+    if (CxPlatDpdkEalInitialized) {
+        return CxPlatDpdkEalStatus;
+    }
 
-    QUIC_STATUS Status = CxPlatThreadCreate(&Config, &Dpdk->DpdkThread);
+    CXPLAT_THREAD_CONFIG ThreadConfig = {
+        0, 0, "DpdkEal", CxPlatDpdkEalThread, Dpdk
+    };
+    CXPLAT_THREAD Thread;
+    QUIC_STATUS Status = CxPlatThreadCreate(&ThreadConfig, &Thread);
     if (QUIC_FAILED(Status)) {
         QuicTraceEvent(
             LibraryErrorStatus,
             "[ lib] ERROR, %u, %s.",
             Status,
             "CxPlatThreadCreate");
-        goto Error;
+        return Status;
     }
-    CleanUpThread = TRUE;
-
-    CxPlatEventWaitForever(Dpdk->StartComplete);
-    Status = Dpdk->StartStatus;
-
-Error:
+    CxPlatThreadWait(&Thread);
+    CxPlatThreadDelete(&Thread);
 
-    if (QUIC_FAILED(Status)) {
-        if (CleanUpThread) {
-            CxPlatLockUninitialize(&Dpdk->Interface.TxLock);
-            CxPlatPoolUninitialize(&Dpdk->AdditionalInfoPool);
-            CxPlatThreadWait(&Dpdk->DpdkThread);
-            CxPlatThreadDelete(&Dpdk->DpdkThread);
-        }
-        CxPlatEventUninitialize(Dpdk->StartComplete);
-    }
-
-    return Status;
+    CxPlatDpdkEalInitialized = TRUE;
+    return CxPlatDpdkEalStatus;
 }
 
+//
+// Finds the port to use: the configured device, else the virtual device, else
+// the first port the EAL found.
+//
 _IRQL_requires_max_(PASSIVE_LEVEL)
-void
-CxPlatDpRawUninitialize(
-    _In_ CXPLAT_DATAPATH* Datapath
+QUIC_STATUS
+CxPlatDpdkFindPort(
+    _In_ const DPDK_DATAPATH* Dpdk,
+    _Out_ uint16_t* Port
     )
 {
-    DPDK_DATAPATH* Dpdk = (DPDK_DATAPATH*)Datapath;
-    Dpdk->Running = FALSE;
-    CxPlatLockUninitialize(&Dpdk->Interface.TxLock);
-    CxPlatPoolUninitialize(&Dpdk->AdditionalInfoPool);
-    CxPlatThreadWait(&Dpdk->DpdkThread);
-    CxPlatThreadDelete(&Dpdk->DpdkThread);
-    CxPlatEventUninitialize(Dpdk->StartComplete);
+    int Ret = -1;
+    if (Dpdk->DeviceName[0] != '\0') {
+        Ret = rte_eth_dev_get_port_by_name(Dpdk->DeviceName, Port);
+    } else if (Dpdk->Vdev[0] != '\0') {
+        char VdevName[sizeof(Dpdk->Vdev)];
+        strcpy(VdevName, Dpdk->Vdev);
+        char* Args = strchr(VdevName, ',');
+        if (Args != NULL) {
+            *Args = '\0';
+        }
+        Ret = rte_eth_dev_get_port_by_name(VdevName, Port);
+    } else {
+        uint16_t PortId;
+        RTE_ETH_FOREACH_DEV(PortId) {
+            *Port = PortId;
+            Ret = 0;
+            break;
+        }
+    }
+
+    if (Ret < 0) {
+        QuicTraceEvent(
+            LibraryError,
+            "[ lib] ERROR, %s.",
+            "no DPDK port");
+        return QUIC_STATUS_NOT_FOUND;
+    }
+    return QUIC_STATUS_SUCCESS;
 }
 
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
-CxPlatDpRawUpdateConfig(
-    _In_ CXPLAT_DATAPATH* Datapath,
-    _In_ QUIC_EXECUTION_CONFIG* Config
+CxPlatDpdkInterfaceUninitialize(
+    _Inout_ DPDK_INTERFACE* Interface
     )
 {
-    UNREFERENCED_PARAMETER(Datapath);
-    UNREFERENCED_PARAMETER(Config);
+    if (Interface->Started) {
+        rte_eth_dev_stop(Interface->Port);
+        Interface->Started = FALSE;
+    }
+
+    for (uint16_t i = 0; Interface->Queues != NULL && i < Interface->QueueCount; i++) {
+        DPDK_QUEUE* Queue = &Interface->Queues[i];
+        for (uint16_t j = 0; j < Queue->TxPendingCount; j++) {
+            rte_pktmbuf_free(Queue->TxPending[j]);
+        }
+        Queue->TxPendingCount = 0;
+        if (Queue->TxRing != NULL) {
+            struct rte_mbuf* Mbuf;
+            while (rte_ring_sc_dequeue(Queue->TxRing, (void**)&Mbuf) == 0) {
+                rte_pktmbuf_free(Mbuf);
+            }
+            rte_ring_free(Queue->TxRing);
+        }
+        //
+        // The mbuf pool is left for the next datapath on the port to reuse,
+        // since the stopped device may still hold mbufs from it.
+        //
+    }
+
+    if (Interface->Queues != NULL) {
+        CXPLAT_FREE(Interface->Queues, QUIC_POOL_DATAPATH);
+        Interface->Queues = NULL;
+    }
 }
 
 _IRQL_requires_max_(PASSIVE_LEVEL)
 QUIC_STATUS
-CxPlatSocketUpdateQeo(
-    _In_ CXPLAT_SOCKET* Socket,
-    _In_reads_(OffloadCount)
-        const CXPLAT_QEO_CONNECTION* Offloads,
-    _In_ uint32_t OffloadCount
+CxPlatDpdkInterfaceInitialize(
+    _In_ DPDK_DATAPATH* Dpdk,
+    _Inout_ DPDK_INTERFACE* Interface,
+    _In_ uint32_t ClientRecvContextLength
     )
 {
-    UNREFERENCED_PARAMETER(Socket);
-    UNREFERENCED_PARAMETER(Offloads);
-    UNREFERENCED_PARAMETER(OffloadCount);
-    return QUIC_STATUS_NOT_SUPPORTED;
-}
-
-CXPLAT_THREAD_CALLBACK(CxPlatDpdkMainThread, Context)
-{
-    DPDK_DATAPATH* Dpdk = (DPDK_DATAPATH*)Context;
-
-    char DpdpCpuStr[16];
-    sprintf(DpdpCpuStr, "%hu", Dpdk->Cpu);
-
-    const char* argv[] = {
-        "msquic",
-        "-n", "4",
-        "-l", DpdpCpuStr,
-        "-d", "rte_mempool_ring-21.dll",
-        "-d", "rte_bus_pci-21.dll",
-        "-d", "rte_common_mlx5-21.dll",
-        "-d", "rte_net_mlx5-21.dll"
-    };
-
-    QUIC_STATUS Status = QUIC_STATUS_SUCCESS;
-    BOOLEAN CleanUpRte = FALSE;
-    uint16_t Port;
-    struct rte_eth_conf PortConfig = {
-        .rxmode = {
-            .max_rx_pkt_len = RTE_ETHER_MAX_LEN,
-        },
-    };
-    uint16_t nb_rxd = 1024;
-    uint16_t nb_txd = 1024;
-    const uint16_t rx_rings = 1, tx_rings = 1;
+    QUIC_STATUS Status;
     struct rte_eth_dev_info DeviceInfo;
-    struct rte_eth_rxconf rxconf;
-    struct rte_eth_txconf txconf;
-    struct rte_ether_addr addr;
-
-    int ret = rte_eal_init(ARRAYSIZE(argv), (char**)argv);
-    if (ret < 0) {
-        QuicTraceEvent(
-            LibraryErrorStatus,
-            "[ lib] ERROR, %u, %s.",
-            ret,
-            "rte_eal_init");
-        Status = QUIC_STATUS_INTERNAL_ERROR;
+    struct rte_eth_conf PortConfig;
+    struct rte_ether_addr MacAddress;
+    uint16_t RxDescriptors = Dpdk->RxDescriptors;
+    uint16_t TxDescriptors = Dpdk->TxDescriptors;
+    const uint32_t RxPacketSize = sizeof(DPDK_RX_PACKET) + ClientRecvContextLength;
+    const uint16_t PrivateSize =
+        (uint16_t)ALIGN_UP(
+            CXPLAT_MAX(RxPacketSize, (uint32_t)sizeof(DPDK_TX_PACKET)),
+            RTE_MBUF_PRIV_ALIGN);
+    int Ret;
+
+    Interface->Dpdk = Dpdk;
+
+    Status = CxPlatDpdkFindPort(Dpdk, &Interface->Port);
+    if (QUIC_FAILED(Status)) {
         goto Error;
     }
-    CleanUpRte = TRUE;
 
-    if (Dpdk->Interface.DeviceName[0] != '\0') {
-        ret = rte_eth_dev_get_port_by_name(Dpdk->Interface.DeviceName, &Port);
-    } else {
-        ret = rte_eth_dev_get_port_by_name("0000:81:00.0", &Port);
-        if (ret < 0) {
-            ret = rte_eth_dev_get_port_by_name("0000:81:00.1", &Port);
-        }
-    }
-
-    if (ret < 0) {
+    Ret = rte_eth_dev_info_get(Interface->Port, &DeviceInfo);
+    if (Ret < 0) {
         QuicTraceEvent(
             LibraryErrorStatus,
             "[ lib] ERROR, %u, %s.",
-            ret,
-            "rte_eth_dev_get_port_by_name");
+            Ret,
+            "rte_eth_dev_info_get");
         Status = QUIC_STATUS_INTERNAL_ERROR;
         goto Error;
     }
 
-    Dpdk->Interface.Port = Port;
-    Dpdk->Interface.MemoryPool =
-        rte_pktmbuf_pool_create(
-            "MBUF_POOL", NUM_MBUFS, MBUF_CACHE_SIZE, 0,
-            RTE_MBUF_DEFAULT_BUF_SIZE, rte_eth_dev_socket_id(Port));
-    if (Dpdk->Interface.MemoryPool == NULL) {
+    Ret = rte_eth_macaddr_get(Interface->Port, &MacAddress);
+    if (Ret < 0) {
         QuicTraceEvent(
             LibraryErrorStatus,
             "[ lib] ERROR, %u, %s.",
-            0,
-            "rte_pktmbuf_pool_create");
+            Ret,
+            "rte_eth_macaddr_get");
         Status = QUIC_STATUS_INTERNAL_ERROR;
         goto Error;
     }
+    CXPLAT_STATIC_ASSERT(
+        sizeof(Interface->PhysicalAddress) == sizeof(MacAddress.addr_bytes),
+        "Ethernet address sizes must match");
+    CxPlatCopyMemory(
+        Interface->PhysicalAddress, MacAddress.addr_bytes, sizeof(Interface->PhysicalAddress));
+    Interface->IfIndex = DeviceInfo.if_index;
+    Interface->ActualIfIndex = DeviceInfo.if_index;
 
-    Dpdk->Interface.TxRingBuffer =
-        rte_ring_create(
-            "TxRing", TX_RING_SIZE, rte_eth_dev_socket_id(Port),
-            RING_F_MP_HTS_ENQ | RING_F_SC_DEQ);
-    if (Dpdk->Interface.TxRingBuffer == NULL) {
+    //
+    // One queue pair per partition, as far as the device goes.
+    //
+    Interface->QueueCount =
+        (uint16_t)CXPLAT_MIN(
+            Dpdk->PartitionCount,
+            CXPLAT_MIN(DeviceInfo.max_rx_queues, DeviceInfo.max_tx_queues));
+    if (Interface->QueueCount == 0) {
         QuicTraceEvent(
-            LibraryErrorStatus,
-            "[ lib] ERROR, %u, %s.",
-            ret,
-            "rte_ring_create");
-        Status = QUIC_STATUS_INTERNAL_ERROR;
+            LibraryError,
+            "[ lib] ERROR, %s.",
+            "DPDK port has no queues");
+        Status = QUIC_STATUS_NOT_SUPPORTED;
         goto Error;
     }
 
-    ret = rte_eth_dev_info_get(Port, &DeviceInfo);
-    if (ret < 0) {
-        QuicTraceEvent(
-            LibraryErrorStatus,
-            "[ lib] ERROR, %u, %s.",
-            ret,
-            "rte_eth_dev_info_get");
-        Status = QUIC_STATUS_INTERNAL_ERROR;
-        goto Error;
+    CxPlatZeroMemory(&PortConfig, sizeof(PortConfig));
+    if (Interface->QueueCount > 1) {
+        PortConfig.rxmode.mq_mode = RTE_ETH_MQ_RX_RSS;
+        PortConfig.rx_adv_conf.rss_conf.rss_hf =
+            (RTE_ETH_RSS_IP | RTE_ETH_RSS_UDP) & DeviceInfo.flow_type_rss_offloads;
+        if (PortConfig.rx_adv_conf.rss_conf.rss_hf == 0) {
+            //
+            // Without RSS, only the first queue would ever receive anything.
+            //
+            PortConfig.rxmode.mq_mode = RTE_ETH_MQ_RX_NONE;
+        }
     }
 
-    Dpdk->Interface.IfIndex = DeviceInfo.if_index;
-
-    if (DeviceInfo.tx_offload_capa & DEV_TX_OFFLOAD_IPV4_CKSUM) {
-        printf("TX IPv4 Checksum Offload Enabled\n");
-        PortConfig.txmode.offloads |= DEV_TX_OFFLOAD_IPV4_CKSUM;
-        Dpdk->Interface.OffloadStatus.Transmit.NetworkLayerXsum = TRUE;
+    //
+    // Use whatever checksum offloads the device has, and skip the software
+    // checksums for them.
+    //
+    if (DeviceInfo.tx_offload_capa & RTE_ETH_TX_OFFLOAD_IPV4_CKSUM) {
+        PortConfig.txmode.offloads |= RTE_ETH_TX_OFFLOAD_IPV4_CKSUM;
+        Interface->OffloadStatus.Transmit.NetworkLayerXsum = TRUE;
     }
-    if (DeviceInfo.tx_offload_capa & DEV_TX_OFFLOAD_UDP_CKSUM) {
-        printf("TX UDP Checksum Offload Enabled\n");
-        PortConfig.txmode.offloads |= DEV_TX_OFFLOAD_UDP_CKSUM;
-        Dpdk->Interface.OffloadStatus.Transmit.TransportLayerXsum = TRUE;
+    if ((DeviceInfo.tx_offload_capa & RTE_ETH_TX_OFFLOAD_UDP_CKSUM) &&
+        (DeviceInfo.tx_offload_capa & RTE_ETH_TX_OFFLOAD_TCP_CKSUM)) {
+        PortConfig.txmode.offloads |=
+            RTE_ETH_TX_OFFLOAD_UDP_CKSUM | RTE_ETH_TX_OFFLOAD_TCP_CKSUM;
+        Interface->OffloadStatus.Transmit.TransportLayerXsum = TRUE;
     }
-    if (DeviceInfo.rx_offload_capa & DEV_RX_OFFLOAD_IPV4_CKSUM) {
-        printf("RX IPv4 Checksum Offload Enabled\n");
-        PortConfig.rxmode.offloads |= DEV_RX_OFFLOAD_IPV4_CKSUM;
-        Dpdk->Interface.OffloadStatus.Receive.NetworkLayerXsum = TRUE;
+    if (DeviceInfo.rx_offload_capa & RTE_ETH_RX_OFFLOAD_IPV4_CKSUM) {
+        PortConfig.rxmode.offloads |= RTE_ETH_RX_OFFLOAD_IPV4_CKSUM;
+        Interface->OffloadStatus.Receive.NetworkLayerXsum = TRUE;
     }
-    if (DeviceInfo.rx_offload_capa & DEV_RX_OFFLOAD_UDP_CKSUM) {
-        printf("RX UDP Checksum Offload Enabled\n");
-        PortConfig.rxmode.offloads |= DEV_RX_OFFLOAD_UDP_CKSUM;
-        Dpdk->Interface.OffloadStatus.Receive.TransportLayerXsum = TRUE;
+    if (DeviceInfo.rx_offload_capa & RTE_ETH_RX_OFFLOAD_UDP_CKSUM) {
+        PortConfig.rxmode.offloads |= RTE_ETH_RX_OFFLOAD_UDP_CKSUM;
+        Interface->OffloadStatus.Receive.TransportLayerXsum = TRUE;
     }
 
-    ret = rte_eth_dev_configure(Port, rx_rings, tx_rings, &PortConfig);
-    if (ret < 0) {
+    Ret = rte_eth_dev_configure(
+        Interface->Port, Interface->QueueCount, Interface->QueueCount, &PortConfig);
+    if (Ret < 0) {
         QuicTraceEvent(
             LibraryErrorStatus,
             "[ lib] ERROR, %u, %s.",
-            ret,
+            Ret,
             "rte_eth_dev_configure");
         Status = QUIC_STATUS_INTERNAL_ERROR;
         goto Error;
     }
 
-    ret = rte_eth_dev_adjust_nb_rx_tx_desc(Port, &nb_rxd, &nb_txd);
-    if (ret < 0) {
+    Ret = rte_eth_dev_adjust_nb_rx_tx_desc(Interface->Port, &RxDescriptors, &TxDescriptors);
+    if (Ret < 0) {
         QuicTraceEvent(
             LibraryErrorStatus,
             "[ lib] ERROR, %u, %s.",
-            ret,
-            "rte_eth_dev_configure");
+            Ret,
+            "rte_eth_dev_adjust_nb_rx_tx_desc");
         Status = QUIC_STATUS_INTERNAL_ERROR;
         goto Error;
     }
 
-    rxconf = DeviceInfo.default_rxconf;
-    for (uint16_t q = 0; q < rx_rings; q++) {
-        ret = rte_eth_rx_queue_setup(Port, q, nb_rxd, rte_eth_dev_socket_id(Port), &rxconf, Dpdk->Interface.MemoryPool);
-        if (ret < 0) {
+    Interface->Queues =
+        CXPLAT_ALLOC_NONPAGED(Interface->QueueCount * sizeof(*Interface->Queues), QUIC_POOL_DATAPATH);
+    if (Interface->Queues == NULL) {
+        QuicTraceEvent(
+            LibraryErrorStatus,
+            "[ lib] ERROR, %u, %s.",
+            Interface->QueueCount,
+            "DPDK queue allocation");
+        Status = QUIC_STATUS_OUT_OF_MEMORY;
+        goto Error;
+    }
+    CxPlatZeroMemory(Interface->Queues, Interface->QueueCount * sizeof(*Interface->Queues));
+
+    const int SocketId = rte_eth_dev_socket_id(Interface->Port);
+    struct rte_eth_rxconf RxConfig = DeviceInfo.default_rxconf;
+    RxConfig.offloads = PortConfig.rxmode.offloads;
+    struct rte_eth_txconf TxConfig = DeviceInfo.default_txconf;
+    TxConfig.offloads = PortConfig.txmode.offloads;
+
+    for (uint16_t i = 0; i < Interface->QueueCount; i++) {
+        DPDK_QUEUE* Queue = &Interface->Queues[i];
+        Queue->Interface = Interface;
+        Queue->Id = i;
+
+        char Name[RTE_MEMPOOL_NAMESIZE];
+        snprintf(Name, sizeof(Name), "msquic_mp_%hu_%hu", Interface->Port, i);
+        Queue->MemoryPool = rte_mempool_lookup(Name);
+        if (Queue->MemoryPool == NULL) {
+            Queue->MemoryPool =
+                rte_pktmbuf_pool_create(
+                    Name, Dpdk->MbufCount, MBUF_CACHE_SIZE, PrivateSize,
+                    RTE_MBUF_DEFAULT_BUF_SIZE, SocketId);
+        } else if (rte_pktmbuf_priv_size(Queue->MemoryPool) < PrivateSize) {
+            Queue->MemoryPool = NULL; // Left over from a datapath with smaller contexts.
+        }
+        if (Queue->MemoryPool == NULL) {
             QuicTraceEvent(
                 LibraryErrorStatus,
                 "[ lib] ERROR, %u, %s.",
-                ret,
+                rte_errno,
+                "rte_pktmbuf_pool_create");
+            Status = QUIC_STATUS_OUT_OF_MEMORY;
+            goto Error;
+        }
+
+        snprintf(Name, sizeof(Name), "msquic_tx_%hu_%hu", Interface->Port, i);
+        Queue->TxRing = rte_ring_create(Name, TX_RING_SIZE, SocketId, RING_F_SC_DEQ);
+        if (Queue->TxRing == NULL) {
+            QuicTraceEvent(
+                LibraryErrorStatus,
+                "[ lib] ERROR, %u, %s.",
+                rte_errno,
+                "rte_ring_create");
+            Status = QUIC_STATUS_OUT_OF_MEMORY;
+            goto Error;
+        }
+
+        Ret = rte_eth_rx_queue_setup(
+            Interface->Port, i, RxDescriptors, SocketId, &RxConfig, Queue->MemoryPool);
+        if (Ret < 0) {
+            QuicTraceEvent(
+                LibraryErrorStatus,
+                "[ lib] ERROR, %u, %s.",
+                Ret,
                 "rte_eth_rx_queue_setup");
             Status = QUIC_STATUS_INTERNAL_ERROR;
             goto Error;
         }
-    }
 
-    txconf = DeviceInfo.default_txconf;
-    txconf.offloads = PortConfig.txmode.offloads;
-    for (uint16_t q = 0; q < tx_rings; q++) {
-        ret = rte_eth_tx_queue_setup(Port, q, nb_txd, rte_eth_dev_socket_id(Port), &txconf);
-        if (ret < 0) {
+        Ret = rte_eth_tx_queue_setup(Interface->Port, i, TxDescriptors, SocketId, &TxConfig);
+        if (Ret < 0) {
             QuicTraceEvent(
                 LibraryErrorStatus,
                 "[ lib] ERROR, %u, %s.",
-                ret,
+                Ret,
                 "rte_eth_tx_queue_setup");
             Status = QUIC_STATUS_INTERNAL_ERROR;
             goto Error;
         }
     }
 
-    ret = rte_eth_dev_start(Port);
-    if (ret < 0) {
+    Ret = rte_eth_dev_start(Interface->Port);
+    if (Ret < 0) {
         QuicTraceEvent(
             LibraryErrorStatus,
             "[ lib] ERROR, %u, %s.",
-            ret,
+            Ret,
             "rte_eth_dev_start");
         Status = QUIC_STATUS_INTERNAL_ERROR;
         goto Error;
     }
+    Interface->Started = TRUE;
 
-    ret = rte_eth_macaddr_get(Port, &addr);
-    if (ret < 0) {
+    if (SocketId >= 0 && SocketId != (int)CxPlatProcNumaNode(Dpdk->Partitions[0].Processor)) {
         QuicTraceEvent(
-            LibraryErrorStatus,
-            "[ lib] ERROR, %u, %s.",
-            ret,
-            "rte_eth_macaddr_get");
-        Status = QUIC_STATUS_INTERNAL_ERROR;
-        goto Error;
+            LibraryError,
+            "[ lib] ERROR, %s.",
+            "DPDK port is on a remote NUMA node to the partitions");
     }
 
-    //
-    // Retrieve ifindex of the interface to which DPDK is binding.
-    //
-    MIB_IF_TABLE2* IfTable;
-    Status = GetIfTable2(&IfTable);
+    for (uint16_t i = 0; i < Interface->QueueCount; i++) {
+        DPDK_PARTITION* Partition = &Dpdk->Partitions[i % Dpdk->PartitionCount];
+        DPDK_QUEUE** Tail = &Partition->Queues;
+        while (*Tail != NULL) {
+            Tail = &(*Tail)->Next;
+        }
+        *Tail = &Interface->Queues[i];
+        Interface->Queues[i].Partition = Partition;
+    }
+
+Error:
+
     if (QUIC_FAILED(Status)) {
-        QuicTraceEvent(
-            LibraryErrorStatus,
-            "[ lib] ERROR, %u, %s.",
-            Status,
-            "GetIfTable2");
-        goto Error;
+        CxPlatDpdkInterfaceUninitialize(Interface);
     }
 
-    for (uint32_t i = 0; i < IfTable->NumEntries; i++) {
-        MIB_IF_ROW2* IfRow = (MIB_IF_ROW2*)&IfTable->Table[i];
-        if (!IfRow->InterfaceAndOperStatusFlags.FilterInterface &&
-            !IfRow->InterfaceAndOperStatusFlags.NotMediaConnected &&
-            !IfRow->InterfaceAndOperStatusFlags.Paused &&
-            IfRow->OperStatus == IfOperStatusUp &&
-            IfRow->MediaType == NdisMedium802_3 &&
-            IfRow->PhysicalAddressLength == 6 &&
-            memcmp(IfRow->PhysicalAddress, addr.addr_bytes, IfRow->PhysicalAddressLength) == 0) {
-            Dpdk->Interface.IfIndex = IfRow->InterfaceIndex;
-            break;
+    return Status;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+size_t
+CxPlatDpRawGetDatapathSize(
+    _In_opt_ const QUIC_EXECUTION_CONFIG* Config
+    )
+{
+    const uint32_t PartitionCount =
+        (Config && Config->ProcessorCount) ? Config->ProcessorCount : CxPlatProcCount();
+    return sizeof(DPDK_DATAPATH) + (PartitionCount * sizeof(DPDK_PARTITION));
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+CxPlatDpRawInitialize(
+    _Inout_ CXPLAT_DATAPATH_RAW* Datapath,
+    _In_ uint32_t ClientRecvContextLength,
+    _In_ CXPLAT_WORKER_POOL* WorkerPool,
+    _In_opt_ const QUIC_EXECUTION_CONFIG* Config
+    )
+{
+    DPDK_DATAPATH* Dpdk = (DPDK_DATAPATH*)Datapath;
+    QUIC_STATUS Status;
+
+    if (WorkerPool == NULL) {
+        return QUIC_STATUS_INVALID_PARAMETER;
+    }
+
+    CxPlatDpdkReadConfig(Dpdk);
+    CxPlatListInitializeHead(&Dpdk->Interfaces);
+
+    if (Config && Config->ProcessorCount) {
+        Dpdk->PartitionCount = Config->ProcessorCount;
+        for (uint32_t i = 0; i < Dpdk->PartitionCount; i++) {
+            Dpdk->Partitions[i].Processor = Config->ProcessorList[i];
+        }
+    } else {
+        Dpdk->PartitionCount = CxPlatProcCount();
+        for (uint32_t i = 0; i < Dpdk->PartitionCount; i++) {
+            Dpdk->Partitions[i].Processor = (uint16_t)i;
         }
     }
 
-    printf(
-        "\nStarting Port %hu on Interface %u, %02hhx:%02hhx:%02hhx:%02hhx:%02hhx:%02hhx\n",
-        Dpdk->Interface.Port, Dpdk->Interface.IfIndex,
-        addr.addr_bytes[0], addr.addr_bytes[1], addr.addr_bytes[2],
-        addr.addr_bytes[3], addr.addr_bytes[4], addr.addr_bytes[5]);
+    Status = CxPlatDpdkEalInitialize(Dpdk);
+    if (QUIC_FAILED(Status)) {
+        return Status;
+    }
 
-    Dpdk->Running = TRUE;
-    ret = rte_eal_mp_remote_launch(CxPlatDpdkWorkerThread, Dpdk, SKIP_MAIN);
-    if (ret < 0) {
-        QuicTraceEvent(
-            LibraryErrorStatus,
-            "[ lib] ERROR, %u, %s.",
-            ret,
-            "rte_eal_mp_remote_launch");
-        Status = QUIC_STATUS_INTERNAL_ERROR;
-        goto Error;
+    Status = CxPlatDpdkInterfaceInitialize(Dpdk, &Dpdk->Interface, ClientRecvContextLength);
+    if (QUIC_FAILED(Status)) {
+        return Status;
     }
+    CxPlatListInsertTail(&Dpdk->Interfaces, &Dpdk->Interface.Link);
 
-    Dpdk->StartStatus = Status;
-    CxPlatEventSet(Dpdk->StartComplete);
+    //
+    // Partitions past the number of queues have nothing to poll.
+    //
+    if (Dpdk->PartitionCount > Dpdk->Interface.QueueCount) {
+        Dpdk->PartitionCount = Dpdk->Interface.QueueCount;
+    }
 
-    CxPlatDpdkWorkerThread(Dpdk);
+    uint32_t PartitionsStarted = 0;
+    Dpdk->Running = TRUE;
+    CxPlatRundownInitialize(&Dpdk->Rundown);
+    for (uint32_t i = 0; i < Dpdk->PartitionCount; i++) {
+        DPDK_PARTITION* Partition = &Dpdk->Partitions[i];
+        Partition->Dpdk = Dpdk;
+        Partition->PartitionIndex = (uint16_t)i;
+        Partition->Ec.Ready = TRUE;
+        Partition->Ec.NextTimeUs = UINT64_MAX;
+        Partition->Ec.Callback = CxPlatDpdkExecute;
+        Partition->Ec.Context = Partition;
+        Partition->EventQ = CxPlatWorkerPoolGetEventQ(WorkerPool, (uint16_t)i);
+
+        if (!CxPlatSqeInitialize(
+                Partition->EventQ,
+                CxPlatDpdkPartitionShutdownEventComplete,
+                &Partition->ShutdownSqe)) {
+            Status = QUIC_STATUS_INTERNAL_ERROR;
+            goto Error;
+        }
 
-    rte_eal_mp_wait_lcore(); // Wait on the other cores/threads
+        CxPlatRundownAcquire(&Dpdk->Rundown);
+        CxPlatWorkerPoolAddExecutionContext(
+            WorkerPool, &Partition->Ec, Partition->PartitionIndex);
+        PartitionsStarted++;
+    }
 
 Error:
 
     if (QUIC_FAILED(Status)) {
-        Dpdk->StartStatus = Status;
-        CxPlatEventSet(Dpdk->StartComplete);
+        //
+        // Stop any partitions that were already started before tearing down
+        // the interface under them.
+        //
+        Dpdk->Running = FALSE;
+        for (uint32_t i = 0; i < PartitionsStarted; i++) {
+            Dpdk->Partitions[i].Ec.Ready = TRUE;
+            CxPlatWakeExecutionContext(&Dpdk->Partitions[i].Ec);
+        }
+        CxPlatRundownReleaseAndWait(&Dpdk->Rundown);
+        CxPlatRundownUninitialize(&Dpdk->Rundown);
+        CxPlatListEntryRemove(&Dpdk->Interface.Link);
+        CxPlatDpdkInterfaceUninitialize(&Dpdk->Interface);
     }
 
-    if (Dpdk->Interface.TxRingBuffer) {
-        rte_ring_free(Dpdk->Interface.TxRingBuffer);
-    }
+    return Status;
+}
 
-    if (Dpdk->Interface.MemoryPool) {
-        rte_mempool_free(Dpdk->Interface.MemoryPool);
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+CxPlatDpRawUninitialize(
+    _In_ CXPLAT_DATAPATH_RAW* Datapath
+    )
+{
+    DPDK_DATAPATH* Dpdk = (DPDK_DATAPATH*)Datapath;
+    Dpdk->Running = FALSE;
+    for (uint32_t i = 0; i < Dpdk->PartitionCount; i++) {
+        Dpdk->Partitions[i].Ec.Ready = TRUE;
+        CxPlatWakeExecutionContext(&Dpdk->Partitions[i].Ec);
     }
 
-    if (CleanUpRte) {
-        rte_eal_cleanup();
+    //
+    // Nothing polls the queues once the partitions are done, so the interface
+    // can be torn down from here.
+    //
+    CxPlatRundownReleaseAndWait(&Dpdk->Rundown);
+    CxPlatRundownUninitialize(&Dpdk->Rundown);
+    while (!CxPlatListIsEmpty(&Dpdk->Interfaces)) {
+        DPDK_INTERFACE* Interface =
+            CXPLAT_CONTAINING_RECORD(CxPlatListRemoveHead(&Dpdk->Interfaces), DPDK_INTERFACE, Link);
+        CxPlatDpdkInterfaceUninitialize(Interface);
     }
+    CxPlatDataPathUninitializeComplete(Datapath);
+}
 
-    CXPLAT_THREAD_RETURN(0);
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+CxPlatDpRawUpdateConfig(
+    _In_ CXPLAT_DATAPATH_RAW* Datapath,
+    _In_ QUIC_EXECUTION_CONFIG* Config
+    )
+{
+    UNREFERENCED_PARAMETER(Datapath);
+    UNREFERENCED_PARAMETER(Config);
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+RawSocketUpdateQeo(
+    _In_ CXPLAT_SOCKET_RAW* Socket,
+    _In_reads_(OffloadCount)
+        const CXPLAT_QEO_CONNECTION* Offloads,
+    _In_ uint32_t OffloadCount
+    )
+{
+    UNREFERENCED_PARAMETER(Socket);
+    UNREFERENCED_PARAMETER(Offloads);
+    UNREFERENCED_PARAMETER(OffloadCount);
+    return QUIC_STATUS_NOT_SUPPORTED;
 }
 
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
 CxPlatDpRawPlumbRulesOnSocket(
-    _In_ CXPLAT_SOCKET* Socket,
+    _In_ CXPLAT_SOCKET_RAW* Socket,
     _In_ BOOLEAN IsCreated
     )
 {
@@ -526,11 +813,23 @@ CxPlatDpRawPlumbRulesOnSocket(
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
 CxPlatDpRawAssignQueue(
-    _In_ const CXPLAT_INTERFACE* Interface,
+    _In_ const CXPLAT_INTERFACE* _Interface,
     _Inout_ CXPLAT_ROUTE* Route
     )
 {
-    Route->Queue = Interface;
+    //
+    // Send from the queue polled on the current processor, if there is one,
+    // so the sends don't have to cross over to another partition.
+    //
+    const DPDK_INTERFACE* Interface = (const DPDK_INTERFACE*)_Interface;
+    const uint16_t Processor = (uint16_t)CxPlatProcCurrentNumber();
+    Route->Queue = &Interface->Queues[0];
+    for (uint16_t i = 0; i < Interface->QueueCount; i++) {
+        if (Interface->Queues[i].Partition->Processor == Processor) {
+            Route->Queue = &Interface->Queues[i];
+            break;
+        }
+    }
 }
 
 _IRQL_requires_max_(DISPATCH_LEVEL)
@@ -539,72 +838,78 @@ CxPlatDpRawGetInterfaceFromQueue(
     _In_ const void* Queue
     )
 {
-    return (const CXPLAT_INTERFACE*)Queue;
+    return (const CXPLAT_INTERFACE*)((const DPDK_QUEUE*)Queue)->Interface;
 }
 
 static
-void
+BOOLEAN // Did work?
 CxPlatDpdkRx(
-    _In_ DPDK_DATAPATH* Dpdk,
-    _In_ const uint16_t Core,
-    _In_ DPDK_INTERFACE* Interface
+    _In_ const DPDK_DATAPATH* Dpdk,
+    _In_ DPDK_QUEUE* Queue,
+    _In_ uint16_t PartitionIndex
     )
 {
-    void* Buffers[RX_BURST_SIZE];
-    const uint16_t BuffersCount =
-        rte_eth_rx_burst(Interface->Port, 0, (struct rte_mbuf**)Buffers, RX_BURST_SIZE);
-    if (unlikely(BuffersCount == 0)) {
-        return;
+    struct rte_mbuf* Mbufs[RX_BURST_SIZE];
+    const uint16_t MbufCount =
+        rte_eth_rx_burst(Queue->Interface->Port, Queue->Id, Mbufs, RX_BURST_SIZE);
+    if (unlikely(MbufCount == 0)) {
+        return FALSE;
     }
 
-    DPDK_RX_PACKET Packet; // Working space
-    CxPlatZeroMemory(&Packet, sizeof(DPDK_RX_PACKET));
-    Packet.Route = &Packet.RouteStorage;
-    Packet.Route->Queue = Interface;
-
+    CXPLAT_RECV_DATA* Packets[RX_BURST_SIZE];
     uint16_t PacketCount = 0;
-    for (uint16_t i = 0; i < BuffersCount; i++) {
-        struct rte_mbuf* Buffer = (struct rte_mbuf*)Buffers[i];
-        Packet.Buffer = NULL;
-        if ((Buffer->ol_flags & (PKT_RX_IP_CKSUM_BAD | PKT_RX_L4_CKSUM_BAD)) == 0) {
-            CxPlatDpRawParseEthernet(
-                (CXPLAT_DATAPATH*)Dpdk,
-                (CXPLAT_RECV_DATA*)&Packet,
-                ((uint8_t*)Buffer->buf_addr) + Buffer->data_off,
-                Buffer->pkt_len);
-            //
-            // The route has been filled in with the packet's src/dst IP and ETH addresses, so
-            // mark it resolved. This allows stateless sends to be issued without performing
-            // a route lookup.
-            //
-            Packet.Route->State = RouteResolved;
-        } else {
+    for (uint16_t i = 0; i < MbufCount; i++) {
+        struct rte_mbuf* Mbuf = Mbufs[i];
+        if (unlikely(Mbuf->ol_flags & (RTE_MBUF_F_RX_IP_CKSUM_BAD | RTE_MBUF_F_RX_L4_CKSUM_BAD))) {
             QuicTraceEvent(
                 LibraryErrorStatus,
                 "[ lib] ERROR, %u, %s.",
-                Buffer->ol_flags,
+                (uint32_t)Mbuf->ol_flags,
                 "L3/L4 checksum incorrect");
-            CXPLAT_DBG_ASSERT(
-                Interface->OffloadStatus.Receive.NetworkLayerXsum != 0 ||
-                Interface->OffloadStatus.Receive.TransportLayerXsum != 0);
+            rte_pktmbuf_free(Mbuf);
+            continue;
+        }
+        if (unlikely(Mbuf->nb_segs != 1)) {
+            rte_pktmbuf_free(Mbuf); // Too large to be for the stack.
+            continue;
         }
 
-        DPDK_RX_PACKET* NewPacket;
-        if (likely(Packet.Buffer && (NewPacket = CxPlatPoolAlloc(&Dpdk->AdditionalInfoPool)) != NULL)) {
-            CxPlatCopyMemory(NewPacket, &Packet, sizeof(DPDK_RX_PACKET));
-            NewPacket->Allocated = TRUE;
-            NewPacket->Mbuf = Buffer;
-            NewPacket->OwnerPool = &Dpdk->AdditionalInfoPool;
-            NewPacket->Route = &NewPacket->RouteStorage;
-            Buffers[PacketCount++] = NewPacket;
+        //
+        // The packet is built in the mbuf's private area and points straight
+        // at the frame, so nothing is copied.
+        //
+        DPDK_RX_PACKET* Packet = (DPDK_RX_PACKET*)rte_mbuf_to_priv(Mbuf);
+        CxPlatZeroMemory(Packet, rte_pktmbuf_priv_size(Queue->MemoryPool));
+        Packet->Mbuf = Mbuf;
+        Packet->RouteStorage.Queue = Queue;
+        Packet->RecvData.Route = &Packet->RouteStorage;
+        Packet->RecvData.Route->DatapathType = Packet->RecvData.DatapathType = CXPLAT_DATAPATH_TYPE_RAW;
+        Packet->RecvData.PartitionIndex = PartitionIndex;
+
+        CxPlatDpRawParseEthernet(
+            (CXPLAT_DATAPATH*)Dpdk,
+            &Packet->RecvData,
+            rte_pktmbuf_mtod(Mbuf, uint8_t*),
+            Mbuf->data_len);
+
+        if (likely(Packet->RecvData.Buffer != NULL)) {
+            //
+            // The route has been filled in with the packet's src/dst IP and ETH addresses, so
+            // mark it resolved. This allows stateless sends to be issued without performing
+            // a route lookup.
+            //
+            Packet->RecvData.Route->State = RouteResolved;
+            Packet->RecvData.Allocated = TRUE;
+            Packets[PacketCount++] = &Packet->RecvData;
         } else {
-            rte_pktmbuf_free(Buffer);
+            rte_pktmbuf_free(Mbuf);
         }
     }
 
     if (likely(PacketCount)) {
-        CxPlatDpRawRxEthernet((CXPLAT_DATAPATH*)Dpdk, (CXPLAT_RECV_DATA**)Buffers, PacketCount);
+        CxPlatDpRawRxEthernet((CXPLAT_DATAPATH_RAW*)Dpdk, Packets, PacketCount);
     }
+    return TRUE;
 }
 
 _IRQL_requires_max_(DISPATCH_LEVEL)
@@ -614,40 +919,36 @@ CxPlatDpRawRxFree(
     )
 {
     while (PacketChain) {
-        const DPDK_RX_PACKET* Packet = (DPDK_RX_PACKET*)PacketChain;
+        const DPDK_RX_PACKET* Packet =
+            CXPLAT_CONTAINING_RECORD(PacketChain, DPDK_RX_PACKET, RecvData);
         PacketChain = PacketChain->Next;
         rte_pktmbuf_free(Packet->Mbuf);
-        CxPlatPoolFree((void*)Packet);
     }
 }
 
 _IRQL_requires_max_(DISPATCH_LEVEL)
 CXPLAT_SEND_DATA*
 CxPlatDpRawTxAlloc(
-    _In_ CXPLAT_DATAPATH* Datapath,
     _Inout_ CXPLAT_SEND_CONFIG* Config
     )
 {
-    DPDK_DATAPATH* Dpdk = (DPDK_DATAPATH*)Datapath;
-    DPDK_TX_PACKET* Packet = CxPlatPoolAlloc(&Dpdk->AdditionalInfoPool);
-    DPDK_INTERFACE* Interface = (DPDK_INTERFACE*)Config->Route->Queue;
-
-    if (likely(Packet)) {
-        Packet->Interface = Interface;
-        Packet->Mbuf = rte_pktmbuf_alloc(Interface->MemoryPool);
-        if (likely(Packet->Mbuf)) {
-            HEADER_BACKFILL HeaderFill = CxPlatDpRawCalculateHeaderBackFill(Config->Route);
-            Packet->Dpdk = Dpdk;
-            Packet->Buffer.Length = Config->MaxPacketSize;
-            Packet->Mbuf->data_off = 0;
-            Packet->Buffer.Buffer = ((uint8_t*)Packet->Mbuf->buf_addr) + HeaderFill.AllLayer;
-            Packet->Mbuf->l2_len = HeaderFill.LinkLayer;
-            Packet->Mbuf->l3_len = HeaderFill.NetworkLayer;
-        } else {
-            CxPlatPoolFree(Packet);
-            Packet = NULL;
-        }
+    DPDK_QUEUE* Queue = (DPDK_QUEUE*)Config->Route->Queue;
+    struct rte_mbuf* Mbuf = rte_pktmbuf_alloc(Queue->MemoryPool);
+    if (unlikely(Mbuf == NULL)) {
+        return NULL;
     }
+
+    DPDK_TX_PACKET* Packet = (DPDK_TX_PACKET*)rte_mbuf_to_priv(Mbuf);
+    HEADER_BACKFILL HeaderBackfill = CxPlatDpRawCalculateHeaderBackFill(Config->Route);
+    CXPLAT_DBG_ASSERT(
+        HeaderBackfill.AllLayer + Config->MaxPacketSize <= rte_pktmbuf_tailroom(Mbuf));
+    Packet->Mbuf = Mbuf;
+    Packet->Queue = Queue;
+    Packet->Buffer.Length = Config->MaxPacketSize;
+    Packet->Buffer.Buffer = rte_pktmbuf_mtod(Mbuf, uint8_t*) + HeaderBackfill.AllLayer;
+    Packet->ECN = Config->ECN;
+    Packet->DSCP = Config->DSCP;
+    Packet->DatapathType = Config->Route->DatapathType = CXPLAT_DATAPATH_TYPE_RAW;
     return (CXPLAT_SEND_DATA*)Packet;
 }
 
@@ -657,9 +958,54 @@ CxPlatDpRawTxFree(
     _In_ CXPLAT_SEND_DATA* SendData
     )
 {
-    DPDK_TX_PACKET* Packet = (DPDK_TX_PACKET*)SendData;
-    rte_pktmbuf_free(Packet->Mbuf);
-    CxPlatPoolFree(SendData);
+    rte_pktmbuf_free(((DPDK_TX_PACKET*)SendData)->Mbuf);
+}
+
+//
+// Sets up the mbuf for the checksums the device computes. The device needs the
+// pseudo header checksum in place of the transport checksum.
+//
+static
+void
+CxPlatDpdkTxSetOffloads(
+    _In_ const DPDK_INTERFACE* Interface,
+    _Inout_ struct rte_mbuf* Mbuf
+    )
+{
+    const struct rte_ether_hdr* Ethernet = rte_pktmbuf_mtod(Mbuf, struct rte_ether_hdr*);
+    uint8_t* Ip = (uint8_t*)(Ethernet + 1);
+    uint8_t Protocol;
+
+    Mbuf->l2_len = sizeof(*Ethernet);
+    if (Ethernet->ether_type == rte_cpu_to_be_16(RTE_ETHER_TYPE_IPV4)) {
+        Mbuf->l3_len = sizeof(struct rte_ipv4_hdr);
+        Mbuf->ol_flags |= RTE_MBUF_F_TX_IPV4;
+        if (Interface->OffloadStatus.Transmit.NetworkLayerXsum) {
+            Mbuf->ol_flags |= RTE_MBUF_F_TX_IP_CKSUM;
+        }
+        Protocol = ((struct rte_ipv4_hdr*)Ip)->next_proto_id;
+    } else {
+        Mbuf->l3_len = sizeof(struct rte_ipv6_hdr);
+        Mbuf->ol_flags |= RTE_MBUF_F_TX_IPV6;
+        Protocol = ((struct rte_ipv6_hdr*)Ip)->proto;
+    }
+
+    if (!Interface->OffloadStatus.Transmit.TransportLayerXsum) {
+        return;
+    }
+
+    uint16_t* Checksum;
+    if (Protocol == IPPROTO_UDP) {
+        Mbuf->ol_flags |= RTE_MBUF_F_TX_UDP_CKSUM;
+        Checksum = &((struct rte_udp_hdr*)(Ip + Mbuf->l3_len))->dgram_cksum;
+    } else {
+        Mbuf->ol_flags |= RTE_MBUF_F_TX_TCP_CKSUM;
+        Checksum = &((struct rte_tcp_hdr*)(Ip + Mbuf->l3_len))->cksum;
+    }
+    *Checksum =
+        (Mbuf->ol_flags & RTE_MBUF_F_TX_IPV4) ?
+            rte_ipv4_phdr_cksum((struct rte_ipv4_hdr*)Ip, Mbuf->ol_flags) :
+            rte_ipv6_phdr_cksum((struct rte_ipv6_hdr*)Ip, Mbuf->ol_flags);
 }
 
 _IRQL_requires_max_(DISPATCH_LEVEL)
@@ -669,72 +1015,150 @@ CxPlatDpRawTxEnqueue(
     )
 {
     DPDK_TX_PACKET* Packet = (DPDK_TX_PACKET*)SendData;
-    DPDK_INTERFACE* Interface = Packet->Interface;
-    Packet->Mbuf->data_len = (uint16_t)Packet->Buffer.Length;
-    Packet->Mbuf->ol_flags = PKT_TX_IPV4 | PKT_TX_IP_CKSUM | PKT_TX_UDP_CKSUM;
+    DPDK_QUEUE* Queue = Packet->Queue;
+    struct rte_mbuf* Mbuf = Packet->Mbuf;
 
-    DPDK_DATAPATH* Dpdk = Packet->Dpdk;
-    if (unlikely(rte_ring_mp_enqueue(Interface->TxRingBuffer, Packet->Mbuf) != 0)) {
-        rte_pktmbuf_free(Packet->Mbuf);
+    //
+    // The headers have been written in front of the payload, so the frame now
+    // starts at the buffer.
+    //
+    Mbuf->data_off = (uint16_t)(Packet->Buffer.Buffer - (uint8_t*)Mbuf->buf_addr);
+    Mbuf->data_len = (uint16_t)Packet->Buffer.Length;
+    Mbuf->pkt_len = Packet->Buffer.Length;
+    Mbuf->ol_flags = 0;
+    CxPlatDpdkTxSetOffloads(Queue->Interface, Mbuf);
+
+    if (unlikely(rte_ring_mp_enqueue(Queue->TxRing, Mbuf) != 0)) {
+        rte_pktmbuf_free(Mbuf);
         QuicTraceEvent(
             LibraryError,
             "[ lib] ERROR, %s.",
             "No room in DPDK TX ring buffer");
     }
-
-    CxPlatPoolFree(Packet);
 }
 
 static
-void
+BOOLEAN // Did work?
 CxPlatDpdkTx(
-    _In_ DPDK_DATAPATH* Dpdk,
-    _In_ DPDK_INTERFACE* Interface
+    _In_ DPDK_QUEUE* Queue
     )
 {
-    struct rte_mbuf* Buffers[TX_BURST_SIZE];
-    const uint16_t BufferCount =
-        (uint16_t)rte_ring_sc_dequeue_burst(
-            Interface->TxRingBuffer, (void**)Buffers, TX_BURST_SIZE, NULL);
-    if (unlikely(BufferCount == 0)) {
-        return;
+    //
+    // Top up the burst with queued sends, then hand as much of it to the
+    // device as it has room for. Whatever is left goes first next time.
+    //
+    if (Queue->TxPendingCount < TX_BURST_SIZE) {
+        Queue->TxPendingCount +=
+            (uint16_t)rte_ring_sc_dequeue_burst(
+                Queue->TxRing,
+                (void**)&Queue->TxPending[Queue->TxPendingCount],
+                TX_BURST_SIZE - Queue->TxPendingCount,
+                NULL);
+    }
+    if (Queue->TxPendingCount == 0) {
+        return FALSE;
     }
 
-    const uint16_t TxCount = rte_eth_tx_burst(Interface->Port, 0, Buffers, BufferCount);
-    if (unlikely(TxCount < BufferCount)) {
-        for (uint16_t buf = TxCount; buf < BufferCount; buf++) {
-            rte_pktmbuf_free(Buffers[buf]);
-        }
+    const uint16_t TxCount =
+        rte_eth_tx_burst(
+            Queue->Interface->Port, Queue->Id, Queue->TxPending, Queue->TxPendingCount);
+    if (TxCount < Queue->TxPendingCount) {
+        memmove(
+            Queue->TxPending,
+            Queue->TxPending + TxCount,
+            (Queue->TxPendingCount - TxCount) * sizeof(Queue->TxPending[0]));
     }
+    Queue->TxPendingCount -= TxCount;
+    return TxCount > 0;
 }
 
-static
-int
-CxPlatDpdkWorkerThread(
-    _In_ void* Context
+_IRQL_requires_max_(PASSIVE_LEVEL)
+BOOLEAN
+CxPlatDpdkExecute(
+    _Inout_ void* Context,
+    _Inout_ CXPLAT_EXECUTION_STATE* State
     )
 {
-    DPDK_DATAPATH* Dpdk = (DPDK_DATAPATH*)Context;
-    const uint16_t Core = (uint16_t)rte_lcore_id();
-    CXPLAT_LIST_ENTRY* Entry;
-
-    printf("Core %u worker running...\n", Core);
-    for (Entry = Dpdk->Interfaces.Flink; Entry != &Dpdk->Interfaces; Entry = Entry->Flink) {
-        if (rte_eth_dev_socket_id(Dpdk->Interface.Port) > 0 &&
-            rte_eth_dev_socket_id(Dpdk->Interface.Port) != (int)rte_socket_id()) {
-            printf("\nWARNING, port %u is on remote NUMA node to polling thread.\n"
-                "\tPerformance will not be optimal.\n\n",
-                Dpdk->Interface.Port);
+    DPDK_PARTITION* Partition = (DPDK_PARTITION*)Context;
+    const DPDK_DATAPATH* Dpdk = Partition->Dpdk;
+
+    if (!Dpdk->Running) {
+        if (Partition->LcoreReferenced) {
+            CXPLAT_DBG_ASSERT(CxPlatDpdkLcoreRefCount != 0);
+            if (--CxPlatDpdkLcoreRefCount == 0) {
+                rte_thread_unregister();
+            }
+            Partition->LcoreReferenced = FALSE;
         }
+        CxPlatEventQEnqueue(Partition->EventQ, &Partition->ShutdownSqe);
+        return FALSE;
     }
 
-    while (likely(Dpdk->Running)) {
-        for (Entry = Dpdk->Interfaces.Flink; Entry != &Dpdk->Interfaces; Entry = Entry->Flink) {
-            DPDK_INTERFACE* Interface = CONTAINING_RECORD(Entry, DPDK_INTERFACE, Link);
-            CxPlatDpdkRx(Dpdk, Core, Interface);
-            CxPlatDpdkTx(Dpdk, Interface);
+    if (unlikely(!Partition->LcoreReferenced)) {
+        //
+        // Give the worker thread an lcore so the mbuf pools use their per
+        // lcore caches. Without one, every alloc and free goes to the pool's
+        // shared ring, which still works, just slower. Threads the EAL gave an
+        // lcore to are left alone.
+        //
+        if (CxPlatDpdkLcoreRefCount != 0) {
+            ++CxPlatDpdkLcoreRefCount;
+            Partition->LcoreReferenced = TRUE;
+        } else if (rte_lcore_id() == LCORE_ID_ANY && rte_thread_register() == 0) {
+            CxPlatDpdkLcoreRefCount = 1;
+            Partition->LcoreReferenced = TRUE;
         }
     }
 
-    return 0;
+    BOOLEAN DidWork = FALSE;
+    DPDK_QUEUE* Queue = Partition->Queues;
+    while (Queue) {
+        DidWork |= CxPlatDpdkRx(Dpdk, Queue, Partition->PartitionIndex);
+        DidWork |= CxPlatDpdkTx(Queue);
+        Queue = Queue->Next;
+    }
+
+    if (DidWork) {
+        State->NoWorkCount = 0;
+    }
+
+    //
+    // DPDK devices are poll mode, so keep polling while running.
+    //
+    Partition->Ec.Ready = TRUE;
+    return TRUE;
+}
+
+void
+CxPlatDpdkPartitionShutdownEventComplete(
+    _In_ CXPLAT_CQE* Cqe
+    )
+{
+    DPDK_PARTITION* Partition =
+        CXPLAT_CONTAINING_RECORD(CxPlatCqeGetSqe(Cqe), DPDK_PARTITION, ShutdownSqe);
+    CxPlatSqeCleanup(Partition->EventQ, &Partition->ShutdownSqe);
+    CxPlatRundownRelease(&((DPDK_DATAPATH*)Partition->Dpdk)->Rundown);
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+CxPlatDataPathRssConfigGet(
+    _In_ uint32_t InterfaceIndex,
+    _Outptr_ _At_(*RssConfig, __drv_allocatesMem(Mem))
+        CXPLAT_RSS_CONFIG** RssConfig
+    )
+{
+    UNREFERENCED_PARAMETER(InterfaceIndex);
+    UNREFERENCED_PARAMETER(RssConfig);
+    return QUIC_STATUS_NOT_SUPPORTED;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+CxPlatDataPathRssConfigFree(
+    _In_ CXPLAT_RSS_CONFIG* RssConfig
+    )
+{
+    UNREFERENCED_PARAMETER(RssConfig);
+    CXPLAT_FRE_ASSERTMSG(FALSE, "CxPlatDataPathRssConfigFree not supported");
 }
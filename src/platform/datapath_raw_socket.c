@@ -469,45 +469,6 @@ CxPlatDpRawCalculateHeaderBackFill(
     return HeaderBackFill;
 }
 
-_IRQL_requires_max_(DISPATCH_LEVEL)
-uint16_t
-CxPlatFramingChecksum(
-    _In_reads_(Length) uint8_t* Data,
-    _In_ uint32_t Length,
-    _In_ uint64_t InitialChecksum
-    )
-{
-    //
-    // Add up all bytes in 3 steps:
-    // 1. Add the odd byte to the checksum if the length is odd.
-    // 2. If the length is divisible by 2 but not 4, add the last 2 bytes.
-    // 3. Sum up the rest as 32-bit words.
-    //
-
-    if ((Length & 1) != 0) {
-        --Length;
-        InitialChecksum += Data[Length];
-    }
-
-    if ((Length & 2) != 0) {
-        Length -= 2;
-        InitialChecksum += *((uint16_t*)(&Data[Length]));
-    }
-
-    for (uint32_t i = 0; i < Length; i += 4) {
-        InitialChecksum += *((uint32_t*)(&Data[i]));
-    }
-
-    //
-    // Fold all carries into the final checksum.
-    //
-    while (InitialChecksum >> 16) {
-        InitialChecksum = (InitialChecksum & 0xffff) + (InitialChecksum >> 16);
-    }
-
-    return (uint16_t)InitialChecksum;
-}
-
 _IRQL_requires_max_(DISPATCH_LEVEL)
 uint16_t
 CxPlatFramingTransportChecksum(
@@ -520,15 +481,15 @@ CxPlatFramingTransportChecksum(
     )
 {
     uint64_t Checksum =
-        CxPlatFramingChecksum(SrcAddr, AddrLength, 0) +
-        CxPlatFramingChecksum(DstAddr, AddrLength, 0);
+        CxPlatChecksum(SrcAddr, AddrLength, 0) +
+        CxPlatChecksum(DstAddr, AddrLength, 0);
     Checksum += CxPlatByteSwapUint16(NextHeader);
     Checksum += CxPlatByteSwapUint16((uint16_t)IPPayloadLength);
 
     //
     // Pseudoheader is always in 32-bit words. So, cross 16-bit boundary adjustment isn't needed.
     //
-    return ~CxPlatFramingChecksum(IPPayload, IPPayloadLength, Checksum);
+    return ~CxPlatChecksum(IPPayload, IPPayloadLength, Checksum);
 }
 
 _IRQL_requires_max_(DISPATCH_LEVEL)
@@ -763,7 +724,7 @@ CxPlatFramingWriteHeaders(
         IPv4->HeaderChecksum = 0;
         CxPlatCopyMemory(IPv4->Source, &Route->LocalAddress.Ipv4.sin_addr, sizeof(Route->LocalAddress.Ipv4.sin_addr));
         CxPlatCopyMemory(IPv4->Destination, &Route->RemoteAddress.Ipv4.sin_addr, sizeof(Route->RemoteAddress.Ipv4.sin_addr));
-        IPv4->HeaderChecksum = SkipNetworkLayerXsum ? 0 : ~CxPlatFramingChecksum((uint8_t*)IPv4, sizeof(IPV4_HEADER), 0);
+        IPv4->HeaderChecksum = SkipNetworkLayerXsum ? 0 : ~CxPlatChecksum((uint8_t*)IPv4, sizeof(IPV4_HEADER), 0);
         EthType = ETHERNET_TYPE_IPV4;
         Ethernet = (ETHERNET_HEADER*)(((uint8_t*)IPv4) - sizeof(ETHERNET_HEADER));
         IpHeaderLen = sizeof(IPV4_HEADER);
@@ -50,6 +50,14 @@ typedef struct QUIC_CACHEALIGN XDP_PARTITION {
     XDP_QUEUE* Queues; // A linked list of queues, accessed by Next.
     uint16_t PartitionIndex;
     uint16_t Processor;
+    //
+    // Busy polling state: when the partition last found work, a moving
+    // average of the idle gaps between bursts of work, and whether it found
+    // no work the last time it polled.
+    //
+    uint64_t LastWorkTimeUs;
+    uint32_t IdleGapUs;
+    BOOLEAN Idle;
 } XDP_PARTITION;
 
 void XdpWorkerAddQueue(_In_ XDP_PARTITION* Partition, _In_ XDP_QUEUE* Queue) {
@@ -27,30 +27,68 @@ Abstract:
 #include "datapath_raw_xdp_linux.c.clog.h"
 #endif
 
-#define NUM_FRAMES         8192 * 2
-#define CONS_NUM_DESCS     NUM_FRAMES / 2
-#define PROD_NUM_DESCS     NUM_FRAMES / 2
-#define FRAME_SIZE         XSK_UMEM__DEFAULT_FRAME_SIZE // TODO: 2K mode
-#define INVALID_UMEM_FRAME UINT64_MAX
-
-struct XskSocketInfo {
-    struct xsk_ring_cons Rx;
-    struct xsk_ring_prod Tx;
-    struct XskUmemInfo *UmemInfo;
-    struct xsk_socket *Xsk;
-
-    CXPLAT_LOCK UmemLock;
-    uint64_t UmemFrameAddr[NUM_FRAMES];
-    uint32_t UmemFrameFree;
-};
+//
+// Not yet in every distribution's uapi headers (Linux 6.6+).
+//
+#ifndef XDP_USE_SG
+#define XDP_USE_SG         (1 << 4)
+#endif
+#ifndef XDP_PKT_CONTD
+#define XDP_PKT_CONTD      (1 << 0)
+#endif
+//
+// Linux 5.11+.
+//
+#ifndef SO_PREFER_BUSY_POLL
+#define SO_PREFER_BUSY_POLL     69
+#endif
+#ifndef SO_BUSY_POLL_BUDGET
+#define SO_BUSY_POLL_BUDGET     70
+#endif
 
+#define DEFAULT_FRAME_COUNT     (8192 * 2)
+#define DEFAULT_RING_SIZE       8192
+#define MIN_FRAME_SIZE          2048
+#define INVALID_UMEM_FRAME      UINT64_MAX
+
+//
+// When busy polling, how long (in us) a blocking receive may spin in the
+// driver, and how much the partition polls for when the idle gaps between
+// bursts are longer than the idle timeout (as a right shift of the timeout).
+//
+#define BUSY_POLL_US            20
+#define BUSY_POLL_SHORT_SHIFT   3
+
+//
+// A UMEM and the pool of its free frames. With a shared UMEM, all the queues
+// of an interface allocate from (and bind their sockets to) the same UMEM.
+//
 struct XskUmemInfo {
-    struct xsk_ring_prod Fq;
-    struct xsk_ring_cons Cq;
     struct xsk_umem *Umem;
     void *Buffer;
+    uint32_t FrameSize;
+    uint32_t FrameCount;
     uint32_t RxHeadRoom;
     uint32_t TxHeadRoom;
+    uint32_t RefCount; // Number of sockets bound to the UMEM.
+
+    CXPLAT_LOCK Lock;
+    uint32_t FrameFree;
+    uint64_t FrameAddr[0];
+};
+
+//
+// An AF_XDP socket. Each socket has its own fill and completion rings, even
+// when it shares the UMEM with other sockets.
+//
+struct XskSocketInfo {
+    struct xsk_ring_cons Rx;
+    struct xsk_ring_prod Tx;
+    struct xsk_ring_prod Fq;
+    struct xsk_ring_cons Cq;
+    struct XskUmemInfo *UmemInfo;
+    struct xsk_socket *Xsk;
+    uint32_t FillShare; // Most frames the socket's fill ring may hold.
 };
 
 // TODO: remove this exception when finalizing members
@@ -65,8 +103,7 @@ typedef struct XDP_DATAPATH { // NOLINT(clang-analyzer-optin.performance.Padding
     uint32_t BufferCount;
 
     uint32_t PollingIdleTimeoutUs;
-    BOOLEAN TxAlwaysPoke;
-    BOOLEAN SkipXsum;
+    CXPLAT_XDP_CONFIG Config;
     BOOLEAN Running;        // Signal to stop workers.
 
     CXPLAT_RUNDOWN_REF Rundown;
@@ -106,13 +143,23 @@ typedef struct XDP_QUEUE {
     CXPLAT_LOCK FqLock;
     CXPLAT_LOCK CqLock;
 
+    //
+    // Buffers that multi-buffer (chained) receives are reassembled into, and
+    // the one being reassembled.
+    //
+    CXPLAT_POOL RxChainPool;
+    BOOLEAN RxChainPoolInitialized;
+    struct XDP_RX_PACKET* RxChain;
+    uint32_t RxChainLength;
+    BOOLEAN RxChainDrop;    // Discard the rest of the chain.
+
     struct XskSocketInfo* XskInfo;
 } XDP_QUEUE;
 
 typedef struct __attribute__((aligned(64))) XDP_RX_PACKET {
     XDP_QUEUE* Queue;
     CXPLAT_ROUTE RouteStorage;
-    uint64_t Addr;
+    uint64_t Addr;          // INVALID_UMEM_FRAME if in RxChainPool.
     CXPLAT_RECV_DATA RecvData;
     // Followed by:
     // uint8_t ClientContext[...];
@@ -127,10 +174,63 @@ typedef struct __attribute__((aligned(64))) XDP_TX_PACKET {
     uint8_t FrameBuffer[MAX_ETH_FRAME_SIZE];
 } XDP_TX_PACKET;
 
+CXPLAT_STATIC_ASSERT(
+    sizeof(XDP_TX_PACKET) <= MIN_FRAME_SIZE,
+    "A Tx packet must fit in a single 2K UMEM frame");
+
+//
+// Pool entries are only as aligned as the system allocator makes them, so
+// chain buffers are padded to fit an aligned packet, and the pool entry is
+// stored just before it.
+//
+#define RX_CHAIN_PADDING        (__alignof__(XDP_RX_PACKET) + sizeof(void*))
+
+static
+XDP_RX_PACKET*
+XdpRxChainAlloc(
+    _In_ XDP_QUEUE* Queue
+    )
+{
+    uint8_t* Buffer = CxPlatPoolAlloc(&Queue->RxChainPool);
+    if (Buffer == NULL) {
+        return NULL;
+    }
+    const uintptr_t Align = __alignof__(XDP_RX_PACKET);
+    XDP_RX_PACKET* Packet =
+        (XDP_RX_PACKET*)(((uintptr_t)Buffer + sizeof(void*) + Align - 1) & ~(Align - 1));
+    ((void**)Packet)[-1] = Buffer;
+    return Packet;
+}
+
+static
+void
+XdpRxChainFree(
+    _In_ XDP_RX_PACKET* Packet
+    )
+{
+    CxPlatPoolFree(((void**)Packet)[-1]);
+}
+
 CXPLAT_EVENT_COMPLETION CxPlatPartitionShutdownEventComplete;
 CXPLAT_EVENT_COMPLETION CxPlatQueueRxIoEventComplete;
 CXPLAT_EVENT_COMPLETION CxPlatQueueTxIoEventComplete;
 
+//
+// The events the partition waits for on the socket while Rx is armed. When
+// busy polling, the partition polls the rings itself and only needs to be
+// woken up once after it backs off into interrupt mode.
+//
+static
+uint32_t
+XdpQueueRxEvents(
+    _In_ const XDP_QUEUE* Queue
+    )
+{
+    return
+        Queue->Interface->Xdp->PollingIdleTimeoutUs != 0 ?
+            (EPOLLIN | EPOLLONESHOT) : EPOLLIN;
+}
+
 void
 XdpSocketContextSetEvents(
     _In_ XDP_QUEUE* Queue,
@@ -197,23 +297,102 @@ CxPlatGetInterfaceRssQueueCount(
 
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
-CxPlatXdpReadConfig(
-    _Inout_ XDP_DATAPATH* Xdp
+CxPlatXdpParseConfig(
+    _In_opt_ FILE* File,
+    _Out_ CXPLAT_XDP_CONFIG* Config
     )
 {
     //
     // Default config.
     //
-    Xdp->TxAlwaysPoke = FALSE;
+    Config->FrameSize = XSK_UMEM__DEFAULT_FRAME_SIZE;
+    Config->FrameCount = DEFAULT_FRAME_COUNT;
+    Config->RxRingSize = DEFAULT_RING_SIZE;
+    Config->TxRingSize = DEFAULT_RING_SIZE;
+    Config->FillRingSize = DEFAULT_RING_SIZE;
+    Config->CompRingSize = DEFAULT_RING_SIZE;
+    Config->SharedUmem = FALSE;
+    Config->MultiBuffer = FALSE;
+    Config->TxAlwaysPoke = FALSE;
+    Config->SkipXsum = FALSE;
+
+    char Line[256];
+    while (File != NULL && fgets(Line, sizeof(Line), File) != NULL) {
+        char* Value = strchr(Line, '=');
+        if (Value == NULL) {
+            continue;
+        }
+        *Value++ = '\0';
+        Value[strcspn(Value, "\r\n")] = '\0';
+
+        if (strcmp(Line, "FrameSize") == 0) {
+            Config->FrameSize = strtoul(Value, NULL, 10);
+        } else if (strcmp(Line, "FrameCount") == 0) {
+            Config->FrameCount = strtoul(Value, NULL, 10);
+        } else if (strcmp(Line, "RxRingSize") == 0) {
+            Config->RxRingSize = strtoul(Value, NULL, 10);
+        } else if (strcmp(Line, "TxRingSize") == 0) {
+            Config->TxRingSize = strtoul(Value, NULL, 10);
+        } else if (strcmp(Line, "FillRingSize") == 0) {
+            Config->FillRingSize = strtoul(Value, NULL, 10);
+        } else if (strcmp(Line, "CompRingSize") == 0) {
+            Config->CompRingSize = strtoul(Value, NULL, 10);
+        } else if (strcmp(Line, "SharedUmem") == 0) {
+            Config->SharedUmem = !!strtoul(Value, NULL, 10);
+        } else if (strcmp(Line, "MultiBuffer") == 0) {
+            Config->MultiBuffer = !!strtoul(Value, NULL, 10);
+        } else if (strcmp(Line, "TxAlwaysPoke") == 0) {
+            Config->TxAlwaysPoke = !!strtoul(Value, NULL, 10);
+        } else if (strcmp(Line, "SkipXsum") == 0) {
+            Config->SkipXsum = !!strtoul(Value, NULL, 10);
+        }
+    }
+
+    //
+    // Frames must be a power of two between 2K and the page size (aligned
+    // UMEM mode), and the rings must be powers of two.
+    //
+    if (Config->FrameSize != MIN_FRAME_SIZE &&
+        Config->FrameSize != XSK_UMEM__DEFAULT_FRAME_SIZE) {
+        Config->FrameSize = XSK_UMEM__DEFAULT_FRAME_SIZE;
+    }
+    uint32_t* RingSizes[] = {
+        &Config->RxRingSize, &Config->TxRingSize, &Config->FillRingSize, &Config->CompRingSize
+    };
+    for (uint32_t i = 0; i < ARRAYSIZE(RingSizes); i++) {
+        if (*RingSizes[i] == 0 || (*RingSizes[i] & (*RingSizes[i] - 1)) != 0) {
+            *RingSizes[i] = DEFAULT_RING_SIZE;
+        }
+    }
+    if (Config->FrameCount == 0) {
+        Config->FrameCount = DEFAULT_FRAME_COUNT;
+    }
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+CxPlatXdpReadConfig(
+    _Inout_ XDP_DATAPATH* Xdp
+    )
+{
+    FILE *File = fopen("xdp.ini", "r");
+    CxPlatXdpParseConfig(File, &Xdp->Config);
+    if (File != NULL) {
+        fclose(File);
+    }
 }
 
 void UninitializeUmem(struct XskUmemInfo* UmemInfo)
 {
+    if (--UmemInfo->RefCount != 0) {
+        return; // Still bound to other queues' sockets.
+    }
     if (xsk_umem__delete(UmemInfo->Umem) != 0) {
         QuicTraceLogVerbose(
             XdpUmemDeleteFails,
             "[ xdp] Failed to delete Umem");
     }
+    CxPlatLockUninitialize(&UmemInfo->Lock);
     free(UmemInfo->Buffer);
     free(UmemInfo);
 }
@@ -268,7 +447,6 @@ CxPlatDpRawInterfaceUninitialize(
             if (Queue->XskInfo->UmemInfo) {
                 UninitializeUmem(Queue->XskInfo->UmemInfo);
             }
-            CxPlatLockUninitialize(&Queue->XskInfo->UmemLock);
             free(Queue->XskInfo);
         }
 
@@ -276,6 +454,12 @@ CxPlatDpRawInterfaceUninitialize(
         CxPlatLockUninitialize(&Queue->RxLock);
         CxPlatLockUninitialize(&Queue->CqLock);
         CxPlatLockUninitialize(&Queue->FqLock);
+        if (Queue->RxChain != NULL) {
+            XdpRxChainFree(Queue->RxChain);
+        }
+        if (Queue->RxChainPoolInitialized) {
+            CxPlatPoolUninitialize(&Queue->RxChainPool);
+        }
     }
 
     if (Interface->Queues != NULL) {
@@ -293,60 +477,130 @@ CxPlatDpRawInterfaceUninitialize(
     }
 }
 
-static QUIC_STATUS InitializeUmem(uint32_t FrameSize, uint32_t NumFrames, uint32_t RxHeadRoom, uint32_t TxHeadRoom, struct XskUmemInfo* UmemInfo)
+//
+// Asks the kernel to keep the driver's interrupts masked while the socket is
+// being polled, so that its Rx processing runs from the partition's recvfrom
+// calls instead of softirq context. Best effort: busy polling still works
+// without it (e.g. on kernels older than 5.11), just with more interrupts.
+//
+static
+void
+XdpSocketEnableBusyPoll(
+    _In_ struct xsk_socket* Xsk
+    )
+{
+    const int Fd = xsk_socket__fd(Xsk);
+    const struct {
+        int Option;
+        int Value;
+        const char* Name;
+    } Options[] = {
+        { SO_PREFER_BUSY_POLL, 1, "setsockopt(SO_PREFER_BUSY_POLL)" },
+        { SO_BUSY_POLL, BUSY_POLL_US, "setsockopt(SO_BUSY_POLL)" },
+        { SO_BUSY_POLL_BUDGET, RX_BATCH_SIZE, "setsockopt(SO_BUSY_POLL_BUDGET)" },
+    };
+    for (uint32_t i = 0; i < ARRAYSIZE(Options); i++) {
+        if (setsockopt(
+                Fd, SOL_SOCKET, Options[i].Option,
+                &Options[i].Value, sizeof(Options[i].Value)) != 0) {
+            QuicTraceEvent(
+                LibraryErrorStatus,
+                "[ lib] ERROR, %u, %s.",
+                errno,
+                Options[i].Name);
+        }
+    }
+}
+
+static
+QUIC_STATUS
+InitializeUmem(
+    _In_ const XDP_DATAPATH* Xdp,
+    _In_ uint32_t RxHeadRoom,
+    _In_ uint32_t TxHeadRoom,
+    _In_ struct XskSocketInfo* XskInfo,
+    _Out_ struct XskUmemInfo** NewUmemInfo
+    )
 {
+    const uint32_t FrameSize = Xdp->Config.FrameSize;
+    const uint32_t FrameCount = Xdp->Config.FrameCount;
+    struct XskUmemInfo* UmemInfo =
+        calloc(1, sizeof(struct XskUmemInfo) + FrameCount * sizeof(uint64_t));
+    if (!UmemInfo) {
+        return QUIC_STATUS_OUT_OF_MEMORY;
+    }
+
     void *Buffer = NULL;
-    if (posix_memalign(&Buffer, getpagesize(), (size_t)(FrameSize) * NumFrames)) {
+    if (posix_memalign(&Buffer, getpagesize(), (size_t)(FrameSize) * FrameCount)) {
         QuicTraceLogVerbose(
             XdpAllocUmem,
             "[ xdp] Failed to allocate umem");
+        free(UmemInfo);
         return QUIC_STATUS_OUT_OF_MEMORY;
     }
 
     struct xsk_umem_config UmemConfig = {
-        .fill_size = PROD_NUM_DESCS,
-        .comp_size = CONS_NUM_DESCS,
+        .fill_size = Xdp->Config.FillRingSize,
+        .comp_size = Xdp->Config.CompRingSize,
         .frame_size = FrameSize, // frame_size is really sensitive to become EINVAL
         .frame_headroom = RxHeadRoom,
         .flags = 0
     };
 
-    int Ret = xsk_umem__create(&UmemInfo->Umem, Buffer, (uint64_t)(FrameSize) * NumFrames, &UmemInfo->Fq, &UmemInfo->Cq, &UmemConfig);
+    //
+    // The UMEM's initial fill and completion rings become the rings of the
+    // first socket bound to it.
+    //
+    int Ret = xsk_umem__create(&UmemInfo->Umem, Buffer, (uint64_t)(FrameSize) * FrameCount, &XskInfo->Fq, &XskInfo->Cq, &UmemConfig);
     if (Ret) {
         errno = -Ret;
         free(Buffer);
+        free(UmemInfo);
         return QUIC_STATUS_INTERNAL_ERROR;
     }
 
     UmemInfo->Buffer = Buffer;
+    UmemInfo->FrameSize = FrameSize;
+    UmemInfo->FrameCount = FrameCount;
     UmemInfo->RxHeadRoom = RxHeadRoom;
     UmemInfo->TxHeadRoom = TxHeadRoom;
+    CxPlatLockInitialize(&UmemInfo->Lock);
+    for (uint32_t i = 0; i < FrameCount; i++) {
+        UmemInfo->FrameAddr[i] = (uint64_t)i * FrameSize;
+    }
+    UmemInfo->FrameFree = FrameCount;
+
+    *NewUmemInfo = UmemInfo;
     return QUIC_STATUS_SUCCESS;
 }
 
-static uint64_t XskUmemFreeFrames(struct XskSocketInfo *Xsk)
+//
+// The frame pool functions must be called with the UMEM's lock held.
+//
+
+static uint64_t XskUmemFreeFrames(struct XskUmemInfo *UmemInfo)
 {
-    return Xsk->UmemFrameFree;
+    return UmemInfo->FrameFree;
 }
 
-static uint64_t XskUmemFrameAlloc(struct XskSocketInfo *Xsk)
+static uint64_t XskUmemFrameAlloc(struct XskUmemInfo *UmemInfo)
 {
     uint64_t Frame;
-    if (Xsk->UmemFrameFree == 0) {
+    if (UmemInfo->FrameFree == 0) {
         QuicTraceLogVerbose(
             XdpUmemAllocFails,
             "[ xdp][umem] Out of UMEM frame, OOM");
         return INVALID_UMEM_FRAME;
     }
-    Frame = Xsk->UmemFrameAddr[--Xsk->UmemFrameFree];
-    Xsk->UmemFrameAddr[Xsk->UmemFrameFree] = INVALID_UMEM_FRAME;
+    Frame = UmemInfo->FrameAddr[--UmemInfo->FrameFree];
+    UmemInfo->FrameAddr[UmemInfo->FrameFree] = INVALID_UMEM_FRAME;
     return Frame;
 }
 
-static void XskUmemFrameFree(struct XskSocketInfo *Xsk, uint64_t Frame)
+static void XskUmemFrameFree(struct XskUmemInfo *UmemInfo, uint64_t Frame)
 {
-    assert(Xsk->UmemFrameFree < NUM_FRAMES);
-    Xsk->UmemFrameAddr[Xsk->UmemFrameFree++] = Frame;
+    assert(UmemInfo->FrameFree < UmemInfo->FrameCount);
+    UmemInfo->FrameAddr[UmemInfo->FrameFree++] = Frame;
 }
 
 QUIC_STATUS
@@ -459,12 +713,19 @@ CxPlatDpRawInterfaceInitialize(
 
     const uint32_t RxHeadroom = ALIGN_UP(sizeof(XDP_RX_PACKET) + ClientRecvContextLength, 32);
     const uint32_t TxHeadroom = ALIGN_UP(FIELD_OFFSET(XDP_TX_PACKET, FrameBuffer), 32);
-    // WARN: variable frame size cause unexpected behavior
-    // TODO: 2K mode
-    const uint32_t FrameSize = FRAME_SIZE;
     QUIC_STATUS Status = QUIC_STATUS_SUCCESS;
     int SocketCreated = 0;
 
+    //
+    // A full size Ethernet frame may not fit in a 2K frame after the headroom,
+    // in which case 2K frames need multi-buffer receives. Fall back to 4K
+    // frames if multi-buffer isn't enabled.
+    //
+    if (!Xdp->Config.MultiBuffer &&
+        Xdp->Config.FrameSize < RxHeadroom + XDP_PACKET_HEADROOM + MAX_ETH_FRAME_SIZE) {
+        Xdp->Config.FrameSize = XSK_UMEM__DEFAULT_FRAME_SIZE;
+    }
+
     // TODO: setup offload features
 
     Interface->Xdp = Xdp;
@@ -473,14 +734,17 @@ CxPlatDpRawInterfaceInitialize(
         Status = QUIC_STATUS_OUT_OF_MEMORY;
         goto Error;
     }
-    XskCfg->rx_size = CONS_NUM_DESCS;
-    XskCfg->tx_size = PROD_NUM_DESCS;
+    XskCfg->rx_size = Xdp->Config.RxRingSize;
+    XskCfg->tx_size = Xdp->Config.TxRingSize;
     XskCfg->libbpf_flags = XSK_LIBBPF_FLAGS__INHIBIT_PROG_LOAD;
     // TODO: check ZEROCOPY feature, change Tx/Rx behavior based on feature
     //       refer xdp-tools/xdp-loader/xdp-loader features <ifname>
     XskCfg->bind_flags &= ~XDP_ZEROCOPY;
     XskCfg->bind_flags |= XDP_COPY;
     XskCfg->bind_flags |= XDP_USE_NEED_WAKEUP;
+    if (Xdp->Config.MultiBuffer) {
+        XskCfg->bind_flags |= XDP_USE_SG;
+    }
     Interface->XskCfg = XskCfg;
 
     DetachXdpProgram(Interface, true);
@@ -490,6 +754,17 @@ CxPlatDpRawInterfaceInitialize(
         goto Error;
     }
 
+    if (Xdp->Config.MultiBuffer &&
+        xdp_program__set_xdp_frags_support(Interface->XdpProg, true) != 0) {
+        QuicTraceLogVerbose(
+            XdpAttachFails,
+            "[ xdp] Failed to attach XDP program to %s. error:%s",
+            Interface->IfName,
+            "no multi-buffer support");
+        Status = QUIC_STATUS_NOT_SUPPORTED;
+        goto Error;
+    }
+
     Status = AttachXdpProgram(Interface->XdpProg, Interface, XskCfg);
     if (QUIC_FAILED(Status)) {
         goto Error;
@@ -528,6 +803,7 @@ CxPlatDpRawInterfaceInitialize(
 
     CxPlatZeroMemory(Interface->Queues, Interface->QueueCount * sizeof(*Interface->Queues));
 
+    struct XskUmemInfo *SharedUmemInfo = NULL;
     for (uint16_t i = 0; i < Interface->QueueCount; i++) {
         XDP_QUEUE* Queue = &Interface->Queues[i];
 
@@ -539,21 +815,12 @@ CxPlatDpRawInterfaceInitialize(
         CxPlatLockInitialize(&Queue->FqLock);
         CxPlatLockInitialize(&Queue->CqLock);
 
-        // Initialize shared packet_buffer for umem usage
-        struct XskUmemInfo *UmemInfo = calloc(1, sizeof(struct XskUmemInfo));
-        if (!UmemInfo) {
-            Status = QUIC_STATUS_OUT_OF_MEMORY;
-            goto Error;
-        }
-
-        Status = InitializeUmem(FRAME_SIZE, NUM_FRAMES, RxHeadroom, TxHeadroom, UmemInfo);
-        if (QUIC_FAILED(Status)) {
-            QuicTraceLogVerbose(
-                XdpConfigureUmem,
-                "[ xdp] Failed to configure Umem");
-            free(UmemInfo);
-            goto Error;
-        }
+        CxPlatPoolInitialize(
+            FALSE,
+            RX_CHAIN_PADDING + RxHeadroom + MAX_ETH_FRAME_SIZE,
+            RX_BUFFER_TAG,
+            &Queue->RxChainPool);
+        Queue->RxChainPoolInitialized = TRUE;
 
         //
         // Create AF_XDP socket.
@@ -561,20 +828,36 @@ CxPlatDpRawInterfaceInitialize(
         struct XskSocketInfo *XskInfo = calloc(1, sizeof(*XskInfo));
         if (!XskInfo) {
             Status = QUIC_STATUS_OUT_OF_MEMORY;
-            free(UmemInfo->Buffer);
-            free(UmemInfo);
             goto Error;
         }
-        CxPlatLockInitialize(&XskInfo->UmemLock);
         Queue->XskInfo = XskInfo;
+
+        //
+        // Create the UMEM, unless the queues share the interface's UMEM and
+        // an earlier queue already created it.
+        //
+        struct XskUmemInfo *UmemInfo = SharedUmemInfo;
+        if (UmemInfo == NULL) {
+            Status = InitializeUmem(Xdp, RxHeadroom, TxHeadroom, XskInfo, &UmemInfo);
+            if (QUIC_FAILED(Status)) {
+                QuicTraceLogVerbose(
+                    XdpConfigureUmem,
+                    "[ xdp] Failed to configure Umem");
+                goto Error;
+            }
+            if (Xdp->Config.SharedUmem) {
+                SharedUmemInfo = UmemInfo;
+            }
+        }
+        UmemInfo->RefCount++;
         XskInfo->UmemInfo = UmemInfo;
 
         int RetryCount = 10;
         int Ret = 0;
         do {
-            Ret = xsk_socket__create(&XskInfo->Xsk, Interface->IfName,
+            Ret = xsk_socket__create_shared(&XskInfo->Xsk, Interface->IfName,
                         i, UmemInfo->Umem, &XskInfo->Rx,
-                        &XskInfo->Tx, XskCfg);
+                        &XskInfo->Tx, &XskInfo->Fq, &XskInfo->Cq, XskCfg);
             if (Ret == -EBUSY) {
                 CxPlatSleep(100);
             }
@@ -589,34 +872,43 @@ CxPlatDpRawInterfaceInitialize(
         CxPlatRundownAcquire(&Xdp->Rundown);
         SocketCreated++;
 
+        if (Xdp->PollingIdleTimeoutUs != 0) {
+            XdpSocketEnableBusyPoll(XskInfo->Xsk);
+        }
+
         if(xsk_socket__update_xskmap(XskInfo->Xsk, XskBypassMapFd)) {
             Status = QUIC_STATUS_INTERNAL_ERROR;
             goto Error;
         }
 
-        for (int i = 0; i < NUM_FRAMES; i++) {
-            XskInfo->UmemFrameAddr[i] = i * FrameSize;
-        }
-        XskInfo->UmemFrameFree = NUM_FRAMES;
-
-        // Setup fill queue for Rx
+        //
+        // Setup fill queue for Rx. Half of the UMEM's frames are left for Tx,
+        // and the sockets sharing a UMEM split the other half.
+        //
+        const uint32_t UmemSocketCount = Xdp->Config.SharedUmem ? Interface->QueueCount : 1;
+        const uint32_t FillCount =
+            CXPLAT_MIN(Xdp->Config.FillRingSize, UmemInfo->FrameCount / 2 / UmemSocketCount);
+        XskInfo->FillShare = FillCount;
         uint32_t FqIdx = 0;
-        Ret = xsk_ring_prod__reserve(&XskInfo->UmemInfo->Fq, PROD_NUM_DESCS, &FqIdx);
-        if (Ret != PROD_NUM_DESCS) {
-            return QUIC_STATUS_OUT_OF_MEMORY;
+        if (xsk_ring_prod__reserve(&XskInfo->Fq, FillCount, &FqIdx) != FillCount) {
+            Status = QUIC_STATUS_OUT_OF_MEMORY;
+            goto Error;
         }
-        for (uint32_t i = 0; i < PROD_NUM_DESCS; i ++) {
-            uint64_t Addr = XskUmemFrameAlloc(XskInfo);
+        uint32_t Filled = 0;
+        CxPlatLockAcquire(&UmemInfo->Lock);
+        for (; Filled < FillCount; Filled++) {
+            uint64_t Addr = XskUmemFrameAlloc(UmemInfo);
             if (Addr == INVALID_UMEM_FRAME) {
                 QuicTraceLogVerbose(
                     FailRxAlloc,
                     "[ xdp][rx  ] OOM for Rx");
                 break;
             }
-            *xsk_ring_prod__fill_addr(&XskInfo->UmemInfo->Fq, FqIdx++) = Addr;
+            *xsk_ring_prod__fill_addr(&XskInfo->Fq, FqIdx++) = Addr;
         }
+        CxPlatLockRelease(&UmemInfo->Lock);
 
-        xsk_ring_prod__submit(&XskInfo->UmemInfo->Fq, PROD_NUM_DESCS);
+        xsk_ring_prod__submit(&XskInfo->Fq, Filled);
     }
 
     //
@@ -824,7 +1116,8 @@ CxPlatDpRawInitialize(
                 Status = QUIC_STATUS_INTERNAL_ERROR;
                 goto Error;
             }
-            XdpSocketContextSetEvents(Queue, EPOLL_CTL_ADD, EPOLLIN);
+            XdpSocketContextSetEvents(Queue, EPOLL_CTL_ADD, XdpQueueRxEvents(Queue));
+            Queue->RxQueued = TRUE;
 
             if (!CxPlatSqeInitialize(
                     Partition->EventQ,
@@ -1018,25 +1311,27 @@ CxPlatDpRawRxFree(
     _In_opt_ const CXPLAT_RECV_DATA* PacketChain
     )
 {
-    uint32_t Count = 0;
-    struct XskSocketInfo *XskInfo = NULL;
-    if (PacketChain) {
+    struct XskUmemInfo *UmemInfo = NULL;
+    while (PacketChain) {
         const XDP_RX_PACKET* Packet =
             CXPLAT_CONTAINING_RECORD(PacketChain, XDP_RX_PACKET, RecvData);
-        XskInfo = Packet->Queue->XskInfo;
-
-        CxPlatLockAcquire(&XskInfo->UmemLock);
-        while (PacketChain) {
-            Packet =
-                CXPLAT_CONTAINING_RECORD(PacketChain, XDP_RX_PACKET, RecvData);
-            PacketChain = PacketChain->Next;
-            XskUmemFrameFree(Packet->Queue->XskInfo, Packet->Addr);
-            Count++;
+        PacketChain = PacketChain->Next;
+        if (Packet->Addr == INVALID_UMEM_FRAME) {
+            XdpRxChainFree((XDP_RX_PACKET*)Packet);
+            continue;
         }
+        if (UmemInfo != Packet->Queue->XskInfo->UmemInfo) {
+            if (UmemInfo != NULL) {
+                CxPlatLockRelease(&UmemInfo->Lock);
+            }
+            UmemInfo = Packet->Queue->XskInfo->UmemInfo;
+            CxPlatLockAcquire(&UmemInfo->Lock);
+        }
+        XskUmemFrameFree(UmemInfo, Packet->Addr);
     }
 
-    if (Count > 0) {
-        CxPlatLockRelease(&XskInfo->UmemLock);
+    if (UmemInfo != NULL) {
+        CxPlatLockRelease(&UmemInfo->Lock);
     }
 }
 
@@ -1049,10 +1344,10 @@ CxPlatDpRawTxAlloc(
     CXPLAT_DBG_ASSERT(Config->MaxPacketSize <= MAX_UDP_PAYLOAD_LENGTH);
     XDP_TX_PACKET* Packet = NULL;
     XDP_QUEUE* Queue = Config->Route->Queue;
-    struct XskSocketInfo* XskInfo = Queue->XskInfo;
-    CxPlatLockAcquire(&XskInfo->UmemLock);
-    uint64_t BaseAddr = XskUmemFrameAlloc(XskInfo);
-    CxPlatLockRelease(&XskInfo->UmemLock);
+    struct XskUmemInfo* UmemInfo = Queue->XskInfo->UmemInfo;
+    CxPlatLockAcquire(&UmemInfo->Lock);
+    uint64_t BaseAddr = XskUmemFrameAlloc(UmemInfo);
+    CxPlatLockRelease(&UmemInfo->Lock);
     if (BaseAddr == INVALID_UMEM_FRAME) {
         QuicTraceLogVerbose(
             FailTxAlloc,
@@ -1060,7 +1355,7 @@ CxPlatDpRawTxAlloc(
         goto Error;
     }
 
-    Packet = (XDP_TX_PACKET*)xsk_umem__get_data(XskInfo->UmemInfo->Buffer, BaseAddr);
+    Packet = (XDP_TX_PACKET*)xsk_umem__get_data(UmemInfo->Buffer, BaseAddr);
     if (Packet) {
         HEADER_BACKFILL HeaderBackfill = CxPlatDpRawCalculateHeaderBackFill(Config->Route); // TODO - Cache in Route?
         CXPLAT_DBG_ASSERT(Config->MaxPacketSize <= sizeof(Packet->FrameBuffer) - HeaderBackfill.AllLayer);
@@ -1093,10 +1388,22 @@ KickTx(
     )
 {
     struct XskSocketInfo* XskInfo = Queue->XskInfo;
-    if (sendto(xsk_socket__fd(XskInfo->Xsk), NULL, 0, MSG_DONTWAIT, NULL, 0) < 0) {
+    const BOOLEAN Polling = Queue->Interface->Xdp->PollingIdleTimeoutUs != 0;
+    const BOOLEAN NeedsWakeup =
+        Queue->Interface->Xdp->Config.TxAlwaysPoke ||
+        xsk_ring_prod__needs_wakeup(&XskInfo->Tx);
+    if (NeedsWakeup &&
+        sendto(xsk_socket__fd(XskInfo->Xsk), NULL, 0, MSG_DONTWAIT, NULL, 0) < 0) {
         if (errno == EAGAIN || errno == EWOULDBLOCK) {
-            if (!SendAlreadyPending) {
-                XdpSocketContextSetEvents(Queue, EPOLL_CTL_MOD, EPOLLIN | EPOLLOUT);
+            //
+            // Wait for the socket to be writable. A one shot registration was
+            // disarmed by the EPOLLOUT that brought us here, so it has to be
+            // armed again even if a send was already pending.
+            //
+            if (!SendAlreadyPending || Polling) {
+                Queue->RxQueued = TRUE;
+                XdpSocketContextSetEvents(
+                    Queue, EPOLL_CTL_MOD, XdpQueueRxEvents(Queue) | EPOLLOUT);
             }
             return;
         }
@@ -1106,22 +1413,24 @@ KickTx(
         "[ xdp][TX  ] Done sendto.");
 
     if (SendAlreadyPending) {
-        XdpSocketContextSetEvents(Queue, EPOLL_CTL_MOD, EPOLLIN);
+        Queue->RxQueued = TRUE;
+        XdpSocketContextSetEvents(Queue, EPOLL_CTL_MOD, XdpQueueRxEvents(Queue));
     }
 
     uint32_t Completed;
     uint32_t CqIdx;
     CxPlatLockAcquire(&Queue->CqLock);
-    Completed = xsk_ring_cons__peek(&XskInfo->UmemInfo->Cq, CONS_NUM_DESCS, &CqIdx);
+    Completed = xsk_ring_cons__peek(&XskInfo->Cq, Queue->Interface->Xdp->Config.CompRingSize, &CqIdx);
     if (Completed > 0) {
-        CxPlatLockAcquire(&XskInfo->UmemLock);
+        struct XskUmemInfo* UmemInfo = XskInfo->UmemInfo;
+        CxPlatLockAcquire(&UmemInfo->Lock);
         for (uint32_t i = 0; i < Completed; i++) {
-            uint64_t addr = *xsk_ring_cons__comp_addr(&XskInfo->UmemInfo->Cq, CqIdx++) - XskInfo->UmemInfo->TxHeadRoom;
-            XskUmemFrameFree(XskInfo, addr);
+            uint64_t addr = *xsk_ring_cons__comp_addr(&XskInfo->Cq, CqIdx++) - UmemInfo->TxHeadRoom;
+            XskUmemFrameFree(UmemInfo, addr);
         }
-        CxPlatLockRelease(&XskInfo->UmemLock);
+        CxPlatLockRelease(&UmemInfo->Lock);
 
-        xsk_ring_cons__release(&XskInfo->UmemInfo->Cq, Completed);
+        xsk_ring_cons__release(&XskInfo->Cq, Completed);
         QuicTraceLogVerbose(
             ReleaseCons,
             "[ xdp][cq  ] Release %d from completion queue", Completed);
@@ -1143,9 +1452,10 @@ CxPlatDpRawTxEnqueue(
     uint32_t TxIdx = 0;
     CxPlatLockAcquire(&Queue->TxLock);
     if (xsk_ring_prod__reserve(&XskInfo->Tx, 1, &TxIdx) != 1) {
-        CxPlatLockAcquire(&XskInfo->UmemLock);
-        XskUmemFrameFree(XskInfo, Packet->UmemRelativeAddr);
-        CxPlatLockRelease(&XskInfo->UmemLock);
+        CxPlatLockRelease(&Queue->TxLock);
+        CxPlatLockAcquire(&XskInfo->UmemInfo->Lock);
+        XskUmemFrameFree(XskInfo->UmemInfo, Packet->UmemRelativeAddr);
+        CxPlatLockRelease(&XskInfo->UmemInfo->Lock);
         QuicTraceLogVerbose(
             FailTxReserve,
             "[ xdp][tx  ] Failed to reserve");
@@ -1204,8 +1514,8 @@ CxPlatXdpExecute(
         return FALSE;
     }
 
-     const BOOLEAN PollingExpired =
-        CxPlatTimeDiff64(State->LastWorkTime, State->TimeNow) >= Xdp->PollingIdleTimeoutUs;
+    const uint64_t IdleUs =
+        CxPlatTimeDiff64(Partition->LastWorkTimeUs, State->TimeNow);
 
     BOOLEAN DidWork = FALSE;
     XDP_QUEUE* Queue = Partition->Queues;
@@ -1216,13 +1526,47 @@ CxPlatXdpExecute(
     }
 
     if (DidWork) {
+        if (Partition->Idle) {
+            //
+            // Track how long the partition typically sits idle between bursts
+            // (a moving average, weighting each new gap by 1/8).
+            //
+            Partition->IdleGapUs =
+                (uint32_t)((7 * (uint64_t)Partition->IdleGapUs +
+                    CXPLAT_MIN(IdleUs, UINT32_MAX)) / 8);
+            Partition->Idle = FALSE;
+        }
+        Partition->LastWorkTimeUs = State->TimeNow;
         Partition->Ec.Ready = TRUE;
         State->NoWorkCount = 0;
-    } else if (!PollingExpired) {
+        return TRUE;
+    }
+
+    Partition->Idle = TRUE;
+
+    //
+    // Keep busy polling until the partition has been idle for the polling idle
+    // timeout. If the bursts are usually further apart than that, polling for
+    // the whole timeout mostly burns CPU, so only poll long enough to catch
+    // the stragglers of the last burst.
+    //
+    uint32_t PollUs = Xdp->PollingIdleTimeoutUs;
+    if (Partition->IdleGapUs > PollUs) {
+        PollUs >>= BUSY_POLL_SHORT_SHIFT;
+    }
+
+    if (IdleUs < PollUs) {
         Partition->Ec.Ready = TRUE;
     } else {
+        //
+        // Back off into interrupt mode: wait for the sockets to be readable.
+        //
         Queue = Partition->Queues;
         while (Queue) {
+            if (!Queue->RxQueued) {
+                Queue->RxQueued = TRUE;
+                XdpSocketContextSetEvents(Queue, EPOLL_CTL_MOD, XdpQueueRxEvents(Queue));
+            }
             Queue = Queue->Next;
         }
     }
@@ -1230,6 +1574,54 @@ CxPlatXdpExecute(
     return TRUE;
 }
 
+//
+// Fills in the Rx packet (in the headroom before the frame) for the received
+// frame. Returns FALSE if the frame isn't for the stack.
+//
+static
+BOOLEAN
+CxPlatXdpRxPreparePacket(
+    _In_ const XDP_DATAPATH* Xdp,
+    _In_ XDP_QUEUE* Queue,
+    _In_ uint16_t PartitionIndex,
+    _Out_ XDP_RX_PACKET* Packet,
+    _In_reads_bytes_(Length) uint8_t* FrameBuffer,
+    _In_ uint32_t Length
+    )
+{
+    CxPlatZeroMemory(Packet, Queue->XskInfo->UmemInfo->RxHeadRoom);
+
+    Packet->Queue = Queue;
+    Packet->RouteStorage.Queue = Queue;
+    Packet->RecvData.Route = &Packet->RouteStorage;
+    Packet->RecvData.Route->DatapathType = Packet->RecvData.DatapathType = CXPLAT_DATAPATH_TYPE_RAW;
+    Packet->RecvData.PartitionIndex = PartitionIndex;
+
+    CxPlatDpRawParseEthernet(
+        (CXPLAT_DATAPATH*)Xdp,
+        &Packet->RecvData,
+        FrameBuffer,
+        (uint16_t)Length);
+    QuicTraceEvent(
+        RxConstructPacket,
+        "[ xdp][rx  ] Constructing Packet from Rx, local=%!ADDR!, remote=%!ADDR!",
+        CASTED_CLOG_BYTEARRAY(sizeof(Packet->RouteStorage.LocalAddress), &Packet->RouteStorage.LocalAddress),
+        CASTED_CLOG_BYTEARRAY(sizeof(Packet->RouteStorage.RemoteAddress), &Packet->RouteStorage.RemoteAddress));
+
+    //
+    // The route has been filled in with the packet's src/dst IP and ETH addresses, so
+    // mark it resolved. This allows stateless sends to be issued without performing
+    // a route lookup.
+    //
+    Packet->RecvData.Route->State = RouteResolved;
+
+    if (Packet->RecvData.Buffer) {
+        Packet->RecvData.Allocated = TRUE;
+        return TRUE;
+    }
+    return FALSE;
+}
+
 static
 BOOLEAN // Did work?
 CxPlatXdpRx(
@@ -1239,8 +1631,10 @@ CxPlatXdpRx(
     )
 {
     struct XskSocketInfo *XskInfo = Queue->XskInfo;
+    struct XskUmemInfo *UmemInfo = XskInfo->UmemInfo;
     uint32_t Rcvd, i;
     uint32_t Available;
+    uint32_t Filled = 0;
     uint32_t RxIdx = 0, FqIdx = 0;
     unsigned int ret;
 
@@ -1250,44 +1644,75 @@ CxPlatXdpRx(
     // Process received packets
     CXPLAT_RECV_DATA* Buffers[RX_BATCH_SIZE] = {};
     uint32_t PacketCount = 0;
+    uint64_t FreeFrames[RX_BATCH_SIZE];
+    uint32_t FreeCount = 0;
     for (i = 0; i < Rcvd; i++) {
-        uint64_t Addr = xsk_ring_cons__rx_desc(&XskInfo->Rx, RxIdx)->addr;
-        uint32_t Len = xsk_ring_cons__rx_desc(&XskInfo->Rx, RxIdx++)->len;
-        uint8_t *FrameBuffer = xsk_umem__get_data(XskInfo->UmemInfo->Buffer, Addr);
-        XDP_RX_PACKET* Packet = (XDP_RX_PACKET*)(FrameBuffer - XskInfo->UmemInfo->RxHeadRoom);
-        CxPlatZeroMemory(Packet, XskInfo->UmemInfo->RxHeadRoom);
-
-        Packet->Queue = Queue;
-        Packet->RouteStorage.Queue = Queue;
-        Packet->RecvData.Route = &Packet->RouteStorage;
-        Packet->RecvData.Route->DatapathType = Packet->RecvData.DatapathType = CXPLAT_DATAPATH_TYPE_RAW;
-        Packet->RecvData.PartitionIndex = PartitionIndex;
-
-        CxPlatDpRawParseEthernet(
-            (CXPLAT_DATAPATH*)Xdp,
-            &Packet->RecvData,
-            FrameBuffer,
-            (uint16_t)Len);
-        QuicTraceEvent(
-            RxConstructPacket,
-            "[ xdp][rx  ] Constructing Packet from Rx, local=%!ADDR!, remote=%!ADDR!",
-            CASTED_CLOG_BYTEARRAY(sizeof(Packet->RouteStorage.LocalAddress), &Packet->RouteStorage.LocalAddress),
-            CASTED_CLOG_BYTEARRAY(sizeof(Packet->RouteStorage.RemoteAddress), &Packet->RouteStorage.RemoteAddress));
+        const struct xdp_desc* Desc = xsk_ring_cons__rx_desc(&XskInfo->Rx, RxIdx++);
+        const uint64_t Addr = Desc->addr;
+        const uint32_t Len = Desc->len;
+        const uint64_t FrameAddr = Addr - (XDP_PACKET_HEADROOM + UmemInfo->RxHeadRoom);
+        uint8_t *FrameBuffer = xsk_umem__get_data(UmemInfo->Buffer, Addr);
+
+        if (Queue->RxChain == NULL && !Queue->RxChainDrop &&
+            !(Desc->options & XDP_PKT_CONTD)) {
+            //
+            // The whole frame is in a single UMEM frame.
+            //
+            XDP_RX_PACKET* Packet = (XDP_RX_PACKET*)(FrameBuffer - UmemInfo->RxHeadRoom);
+            if (CxPlatXdpRxPreparePacket(Xdp, Queue, PartitionIndex, Packet, FrameBuffer, Len)) {
+                Packet->Addr = FrameAddr;
+                Buffers[PacketCount++] = &Packet->RecvData;
+            } else {
+                FreeFrames[FreeCount++] = FrameAddr;
+            }
+            continue;
+        }
 
         //
-        // The route has been filled in with the packet's src/dst IP and ETH addresses, so
-        // mark it resolved. This allows stateless sends to be issued without performing
-        // a route lookup.
+        // Part of a multi-buffer frame. The stack needs the frame in a single
+        // buffer, so the fragments are copied out into one and their UMEM
+        // frames are returned right away. A chain may span Rx batches.
         //
-        Packet->RecvData.Route->State = RouteResolved;
-
-        if (Packet->RecvData.Buffer) {
-            Packet->Addr = Addr - (XDP_PACKET_HEADROOM + XskInfo->UmemInfo->RxHeadRoom);
-            Packet->RecvData.Allocated = TRUE;
-            Buffers[PacketCount++] = &Packet->RecvData;
-        } else {
-            XskUmemFrameFree(XskInfo, Addr - (XDP_PACKET_HEADROOM + XskInfo->UmemInfo->RxHeadRoom));
+        if (Queue->RxChain == NULL && !Queue->RxChainDrop) {
+            Queue->RxChain = XdpRxChainAlloc(Queue);
+            Queue->RxChainLength = 0;
+            Queue->RxChainDrop = Queue->RxChain == NULL;
         }
+        if (!Queue->RxChainDrop) {
+            if (Queue->RxChainLength + Len <= MAX_ETH_FRAME_SIZE) {
+                CxPlatCopyMemory(
+                    (uint8_t*)Queue->RxChain + UmemInfo->RxHeadRoom + Queue->RxChainLength,
+                    FrameBuffer,
+                    Len);
+                Queue->RxChainLength += Len;
+            } else {
+                Queue->RxChainDrop = TRUE; // Too large to be for the stack.
+            }
+        }
+        FreeFrames[FreeCount++] = FrameAddr;
+
+        if (Desc->options & XDP_PKT_CONTD) {
+            continue;
+        }
+
+        XDP_RX_PACKET* Packet = Queue->RxChain;
+        if (Packet != NULL) {
+            if (!Queue->RxChainDrop &&
+                CxPlatXdpRxPreparePacket(
+                    Xdp,
+                    Queue,
+                    PartitionIndex,
+                    Packet,
+                    (uint8_t*)Packet + UmemInfo->RxHeadRoom,
+                    Queue->RxChainLength)) {
+                Packet->Addr = INVALID_UMEM_FRAME;
+                Buffers[PacketCount++] = &Packet->RecvData;
+            } else {
+                XdpRxChainFree(Packet);
+            }
+        }
+        Queue->RxChain = NULL;
+        Queue->RxChainDrop = FALSE;
     }
 
     if (Rcvd) {
@@ -1295,33 +1720,54 @@ CxPlatXdpRx(
     }
     CxPlatLockRelease(&Queue->RxLock);
 
-    CxPlatLockAcquire(&XskInfo->UmemLock);
+    CxPlatLockAcquire(&UmemInfo->Lock);
+    for (i = 0; i < FreeCount; i++) {
+        XskUmemFrameFree(UmemInfo, FreeFrames[i]);
+    }
     CxPlatLockAcquire(&Queue->FqLock);
-    // Stuff the ring with as much frames as possible
-    Available = xsk_prod_nb_free(&XskInfo->UmemInfo->Fq, XskUmemFreeFrames(XskInfo));
+    //
+    // Top the fill ring back up to the socket's share, so that one busy queue
+    // doesn't take the frames the other sockets on a shared UMEM (and Tx)
+    // rely on.
+    //
+    const uint32_t Queued =
+        XskInfo->Fq.size - xsk_prod_nb_free(&XskInfo->Fq, XskInfo->Fq.size);
+    Available =
+        Queued < XskInfo->FillShare ?
+            (uint32_t)CXPLAT_MIN(XskInfo->FillShare - Queued, XskUmemFreeFrames(UmemInfo)) : 0;
     if (Available > 0) {
-        ret = xsk_ring_prod__reserve(&XskInfo->UmemInfo->Fq, Available, &FqIdx);
+        ret = xsk_ring_prod__reserve(&XskInfo->Fq, Available, &FqIdx);
 
         // This should not happen, but just in case
         while (ret != Available) {
-            ret = xsk_ring_prod__reserve(&XskInfo->UmemInfo->Fq, Rcvd, &FqIdx);
+            ret = xsk_ring_prod__reserve(&XskInfo->Fq, Rcvd, &FqIdx);
         }
-        for (i = 0; i < Available; i++) {
-            uint64_t addr = XskUmemFrameAlloc(XskInfo);
+        for (; Filled < Available; Filled++) {
+            uint64_t addr = XskUmemFrameAlloc(UmemInfo);
             if (addr == INVALID_UMEM_FRAME) {
                 QuicTraceLogVerbose(
                     FailRxAlloc,
                     "[ xdp][rx  ] OOM for Rx");
                 break;
             }
-            *xsk_ring_prod__fill_addr(&XskInfo->UmemInfo->Fq, FqIdx++) = addr;
+            *xsk_ring_prod__fill_addr(&XskInfo->Fq, FqIdx++) = addr;
         }
-        if (i > 0) {
-            xsk_ring_prod__submit(&XskInfo->UmemInfo->Fq, i);
+        if (Filled > 0) {
+            xsk_ring_prod__submit(&XskInfo->Fq, Filled);
         }
     }
     CxPlatLockRelease(&Queue->FqLock);
-    CxPlatLockRelease(&XskInfo->UmemLock);
+    CxPlatLockRelease(&UmemInfo->Lock);
+
+    //
+    // When busy polling, run the driver's Rx processing from here (with
+    // SO_PREFER_BUSY_POLL its interrupts stay masked while it's polled).
+    // Otherwise, only kick it if it ran out of fill buffers and asked for it.
+    //
+    if ((Rcvd == 0 && Xdp->PollingIdleTimeoutUs != 0) ||
+        xsk_ring_prod__needs_wakeup(&XskInfo->Fq)) {
+        recvfrom(xsk_socket__fd(XskInfo->Xsk), NULL, 0, MSG_DONTWAIT, NULL, NULL);
+    }
 
     if (PacketCount) {
         CxPlatDpRawRxEthernet(
@@ -1329,7 +1775,7 @@ CxPlatXdpRx(
             Buffers,
             (uint16_t)PacketCount);
     }
-    return PacketCount > 0 || i > 0;
+    return Rcvd > 0 || Filled > 0;
 }
 
 void
@@ -1358,10 +1804,22 @@ CxPlatQueueRxIoEventComplete(
         XdpQueueAsyncIoRxComplete,
         "[ xdp][%p] XDP async IO complete (RX)",
         Queue);
+    //
+    // When busy polling, the socket was registered one shot and any event
+    // disarmed it, so it needs to be armed again: by KickTx if it still has to
+    // wait for Tx, and otherwise the next time the partition backs off. When
+    // not busy polling, it stays armed.
+    //
+    if (Queue->Interface->Xdp->PollingIdleTimeoutUs != 0) {
+        Queue->RxQueued = FALSE;
+    }
     if (EPOLLOUT & Cqe->events) {
         KickTx(Queue, TRUE);
-    } else {
-        Queue->RxQueued = FALSE;
+    }
+    if (!(EPOLLOUT & Cqe->events) || (EPOLLIN & Cqe->events)) {
+        //
+        // Resume polling.
+        //
         Queue->Partition->Ec.Ready = TRUE;
     }
 }
@@ -939,6 +939,17 @@ DataPathGetSupportedFeatures(
     return Datapath->Features;
 }
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+DataPathGetBufferStatistics(
+    _In_ CXPLAT_DATAPATH* Datapath,
+    _Out_ CXPLAT_DATAPATH_BUFFER_STATISTICS* Statistics
+    )
+{
+    UNREFERENCED_PARAMETER(Datapath);
+    CxPlatZeroMemory(Statistics, sizeof(*Statistics));
+}
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 BOOLEAN
 DataPathIsPaddingPreferred(
@@ -2293,6 +2304,7 @@ CxPlatDataPathSocketReceive(
             Datagram->Data.HopLimitTTL = (uint8_t)HopLimitTTL;
             Datagram->Data.Allocated = TRUE;
             Datagram->Data.QueuedOnConnection = FALSE;
+            Datagram->Data.Coalesced = IoBlock->ReferenceCount != 0;
 
             if (IoBlock->IsCopiedBuffer) {
                 Datagram->Data.Buffer = CurrentCopiedBuffer;
@@ -3013,6 +3025,51 @@ SocketSend(
     }
 }
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+SocketIsSendBlocked(
+    _In_ CXPLAT_SOCKET* Binding,
+    _In_ const CXPLAT_ROUTE* Route
+    )
+{
+    //
+    // Sends are handed straight to WSK, so nothing waits in the datapath.
+    //
+    UNREFERENCED_PARAMETER(Binding);
+    UNREFERENCED_PARAMETER(Route);
+    return FALSE;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+SocketSendBatched(
+    _In_ CXPLAT_SOCKET* Binding,
+    _In_ const CXPLAT_ROUTE* Route,
+    _In_ CXPLAT_SEND_DATA* SendData,
+    _Inout_ CXPLAT_SEND_BATCH* Batch
+    )
+{
+    //
+    // WskSendMessages takes a single remote address, so sends for different
+    // connections can't be combined.
+    //
+    UNREFERENCED_PARAMETER(Binding);
+    UNREFERENCED_PARAMETER(Route);
+    UNREFERENCED_PARAMETER(SendData);
+    UNREFERENCED_PARAMETER(Batch);
+    return FALSE;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+SendBatchFlush(
+    _Inout_ CXPLAT_SEND_BATCH* Batch
+    )
+{
+    CXPLAT_DBG_ASSERT(Batch->Count == 0);
+    UNREFERENCED_PARAMETER(Batch);
+}
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 QUIC_STATUS
 CxPlatSocketGetTcpStatistics(
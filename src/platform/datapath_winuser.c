@@ -1031,6 +1031,17 @@ DataPathGetSupportedFeatures(
     return Datapath->Features;
 }
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+DataPathGetBufferStatistics(
+    _In_ CXPLAT_DATAPATH* Datapath,
+    _Out_ CXPLAT_DATAPATH_BUFFER_STATISTICS* Statistics
+    )
+{
+    UNREFERENCED_PARAMETER(Datapath);
+    CxPlatZeroMemory(Statistics, sizeof(*Statistics));
+}
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 BOOLEAN
 DataPathIsPaddingPreferred(
@@ -2805,7 +2816,7 @@ CxPlatSocketAllocRxIoBlock(
     if (SocketProc->Parent->UseRio) {
         IoBlock = CxPlatPoolAlloc(&DatapathProc->RioRecvPool);
     } else {
-        IoBlock = CxPlatPoolAlloc(&DatapathProc->RecvDatagramPool.Base);
+        IoBlock = CxPlatPoolExAlloc(&DatapathProc->RecvDatagramPool);
     }
 
     if (IoBlock != NULL) {
@@ -3536,6 +3547,7 @@ CxPlatDataPathUdpRecvComplete(
             Datagram->Allocated = TRUE;
             Datagram->Route->DatapathType = Datagram->DatapathType = CXPLAT_DATAPATH_TYPE_NORMAL;
             Datagram->QueuedOnConnection = FALSE;
+            Datagram->Coalesced = IoBlock->ReferenceCount != 0;
 
             RecvPayload += MessageLength;
 
@@ -3792,6 +3804,7 @@ CxPlatDataPathTcpRecvComplete(
         Data->Allocated = TRUE;
         Data->Route->DatapathType = Data->DatapathType = CXPLAT_DATAPATH_TYPE_NORMAL;
         Data->QueuedOnConnection = FALSE;
+        Data->Coalesced = FALSE;
         IoBlock->ReferenceCount++;
         IoBlock = NULL;
 
@@ -4680,6 +4693,52 @@ SocketSend(
     }
 }
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+SocketIsSendBlocked(
+    _In_ CXPLAT_SOCKET* Socket,
+    _In_ const CXPLAT_ROUTE* Route
+    )
+{
+    //
+    // Sends are handed straight to Winsock as overlapped IO, so nothing waits
+    // in the datapath.
+    //
+    UNREFERENCED_PARAMETER(Socket);
+    UNREFERENCED_PARAMETER(Route);
+    return FALSE;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+SocketSendBatched(
+    _In_ CXPLAT_SOCKET* Socket,
+    _In_ const CXPLAT_ROUTE* Route,
+    _In_ CXPLAT_SEND_DATA* SendData,
+    _Inout_ CXPLAT_SEND_BATCH* Batch
+    )
+{
+    //
+    // Winsock has no multi-message send, so there's nothing to gain from
+    // batching here.
+    //
+    UNREFERENCED_PARAMETER(Socket);
+    UNREFERENCED_PARAMETER(Route);
+    UNREFERENCED_PARAMETER(SendData);
+    UNREFERENCED_PARAMETER(Batch);
+    return FALSE;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+SendBatchFlush(
+    _Inout_ CXPLAT_SEND_BATCH* Batch
+    )
+{
+    CXPLAT_DBG_ASSERT(Batch->Count == 0);
+    UNREFERENCED_PARAMETER(Batch);
+}
+
 void
 CxPlatDataPathSocketProcessQueuedSend(
     _In_ CXPLAT_SEND_DATA* SendData
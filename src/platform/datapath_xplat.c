@@ -108,6 +108,16 @@ CxPlatDataPathGetSupportedFeatures(
     return DataPathGetSupportedFeatures(Datapath);
 }
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+CxPlatDataPathGetBufferStatistics(
+    _In_ CXPLAT_DATAPATH* Datapath,
+    _Out_ CXPLAT_DATAPATH_BUFFER_STATISTICS* Statistics
+    )
+{
+    DataPathGetBufferStatistics(Datapath, Statistics);
+}
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 BOOLEAN
 CxPlatDataPathIsPaddingPreferred(
@@ -385,6 +395,54 @@ CxPlatSocketSend(
      }
 }
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+CxPlatSocketIsSendBlocked(
+    _In_ CXPLAT_SOCKET* Socket,
+    _In_ const CXPLAT_ROUTE* Route
+    )
+{
+    //
+    // Raw sends never wait on the socket.
+    //
+    if (Route->DatapathType == CXPLAT_DATAPATH_TYPE_RAW ||
+        (Route->DatapathType == CXPLAT_DATAPATH_TYPE_UNKNOWN &&
+        Socket->RawSocketAvailable && !IS_LOOPBACK(Route->RemoteAddress))) {
+        return FALSE;
+    }
+    return SocketIsSendBlocked(Socket, Route);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+CxPlatSocketSendBatched(
+    _In_ CXPLAT_SOCKET* Socket,
+    _In_ const CXPLAT_ROUTE* Route,
+    _In_ CXPLAT_SEND_DATA* SendData,
+    _Inout_ CXPLAT_SEND_BATCH* Batch
+    )
+{
+    //
+    // Raw sends are already batched per queue, so only normal sends go in the
+    // batch.
+    //
+    if (DatapathType(SendData) != CXPLAT_DATAPATH_TYPE_NORMAL) {
+        return FALSE;
+    }
+    return SocketSendBatched(Socket, Route, SendData, Batch);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+CxPlatSendBatchFlush(
+    _Inout_ CXPLAT_SEND_BATCH* Batch
+    )
+{
+    if (Batch->Count != 0) {
+        SendBatchFlush(Batch);
+    }
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
 QuicCopyRouteInfo(
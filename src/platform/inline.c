@@ -31,16 +31,15 @@ MaxUdpPayloadSizeForFamily(
     _In_ uint16_t Mtu
     );
 
-void
-CxPlatPoolInitialize(
-    _In_ BOOLEAN IsPaged,
-    _In_ uint32_t Size,
-    _In_ uint32_t Tag,
-    _Inout_ CXPLAT_POOL* Pool
+uint16_t
+CxPlatChecksumUpdate16(
+    _In_ uint16_t Checksum,
+    _In_ uint16_t OldValue,
+    _In_ uint16_t NewValue
     );
 
-void
-CxPlatPoolUninitialize(
+CXPLAT_POOL_MAGAZINE*
+CxPlatPoolGetMagazine(
     _Inout_ CXPLAT_POOL* Pool
     );
 
@@ -54,9 +53,20 @@ CxPlatPoolFree(
     _In_ void* Memory
     );
 
-BOOLEAN
-CxPlatPoolPrune(
-    _Inout_ CXPLAT_POOL* Pool
+uint32_t
+CxPlatPoolGetLocalDepth(
+    _In_ const CXPLAT_POOL* Pool
+    );
+
+void
+CxPlatPoolSetMaxDepth(
+    _Inout_ CXPLAT_POOL* Pool,
+    _In_ uint32_t MaxDepth
+    );
+
+void*
+CxPlatPoolExAlloc(
+    _Inout_ CXPLAT_POOL_EX* Pool
     );
 
 void
@@ -176,6 +186,13 @@ InterlockedExchangePointer(
     _In_opt_ void* Value
     );
 
+void*
+InterlockedCompareExchangePointer(
+    _Inout_ _Interlocked_operand_ void* volatile *Destination,
+    _In_opt_ void* ExChange,
+    _In_opt_ void* Comperand
+    );
+
 void*
 InterlockedFetchAndClearPointer(
     _Inout_ _Interlocked_operand_ void* volatile *Target
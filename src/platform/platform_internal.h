@@ -785,6 +785,51 @@ CxPlatDpRawGetDatapathSize(
 
 typedef struct CXPLAT_DATAPATH_PARTITION CXPLAT_DATAPATH_PARTITION;
 
+//
+// The number of entries an I/O ring holds: sends waiting on a socket context
+// for the socket to become writable, or loopback receives waiting to be
+// indicated. Must be a power of 2.
+//
+#define CXPLAT_IO_RING_SIZE 256
+
+//
+// The socket is reported as blocked to the upper layers once this many sends
+// are waiting.
+//
+#define CXPLAT_SEND_RING_BLOCKED_THRESHOLD (CXPLAT_IO_RING_SIZE / 2)
+
+typedef struct CXPLAT_IO_RING_SLOT {
+
+    //
+    // Equal to the slot's position when it is free to be written, and one
+    // past the position once the entry in it has been published.
+    //
+    long volatile Sequence;
+
+    void* Entry;
+
+} CXPLAT_IO_RING_SLOT;
+
+//
+// Bounded ring of pending I/O. Any thread may push, but only the socket
+// context's partition thread pops.
+//
+typedef struct CXPLAT_IO_RING {
+
+    //
+    // The next position to be reserved by a producer.
+    //
+    long volatile Tail;
+
+    //
+    // The next position to be consumed.
+    //
+    long volatile Head;
+
+    CXPLAT_IO_RING_SLOT Slots[CXPLAT_IO_RING_SIZE];
+
+} CXPLAT_IO_RING;
+
 //
 // Socket context.
 //
@@ -821,20 +866,35 @@ typedef struct QUIC_CACHEALIGN CXPLAT_SOCKET_CONTEXT {
     CXPLAT_SQE FlushTxSqe;
 
     //
-    // The head of list containg all pending sends on this socket.
+    // The submission queue event for delivering steered receives. Only
+    // initialized if the binding uses CID steering.
     //
-    CXPLAT_LIST_ENTRY TxQueue;
+    CXPLAT_SQE SteerSqe;
 
     //
-    // Lock around the PendingSendData list.
+    // Sends waiting for the socket to become writable.
     //
-    CXPLAT_LOCK TxQueueLock;
+    CXPLAT_IO_RING TxRing;
 
     //
     // Rundown for synchronizing clean up with upcalls.
     //
     CXPLAT_RUNDOWN_REF UpcallRundown;
 
+    //
+    // Datagrams received on other socket contexts of the binding and steered
+    // to this one by their destination CID, waiting to be indicated on this
+    // context's partition.
+    //
+    CXPLAT_RECV_DATA* SteerHead;
+    CXPLAT_RECV_DATA** SteerTail;
+    uint32_t SteerCount;
+
+    //
+    // Lock around the steered receive queue.
+    //
+    CXPLAT_LOCK SteerLock;
+
     //
     // Inidicates the SQEs have been initialized.
     //
@@ -852,6 +912,35 @@ typedef struct QUIC_CACHEALIGN CXPLAT_SOCKET_CONTEXT {
 
     CXPLAT_SOCKET* AcceptSocket;
 
+    //
+    // Entry in the datapath's loopback socket table, keyed by local port.
+    // Only used when the datapath is in loopback mode, as are the fields
+    // below.
+    //
+    CXPLAT_HASHTABLE_ENTRY LoopbackEntry;
+
+    //
+    // The bound local address, in mapped V6 form, with the wildcard address
+    // always stored as ::.
+    //
+    QUIC_ADDR LoopbackAddress;
+
+    //
+    // Chains of datagrams sent to this socket by other threads, waiting to be
+    // indicated on this socket context's partition.
+    //
+    CXPLAT_IO_RING* LoopbackRxRing;
+
+    //
+    // Wakes the partition to drain LoopbackRxRing.
+    //
+    CXPLAT_SQE LoopbackRxSqe;
+
+    //
+    // Set while LoopbackEntry is in the datapath's loopback socket table.
+    //
+    BOOLEAN LoopbackInserted;
+
 } CXPLAT_SOCKET_CONTEXT;
 
 //
@@ -910,6 +999,19 @@ typedef struct CXPLAT_SOCKET {
 
     uint8_t RawSocketAvailable : 1;
 
+    //
+    // Flag indicates short header datagrams are steered (in software) to the
+    // socket context of the partition encoded in their destination CID.
+    //
+    uint8_t CidSteering : 1;
+
+    //
+    // Where the partition ID is in the destination CID, if CidSteering.
+    //
+    uint8_t CidPartitionIdOffset;
+    uint16_t CidPartitionIdMask;
+    uint16_t CidPartitionCount;
+
     //
     // Set of socket contexts one per proc.
     //
@@ -948,15 +1050,37 @@ typedef struct QUIC_CACHEALIGN CXPLAT_DATAPATH_PARTITION {
 
     //
     // Pool of receive packet contexts and buffers to be shared by all sockets
-    // on this core.
+    // on this core. Sized, and reported, by the partition's worker.
     //
-    CXPLAT_POOL RecvBlockPool;
+    CXPLAT_POOL_EX RecvBlockPool;
 
     //
     // Pool of send packet contexts and buffers to be shared by all sockets
-    // on this core.
+    // on this core. Sized, and reported, by the partition's worker.
     //
-    CXPLAT_POOL SendBlockPool;
+    CXPLAT_POOL_EX SendBlockPool;
+
+    //
+    // The NUMA node of the partition's processor.
+    //
+    uint16_t NumaNode;
+
+    //
+    // Receive blocks freed on other NUMA nodes, returned to RecvBlockPool in
+    // a batch the next time this partition allocates receive blocks.
+    //
+    struct DATAPATH_RX_IO_BLOCK* volatile RemoteFreeBlocks;
+
+    //
+    // The number of receive blocks returned through RemoteFreeBlocks.
+    //
+    int64_t RemoteFreeCount;
+
+    //
+    // The number of send contexts allocated from this partition for sockets
+    // on other NUMA nodes.
+    //
+    int64_t CrossNodeSendCount;
 
 } CXPLAT_DATAPATH_PARTITION;
 
@@ -1015,6 +1139,50 @@ typedef struct CXPLAT_DATAPATH {
 
     uint8_t ReserveAuxTcpSock : 1;
 
+    //
+    // Indicates UDP sockets are purely in-memory. Sends are copied directly
+    // into the receive path of the socket bound to the destination port,
+    // without any system calls.
+    //
+    uint8_t Loopback : 1;
+
+    //
+    // Indicates server sockets steer short header packets to the per-processor
+    // socket of the partition encoded in the destination CID.
+    //
+    uint8_t CidSteering : 1;
+
+    //
+    // Indicates the partitions span more than one NUMA node, so buffers are
+    // kept on the node of the processor using them.
+    //
+    uint8_t NumaAware : 1;
+
+    //
+    // Per-processor NUMA node, and index of the partition to allocate send
+    // contexts from (UINT16_MAX if there is no partition on the node). Only
+    // set if NumaAware.
+    //
+    uint32_t ProcCount;
+    uint16_t* ProcNumaNodes;
+    uint16_t* ProcPartitions;
+
+    //
+    // The next ephemeral port to hand out in loopback mode.
+    //
+    uint16_t LoopbackNextPort;
+
+    //
+    // Lock protecting LoopbackSockets.
+    //
+    CXPLAT_RW_LOCK LoopbackLock;
+
+    //
+    // Table of loopback socket contexts, keyed by local port. Sockets bound to
+    // different IP addresses on the same port share a key.
+    //
+    CXPLAT_HASHTABLE LoopbackSockets;
+
     //
     // The per proc datapath contexts.
     //
@@ -1091,6 +1259,13 @@ DataPathGetSupportedFeatures(
     _In_ CXPLAT_DATAPATH* Datapath
     );
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+DataPathGetBufferStatistics(
+    _In_ CXPLAT_DATAPATH* Datapath,
+    _Out_ CXPLAT_DATAPATH_BUFFER_STATISTICS* Statistics
+    );
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 BOOLEAN
 DataPathIsPaddingPreferred(
@@ -1146,6 +1321,28 @@ SocketSend(
     _In_ CXPLAT_SEND_DATA* SendData
     );
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+SocketIsSendBlocked(
+    _In_ CXPLAT_SOCKET* Socket,
+    _In_ const CXPLAT_ROUTE* Route
+    );
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+SocketSendBatched(
+    _In_ CXPLAT_SOCKET* Socket,
+    _In_ const CXPLAT_ROUTE* Route,
+    _In_ CXPLAT_SEND_DATA* SendData,
+    _Inout_ CXPLAT_SEND_BATCH* Batch
+    );
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+SendBatchFlush(
+    _Inout_ CXPLAT_SEND_BATCH* Batch
+    );
+
 CXPLAT_SOCKET*
 CxPlatRawToSocket(
     _In_ CXPLAT_SOCKET_RAW* Socket
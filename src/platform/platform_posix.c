@@ -26,6 +26,7 @@ Environment:
 #include <limits.h>
 #include <sched.h>
 #include <syslog.h>
+#include <sys/mman.h>
 #define QUIC_VERSION_ONLY 1
 #include "msquic.ver"
 #ifdef QUIC_CLOG
@@ -220,6 +221,19 @@ CxPlatSystemUnload(
 
 uint64_t CGroupGetMemoryLimit();
 
+//
+// Frees a thread's pool magazines when it exits. Only valid between
+// CxPlatInitialize and CxPlatUninitialize.
+//
+static pthread_key_t CxPlatPoolThreadKey;
+static BOOLEAN CxPlatPoolThreadKeyValid;
+
+static
+void
+CxPlatPoolThreadExit(
+    _In_ void* Context
+    );
+
 QUIC_STATUS
 CxPlatInitialize(
     void
@@ -247,6 +261,9 @@ CxPlatInitialize(
 
     CxPlatTotalMemory = CGroupGetMemoryLimit();
 
+    CxPlatPoolThreadKeyValid =
+        pthread_key_create(&CxPlatPoolThreadKey, CxPlatPoolThreadExit) == 0;
+
     QuicTraceLogInfo(
         PosixInitialized,
         "[ dso] Initialized (AvailMem = %llu bytes)",
@@ -260,6 +277,10 @@ CxPlatUninitialize(
     void
     )
 {
+    if (CxPlatPoolThreadKeyValid) {
+        CxPlatPoolThreadKeyValid = FALSE;
+        (void)pthread_key_delete(CxPlatPoolThreadKey);
+    }
     CxPlatCryptUninitialize();
     close(RandomFd);
     QuicTraceLogInfo(
@@ -295,6 +316,507 @@ CxPlatFree(
     free(Mem);
 }
 
+_Ret_maybenull_
+void*
+CxPlatLargePageAlloc(
+    _In_ size_t Size,
+    _In_ uint16_t Processor,
+    _In_ uint32_t Tag,
+    _Out_ BOOLEAN* IsLargePage
+    )
+{
+    UNREFERENCED_PARAMETER(Tag);
+    CXPLAT_DBG_ASSERT(Size % CXPLAT_LARGE_PAGE_SIZE == 0);
+
+    uint8_t* Memory = MAP_FAILED;
+    *IsLargePage = FALSE;
+
+#ifdef MAP_HUGETLB
+    Memory =
+        mmap(
+            NULL, Size, PROT_READ | PROT_WRITE,
+            MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    *IsLargePage = Memory != MAP_FAILED;
+#endif
+
+    if (Memory == MAP_FAILED) {
+        //
+        // No huge pages are reserved. Map regular pages instead, aligned so
+        // that transparent huge pages can back the region. That is only a
+        // hint the kernel may not act on, so the region isn't reported as
+        // large page backed.
+        //
+        uint8_t* Base =
+            mmap(
+                NULL, Size + CXPLAT_LARGE_PAGE_SIZE, PROT_READ | PROT_WRITE,
+                MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (Base == MAP_FAILED) {
+            return NULL;
+        }
+        Memory =
+            (uint8_t*)(((uintptr_t)Base + CXPLAT_LARGE_PAGE_SIZE - 1) &
+                ~(uintptr_t)(CXPLAT_LARGE_PAGE_SIZE - 1));
+        if (Memory != Base) {
+            munmap(Base, (size_t)(Memory - Base));
+        }
+        munmap(Memory + Size, (size_t)(Base + CXPLAT_LARGE_PAGE_SIZE - Memory));
+#ifdef MADV_HUGEPAGE
+        (void)madvise(Memory, Size, MADV_HUGEPAGE);
+#endif
+    }
+
+#ifdef CXPLAT_NUMA_AWARE
+    if (CxPlatNumaNodeCount > 1) {
+        numa_tonode_memory(Memory, Size, numa_node_of_cpu((int)Processor));
+    }
+#else
+    //
+    // Without NUMA support, placement relies on the region being first touched
+    // by the thread that requested it.
+    //
+    UNREFERENCED_PARAMETER(Processor);
+#endif
+
+    return Memory;
+}
+
+void
+CxPlatLargePageFree(
+    _In_ void* Memory,
+    _In_ size_t Size,
+    _In_ uint32_t Tag
+    )
+{
+    UNREFERENCED_PARAMETER(Tag);
+    munmap(Memory, Size);
+}
+
+//
+// Pool (magazine allocator) support. See quic_platform_posix.h.
+//
+
+__thread CXPLAT_POOL_TLS_ENTRY* CxPlatPoolTlsCache;
+__thread uint32_t CxPlatPoolTlsCacheSize;
+
+static int64_t CxPlatPoolNextId;
+
+//
+// The live pools, indexed by slot. Protected by CxPlatPoolSlotLock, which is a
+// statically initialized mutex since pools may be created before
+// CxPlatInitialize.
+//
+static pthread_mutex_t CxPlatPoolSlotLock = PTHREAD_MUTEX_INITIALIZER;
+static CXPLAT_POOL** CxPlatPoolSlots;
+static uint32_t CxPlatPoolSlotCount;
+static uint32_t CxPlatPoolSlotCapacity;
+
+//
+// Returns the pool's slot plus one, or zero if none could be allocated.
+//
+static
+uint32_t
+CxPlatPoolSlotAllocate(
+    _In_ CXPLAT_POOL* Pool
+    )
+{
+    uint32_t Slot = UINT32_MAX;
+    pthread_mutex_lock(&CxPlatPoolSlotLock);
+    for (uint32_t i = 0; i < CxPlatPoolSlotCount; ++i) {
+        if (CxPlatPoolSlots[i] == NULL) {
+            Slot = i;
+            goto Exit;
+        }
+    }
+    if (CxPlatPoolSlotCount == CxPlatPoolSlotCapacity) {
+        const uint32_t NewCapacity =
+            CxPlatPoolSlotCapacity == 0 ? 64 : CxPlatPoolSlotCapacity * 2;
+        CXPLAT_POOL** NewSlots =
+            CxPlatAlloc(NewCapacity * sizeof(CXPLAT_POOL*), QUIC_POOL_PLATFORM_GENERIC);
+        if (NewSlots == NULL) {
+            goto Exit;
+        }
+        if (CxPlatPoolSlots != NULL) {
+            CxPlatCopyMemory(
+                NewSlots, CxPlatPoolSlots, CxPlatPoolSlotCount * sizeof(CXPLAT_POOL*));
+            CxPlatFree(CxPlatPoolSlots, QUIC_POOL_PLATFORM_GENERIC);
+        }
+        CxPlatPoolSlots = NewSlots;
+        CxPlatPoolSlotCapacity = NewCapacity;
+    }
+    Slot = CxPlatPoolSlotCount++;
+Exit:
+    if (Slot != UINT32_MAX) {
+        CxPlatPoolSlots[Slot] = Pool;
+    }
+    pthread_mutex_unlock(&CxPlatPoolSlotLock);
+    return Slot + 1;
+}
+
+void
+CxPlatPoolInitialize(
+    _In_ BOOLEAN IsPaged,
+    _In_ uint32_t Size,
+    _In_ uint32_t Tag,
+    _Inout_ CXPLAT_POOL* Pool
+    )
+{
+    Pool->Id = (uint64_t)InterlockedIncrement64(&CxPlatPoolNextId); // Never zero
+    Pool->Size = Size + sizeof(CXPLAT_POOL_HEADER); // Add space for the pool header
+    Pool->Tag = Tag;
+    Pool->Depot = NULL;
+    Pool->DepotBatchCount = 0;
+    Pool->MaxDepotBatches = CXPLAT_POOL_MAX_DEPOT_BATCHES;
+    Pool->Magazines = NULL;
+    CxPlatLockInitialize(&Pool->Lock);
+    Pool->Slot = CxPlatPoolSlotAllocate(Pool); // Without a slot, the pool is bypassed
+    UNREFERENCED_PARAMETER(IsPaged);
+}
+
+static
+void
+CxPlatPoolFreeList(
+    _In_ CXPLAT_POOL* Pool,
+    _In_opt_ CXPLAT_SLIST_ENTRY* Entry
+    )
+{
+    while (Entry != NULL) {
+        CXPLAT_POOL_HEADER* Header = CXPLAT_CONTAINING_RECORD(Entry, CXPLAT_POOL_HEADER, Entry);
+        Entry = Entry->Next;
+        CXPLAT_DBG_ASSERT(Header->SpecialFlag == CXPLAT_POOL_FREE_FLAG);
+        CxPlatFree(Header, Pool->Tag);
+    }
+}
+
+void
+CxPlatPoolUninitialize(
+    _Inout_ CXPLAT_POOL* Pool
+    )
+{
+    if (Pool->Slot != 0) {
+        //
+        // Once out of the slot table, exiting threads leave the pool's
+        // magazines alone.
+        //
+        pthread_mutex_lock(&CxPlatPoolSlotLock);
+        CXPLAT_DBG_ASSERT(CxPlatPoolSlots[Pool->Slot - 1] == Pool);
+        CxPlatPoolSlots[Pool->Slot - 1] = NULL;
+        pthread_mutex_unlock(&CxPlatPoolSlotLock);
+        Pool->Slot = 0;
+    }
+
+    CXPLAT_POOL_HEADER* Batch = Pool->Depot;
+    while (Batch != NULL) {
+        CXPLAT_POOL_HEADER* NextBatch = Batch->NextBatch;
+        CxPlatPoolFreeList(Pool, &Batch->Entry);
+        Batch = NextBatch;
+    }
+    Pool->Depot = NULL;
+
+    while (Pool->Magazines != NULL) {
+        CXPLAT_POOL_MAGAZINE* Magazine = Pool->Magazines;
+        Pool->Magazines = Magazine->Next;
+        CxPlatPoolFreeList(Pool, Magazine->ListHead.Next);
+        CxPlatFree(Magazine, Pool->Tag);
+    }
+
+    //
+    // Stale per-thread cache entries can't match any future pool, since pool
+    // IDs are never reused.
+    //
+    CxPlatLockUninitialize(&Pool->Lock);
+}
+
+//
+// Thread exit callback. Frees the exiting thread's magazines for all pools
+// that are still alive, and its magazine cache.
+//
+static
+void
+CxPlatPoolThreadExit(
+    _In_ void* Context
+    )
+{
+    CXPLAT_POOL_TLS_ENTRY* Cache = (CXPLAT_POOL_TLS_ENTRY*)Context;
+    CXPLAT_DBG_ASSERT(Cache == CxPlatPoolTlsCache);
+
+    pthread_mutex_lock(&CxPlatPoolSlotLock);
+    const uint32_t Count = CXPLAT_MIN(CxPlatPoolTlsCacheSize, CxPlatPoolSlotCount);
+    for (uint32_t i = 0; i < Count; ++i) {
+        CXPLAT_POOL* Pool = CxPlatPoolSlots[i];
+        if (Pool == NULL || Pool->Id != Cache[i].PoolId) {
+            continue;
+        }
+        CXPLAT_POOL_MAGAZINE* Magazine = Cache[i].Magazine;
+        CxPlatLockAcquire(&Pool->Lock);
+        CXPLAT_POOL_MAGAZINE** Link = &Pool->Magazines;
+        while (*Link != Magazine) {
+            Link = &(*Link)->Next;
+        }
+        *Link = Magazine->Next;
+        CxPlatLockRelease(&Pool->Lock);
+        CxPlatPoolFreeList(Pool, Magazine->ListHead.Next);
+        CxPlatFree(Magazine, Pool->Tag);
+    }
+    pthread_mutex_unlock(&CxPlatPoolSlotLock);
+
+    CxPlatFree(Cache, QUIC_POOL_PLATFORM_GENERIC);
+    CxPlatPoolTlsCache = NULL;
+    CxPlatPoolTlsCacheSize = 0;
+}
+
+//
+// Grows the calling thread's magazine cache to cover the slot.
+//
+static
+BOOLEAN
+CxPlatPoolTlsCacheGrow(
+    _In_ uint32_t Slot
+    )
+{
+    uint32_t NewSize = CxPlatPoolTlsCacheSize == 0 ? 64 : CxPlatPoolTlsCacheSize;
+    while (NewSize <= Slot) {
+        NewSize *= 2;
+    }
+    CXPLAT_POOL_TLS_ENTRY* NewCache =
+        CxPlatAlloc(NewSize * sizeof(CXPLAT_POOL_TLS_ENTRY), QUIC_POOL_PLATFORM_GENERIC);
+    if (NewCache == NULL) {
+        return FALSE;
+    }
+    CxPlatZeroMemory(NewCache, NewSize * sizeof(CXPLAT_POOL_TLS_ENTRY));
+    if (CxPlatPoolTlsCache != NULL) {
+        CxPlatCopyMemory(
+            NewCache,
+            CxPlatPoolTlsCache,
+            CxPlatPoolTlsCacheSize * sizeof(CXPLAT_POOL_TLS_ENTRY));
+        CxPlatFree(CxPlatPoolTlsCache, QUIC_POOL_PLATFORM_GENERIC);
+    }
+    CxPlatPoolTlsCache = NewCache;
+    CxPlatPoolTlsCacheSize = NewSize;
+    return TRUE;
+}
+
+CXPLAT_POOL_MAGAZINE*
+CxPlatPoolGetMagazineSlow(
+    _Inout_ CXPLAT_POOL* Pool
+    )
+{
+    if (Pool->Slot == 0) {
+        return NULL;
+    }
+    const uint32_t Index = Pool->Slot - 1;
+    if (Index >= CxPlatPoolTlsCacheSize && !CxPlatPoolTlsCacheGrow(Index)) {
+        return NULL;
+    }
+
+    const uint32_t ThreadId = (uint32_t)CxPlatCurThreadID();
+
+    CxPlatLockAcquire(&Pool->Lock);
+    CXPLAT_POOL_MAGAZINE* Magazine = Pool->Magazines;
+    while (Magazine != NULL && Magazine->ThreadId != ThreadId) {
+        Magazine = Magazine->Next;
+    }
+    if (Magazine == NULL) {
+        //
+        // First use of this pool by this thread (or by a thread with the same
+        // ID that exited without the exit callback, whose magazine is simply
+        // adopted).
+        //
+        Magazine = CxPlatAlloc(sizeof(CXPLAT_POOL_MAGAZINE), Pool->Tag);
+        if (Magazine != NULL) {
+            Magazine->ListHead.Next = NULL;
+            Magazine->Depth = 0;
+            Magazine->Capacity = CXPLAT_POOL_BATCH_SIZE;
+            Magazine->ThreadId = ThreadId;
+            Magazine->DrainRequested = FALSE;
+            Magazine->Next = Pool->Magazines;
+            Pool->Magazines = Magazine;
+        }
+    }
+    CxPlatLockRelease(&Pool->Lock);
+
+    if (Magazine != NULL) {
+        CXPLAT_POOL_TLS_ENTRY* Entry = &CxPlatPoolTlsCache[Index];
+        Entry->PoolId = Pool->Id;
+        Entry->Magazine = Magazine;
+        if (CxPlatPoolThreadKeyValid) {
+            (void)pthread_setspecific(CxPlatPoolThreadKey, CxPlatPoolTlsCache);
+        }
+    }
+
+    return Magazine;
+}
+
+//
+// Pushes a chain of batches (linked via NextBatch) onto the depot.
+//
+static
+void
+CxPlatPoolDepotPush(
+    _Inout_ CXPLAT_POOL* Pool,
+    _In_ CXPLAT_POOL_HEADER* First,
+    _In_ CXPLAT_POOL_HEADER* Last
+    )
+{
+    CXPLAT_POOL_HEADER* Head;
+    do {
+        Head = Pool->Depot;
+        Last->NextBatch = Head;
+    } while (InterlockedCompareExchangePointer(
+                (void* volatile*)&Pool->Depot, First, Head) != Head);
+}
+
+void
+CxPlatPoolMagazineRefill(
+    _Inout_ CXPLAT_POOL* Pool,
+    _Inout_ CXPLAT_POOL_MAGAZINE* Magazine
+    )
+{
+    CXPLAT_DBG_ASSERT(Magazine->Depth == 0);
+
+    CXPLAT_POOL_HEADER* Batch =
+        (CXPLAT_POOL_HEADER*)InterlockedExchangePointer((void* volatile*)&Pool->Depot, NULL);
+    if (Batch == NULL) {
+        //
+        // The working set on this thread is larger than what the pool had
+        // cached. Let the magazine hold more before flushing to the depot.
+        //
+        if (Magazine->Capacity + CXPLAT_POOL_BATCH_SIZE <= CXPLAT_POOL_MAXIMUM_DEPTH &&
+            (uint32_t)Magazine->Capacity + CXPLAT_POOL_BATCH_SIZE <=
+                Pool->MaxDepotBatches * CXPLAT_POOL_BATCH_SIZE) {
+            Magazine->Capacity += CXPLAT_POOL_BATCH_SIZE;
+        }
+        return;
+    }
+    InterlockedDecrement(&Pool->DepotBatchCount);
+
+    //
+    // Keep the first batch and return the rest.
+    //
+    CXPLAT_POOL_HEADER* Rest = Batch->NextBatch;
+    if (Rest != NULL) {
+        CXPLAT_POOL_HEADER* Last = Rest;
+        while (Last->NextBatch != NULL) {
+            Last = Last->NextBatch;
+        }
+        CxPlatPoolDepotPush(Pool, Rest, Last);
+    }
+
+    Magazine->ListHead.Next = &Batch->Entry;
+    Magazine->Depth = CXPLAT_POOL_BATCH_SIZE;
+}
+
+void
+CxPlatPoolMagazineFlush(
+    _Inout_ CXPLAT_POOL* Pool,
+    _Inout_ CXPLAT_POOL_MAGAZINE* Magazine
+    )
+{
+    CXPLAT_DBG_ASSERT(Magazine->Depth >= CXPLAT_POOL_BATCH_SIZE);
+
+    //
+    // Detach a batch from the head of the magazine's list.
+    //
+    CXPLAT_SLIST_ENTRY* First = Magazine->ListHead.Next;
+    CXPLAT_SLIST_ENTRY* Last = First;
+    for (uint32_t i = 1; i < CXPLAT_POOL_BATCH_SIZE; ++i) {
+        Last = Last->Next;
+    }
+    Magazine->ListHead.Next = Last->Next;
+    Last->Next = NULL;
+    Magazine->Depth -= CXPLAT_POOL_BATCH_SIZE;
+
+    CXPLAT_POOL_HEADER* Batch = CXPLAT_CONTAINING_RECORD(First, CXPLAT_POOL_HEADER, Entry);
+    if ((uint32_t)Pool->DepotBatchCount >= Pool->MaxDepotBatches) {
+        //
+        // The pool already caches more than enough. Give the memory back and
+        // keep less on this thread from now on.
+        //
+        CxPlatPoolFreeList(Pool, First);
+        if (Magazine->Capacity > CXPLAT_POOL_BATCH_SIZE) {
+            Magazine->Capacity -= CXPLAT_POOL_BATCH_SIZE;
+        }
+    } else {
+        InterlockedIncrement(&Pool->DepotBatchCount);
+        CxPlatPoolDepotPush(Pool, Batch, Batch);
+    }
+}
+
+uint32_t
+CxPlatPoolGetDepth(
+    _In_ CXPLAT_POOL* Pool
+    )
+{
+    uint32_t Depth = (uint32_t)Pool->DepotBatchCount * CXPLAT_POOL_BATCH_SIZE;
+    CxPlatLockAcquire(&Pool->Lock);
+    for (CXPLAT_POOL_MAGAZINE* Magazine = Pool->Magazines;
+         Magazine != NULL;
+         Magazine = Magazine->Next) {
+        Depth += Magazine->Depth;
+    }
+    CxPlatLockRelease(&Pool->Lock);
+    return Depth;
+}
+
+void
+CxPlatPoolMagazineDrain(
+    _Inout_ CXPLAT_POOL* Pool,
+    _Inout_ CXPLAT_POOL_MAGAZINE* Magazine
+    )
+{
+    Magazine->DrainRequested = FALSE;
+    CxPlatPoolFreeList(Pool, Magazine->ListHead.Next);
+    Magazine->ListHead.Next = NULL;
+    Magazine->Depth = 0;
+    Magazine->Capacity = CXPLAT_POOL_BATCH_SIZE;
+}
+
+BOOLEAN
+CxPlatPoolPrune(
+    _Inout_ CXPLAT_POOL* Pool
+    )
+{
+    CXPLAT_POOL_HEADER* Batch =
+        (CXPLAT_POOL_HEADER*)InterlockedExchangePointer((void* volatile*)&Pool->Depot, NULL);
+    if (Batch == NULL) {
+        //
+        // Only a magazine's owner may touch its entries, so this thread's
+        // magazine is freed here and other threads are asked to free theirs.
+        // Depth is only read as a hint for the other magazines.
+        //
+        BOOLEAN Pruned = FALSE;
+        const uint32_t ThreadId = (uint32_t)CxPlatCurThreadID();
+        CxPlatLockAcquire(&Pool->Lock);
+        for (CXPLAT_POOL_MAGAZINE* Magazine = Pool->Magazines;
+             Magazine != NULL;
+             Magazine = Magazine->Next) {
+            if (Magazine->Depth == 0) {
+                continue;
+            }
+            if (Magazine->ThreadId == ThreadId) {
+                CxPlatPoolMagazineDrain(Pool, Magazine);
+                Pruned = TRUE;
+            } else {
+                Magazine->DrainRequested = TRUE;
+            }
+        }
+        CxPlatLockRelease(&Pool->Lock);
+        return Pruned;
+    }
+    InterlockedDecrement(&Pool->DepotBatchCount);
+
+    CXPLAT_POOL_HEADER* Rest = Batch->NextBatch;
+    if (Rest != NULL) {
+        CXPLAT_POOL_HEADER* Last = Rest;
+        while (Last->NextBatch != NULL) {
+            Last = Last->NextBatch;
+        }
+        CxPlatPoolDepotPush(Pool, Rest, Last);
+    }
+
+    CxPlatPoolFreeList(Pool, &Batch->Entry);
+    return TRUE;
+}
+
 void
 CxPlatRefInitialize(
     _Inout_ CXPLAT_REF_COUNT* RefCount
@@ -534,6 +1056,23 @@ CxPlatProcCurrentNumber(
 #endif // CX_PLATFORM_DARWIN
 }
 
+uint32_t
+CxPlatProcNumaNode(
+    _In_ uint32_t Processor
+    )
+{
+#ifdef CXPLAT_NUMA_AWARE
+    for (uint32_t n = 0; n < CxPlatNumaNodeCount; ++n) {
+        if (CPU_ISSET(Processor, &CxPlatNumaNodeMasks[n])) {
+            return n;
+        }
+    }
+#else
+    UNREFERENCED_PARAMETER(Processor);
+#endif // CXPLAT_NUMA_AWARE
+    return 0;
+}
+
 QUIC_STATUS
 CxPlatRandom(
     _In_ uint32_t BufferLen,
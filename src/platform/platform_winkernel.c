@@ -267,6 +267,37 @@ CxPlatGetAllocFailDenominator(
 
 #endif
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+_Ret_maybenull_
+void*
+CxPlatLargePageAlloc(
+    _In_ size_t Size,
+    _In_ uint16_t Processor,
+    _In_ uint32_t Tag,
+    _Out_ BOOLEAN* IsLargePage
+    )
+{
+    //
+    // Non-paged pool is already mapped with large pages where possible, and
+    // allocated from the current processor's node.
+    //
+    UNREFERENCED_PARAMETER(Processor);
+    *IsLargePage = FALSE;
+    return ExAllocatePool2(POOL_FLAG_NON_PAGED, Size, Tag);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+CxPlatLargePageFree(
+    _In_ void* Memory,
+    _In_ size_t Size,
+    _In_ uint32_t Tag
+    )
+{
+    UNREFERENCED_PARAMETER(Size);
+    ExFreePoolWithTag(Memory, Tag);
+}
+
 #ifdef QUIC_EVENTS_MANIFEST_ETW
 
 _IRQL_requires_max_(PASSIVE_LEVEL)
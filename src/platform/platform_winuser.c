@@ -492,6 +492,64 @@ CxPlatFree(
 #endif
 }
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+_Ret_maybenull_
+void*
+CxPlatLargePageAlloc(
+    _In_ size_t Size,
+    _In_ uint16_t Processor,
+    _In_ uint32_t Tag,
+    _Out_ BOOLEAN* IsLargePage
+    )
+{
+    UNREFERENCED_PARAMETER(Tag);
+    CXPLAT_DBG_ASSERT(Size % CXPLAT_LARGE_PAGE_SIZE == 0);
+
+    PROCESSOR_NUMBER ProcNumber = {
+        CxPlatProcessorInfo[Processor].Group,
+        CxPlatProcessorInfo[Processor].Index,
+        0
+    };
+    USHORT Node;
+    if (!GetNumaProcessorNodeEx(&ProcNumber, &Node)) {
+        Node = (USHORT)NUMA_NO_PREFERRED_NODE;
+    }
+
+    //
+    // Large pages require the SeLockMemoryPrivilege; fall back to regular
+    // pages without it.
+    //
+    void* Memory = NULL;
+    const SIZE_T LargePageMinimum = GetLargePageMinimum();
+    if (LargePageMinimum != 0 && Size % LargePageMinimum == 0) {
+        Memory =
+            VirtualAllocExNuma(
+                GetCurrentProcess(), NULL, Size,
+                MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE, Node);
+    }
+    *IsLargePage = Memory != NULL;
+    if (Memory == NULL) {
+        Memory =
+            VirtualAllocExNuma(
+                GetCurrentProcess(), NULL, Size,
+                MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE, Node);
+    }
+    return Memory;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+CxPlatLargePageFree(
+    _In_ void* Memory,
+    _In_ size_t Size,
+    _In_ uint32_t Tag
+    )
+{
+    UNREFERENCED_PARAMETER(Size);
+    UNREFERENCED_PARAMETER(Tag);
+    (void)VirtualFree(Memory, 0, MEM_RELEASE);
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 QUIC_STATUS
 CxPlatUtf8ToWideChar(
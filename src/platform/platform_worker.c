@@ -375,6 +375,17 @@ CxPlatWorkerPoolGetEventQ(
     return &WorkerPool->Workers[Index].EventQ;
 }
 
+uint16_t
+CxPlatWorkerPoolGetIdealProcessor(
+    _In_ CXPLAT_WORKER_POOL* WorkerPool,
+    _In_ uint16_t Index
+    )
+{
+    CXPLAT_DBG_ASSERT(WorkerPool);
+    CXPLAT_FRE_ASSERT(Index < WorkerPool->WorkerCount);
+    return WorkerPool->Workers[Index].IdealProcessor;
+}
+
 void
 CxPlatWorkerPoolAddExecutionContext(
     _In_ CXPLAT_WORKER_POOL* WorkerPool,
@@ -488,7 +499,17 @@ CxPlatRunExecutionContexts(
 }
 
 #define DYNAMIC_POOL_PROCESSING_PERIOD  1000000 // 1 second
-#define DYNAMIC_POOL_PRUNE_COUNT        8
+
+//
+// Pruning stops once a pool is down to its target depth, so this only bounds
+// the work done per period. Windows pools free a single entry per prune, and
+// a pool at the maximum depth (256) took 28 periods to get back to the
+// minimum (32) with the previous bound of 8; now it takes 4.
+//
+#define DYNAMIC_POOL_PRUNE_COUNT        64
+#define DYNAMIC_POOL_MIN_DEPTH          CXPLAT_MIN(32, CXPLAT_POOL_MAXIMUM_DEPTH)
+#define DYNAMIC_POOL_MAX_DEPTH          CXPLAT_POOL_MAXIMUM_DEPTH
+#define DYNAMIC_POOL_DECAY_SHIFT        3 // Shed 1/8th of the excess per period.
 
 void
 CxPlatAddDynamicPoolAllocator(
@@ -501,6 +522,11 @@ CxPlatAddDynamicPoolAllocator(
     CXPLAT_FRE_ASSERT(Index < WorkerPool->WorkerCount);
     CXPLAT_WORKER* Worker = &WorkerPool->Workers[Index];
     Pool->Owner = Worker;
+    Pool->AllocCount = 0;
+    Pool->MissCount = 0;
+    Pool->LastMissCount = 0;
+    Pool->PeriodStartDepth = Pool->MinDepth = CxPlatPoolGetLocalDepth(&Pool->Base);
+    Pool->TargetDepth = DYNAMIC_POOL_MIN_DEPTH;
     CxPlatLockAcquire(&Worker->ECLock);
     CxPlatListInsertTail(&Worker->DynamicPoolList, &Pool->Link);
     CxPlatLockRelease(&Worker->ECLock);
@@ -522,11 +548,38 @@ CxPlatProcessDynamicPoolAllocator(
     _Inout_ CXPLAT_POOL_EX* Pool
     )
 {
-    for (uint32_t i = 0; i < DYNAMIC_POOL_PRUNE_COUNT; ++i) {
+    //
+    // Demand over the last period is how far the pool was drawn down, plus
+    // the allocations it couldn't satisfy at all.
+    //
+    const uint64_t MissCount = Pool->MissCount;
+    uint64_t Demand = MissCount - Pool->LastMissCount;
+    Pool->LastMissCount = MissCount;
+    if (Pool->PeriodStartDepth > Pool->MinDepth) {
+        Demand += Pool->PeriodStartDepth - Pool->MinDepth;
+    }
+
+    if (Demand >= Pool->TargetDepth) {
+        Pool->TargetDepth = (uint32_t)CXPLAT_MIN(Demand, DYNAMIC_POOL_MAX_DEPTH);
+    } else {
+        Pool->TargetDepth -=
+            (uint32_t)((Pool->TargetDepth - Demand) >> DYNAMIC_POOL_DECAY_SHIFT);
+        if (Pool->TargetDepth < DYNAMIC_POOL_MIN_DEPTH) {
+            Pool->TargetDepth = DYNAMIC_POOL_MIN_DEPTH;
+        }
+    }
+    CxPlatPoolSetMaxDepth(&Pool->Base, Pool->TargetDepth);
+
+    for (uint32_t i = 0;
+         i < DYNAMIC_POOL_PRUNE_COUNT &&
+            CxPlatPoolGetDepth(&Pool->Base) > Pool->TargetDepth;
+         ++i) {
         if (!CxPlatPoolPrune((CXPLAT_POOL*)Pool)) {
-            return;
+            break;
         }
     }
+
+    Pool->PeriodStartDepth = Pool->MinDepth = CxPlatPoolGetLocalDepth(&Pool->Base);
 }
 
 void
@@ -549,6 +602,37 @@ CxPlatProcessDynamicPoolAllocators(
     CxPlatLockRelease(&Worker->ECLock);
 }
 
+uint32_t
+CxPlatWorkerPoolGetPoolStats(
+    _In_ CXPLAT_WORKER_POOL* WorkerPool,
+    _In_ uint32_t StatsCount,
+    _Out_writes_(StatsCount) QUIC_POOL_STATS* Stats
+    )
+{
+    uint32_t Count = 0;
+    for (uint32_t i = 0; i < WorkerPool->WorkerCount; ++i) {
+        CXPLAT_WORKER* Worker = &WorkerPool->Workers[i];
+        CxPlatLockAcquire(&Worker->ECLock);
+        CXPLAT_LIST_ENTRY* Entry = Worker->DynamicPoolList.Flink;
+        for (; Entry != &Worker->DynamicPoolList; Entry = Entry->Flink, ++Count) {
+            if (Count >= StatsCount) {
+                continue;
+            }
+            CXPLAT_POOL_EX* Pool = CXPLAT_CONTAINING_RECORD(Entry, CXPLAT_POOL_EX, Link);
+            QUIC_POOL_STATS* Stat = &Stats[Count];
+            Stat->PartitionIndex = i;
+            Stat->EntrySize = Pool->Base.Size;
+            Stat->Depth = CxPlatPoolGetDepth(&Pool->Base);
+            Stat->TargetDepth = Pool->TargetDepth;
+            Stat->AllocCount = Pool->AllocCount;
+            Stat->MissCount = Pool->MissCount;
+            Stat->BytesHeld = (uint64_t)Stat->Depth * Pool->Base.Size;
+        }
+        CxPlatLockRelease(&Worker->ECLock);
+    }
+    return Count;
+}
+
 void
 CxPlatProcessEvents(
     _In_ CXPLAT_WORKER* Worker,
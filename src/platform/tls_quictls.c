@@ -941,6 +941,34 @@ CxPlatTlsGetProvider(
     return QUIC_TLS_PROVIDER_OPENSSL;
 }
 
+//
+// Does the per-certificate work up front that OpenSSL would otherwise repeat
+// for every server handshake.
+//
+static
+void
+CxPlatTlsPrepareServerCertificate(
+    _In_ SSL_CTX* SSLCtx
+    )
+{
+    STACK_OF(X509)* Chain = NULL;
+    STACK_OF(X509)* ExtraCerts = NULL;
+    SSL_CTX_get0_chain_certs(SSLCtx, &Chain);
+    SSL_CTX_get_extra_chain_certs_only(SSLCtx, &ExtraCerts);
+    if (sk_X509_num(Chain) <= 0 && sk_X509_num(ExtraCerts) <= 0) {
+        //
+        // No chain was explicitly configured, so OpenSSL would build (and
+        // verify) one from the cert store on each handshake. Build it once
+        // here instead. Errors are ignored, the same as they are when built
+        // per handshake; whatever partial chain was found is still sent.
+        //
+        (void)SSL_CTX_build_cert_chain(
+            SSLCtx,
+            SSL_BUILD_CHAIN_FLAG_NO_ROOT | SSL_BUILD_CHAIN_FLAG_IGNORE_ERROR);
+        ERR_clear_error();
+    }
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 QUIC_STATUS
 CxPlatTlsSecConfigCreate(
@@ -1555,6 +1583,10 @@ CxPlatTlsSecConfigCreate(
 
         SSL_CTX_set_max_early_data(SecurityConfig->SSLCtx, UINT32_MAX);
         SSL_CTX_set_client_hello_cb(SecurityConfig->SSLCtx, CxPlatTlsClientHelloCallback, NULL);
+
+        if (CredConfig->Type != QUIC_CREDENTIAL_TYPE_NONE) {
+            CxPlatTlsPrepareServerCertificate(SecurityConfig->SSLCtx);
+        }
     }
 
     //
@@ -0,0 +1,175 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Unit test and benchmark for the Internet checksum (CxPlatChecksum).
+
+--*/
+
+#include "main.h"
+#ifdef QUIC_CLOG
+#include "ChecksumTest.cpp.clog.h"
+#endif
+
+#define CHECKSUM_TEST_MAX_LENGTH    1600
+#define CHECKSUM_TEST_MAX_OFFSET    8
+#define CHECKSUM_BENCH_BYTES        (256 * 1024 * 1024)
+
+//
+// The one's complement sum of the buffer, one 16-bit word at a time, as
+// described by RFC 1071.
+//
+static
+uint16_t
+ReferenceChecksum(
+    _In_reads_(Length) const uint8_t* Data,
+    _In_ uint32_t Length,
+    _In_ uint64_t InitialChecksum
+    )
+{
+    uint64_t Sum = InitialChecksum;
+    for (uint32_t i = 0; i < Length; i += 2) {
+        uint16_t Word = 0;
+        memcpy(&Word, Data + i, CXPLAT_MIN(2u, Length - i));
+        Sum += Word;
+    }
+    while (Sum >> 16) {
+        Sum = (Sum & 0xffff) + (Sum >> 16);
+    }
+    return (uint16_t)Sum;
+}
+
+static
+std::vector<uint8_t>
+RandomBuffer(
+    _In_ uint32_t Length
+    )
+{
+    std::vector<uint8_t> Buffer(Length);
+    CxPlatRandom(Length, Buffer.data());
+    return Buffer;
+}
+
+TEST(ChecksumTest, Ipv4Header)
+{
+    //
+    // The example IPv4 header from the Wikipedia article on the IPv4 header
+    // checksum, with a checksum of 0xb861.
+    //
+    uint8_t Header[] = {
+        0x45, 0x00, 0x00, 0x73, 0x00, 0x00, 0x40, 0x00, 0x40, 0x11,
+        0x00, 0x00, 0xc0, 0xa8, 0x00, 0x01, 0xc0, 0xa8, 0x00, 0xc7
+    };
+    const uint16_t Checksum = (uint16_t)~CxPlatChecksum(Header, sizeof(Header), 0);
+    memcpy(Header + 10, &Checksum, sizeof(Checksum));
+    ASSERT_EQ(0xb8, Header[10]);
+    ASSERT_EQ(0x61, Header[11]);
+
+    //
+    // A header with a valid checksum sums to all ones.
+    //
+    ASSERT_EQ(0xffff, CxPlatChecksum(Header, sizeof(Header), 0));
+}
+
+TEST(ChecksumTest, MatchesReference)
+{
+    auto Buffer = RandomBuffer(CHECKSUM_TEST_MAX_LENGTH + CHECKSUM_TEST_MAX_OFFSET);
+    for (uint32_t Offset = 0; Offset < CHECKSUM_TEST_MAX_OFFSET; ++Offset) {
+        for (uint32_t Length = 0; Length <= CHECKSUM_TEST_MAX_LENGTH; ++Length) {
+            uint32_t InitialChecksum;
+            CxPlatRandom(sizeof(InitialChecksum), &InitialChecksum);
+            const uint8_t* Data = Buffer.data() + Offset;
+            const uint16_t Expected = ReferenceChecksum(Data, Length, InitialChecksum);
+            ASSERT_EQ(Expected, CxPlatChecksumScalar(Data, Length, InitialChecksum))
+                << "Offset " << Offset << " Length " << Length;
+            ASSERT_EQ(Expected, CxPlatChecksum(Data, Length, InitialChecksum))
+                << "Offset " << Offset << " Length " << Length;
+        }
+    }
+}
+
+TEST(ChecksumTest, AllOnes)
+{
+    //
+    // The largest sums possible, to catch lost carries in the vector lanes.
+    //
+    std::vector<uint8_t> Buffer(UINT16_MAX, 0xff);
+    for (uint32_t Length : { 64u, 1500u, 9000u, (uint32_t)UINT16_MAX }) {
+        ASSERT_EQ(
+            ReferenceChecksum(Buffer.data(), Length, UINT32_MAX),
+            CxPlatChecksum(Buffer.data(), Length, UINT32_MAX));
+    }
+}
+
+TEST(ChecksumTest, Update16)
+{
+    auto Buffer = RandomBuffer(CHECKSUM_TEST_MAX_LENGTH);
+    uint16_t Checksum = (uint16_t)~CxPlatChecksum(Buffer.data(), (uint32_t)Buffer.size(), 0);
+
+    for (uint32_t i = 0; i < 1000; ++i) {
+        uint16_t Field;
+        CxPlatRandom(sizeof(Field), &Field);
+        const uint32_t Offset = 2 * (Field % (CHECKSUM_TEST_MAX_LENGTH / 2));
+
+        uint16_t OldValue, NewValue;
+        memcpy(&OldValue, Buffer.data() + Offset, sizeof(OldValue));
+        CxPlatRandom(sizeof(NewValue), &NewValue);
+        if (i % 10 == 0) {
+            NewValue = (uint16_t)~OldValue; // Exercise the end around carry.
+        }
+        memcpy(Buffer.data() + Offset, &NewValue, sizeof(NewValue));
+
+        Checksum = CxPlatChecksumUpdate16(Checksum, OldValue, NewValue);
+        const uint16_t Expected =
+            (uint16_t)~CxPlatChecksum(Buffer.data(), (uint32_t)Buffer.size(), 0);
+
+        //
+        // 0x0000 and 0xffff are the same value in one's complement.
+        //
+        if (Expected == 0 || Expected == 0xffff) {
+            ASSERT_TRUE(Checksum == 0 || Checksum == 0xffff);
+            Checksum = Expected;
+        } else {
+            ASSERT_EQ(Expected, Checksum);
+        }
+    }
+}
+
+//
+// Compares the throughput of the portable and the dispatched (vector)
+// checksum over typical packet sizes. Disabled by default; it's run with
+// --gtest_also_run_disabled_tests.
+//
+TEST(ChecksumTest, DISABLED_Benchmark)
+{
+    auto Buffer = RandomBuffer(UINT16_MAX);
+    uint16_t Result = 0;
+
+    for (uint32_t Length : { 64u, 256u, 1500u, 9000u, (uint32_t)UINT16_MAX }) {
+        const uint32_t Iterations = CHECKSUM_BENCH_BYTES / Length;
+
+        uint64_t Start = CxPlatTimeUs64();
+        for (uint32_t i = 0; i < Iterations; ++i) {
+            Result ^= CxPlatChecksumScalar(Buffer.data(), Length, i);
+        }
+        const uint64_t ScalarUs = CXPLAT_MAX(1, CxPlatTimeDiff64(Start, CxPlatTimeUs64()));
+
+        Start = CxPlatTimeUs64();
+        for (uint32_t i = 0; i < Iterations; ++i) {
+            Result ^= CxPlatChecksum(Buffer.data(), Length, i);
+        }
+        const uint64_t VectorUs = CXPLAT_MAX(1, CxPlatTimeDiff64(Start, CxPlatTimeUs64()));
+
+        const uint64_t Bytes = (uint64_t)Iterations * Length;
+        std::cout << Length << " bytes: scalar " << Bytes / ScalarUs << " MB/s, dispatched "
+            << Bytes / VectorUs << " MB/s" << std::endl;
+    }
+
+    //
+    // Keep the compiler from discarding the loops.
+    //
+    ASSERT_NE(0x10000u, (uint32_t)Result);
+}
@@ -105,7 +105,8 @@ struct TcpClientContext {
     CXPLAT_EVENT ConnectEvent;
     CXPLAT_EVENT DisconnectEvent;
     CXPLAT_EVENT ReceiveEvent;
-    TcpClientContext() : Connected(false), Disconnected(false), Received(false) {
+    CXPLAT_EVENT* ReceiveGate; // If set, the first receive waits on it.
+    TcpClientContext() : Connected(false), Disconnected(false), Received(false), ReceiveGate(nullptr) {
         CxPlatEventInitialize(&ConnectEvent, FALSE, FALSE);
         CxPlatEventInitialize(&DisconnectEvent, FALSE, FALSE);
         CxPlatEventInitialize(&ReceiveEvent, FALSE, FALSE);
@@ -404,6 +405,10 @@ protected:
             TcpClientContext* ClientContext = (TcpClientContext*)Context;
             ClientContext->Received = true;
             CxPlatEventSet(ClientContext->ReceiveEvent);
+            if (ClientContext->ReceiveGate != nullptr) {
+                CxPlatEventWaitForever(*ClientContext->ReceiveGate);
+                ClientContext->ReceiveGate = nullptr;
+            }
         }
         CxPlatRecvDataReturn(RecvDataChain);
     }
@@ -705,6 +710,69 @@ TEST_F(DataPathTest, Initialize)
     }
 }
 
+#if defined(__linux__) && defined(QUIC_LINUX_XDP_ENABLED)
+TEST_F(DataPathTest, XdpConfig)
+{
+    CXPLAT_XDP_CONFIG Defaults;
+    CxPlatXdpParseConfig(nullptr, &Defaults);
+    ASSERT_EQ(4096u, Defaults.FrameSize);
+    ASSERT_FALSE(Defaults.SharedUmem);
+    ASSERT_FALSE(Defaults.MultiBuffer);
+
+    char Ini[] =
+        "FrameSize=2048\n"
+        "FrameCount=4096\n"
+        "RxRingSize=1024\n"
+        "TxRingSize=512\r\n"      // CRLF line ending
+        "FillRingSize=1000\n"      // Not a power of two
+        "CompRingSize=\n"          // Empty
+        "SharedUmem=1\n"
+        "MultiBuffer=1\n"
+        "not a setting\n"
+        "Unknown=1\n"
+        "TxAlwaysPoke=1";          // No trailing newline
+    FILE* File = fmemopen(Ini, sizeof(Ini) - 1, "r");
+    ASSERT_NE(nullptr, File);
+    CXPLAT_XDP_CONFIG Config;
+    CxPlatXdpParseConfig(File, &Config);
+    fclose(File);
+    ASSERT_EQ(2048u, Config.FrameSize);
+    ASSERT_EQ(4096u, Config.FrameCount);
+    ASSERT_EQ(1024u, Config.RxRingSize);
+    ASSERT_EQ(512u, Config.TxRingSize);
+    ASSERT_EQ(Defaults.FillRingSize, Config.FillRingSize);
+    ASSERT_EQ(Defaults.CompRingSize, Config.CompRingSize);
+    ASSERT_TRUE(Config.SharedUmem);
+    ASSERT_TRUE(Config.MultiBuffer);
+    ASSERT_TRUE(Config.TxAlwaysPoke);
+    ASSERT_FALSE(Config.SkipXsum);
+
+    char BadIni[] = "FrameSize=3000\nFrameCount=0\n";
+    File = fmemopen(BadIni, sizeof(BadIni) - 1, "r");
+    ASSERT_NE(nullptr, File);
+    CxPlatXdpParseConfig(File, &Config);
+    fclose(File);
+    ASSERT_EQ(Defaults.FrameSize, Config.FrameSize);
+    ASSERT_EQ(Defaults.FrameCount, Config.FrameCount);
+}
+#endif
+
+#if defined(_WIN32) || defined(__linux__)
+TEST_F(DataPathTest, PoolStats)
+{
+    //
+    // Each partition's receive pool, at least, is a dynamic pool reported in
+    // the pool statistics.
+    //
+    CxPlatDataPath Datapath(&EmptyUdpCallbacks);
+    VERIFY_QUIC_SUCCESS(Datapath.GetInitStatus());
+    QUIC_POOL_STATS Stats[1];
+    ASSERT_GE(
+        CxPlatWorkerPoolGetPoolStats(Datapath.WorkerPool, 0, Stats),
+        CxPlatWorkerPoolGetCount(Datapath.WorkerPool));
+}
+#endif
+
 TEST_F(DataPathTest, InitializeInvalid)
 {
     ASSERT_EQ(QUIC_STATUS_INVALID_PARAMETER, CxPlatDataPathInitialize(0, nullptr, nullptr, nullptr, nullptr, nullptr));
@@ -971,6 +1039,509 @@ TEST_P(DataPathTest, UdpDataECT0)
     ASSERT_TRUE(CxPlatEventWaitWithTimeout(RecvContext.ClientCompletion, 2000));
 }
 
+struct BatchedRecvContext {
+    CXPLAT_EVENT Received;
+    long Expected {0};
+    long Count {0};
+    BatchedRecvContext() {
+        CxPlatEventInitialize(&Received, FALSE, FALSE);
+    }
+    ~BatchedRecvContext() {
+        CxPlatEventUninitialize(Received);
+    }
+};
+
+static
+void
+BatchedRecvCallback(
+    _In_ CXPLAT_SOCKET* /* Socket */,
+    _In_ void* Context,
+    _In_ CXPLAT_RECV_DATA* RecvDataChain
+    )
+{
+    BatchedRecvContext* RecvContext = (BatchedRecvContext*)Context;
+    for (CXPLAT_RECV_DATA* RecvData = RecvDataChain; RecvData != NULL; RecvData = RecvData->Next) {
+        if (InterlockedIncrement(&RecvContext->Count) == RecvContext->Expected) {
+            CxPlatEventSet(RecvContext->Received);
+        }
+    }
+    CxPlatRecvDataReturn(RecvDataChain);
+}
+
+TEST_P(DataPathTest, UdpDataBatched)
+{
+    const CXPLAT_UDP_DATAPATH_CALLBACKS BatchedCallbacks = {
+        BatchedRecvCallback,
+        EmptyUnreachableCallback,
+    };
+    CxPlatDataPath Datapath(&BatchedCallbacks);
+    VERIFY_QUIC_SUCCESS(Datapath.GetInitStatus());
+    ASSERT_NE(nullptr, Datapath.Datapath);
+
+    const uint16_t DatagramSize = 100;
+    const uint32_t DatagramsPerSend = 2;
+    const uint32_t SendCount = 5;
+    BatchedRecvContext RecvContext;
+    RecvContext.Expected = SendCount * DatagramsPerSend;
+
+    auto unspecAddress = GetNewUnspecAddr();
+    CxPlatSocket Server(Datapath, &unspecAddress.SockAddr, nullptr, &RecvContext);
+    while (Server.GetInitStatus() == QUIC_STATUS_ADDRESS_IN_USE) {
+        unspecAddress.SockAddr.Ipv4.sin_port = GetNextPort();
+        Server.CreateUdp(Datapath, &unspecAddress.SockAddr, nullptr, &RecvContext);
+    }
+    VERIFY_QUIC_SUCCESS(Server.GetInitStatus());
+
+    auto serverAddress = GetNewLocalAddr();
+    serverAddress.SockAddr.Ipv4.sin_port = Server.GetLocalAddress().Ipv4.sin_port;
+    CxPlatSocket Client(Datapath, nullptr, &serverAddress.SockAddr, &RecvContext);
+    VERIFY_QUIC_SUCCESS(Client.GetInitStatus());
+
+    //
+    // Sends that can't be batched go out right away; the rest only when the
+    // batch is flushed. Either way, every datagram must arrive.
+    //
+    CXPLAT_SEND_BATCH Batch;
+    CxPlatZeroMemory(&Batch, sizeof(Batch));
+    for (uint32_t i = 0; i < SendCount; ++i) {
+        CXPLAT_SEND_CONFIG SendConfig = { &Client.Route, DatagramSize, CXPLAT_ECN_NON_ECT, 0, CXPLAT_DSCP_CS0 };
+        auto ClientSendData = CxPlatSendDataAlloc(Client, &SendConfig);
+        ASSERT_NE(nullptr, ClientSendData);
+        for (uint32_t j = 0; j < DatagramsPerSend; ++j) {
+            auto ClientBuffer = CxPlatSendDataAllocBuffer(ClientSendData, DatagramSize);
+            ASSERT_NE(nullptr, ClientBuffer);
+            CxPlatZeroMemory(ClientBuffer->Buffer, DatagramSize);
+        }
+        if (!CxPlatSocketSendBatched(Client, &Client.Route, ClientSendData, &Batch)) {
+            Client.Send(ClientSendData);
+        }
+    }
+    CxPlatSendBatchFlush(&Batch);
+    ASSERT_EQ(0u, Batch.Count);
+
+    ASSERT_TRUE(CxPlatEventWaitWithTimeout(RecvContext.Received, 2000));
+    ASSERT_EQ(RecvContext.Expected, RecvContext.Count);
+}
+
+#ifdef __linux__
+TEST_P(DataPathTest, UdpDataLoopback)
+{
+    QUIC_EXECUTION_CONFIG Config = { QUIC_EXECUTION_CONFIG_FLAG_LOOPBACK, 0, 0, {0} };
+    UdpRecvContext RecvContext;
+    RecvContext.EcnType = CXPLAT_ECN_ECT_0;
+    CxPlatDataPath Datapath(&UdpRecvCallbacks, nullptr, 0, &Config);
+    RecvContext.TtlSupported = Datapath.IsSupported(CXPLAT_DATAPATH_FEATURE_TTL);
+    RecvContext.DscpSupported = Datapath.IsSupported(CXPLAT_DATAPATH_FEATURE_SEND_DSCP);
+    VERIFY_QUIC_SUCCESS(Datapath.GetInitStatus());
+    ASSERT_NE(nullptr, Datapath.Datapath);
+    ASSERT_TRUE(Datapath.IsSupported(CXPLAT_DATAPATH_FEATURE_SEND_SEGMENTATION));
+    ASSERT_TRUE(Datapath.IsSupported(CXPLAT_DATAPATH_FEATURE_RECV_COALESCING));
+
+    RecvContext.Dscp = RecvContext.DscpSupported ? CXPLAT_DSCP_LE : CXPLAT_DSCP_CS0;
+
+    auto unspecAddress = GetNewUnspecAddr();
+    CxPlatSocket Server(Datapath, &unspecAddress.SockAddr, nullptr, &RecvContext);
+    VERIFY_QUIC_SUCCESS(Server.GetInitStatus());
+    ASSERT_NE(nullptr, Server.Socket);
+
+    //
+    // Loopback ports are private to the datapath, so the same port can't be
+    // bound twice.
+    //
+    CxPlatSocket Duplicate(Datapath, &unspecAddress.SockAddr, nullptr, &RecvContext);
+    ASSERT_EQ(QUIC_STATUS_ADDRESS_IN_USE, Duplicate.GetInitStatus());
+
+    auto serverAddress = GetNewLocalAddr();
+    RecvContext.DestinationAddress = serverAddress.SockAddr;
+    RecvContext.DestinationAddress.Ipv4.sin_port = Server.GetLocalAddress().Ipv4.sin_port;
+    ASSERT_NE(RecvContext.DestinationAddress.Ipv4.sin_port, (uint16_t)0);
+
+    CxPlatSocket Client(Datapath, nullptr, &RecvContext.DestinationAddress, &RecvContext);
+    VERIFY_QUIC_SUCCESS(Client.GetInitStatus());
+    ASSERT_NE(nullptr, Client.Socket);
+    ASSERT_NE(Client.GetLocalAddress().Ipv4.sin_port, (uint16_t)0);
+
+    CXPLAT_SEND_CONFIG SendConfig = { &Client.Route, (uint16_t)ExpectedDataSize, CXPLAT_ECN_ECT_0, 0, (uint8_t)RecvContext.Dscp };
+    auto ClientSendData = CxPlatSendDataAlloc(Client, &SendConfig);
+    ASSERT_NE(nullptr, ClientSendData);
+    auto ClientBuffer = CxPlatSendDataAllocBuffer(ClientSendData, ExpectedDataSize);
+    ASSERT_NE(nullptr, ClientBuffer);
+    memcpy(ClientBuffer->Buffer, ExpectedData, ExpectedDataSize);
+
+    Client.Send(ClientSendData);
+    ASSERT_TRUE(CxPlatEventWaitWithTimeout(RecvContext.ClientCompletion, 2000));
+}
+
+struct CoalescedRecvContext {
+    CXPLAT_EVENT Received;
+    std::vector<CXPLAT_ROUTE*> Routes;
+    std::vector<bool> Coalesced;
+    CoalescedRecvContext() {
+        CxPlatEventInitialize(&Received, FALSE, FALSE);
+    }
+    ~CoalescedRecvContext() {
+        CxPlatEventUninitialize(Received);
+    }
+};
+
+static
+void
+CoalescedRecvCallback(
+    _In_ CXPLAT_SOCKET* /* Socket */,
+    _In_ void* Context,
+    _In_ CXPLAT_RECV_DATA* RecvDataChain
+    )
+{
+    CoalescedRecvContext* RecvContext = (CoalescedRecvContext*)Context;
+    for (CXPLAT_RECV_DATA* RecvData = RecvDataChain; RecvData != NULL; RecvData = RecvData->Next) {
+        RecvContext->Routes.push_back(RecvData->Route);
+        RecvContext->Coalesced.push_back(RecvData->Coalesced);
+    }
+    CxPlatRecvDataReturn(RecvDataChain);
+    CxPlatEventSet(RecvContext->Received);
+}
+
+TEST_P(DataPathTest, UdpDataLoopbackCoalesced)
+{
+    const CXPLAT_UDP_DATAPATH_CALLBACKS CoalescedCallbacks = {
+        CoalescedRecvCallback,
+        EmptyUnreachableCallback,
+    };
+    QUIC_EXECUTION_CONFIG Config = { QUIC_EXECUTION_CONFIG_FLAG_LOOPBACK, 0, 0, {0} };
+    CxPlatDataPath Datapath(&CoalescedCallbacks, nullptr, 0, &Config);
+    VERIFY_QUIC_SUCCESS(Datapath.GetInitStatus());
+    ASSERT_NE(nullptr, Datapath.Datapath);
+
+    CoalescedRecvContext ServerContext;
+    auto unspecAddress = GetNewUnspecAddr();
+    CxPlatSocket Server(Datapath, &unspecAddress.SockAddr, nullptr, &ServerContext);
+    VERIFY_QUIC_SUCCESS(Server.GetInitStatus());
+
+    auto serverAddress = GetNewLocalAddr();
+    serverAddress.SockAddr.Ipv4.sin_port = Server.GetLocalAddress().Ipv4.sin_port;
+    CoalescedRecvContext ClientContext;
+    CxPlatSocket Client(Datapath, nullptr, &serverAddress.SockAddr, &ClientContext);
+    VERIFY_QUIC_SUCCESS(Client.GetInitStatus());
+
+    //
+    // A segmented send is received as a train of datagrams sharing the route,
+    // with all but the first tagged as coalesced.
+    //
+    const uint16_t SegmentSize = 100;
+    const uint32_t SegmentCount = 3;
+    CXPLAT_SEND_CONFIG SendConfig = { &Client.Route, SegmentSize, CXPLAT_ECN_NON_ECT, 0, CXPLAT_DSCP_CS0 };
+    auto ClientSendData = CxPlatSendDataAlloc(Client, &SendConfig);
+    ASSERT_NE(nullptr, ClientSendData);
+    for (uint32_t i = 0; i < SegmentCount; ++i) {
+        auto ClientBuffer = CxPlatSendDataAllocBuffer(ClientSendData, SegmentSize);
+        ASSERT_NE(nullptr, ClientBuffer);
+        CxPlatZeroMemory(ClientBuffer->Buffer, SegmentSize);
+    }
+
+    Client.Send(ClientSendData);
+    ASSERT_TRUE(CxPlatEventWaitWithTimeout(ServerContext.Received, 2000));
+    ASSERT_EQ(SegmentCount, ServerContext.Coalesced.size());
+    for (uint32_t i = 0; i < SegmentCount; ++i) {
+        ASSERT_EQ(i != 0, ServerContext.Coalesced[i]);
+        ASSERT_EQ(ServerContext.Routes[0], ServerContext.Routes[i]);
+    }
+}
+
+TEST_P(DataPathTest, UdpDataLoopbackRemoteFree)
+{
+    //
+    // Loopback allocates the receive buffers from the sender's partition and
+    // the receiver frees them, so with the hook every buffer is a remote free,
+    // returned to its partition by the sender's next allocation.
+    //
+    struct ForceRemoteFrees {
+        ForceRemoteFrees() { CxPlatDataPathTestHooks.ForceRemoteFrees = TRUE; }
+        ~ForceRemoteFrees() { CxPlatDataPathTestHooks.ForceRemoteFrees = FALSE; }
+    } Hook;
+
+    const CXPLAT_UDP_DATAPATH_CALLBACKS CoalescedCallbacks = {
+        CoalescedRecvCallback,
+        EmptyUnreachableCallback,
+    };
+    QUIC_EXECUTION_CONFIG Config = { QUIC_EXECUTION_CONFIG_FLAG_LOOPBACK, 0, 0, {0} };
+    CxPlatDataPath Datapath(&CoalescedCallbacks, nullptr, 0, &Config);
+    VERIFY_QUIC_SUCCESS(Datapath.GetInitStatus());
+    ASSERT_NE(nullptr, Datapath.Datapath);
+
+    CoalescedRecvContext ServerContext;
+    auto unspecAddress = GetNewUnspecAddr();
+    CxPlatSocket Server(Datapath, &unspecAddress.SockAddr, nullptr, &ServerContext);
+    VERIFY_QUIC_SUCCESS(Server.GetInitStatus());
+
+    auto serverAddress = GetNewLocalAddr();
+    serverAddress.SockAddr.Ipv4.sin_port = Server.GetLocalAddress().Ipv4.sin_port;
+    CoalescedRecvContext ClientContext;
+    CxPlatSocket Client(Datapath, nullptr, &serverAddress.SockAddr, &ClientContext);
+    VERIFY_QUIC_SUCCESS(Client.GetInitStatus());
+
+    const uint32_t SendCount = 3;
+    for (uint32_t i = 0; i < SendCount; ++i) {
+        CXPLAT_SEND_CONFIG SendConfig = { &Client.Route, 0, CXPLAT_ECN_NON_ECT, 0, CXPLAT_DSCP_CS0 };
+        auto ClientSendData = CxPlatSendDataAlloc(Client, &SendConfig);
+        ASSERT_NE(nullptr, ClientSendData);
+        auto ClientBuffer = CxPlatSendDataAllocBuffer(ClientSendData, 100);
+        ASSERT_NE(nullptr, ClientBuffer);
+        CxPlatZeroMemory(ClientBuffer->Buffer, 100);
+
+        Client.Send(ClientSendData);
+        ASSERT_TRUE(CxPlatEventWaitWithTimeout(ServerContext.Received, 2000));
+    }
+    ASSERT_EQ(SendCount, ServerContext.Routes.size());
+
+    CXPLAT_DATAPATH_BUFFER_STATISTICS Stats;
+    CxPlatDataPathGetBufferStatistics(Datapath, &Stats);
+    ASSERT_EQ(SendCount - 1, Stats.RemoteFrees);
+}
+
+struct LoopbackAddressRecvContext {
+    CXPLAT_EVENT Received;
+    CXPLAT_THREAD_ID ThreadId {0};
+    uint32_t Count {0};
+    LoopbackAddressRecvContext() {
+        CxPlatEventInitialize(&Received, FALSE, FALSE);
+    }
+    ~LoopbackAddressRecvContext() {
+        CxPlatEventUninitialize(Received);
+    }
+};
+
+static
+void
+LoopbackAddressRecvCallback(
+    _In_ CXPLAT_SOCKET* /* Socket */,
+    _In_ void* Context,
+    _In_ CXPLAT_RECV_DATA* RecvDataChain
+    )
+{
+    LoopbackAddressRecvContext* RecvContext = (LoopbackAddressRecvContext*)Context;
+    RecvContext->ThreadId = CxPlatCurThreadID();
+    for (CXPLAT_RECV_DATA* RecvData = RecvDataChain; RecvData != NULL; RecvData = RecvData->Next) {
+        RecvContext->Count++;
+    }
+    CxPlatRecvDataReturn(RecvDataChain);
+    CxPlatEventSet(RecvContext->Received);
+}
+
+TEST_P(DataPathTest, UdpDataLoopbackAddresses)
+{
+    const CXPLAT_UDP_DATAPATH_CALLBACKS LoopbackCallbacks = {
+        LoopbackAddressRecvCallback,
+        EmptyUnreachableCallback,
+    };
+    QUIC_EXECUTION_CONFIG Config = { QUIC_EXECUTION_CONFIG_FLAG_LOOPBACK, 0, 0, {0} };
+    CxPlatDataPath Datapath(&LoopbackCallbacks, nullptr, 0, &Config);
+    VERIFY_QUIC_SUCCESS(Datapath.GetInitStatus());
+    ASSERT_NE(nullptr, Datapath.Datapath);
+
+    //
+    // Sockets bound to different IP addresses can share a port, but not with
+    // the wildcard address.
+    //
+    auto firstAddress = GetNewLocalAddr();
+    auto secondAddress = firstAddress;
+    if (GetParam() == 4) {
+        firstAddress.SockAddr.Ipv4.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        secondAddress.SockAddr.Ipv4.sin_addr.s_addr = htonl(INADDR_LOOPBACK + 1);
+    } else {
+        firstAddress.SockAddr.Ipv6.sin6_addr = in6addr_loopback;
+        secondAddress.SockAddr.Ipv6.sin6_addr = in6addr_loopback;
+        secondAddress.SockAddr.Ipv6.sin6_addr.s6_addr[15] = 2;
+    }
+
+    LoopbackAddressRecvContext FirstContext;
+    CxPlatSocket First(Datapath, &firstAddress.SockAddr, nullptr, &FirstContext);
+    VERIFY_QUIC_SUCCESS(First.GetInitStatus());
+
+    LoopbackAddressRecvContext SecondContext;
+    CxPlatSocket Second(Datapath, &secondAddress.SockAddr, nullptr, &SecondContext);
+    VERIFY_QUIC_SUCCESS(Second.GetInitStatus());
+
+    CxPlatSocket Duplicate(Datapath, &secondAddress.SockAddr, nullptr, &SecondContext);
+    ASSERT_EQ(QUIC_STATUS_ADDRESS_IN_USE, Duplicate.GetInitStatus());
+
+    auto unspecAddress = GetNewUnspecAddr();
+    unspecAddress.SockAddr.Ipv4.sin_port = firstAddress.SockAddr.Ipv4.sin_port;
+    CxPlatSocket WildCard(Datapath, &unspecAddress.SockAddr, nullptr, &SecondContext);
+    ASSERT_EQ(QUIC_STATUS_ADDRESS_IN_USE, WildCard.GetInitStatus());
+
+    //
+    // Only the socket bound to the destination address receives the datagram,
+    // and it is indicated on that socket's partition rather than the sender's
+    // thread.
+    //
+    LoopbackAddressRecvContext ClientContext;
+    CxPlatSocket Client(Datapath, nullptr, &secondAddress.SockAddr, &ClientContext);
+    VERIFY_QUIC_SUCCESS(Client.GetInitStatus());
+
+    CXPLAT_SEND_CONFIG SendConfig = { &Client.Route, 100, CXPLAT_ECN_NON_ECT, 0, CXPLAT_DSCP_CS0 };
+    auto ClientSendData = CxPlatSendDataAlloc(Client, &SendConfig);
+    ASSERT_NE(nullptr, ClientSendData);
+    auto ClientBuffer = CxPlatSendDataAllocBuffer(ClientSendData, 100);
+    ASSERT_NE(nullptr, ClientBuffer);
+    CxPlatZeroMemory(ClientBuffer->Buffer, 100);
+
+    Client.Send(ClientSendData);
+    ASSERT_TRUE(CxPlatEventWaitWithTimeout(SecondContext.Received, 2000));
+    ASSERT_EQ(1u, SecondContext.Count);
+    ASSERT_NE(CxPlatCurThreadID(), SecondContext.ThreadId);
+    ASSERT_EQ(0u, FirstContext.Count);
+}
+
+struct CidSteeringRecvContext {
+    CXPLAT_EVENT Received;
+    uint16_t PartitionIndex {UINT16_MAX};
+    CidSteeringRecvContext() {
+        CxPlatEventInitialize(&Received, FALSE, FALSE);
+    }
+    ~CidSteeringRecvContext() {
+        CxPlatEventUninitialize(Received);
+    }
+};
+
+static
+void
+CidSteeringRecvCallback(
+    _In_ CXPLAT_SOCKET* /* Socket */,
+    _In_ void* Context,
+    _In_ CXPLAT_RECV_DATA* RecvDataChain
+    )
+{
+    CidSteeringRecvContext* RecvContext = (CidSteeringRecvContext*)Context;
+    RecvContext->PartitionIndex = RecvDataChain->PartitionIndex;
+    CxPlatRecvDataReturn(RecvDataChain);
+    CxPlatEventSet(RecvContext->Received);
+}
+
+TEST_P(DataPathTest, UdpCidSteering)
+{
+    const CXPLAT_UDP_DATAPATH_CALLBACKS CidSteeringCallbacks = {
+        CidSteeringRecvCallback,
+        EmptyUnreachableCallback,
+    };
+    QUIC_EXECUTION_CONFIG Config = { QUIC_EXECUTION_CONFIG_FLAG_CID_STEERING, 0, 0, {0} };
+    CxPlatDataPath Datapath(&CidSteeringCallbacks, nullptr, 0, &Config);
+    VERIFY_QUIC_SUCCESS(Datapath.GetInitStatus());
+    ASSERT_NE(nullptr, Datapath.Datapath);
+    const uint16_t PartitionCount = (uint16_t)CxPlatWorkerPoolGetCount(Datapath.WorkerPool);
+    if (PartitionCount < 2 || UseDuoNic) {
+        std::cout << "SKIP: CID Steering Needs Per-Processor Sockets" << std::endl;
+        return;
+    }
+
+    //
+    // The partition ID is the first two bytes of the CID, right after the
+    // short header's first byte.
+    //
+    CidSteeringRecvContext ServerContext;
+    auto unspecAddress = GetNewUnspecAddr();
+    CXPLAT_UDP_CONFIG UdpConfig = {0};
+    UdpConfig.LocalAddress = &unspecAddress.SockAddr;
+    UdpConfig.CallbackContext = &ServerContext;
+    UdpConfig.CidPartitionIdOffset = 0;
+    UdpConfig.CidPartitionIdMask = 0xFFFF;
+    UdpConfig.CidPartitionCount = PartitionCount;
+    CxPlatSocket Server;
+    Server.InitStatus = CxPlatSocketCreateUdp(Datapath, &UdpConfig, &Server.Socket);
+    while (Server.GetInitStatus() == QUIC_STATUS_ADDRESS_IN_USE) {
+        unspecAddress.SockAddr.Ipv4.sin_port = GetNextPort();
+        Server.InitStatus = CxPlatSocketCreateUdp(Datapath, &UdpConfig, &Server.Socket);
+    }
+    VERIFY_QUIC_SUCCESS(Server.GetInitStatus());
+
+    auto serverAddress = GetNewLocalAddr();
+    serverAddress.SockAddr.Ipv4.sin_port = unspecAddress.SockAddr.Ipv4.sin_port;
+    CidSteeringRecvContext ClientContext;
+    CxPlatSocket Client(Datapath, nullptr, &serverAddress.SockAddr, &ClientContext);
+    VERIFY_QUIC_SUCCESS(Client.GetInitStatus());
+
+    for (uint16_t i = 0; i < 2 * PartitionCount; ++i) {
+        uint8_t Packet[32] = {0};
+        Packet[0] = 0x40; // Short header
+        CxPlatCopyMemory(Packet + 1, &i, sizeof(i));
+
+        CXPLAT_SEND_CONFIG SendConfig = { &Client.Route, 0, CXPLAT_ECN_NON_ECT, 0, CXPLAT_DSCP_CS0 };
+        auto ClientSendData = CxPlatSendDataAlloc(Client, &SendConfig);
+        ASSERT_NE(nullptr, ClientSendData);
+        auto ClientBuffer = CxPlatSendDataAllocBuffer(ClientSendData, sizeof(Packet));
+        ASSERT_NE(nullptr, ClientBuffer);
+        memcpy(ClientBuffer->Buffer, Packet, sizeof(Packet));
+
+        Client.Send(ClientSendData);
+        ASSERT_TRUE(CxPlatEventWaitWithTimeout(ServerContext.Received, 2000));
+        ASSERT_EQ(i % PartitionCount, ServerContext.PartitionIndex);
+    }
+}
+TEST_P(DataPathTest, UdpCidSteeringSoftware)
+{
+    //
+    // Without the BPF program, SO_REUSEPORT spreads the datagrams over the
+    // sockets by hash, so the receive path has to steer them.
+    //
+    struct SkipCidSteeringProgram {
+        SkipCidSteeringProgram() { CxPlatDataPathTestHooks.SkipCidSteeringProgram = TRUE; }
+        ~SkipCidSteeringProgram() { CxPlatDataPathTestHooks.SkipCidSteeringProgram = FALSE; }
+    } Hook;
+
+    const CXPLAT_UDP_DATAPATH_CALLBACKS CidSteeringCallbacks = {
+        CidSteeringRecvCallback,
+        EmptyUnreachableCallback,
+    };
+    QUIC_EXECUTION_CONFIG Config = { QUIC_EXECUTION_CONFIG_FLAG_CID_STEERING, 0, 0, {0} };
+    CxPlatDataPath Datapath(&CidSteeringCallbacks, nullptr, 0, &Config);
+    VERIFY_QUIC_SUCCESS(Datapath.GetInitStatus());
+    ASSERT_NE(nullptr, Datapath.Datapath);
+    const uint16_t PartitionCount = (uint16_t)CxPlatWorkerPoolGetCount(Datapath.WorkerPool);
+    if (PartitionCount < 2 || UseDuoNic) {
+        std::cout << "SKIP: CID Steering Needs Per-Processor Sockets" << std::endl;
+        return;
+    }
+
+    CidSteeringRecvContext ServerContext;
+    auto unspecAddress = GetNewUnspecAddr();
+    CXPLAT_UDP_CONFIG UdpConfig = {0};
+    UdpConfig.LocalAddress = &unspecAddress.SockAddr;
+    UdpConfig.CallbackContext = &ServerContext;
+    UdpConfig.CidPartitionIdOffset = 0;
+    UdpConfig.CidPartitionIdMask = 0xFFFF;
+    UdpConfig.CidPartitionCount = PartitionCount;
+    CxPlatSocket Server;
+    Server.InitStatus = CxPlatSocketCreateUdp(Datapath, &UdpConfig, &Server.Socket);
+    while (Server.GetInitStatus() == QUIC_STATUS_ADDRESS_IN_USE) {
+        unspecAddress.SockAddr.Ipv4.sin_port = GetNextPort();
+        Server.InitStatus = CxPlatSocketCreateUdp(Datapath, &UdpConfig, &Server.Socket);
+    }
+    VERIFY_QUIC_SUCCESS(Server.GetInitStatus());
+
+    auto serverAddress = GetNewLocalAddr();
+    serverAddress.SockAddr.Ipv4.sin_port = unspecAddress.SockAddr.Ipv4.sin_port;
+    CidSteeringRecvContext ClientContext;
+    CxPlatSocket Client(Datapath, nullptr, &serverAddress.SockAddr, &ClientContext);
+    VERIFY_QUIC_SUCCESS(Client.GetInitStatus());
+
+    for (uint16_t i = 0; i < 2 * PartitionCount; ++i) {
+        uint8_t Packet[32] = {0};
+        Packet[0] = 0x40; // Short header
+        CxPlatCopyMemory(Packet + 1, &i, sizeof(i));
+
+        CXPLAT_SEND_CONFIG SendConfig = { &Client.Route, 0, CXPLAT_ECN_NON_ECT, 0, CXPLAT_DSCP_CS0 };
+        auto ClientSendData = CxPlatSendDataAlloc(Client, &SendConfig);
+        ASSERT_NE(nullptr, ClientSendData);
+        auto ClientBuffer = CxPlatSendDataAllocBuffer(ClientSendData, sizeof(Packet));
+        ASSERT_NE(nullptr, ClientBuffer);
+        memcpy(ClientBuffer->Buffer, Packet, sizeof(Packet));
+
+        Client.Send(ClientSendData);
+        ASSERT_TRUE(CxPlatEventWaitWithTimeout(ServerContext.Received, 2000));
+        ASSERT_EQ(i % PartitionCount, ServerContext.PartitionIndex);
+    }
+}
+#endif // __linux__
+
 TEST_P(DataPathTest, UdpShareClientSocket)
 {
     UdpRecvContext RecvContext;
@@ -1296,4 +1867,85 @@ TEST_P(DataPathTest, TcpDataServer)
     ASSERT_TRUE(CxPlatEventWaitWithTimeout(ClientContext.ReceiveEvent, 500));
 }
 
+TEST_P(DataPathTest, TcpSendBackpressure)
+{
+    CxPlatDataPath Datapath(nullptr, &TcpRecvCallbacks);
+    if (!Datapath.IsSupported(CXPLAT_DATAPATH_FEATURE_TCP)) {
+        GTEST_SKIP_("TCP is not supported");
+    }
+    VERIFY_QUIC_SUCCESS(Datapath.GetInitStatus());
+    ASSERT_NE(nullptr, Datapath.Datapath);
+
+    //
+    // Hold up the server's first receive. That stalls the datapath thread, so
+    // the server stops reading and the client's sends back up behind a full
+    // socket.
+    //
+    CXPLAT_EVENT ReceiveGate;
+    CxPlatEventInitialize(&ReceiveGate, TRUE, FALSE);
+    TcpListenerContext ListenerContext;
+    ListenerContext.ServerContext.ReceiveGate = &ReceiveGate;
+
+    auto serverAddress = GetNewLocalAddr();
+    CxPlatSocket Listener; Listener.CreateTcpListener(Datapath, &serverAddress.SockAddr, &ListenerContext);
+    while (Listener.GetInitStatus() == QUIC_STATUS_ADDRESS_IN_USE) {
+        serverAddress.SockAddr.Ipv4.sin_port = GetNextPort();
+        Listener.CreateTcpListener(Datapath, &serverAddress.SockAddr, &ListenerContext);
+    }
+    VERIFY_QUIC_SUCCESS(Listener.GetInitStatus());
+    ASSERT_NE(nullptr, Listener.Socket);
+    serverAddress.SockAddr = Listener.GetLocalAddress();
+    ASSERT_NE(serverAddress.SockAddr.Ipv4.sin_port, (uint16_t)0);
+
+    TcpClientContext ClientContext;
+    CxPlatSocket Client; Client.CreateTcp(Datapath, nullptr, &serverAddress.SockAddr, &ClientContext);
+    VERIFY_QUIC_SUCCESS(Client.GetInitStatus());
+    ASSERT_NE(nullptr, Client.Socket);
+
+    ASSERT_TRUE(CxPlatEventWaitWithTimeout(ClientContext.ConnectEvent, 500));
+    ASSERT_TRUE(CxPlatEventWaitWithTimeout(ListenerContext.AcceptEvent, 500));
+    ASSERT_NE(nullptr, ListenerContext.Server);
+
+    //
+    // N.B. Nothing may fail out of this loop before the gate is released, or
+    // the datapath thread never returns from the receive.
+    //
+    bool Blocked = false;
+    bool Received = true;
+    for (uint32_t i = 0; i < 100000 && !Blocked && Received; ++i) {
+        CXPLAT_SEND_CONFIG SendConfig = { &Client.Route, 0, CXPLAT_ECN_NON_ECT, 0, CXPLAT_DSCP_CS0 };
+        auto SendData = CxPlatSendDataAlloc(Client, &SendConfig);
+        if (SendData == nullptr) {
+            break;
+        }
+        auto SendBuffer = CxPlatSendDataAllocBuffer(SendData, ExpectedDataSize);
+        if (SendBuffer == nullptr) {
+            CxPlatSendDataFree(SendData);
+            break;
+        }
+        memcpy(SendBuffer->Buffer, ExpectedData, ExpectedDataSize);
+        Client.Send(SendData);
+        if (i == 0) {
+            Received = CxPlatEventWaitWithTimeout(ListenerContext.ServerContext.ReceiveEvent, 500);
+        }
+        Blocked = CxPlatSocketIsSendBlocked(Client, &Client.Route);
+    }
+    CxPlatEventSet(ReceiveGate);
+    ASSERT_TRUE(Received);
+    ASSERT_TRUE(Blocked);
+
+    //
+    // Once the server reads again, the queued sends drain and the socket is
+    // no longer reported as blocked.
+    //
+    for (uint32_t i = 0; i < 100 && Blocked; ++i) {
+        CxPlatSleep(10);
+        Blocked = CxPlatSocketIsSendBlocked(Client, &Client.Route);
+    }
+    ASSERT_FALSE(Blocked);
+
+    ListenerContext.DeleteSocket();
+    CxPlatEventUninitialize(ReceiveGate);
+}
+
 INSTANTIATE_TEST_SUITE_P(DataPathTest, DataPathTest, ::testing::Values(4, 6), testing::PrintToStringParamName());
@@ -0,0 +1,377 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Unit test and benchmark for the fixed size allocation pool (CXPLAT_POOL).
+
+--*/
+
+#define QUIC_API_ENABLE_PREVIEW_FEATURES 1
+
+#include "main.h"
+#include "msquic.h"
+#ifdef QUIC_CLOG
+#include "PoolTest.cpp.clog.h"
+#endif
+
+#define POOL_TEST_ENTRY_SIZE    256
+#define POOL_TEST_BATCH         1024
+#define POOL_TEST_ROUNDS        1000
+
+struct PoolScope {
+    CXPLAT_POOL Pool;
+    PoolScope(uint32_t Size = POOL_TEST_ENTRY_SIZE) {
+        CxPlatPoolInitialize(FALSE, Size, QUIC_POOL_TEST, &Pool);
+    }
+    ~PoolScope() {
+        CxPlatPoolUninitialize(&Pool);
+    }
+    operator CXPLAT_POOL* () { return &Pool; }
+};
+
+//
+// Hands batches of allocations from a producer thread to a consumer thread,
+// which frees them.
+//
+struct PoolHandoff {
+    CXPLAT_POOL* Pool;
+    void* Entries[POOL_TEST_BATCH];
+    uint32_t Rounds;
+    BOOLEAN Failed;
+    CXPLAT_EVENT Ready;
+    CXPLAT_EVENT Done;
+
+    PoolHandoff(CXPLAT_POOL* Pool, uint32_t Rounds) : Pool(Pool), Rounds(Rounds), Failed(FALSE) {
+        CxPlatEventInitialize(&Ready, FALSE, FALSE);
+        CxPlatEventInitialize(&Done, FALSE, FALSE);
+    }
+    ~PoolHandoff() {
+        CxPlatEventUninitialize(Ready);
+        CxPlatEventUninitialize(Done);
+    }
+
+    static CXPLAT_THREAD_CALLBACK(ProducerCallback, Context) {
+        auto Handoff = (PoolHandoff*)Context;
+        for (uint32_t i = 0; i < Handoff->Rounds; ++i) {
+            for (uint32_t j = 0; j < POOL_TEST_BATCH; ++j) {
+                Handoff->Entries[j] = CxPlatPoolAlloc(Handoff->Pool);
+                if (Handoff->Entries[j] == nullptr) {
+                    Handoff->Failed = TRUE;
+                } else {
+                    memset(Handoff->Entries[j], (uint8_t)j, POOL_TEST_ENTRY_SIZE);
+                }
+            }
+            CxPlatEventSet(Handoff->Ready);
+            CxPlatEventWaitForever(Handoff->Done);
+        }
+        CXPLAT_THREAD_RETURN(0);
+    }
+
+    void Consume() {
+        for (uint32_t i = 0; i < Rounds; ++i) {
+            CxPlatEventWaitForever(Ready);
+            for (uint32_t j = 0; j < POOL_TEST_BATCH; ++j) {
+                if (Entries[j] != nullptr) {
+                    CxPlatPoolFree(Entries[j]);
+                }
+            }
+            CxPlatEventSet(Done);
+        }
+    }
+};
+
+static
+void
+RunCrossThread(
+    _In_ CXPLAT_POOL* Pool,
+    _In_ uint32_t Rounds
+    )
+{
+    PoolHandoff Handoff(Pool, Rounds);
+    CXPLAT_THREAD_CONFIG Config = { 0, 0, "PoolProducer", PoolHandoff::ProducerCallback, &Handoff };
+    CXPLAT_THREAD Thread;
+    ASSERT_TRUE(QUIC_SUCCEEDED(CxPlatThreadCreate(&Config, &Thread)));
+    Handoff.Consume();
+    CxPlatThreadWait(&Thread);
+    CxPlatThreadDelete(&Thread);
+    ASSERT_FALSE(Handoff.Failed);
+}
+
+static
+void
+PrintRate(
+    _In_z_ const char* Name,
+    _In_ uint64_t Count,
+    _In_ uint64_t ElapsedUs
+    )
+{
+    if (ElapsedUs == 0) {
+        ElapsedUs = 1;
+    }
+    std::cout << Name << ": " << (Count * 1000000ull / ElapsedUs) << " allocs/sec" << std::endl;
+}
+
+TEST(PoolTest, AllocFree)
+{
+    PoolScope Pool;
+    void* Entries[POOL_TEST_BATCH];
+    for (uint32_t i = 0; i < POOL_TEST_BATCH; ++i) {
+        Entries[i] = CxPlatPoolAlloc(Pool);
+        ASSERT_NE(nullptr, Entries[i]);
+        memset(Entries[i], 0xCC, POOL_TEST_ENTRY_SIZE);
+    }
+    for (uint32_t i = 0; i < POOL_TEST_BATCH; ++i) {
+        CxPlatPoolFree(Entries[i]);
+    }
+
+    //
+    // Freed entries are reused.
+    //
+    void* Entry = CxPlatPoolAlloc(Pool);
+    ASSERT_NE(nullptr, Entry);
+#ifndef DISABLE_CXPLAT_POOL
+    BOOLEAN Found = FALSE;
+    for (uint32_t i = 0; i < POOL_TEST_BATCH; ++i) {
+        if (Entries[i] == Entry) {
+            Found = TRUE;
+        }
+    }
+    ASSERT_TRUE(Found);
+#endif
+    CxPlatPoolFree(Entry);
+}
+
+TEST(PoolTest, Prune)
+{
+    PoolScope Pool;
+    void* Entries[POOL_TEST_BATCH];
+    for (uint32_t i = 0; i < POOL_TEST_BATCH; ++i) {
+        Entries[i] = CxPlatPoolAlloc(Pool);
+        ASSERT_NE(nullptr, Entries[i]);
+    }
+    for (uint32_t i = 0; i < POOL_TEST_BATCH; ++i) {
+        CxPlatPoolFree(Entries[i]);
+    }
+    uint32_t PruneCount = 0;
+    while (CxPlatPoolPrune(Pool)) {
+        ASSERT_LT(++PruneCount, (uint32_t)POOL_TEST_BATCH);
+    }
+    ASSERT_FALSE(CxPlatPoolPrune(Pool));
+}
+
+TEST(PoolTest, MaxDepth)
+{
+    PoolScope Pool;
+    CxPlatPoolSetMaxDepth(Pool, 64);
+    void* Entries[POOL_TEST_BATCH];
+    for (uint32_t i = 0; i < POOL_TEST_BATCH; ++i) {
+        Entries[i] = CxPlatPoolAlloc(Pool);
+        ASSERT_NE(nullptr, Entries[i]);
+    }
+    for (uint32_t i = 0; i < POOL_TEST_BATCH; ++i) {
+        CxPlatPoolFree(Entries[i]);
+    }
+    //
+    // The calling thread's magazine may hold up to the max depth on top of
+    // what the pool shares between threads.
+    //
+    ASSERT_LE(CxPlatPoolGetDepth(Pool), 2 * 64u);
+}
+
+TEST(PoolTest, DynamicPoolStats)
+{
+    CXPLAT_WORKER_POOL* WorkerPool = CxPlatWorkerPoolCreate(nullptr);
+    ASSERT_NE(nullptr, WorkerPool);
+
+    CXPLAT_POOL_EX Pool;
+    CxPlatPoolInitialize(FALSE, POOL_TEST_ENTRY_SIZE, QUIC_POOL_TEST, &Pool.Base);
+    CxPlatAddDynamicPoolAllocator(WorkerPool, &Pool, 0);
+
+    void* Entries[POOL_TEST_BATCH];
+    for (uint32_t i = 0; i < POOL_TEST_BATCH; ++i) {
+        Entries[i] = CxPlatPoolExAlloc(&Pool);
+        ASSERT_NE(nullptr, Entries[i]);
+    }
+    for (uint32_t i = 0; i < POOL_TEST_BATCH; ++i) {
+        CxPlatPoolFree(Entries[i]);
+    }
+
+    QUIC_POOL_STATS Stats[8];
+    const uint32_t Count = CxPlatWorkerPoolGetPoolStats(WorkerPool, ARRAYSIZE(Stats), Stats);
+    ASSERT_GE(Count, 1u);
+    BOOLEAN Found = FALSE;
+    for (uint32_t i = 0; i < CXPLAT_MIN(Count, (uint32_t)ARRAYSIZE(Stats)); ++i) {
+        if (Stats[i].EntrySize == Pool.Base.Size) {
+            ASSERT_EQ(0u, Stats[i].PartitionIndex);
+            ASSERT_EQ((uint64_t)POOL_TEST_BATCH, Stats[i].AllocCount);
+            ASSERT_LE(Stats[i].MissCount, Stats[i].AllocCount);
+            ASSERT_GT(Stats[i].MissCount, 0ull);
+            ASSERT_EQ((uint64_t)Stats[i].Depth * Stats[i].EntrySize, Stats[i].BytesHeld);
+#ifndef DISABLE_CXPLAT_POOL
+            ASSERT_GT(Stats[i].Depth, 0u);
+#endif
+            Found = TRUE;
+        }
+    }
+    ASSERT_TRUE(Found);
+
+#ifndef DISABLE_CXPLAT_POOL
+    //
+    // Allocations served from the entries cached above aren't misses.
+    //
+    const uint64_t MissCount = Pool.MissCount;
+    for (uint32_t i = 0; i < 64; ++i) {
+        Entries[i] = CxPlatPoolExAlloc(&Pool);
+        ASSERT_NE(nullptr, Entries[i]);
+    }
+    ASSERT_EQ(MissCount, Pool.MissCount);
+    for (uint32_t i = 0; i < 64; ++i) {
+        CxPlatPoolFree(Entries[i]);
+    }
+#endif
+
+    CxPlatRemoveDynamicPoolAllocator(&Pool);
+    CxPlatPoolUninitialize(&Pool.Base);
+    CxPlatWorkerPoolDelete(WorkerPool);
+}
+
+TEST(PoolTest, CrossThreadFree)
+{
+    PoolScope Pool;
+    RunCrossThread(Pool, 16);
+
+    //
+    // Entries freed on this thread are usable from this thread.
+    //
+    void* Entry = CxPlatPoolAlloc(Pool);
+    ASSERT_NE(nullptr, Entry);
+    CxPlatPoolFree(Entry);
+}
+
+TEST(PoolTest, ManyPools)
+{
+    //
+    // More pools than a thread's initial magazine cache holds, each of which
+    // keeps reusing its own entries.
+    //
+    const uint32_t PoolCount = 200;
+    PoolScope* Pools = new PoolScope[PoolCount];
+    for (uint32_t Round = 0; Round < 2; ++Round) {
+        for (uint32_t i = 0; i < PoolCount; ++i) {
+            void* Entry = CxPlatPoolAlloc(Pools[i]);
+            ASSERT_NE(nullptr, Entry);
+            CxPlatPoolFree(Entry);
+#ifndef DISABLE_CXPLAT_POOL
+            ASSERT_EQ(Entry, CxPlatPoolAlloc(Pools[i]));
+            CxPlatPoolFree(Entry);
+#endif
+        }
+    }
+    delete[] Pools;
+}
+
+#if !defined(_WIN32) && !defined(DISABLE_CXPLAT_POOL)
+TEST(PoolTest, UninitializeZeroedPool)
+{
+    //
+    // Pools take the lowest free slot, so once this one is initialized the
+    // first slot belongs to a live pool. Uninitializing a pool that was never
+    // initialized must not give it up.
+    //
+    PoolScope Pool;
+    ASSERT_NE(0u, Pool.Pool.Slot);
+
+    CXPLAT_POOL Zeroed;
+    CxPlatZeroMemory(&Zeroed, sizeof(Zeroed));
+    CxPlatPoolUninitialize(&Zeroed);
+
+    PoolScope Next;
+    ASSERT_NE(0u, Next.Pool.Slot);
+    ASSERT_NE(1u, Next.Pool.Slot);
+    ASSERT_NE(Pool.Pool.Slot, Next.Pool.Slot);
+}
+#endif
+
+#if !defined(_WIN32) && !defined(DISABLE_CXPLAT_POOL)
+struct PoolThreadScope {
+    CXPLAT_POOL* Pool;
+    static CXPLAT_THREAD_CALLBACK(Callback, Context) {
+        auto Scope = (PoolThreadScope*)Context;
+        void* Entries[POOL_TEST_BATCH];
+        for (uint32_t i = 0; i < POOL_TEST_BATCH; ++i) {
+            Entries[i] = CxPlatPoolAlloc(Scope->Pool);
+        }
+        for (uint32_t i = 0; i < POOL_TEST_BATCH; ++i) {
+            if (Entries[i] != nullptr) {
+                CxPlatPoolFree(Entries[i]);
+            }
+        }
+        CXPLAT_THREAD_RETURN(0);
+    }
+};
+
+TEST(PoolTest, ThreadExitFreesMagazine)
+{
+    PoolScope Pool;
+    PoolThreadScope Scope = { Pool };
+    CXPLAT_THREAD_CONFIG Config = { 0, 0, "PoolThread", PoolThreadScope::Callback, &Scope };
+    CXPLAT_THREAD Thread;
+    ASSERT_TRUE(QUIC_SUCCEEDED(CxPlatThreadCreate(&Config, &Thread)));
+    CxPlatThreadWait(&Thread);
+    CxPlatThreadDelete(&Thread);
+    ASSERT_EQ(nullptr, Pool.Pool.Magazines);
+}
+
+TEST(PoolTest, PruneDrainsMagazines)
+{
+    PoolScope Pool;
+    void* Entries[POOL_TEST_BATCH];
+    for (uint32_t i = 0; i < POOL_TEST_BATCH; ++i) {
+        Entries[i] = CxPlatPoolAlloc(Pool);
+        ASSERT_NE(nullptr, Entries[i]);
+    }
+    for (uint32_t i = 0; i < POOL_TEST_BATCH; ++i) {
+        CxPlatPoolFree(Entries[i]);
+    }
+    ASSERT_NE(nullptr, Pool.Pool.Magazines);
+    ASSERT_NE(0u, Pool.Pool.Magazines->Depth);
+    while (CxPlatPoolPrune(Pool)) {
+    }
+    ASSERT_EQ(0u, Pool.Pool.Magazines->Depth);
+}
+#endif
+
+//
+// Throughput benchmarks, which only print their results. They don't run by
+// default; use --gtest_also_run_disabled_tests.
+//
+
+TEST(PoolTest, DISABLED_BenchmarkSameThread)
+{
+    PoolScope Pool;
+    void* Entries[POOL_TEST_BATCH];
+    const uint64_t Start = CxPlatTimeUs64();
+    for (uint32_t i = 0; i < POOL_TEST_ROUNDS; ++i) {
+        for (uint32_t j = 0; j < POOL_TEST_BATCH; ++j) {
+            Entries[j] = CxPlatPoolAlloc(Pool);
+            ASSERT_NE(nullptr, Entries[j]);
+        }
+        for (uint32_t j = 0; j < POOL_TEST_BATCH; ++j) {
+            CxPlatPoolFree(Entries[j]);
+        }
+    }
+    const uint64_t Elapsed = CxPlatTimeDiff64(Start, CxPlatTimeUs64());
+    PrintRate("Same-thread", (uint64_t)POOL_TEST_ROUNDS * POOL_TEST_BATCH, Elapsed);
+}
+
+TEST(PoolTest, DISABLED_BenchmarkCrossThread)
+{
+    PoolScope Pool;
+    const uint64_t Start = CxPlatTimeUs64();
+    RunCrossThread(Pool, POOL_TEST_ROUNDS);
+    const uint64_t Elapsed = CxPlatTimeDiff64(Start, CxPlatTimeUs64());
+    PrintRate("Cross-thread", (uint64_t)POOL_TEST_ROUNDS * POOL_TEST_BATCH, Elapsed);
+}
@@ -1415,6 +1415,47 @@ TEST_F(TlsTest, DeferredCertificateValidationAllowCa)
         ASSERT_TRUE(Result & CXPLAT_TLS_RESULT_HANDSHAKE_COMPLETE);
     }
 }
+
+TEST_F(TlsTest, ServerCertificateChainCached)
+{
+    //
+    // The server's chain is built once, when its sec config is created, and
+    // without the root. So even with its own CA in its cert store, the server
+    // sends just its certificate, and its first flight is no larger than when
+    // the CA isn't available at all.
+    //
+    uint32_t FlightLength[2];
+    for (uint32_t i = 0; i < 2; ++i) {
+        QUIC_CREDENTIAL_CONFIG CredConfig = *CaSelfSignedCertParams;
+        CredConfig.Flags = CaSelfSignedCertParamsFlags;
+        if (i == 1) {
+            CredConfig.Flags |= QUIC_CREDENTIAL_FLAG_SET_CA_CERTIFICATE_FILE;
+            CredConfig.CaCertificateFile = ServerCaCertificateFile;
+        }
+        CxPlatSecConfig ServerConfig;
+        ServerConfig.Load(&CredConfig);
+        CxPlatClientSecConfig ClientConfig;
+        TlsContext ServerContext, ClientContext;
+        ClientContext.InitializeClient(ClientConfig);
+        ServerContext.InitializeServer(ServerConfig);
+
+        auto Result = ClientContext.ProcessData(nullptr);
+        ASSERT_TRUE(Result & CXPLAT_TLS_RESULT_DATA);
+
+        Result = ServerContext.ProcessData(&ClientContext.State);
+        ASSERT_TRUE(Result & CXPLAT_TLS_RESULT_DATA);
+        FlightLength[i] = ServerContext.State.BufferTotalLength;
+
+        Result = ClientContext.ProcessData(&ServerContext.State);
+        ASSERT_TRUE(Result & CXPLAT_TLS_RESULT_HANDSHAKE_COMPLETE);
+    }
+
+    //
+    // Allow for the signature's length varying a little between handshakes.
+    // A CA certificate is hundreds of bytes.
+    //
+    ASSERT_LT(FlightLength[1], FlightLength[0] + 16);
+}
 #endif
 
 TEST_F(TlsTest, DeferredCertificateValidationReject)
@@ -168,6 +168,8 @@ pub const QUIC_PARAM_GLOBAL_LIBRARY_GIT_HASH: u32 = 16777224;
 pub const QUIC_PARAM_GLOBAL_EXECUTION_CONFIG: u32 = 16777225;
 pub const QUIC_PARAM_GLOBAL_TLS_PROVIDER: u32 = 16777226;
 pub const QUIC_PARAM_GLOBAL_STATELESS_RESET_KEY: u32 = 16777227;
+pub const QUIC_PARAM_GLOBAL_POOL_STATS: u32 = 16777228;
+pub const QUIC_PARAM_REGISTRATION_RESUMPTION_CACHE: u32 = 33554432;
 pub const QUIC_PARAM_CONFIGURATION_SETTINGS: u32 = 50331648;
 pub const QUIC_PARAM_CONFIGURATION_TICKET_KEYS: u32 = 50331649;
 pub const QUIC_PARAM_CONFIGURATION_VERSION_SETTINGS: u32 = 50331650;
@@ -176,6 +178,7 @@ pub const QUIC_PARAM_LISTENER_LOCAL_ADDRESS: u32 = 67108864;
 pub const QUIC_PARAM_LISTENER_STATS: u32 = 67108865;
 pub const QUIC_PARAM_LISTENER_CIBIR_ID: u32 = 67108866;
 pub const QUIC_PARAM_DOS_MODE_EVENTS: u32 = 67108868;
+pub const QUIC_PARAM_LISTENER_ADMISSION_CONTROL: u32 = 67108869;
 pub const QUIC_PARAM_CONN_QUIC_VERSION: u32 = 83886080;
 pub const QUIC_PARAM_CONN_LOCAL_ADDRESS: u32 = 83886081;
 pub const QUIC_PARAM_CONN_REMOTE_ADDRESS: u32 = 83886082;
@@ -423,6 +426,10 @@ pub const QUIC_EXECUTION_CONFIG_FLAGS_QUIC_EXECUTION_CONFIG_FLAG_HIGH_PRIORITY:
     QUIC_EXECUTION_CONFIG_FLAGS = 16;
 pub const QUIC_EXECUTION_CONFIG_FLAGS_QUIC_EXECUTION_CONFIG_FLAG_AFFINITIZE:
     QUIC_EXECUTION_CONFIG_FLAGS = 32;
+pub const QUIC_EXECUTION_CONFIG_FLAGS_QUIC_EXECUTION_CONFIG_FLAG_LOOPBACK:
+    QUIC_EXECUTION_CONFIG_FLAGS = 64;
+pub const QUIC_EXECUTION_CONFIG_FLAGS_QUIC_EXECUTION_CONFIG_FLAG_CID_STEERING:
+    QUIC_EXECUTION_CONFIG_FLAGS = 128;
 pub type QUIC_EXECUTION_CONFIG_FLAGS = ::std::os::raw::c_int;
 #[repr(C)]
 #[derive(Debug, Copy, Clone)]
@@ -1523,6 +1530,34 @@ const _: () = {
     ["Offset of field: QUIC_LISTENER_STATISTICS::BindingRecvDroppedPackets"]
         [::std::mem::offset_of!(QUIC_LISTENER_STATISTICS, BindingRecvDroppedPackets) - 16usize];
 };
+pub const QUIC_LISTENER_ADMISSION_LEVEL_QUIC_LISTENER_ADMISSION_LEVEL_NORMAL:
+    QUIC_LISTENER_ADMISSION_LEVEL = 0;
+pub const QUIC_LISTENER_ADMISSION_LEVEL_QUIC_LISTENER_ADMISSION_LEVEL_RETRY:
+    QUIC_LISTENER_ADMISSION_LEVEL = 1;
+pub const QUIC_LISTENER_ADMISSION_LEVEL_QUIC_LISTENER_ADMISSION_LEVEL_SHED:
+    QUIC_LISTENER_ADMISSION_LEVEL = 2;
+pub const QUIC_LISTENER_ADMISSION_LEVEL_QUIC_LISTENER_ADMISSION_LEVEL_REJECT:
+    QUIC_LISTENER_ADMISSION_LEVEL = 3;
+pub type QUIC_LISTENER_ADMISSION_LEVEL = ::std::os::raw::c_int;
+#[repr(C)]
+#[derive(Debug, Copy, Clone)]
+pub struct QUIC_LISTENER_ADMISSION_CONTROL {
+    pub QueueDelayTargetUs: u32,
+    pub HandshakeBacklogTarget: u32,
+}
+#[allow(clippy::unnecessary_operation, clippy::identity_op)]
+const _: () = {
+    ["Size of QUIC_LISTENER_ADMISSION_CONTROL"]
+        [::std::mem::size_of::<QUIC_LISTENER_ADMISSION_CONTROL>() - 8usize];
+    ["Alignment of QUIC_LISTENER_ADMISSION_CONTROL"]
+        [::std::mem::align_of::<QUIC_LISTENER_ADMISSION_CONTROL>() - 4usize];
+    ["Offset of field: QUIC_LISTENER_ADMISSION_CONTROL::QueueDelayTargetUs"]
+        [::std::mem::offset_of!(QUIC_LISTENER_ADMISSION_CONTROL, QueueDelayTargetUs) - 0usize];
+    ["Offset of field: QUIC_LISTENER_ADMISSION_CONTROL::HandshakeBacklogTarget"][::std::mem::offset_of!(
+        QUIC_LISTENER_ADMISSION_CONTROL,
+        HandshakeBacklogTarget
+    ) - 4usize];
+};
 pub const QUIC_PERFORMANCE_COUNTERS_QUIC_PERF_COUNTER_CONN_CREATED: QUIC_PERFORMANCE_COUNTERS = 0;
 pub const QUIC_PERFORMANCE_COUNTERS_QUIC_PERF_COUNTER_CONN_HANDSHAKE_FAIL:
     QUIC_PERFORMANCE_COUNTERS = 1;
@@ -1577,7 +1612,18 @@ pub const QUIC_PERFORMANCE_COUNTERS_QUIC_PERF_COUNTER_SEND_STATELESS_RETRY:
     QUIC_PERFORMANCE_COUNTERS = 30;
 pub const QUIC_PERFORMANCE_COUNTERS_QUIC_PERF_COUNTER_CONN_LOAD_REJECT: QUIC_PERFORMANCE_COUNTERS =
     31;
-pub const QUIC_PERFORMANCE_COUNTERS_QUIC_PERF_COUNTER_MAX: QUIC_PERFORMANCE_COUNTERS = 32;
+pub const QUIC_PERFORMANCE_COUNTERS_QUIC_PERF_COUNTER_CONN_HIBERNATED: QUIC_PERFORMANCE_COUNTERS =
+    32;
+pub const QUIC_PERFORMANCE_COUNTERS_QUIC_PERF_COUNTER_CONN_HIBERNATED_BYTES:
+    QUIC_PERFORMANCE_COUNTERS = 33;
+pub const QUIC_PERFORMANCE_COUNTERS_QUIC_PERF_COUNTER_CONN_RECV_QUEUED: QUIC_PERFORMANCE_COUNTERS =
+    34;
+pub const QUIC_PERFORMANCE_COUNTERS_QUIC_PERF_COUNTER_WORK_WAKES: QUIC_PERFORMANCE_COUNTERS = 35;
+pub const QUIC_PERFORMANCE_COUNTERS_QUIC_PERF_COUNTER_DATAPATH_REMOTE_FREES:
+    QUIC_PERFORMANCE_COUNTERS = 36;
+pub const QUIC_PERFORMANCE_COUNTERS_QUIC_PERF_COUNTER_DATAPATH_CROSS_NODE_SENDS:
+    QUIC_PERFORMANCE_COUNTERS = 37;
+pub const QUIC_PERFORMANCE_COUNTERS_QUIC_PERF_COUNTER_MAX: QUIC_PERFORMANCE_COUNTERS = 38;
 pub type QUIC_PERFORMANCE_COUNTERS = ::std::os::raw::c_int;
 #[repr(C)]
 #[derive(Debug, Copy, Clone)]
@@ -1614,6 +1660,9 @@ pub struct QUIC_GLOBAL_SETTINGS {
     pub RetryMemoryLimit: u16,
     pub LoadBalancingMode: u16,
     pub FixedServerID: u32,
+    pub AntiReplayWindowMs: u32,
+    pub AntiReplayCapacity: u32,
+    pub ObjectArenaEnabled: u8,
 }
 #[repr(C)]
 #[derive(Copy, Clone)]
@@ -1735,14 +1784,113 @@ impl QUIC_GLOBAL_SETTINGS__bindgen_ty_1__bindgen_ty_1 {
         }
     }
     #[inline]
+    pub fn AntiReplayWindowMs(&self) -> u64 {
+        unsafe { ::std::mem::transmute(self._bitfield_1.get(3usize, 1u8) as u64) }
+    }
+    #[inline]
+    pub fn set_AntiReplayWindowMs(&mut self, val: u64) {
+        unsafe {
+            let val: u64 = ::std::mem::transmute(val);
+            self._bitfield_1.set(3usize, 1u8, val as u64)
+        }
+    }
+    #[inline]
+    pub unsafe fn AntiReplayWindowMs_raw(this: *const Self) -> u64 {
+        unsafe {
+            ::std::mem::transmute(<__BindgenBitfieldUnit<[u8; 8usize]>>::raw_get(
+                ::std::ptr::addr_of!((*this)._bitfield_1),
+                3usize,
+                1u8,
+            ) as u64)
+        }
+    }
+    #[inline]
+    pub unsafe fn set_AntiReplayWindowMs_raw(this: *mut Self, val: u64) {
+        unsafe {
+            let val: u64 = ::std::mem::transmute(val);
+            <__BindgenBitfieldUnit<[u8; 8usize]>>::raw_set(
+                ::std::ptr::addr_of_mut!((*this)._bitfield_1),
+                3usize,
+                1u8,
+                val as u64,
+            )
+        }
+    }
+    #[inline]
+    pub fn AntiReplayCapacity(&self) -> u64 {
+        unsafe { ::std::mem::transmute(self._bitfield_1.get(4usize, 1u8) as u64) }
+    }
+    #[inline]
+    pub fn set_AntiReplayCapacity(&mut self, val: u64) {
+        unsafe {
+            let val: u64 = ::std::mem::transmute(val);
+            self._bitfield_1.set(4usize, 1u8, val as u64)
+        }
+    }
+    #[inline]
+    pub unsafe fn AntiReplayCapacity_raw(this: *const Self) -> u64 {
+        unsafe {
+            ::std::mem::transmute(<__BindgenBitfieldUnit<[u8; 8usize]>>::raw_get(
+                ::std::ptr::addr_of!((*this)._bitfield_1),
+                4usize,
+                1u8,
+            ) as u64)
+        }
+    }
+    #[inline]
+    pub unsafe fn set_AntiReplayCapacity_raw(this: *mut Self, val: u64) {
+        unsafe {
+            let val: u64 = ::std::mem::transmute(val);
+            <__BindgenBitfieldUnit<[u8; 8usize]>>::raw_set(
+                ::std::ptr::addr_of_mut!((*this)._bitfield_1),
+                4usize,
+                1u8,
+                val as u64,
+            )
+        }
+    }
+    #[inline]
+    pub fn ObjectArenaEnabled(&self) -> u64 {
+        unsafe { ::std::mem::transmute(self._bitfield_1.get(5usize, 1u8) as u64) }
+    }
+    #[inline]
+    pub fn set_ObjectArenaEnabled(&mut self, val: u64) {
+        unsafe {
+            let val: u64 = ::std::mem::transmute(val);
+            self._bitfield_1.set(5usize, 1u8, val as u64)
+        }
+    }
+    #[inline]
+    pub unsafe fn ObjectArenaEnabled_raw(this: *const Self) -> u64 {
+        unsafe {
+            ::std::mem::transmute(<__BindgenBitfieldUnit<[u8; 8usize]>>::raw_get(
+                ::std::ptr::addr_of!((*this)._bitfield_1),
+                5usize,
+                1u8,
+            ) as u64)
+        }
+    }
+    #[inline]
+    pub unsafe fn set_ObjectArenaEnabled_raw(this: *mut Self, val: u64) {
+        unsafe {
+            let val: u64 = ::std::mem::transmute(val);
+            <__BindgenBitfieldUnit<[u8; 8usize]>>::raw_set(
+                ::std::ptr::addr_of_mut!((*this)._bitfield_1),
+                5usize,
+                1u8,
+                val as u64,
+            )
+        }
+    }
+    #[inline]
     pub fn RESERVED(&self) -> u64 {
-        unsafe { ::std::mem::transmute(self._bitfield_1.get(3usize, 61u8) as u64) }
+        unsafe { ::std::mem::transmute(self._bitfield_1.get(6usize, 58u8) as u64) }
     }
     #[inline]
     pub fn set_RESERVED(&mut self, val: u64) {
         unsafe {
             let val: u64 = ::std::mem::transmute(val);
-            self._bitfield_1.set(3usize, 61u8, val as u64)
+            self._bitfield_1.set(6usize, 58u8, val as u64)
         }
     }
     #[inline]
@@ -1750,8 +1898,8 @@ impl QUIC_GLOBAL_SETTINGS__bindgen_ty_1__bindgen_ty_1 {
         unsafe {
             ::std::mem::transmute(<__BindgenBitfieldUnit<[u8; 8usize]>>::raw_get(
                 ::std::ptr::addr_of!((*this)._bitfield_1),
-                3usize,
-                61u8,
+                6usize,
+                58u8,
             ) as u64)
         }
     }
@@ -1761,8 +1909,8 @@ impl QUIC_GLOBAL_SETTINGS__bindgen_ty_1__bindgen_ty_1 {
             let val: u64 = ::std::mem::transmute(val);
             <__BindgenBitfieldUnit<[u8; 8usize]>>::raw_set(
                 ::std::ptr::addr_of_mut!((*this)._bitfield_1),
-                3usize,
-                61u8,
+                6usize,
+                58u8,
                 val as u64,
             )
         }
@@ -1772,6 +1920,9 @@ impl QUIC_GLOBAL_SETTINGS__bindgen_ty_1__bindgen_ty_1 {
         RetryMemoryLimit: u64,
         LoadBalancingMode: u64,
         FixedServerID: u64,
+        AntiReplayWindowMs: u64,
+        AntiReplayCapacity: u64,
+        ObjectArenaEnabled: u64,
         RESERVED: u64,
     ) -> __BindgenBitfieldUnit<[u8; 8usize]> {
         let mut __bindgen_bitfield_unit: __BindgenBitfieldUnit<[u8; 8usize]> = Default::default();
@@ -1787,7 +1938,19 @@ impl QUIC_GLOBAL_SETTINGS__bindgen_ty_1__bindgen_ty_1 {
             let FixedServerID: u64 = unsafe { ::std::mem::transmute(FixedServerID) };
             FixedServerID as u64
         });
-        __bindgen_bitfield_unit.set(3usize, 61u8, {
+        __bindgen_bitfield_unit.set(3usize, 1u8, {
+            let AntiReplayWindowMs: u64 = unsafe { ::std::mem::transmute(AntiReplayWindowMs) };
+            AntiReplayWindowMs as u64
+        });
+        __bindgen_bitfield_unit.set(4usize, 1u8, {
+            let AntiReplayCapacity: u64 = unsafe { ::std::mem::transmute(AntiReplayCapacity) };
+            AntiReplayCapacity as u64
+        });
+        __bindgen_bitfield_unit.set(5usize, 1u8, {
+            let ObjectArenaEnabled: u64 = unsafe { ::std::mem::transmute(ObjectArenaEnabled) };
+            ObjectArenaEnabled as u64
+        });
+        __bindgen_bitfield_unit.set(6usize, 58u8, {
             let RESERVED: u64 = unsafe { ::std::mem::transmute(RESERVED) };
             RESERVED as u64
         });
@@ -1807,7 +1970,7 @@ const _: () = {
 };
 #[allow(clippy::unnecessary_operation, clippy::identity_op)]
 const _: () = {
-    ["Size of QUIC_GLOBAL_SETTINGS"][::std::mem::size_of::<QUIC_GLOBAL_SETTINGS>() - 16usize];
+    ["Size of QUIC_GLOBAL_SETTINGS"][::std::mem::size_of::<QUIC_GLOBAL_SETTINGS>() - 32usize];
     ["Alignment of QUIC_GLOBAL_SETTINGS"][::std::mem::align_of::<QUIC_GLOBAL_SETTINGS>() - 8usize];
     ["Offset of field: QUIC_GLOBAL_SETTINGS::RetryMemoryLimit"]
         [::std::mem::offset_of!(QUIC_GLOBAL_SETTINGS, RetryMemoryLimit) - 8usize];
@@ -1815,6 +1978,12 @@ const _: () = {
         [::std::mem::offset_of!(QUIC_GLOBAL_SETTINGS, LoadBalancingMode) - 10usize];
     ["Offset of field: QUIC_GLOBAL_SETTINGS::FixedServerID"]
         [::std::mem::offset_of!(QUIC_GLOBAL_SETTINGS, FixedServerID) - 12usize];
+    ["Offset of field: QUIC_GLOBAL_SETTINGS::AntiReplayWindowMs"]
+        [::std::mem::offset_of!(QUIC_GLOBAL_SETTINGS, AntiReplayWindowMs) - 16usize];
+    ["Offset of field: QUIC_GLOBAL_SETTINGS::AntiReplayCapacity"]
+        [::std::mem::offset_of!(QUIC_GLOBAL_SETTINGS, AntiReplayCapacity) - 20usize];
+    ["Offset of field: QUIC_GLOBAL_SETTINGS::ObjectArenaEnabled"]
+        [::std::mem::offset_of!(QUIC_GLOBAL_SETTINGS, ObjectArenaEnabled) - 24usize];
 };
 #[repr(C)]
 #[derive(Copy, Clone)]
@@ -1853,6 +2022,7 @@ pub struct QUIC_SETTINGS {
     pub StreamRecvWindowBidiLocalDefault: u32,
     pub StreamRecvWindowBidiRemoteDefault: u32,
     pub StreamRecvWindowUnidiDefault: u32,
+    pub IdleHibernationTimeoutMs: u32,
 }
 #[repr(C)]
 #[derive(Copy, Clone)]
@@ -3328,14 +3498,47 @@ impl QUIC_SETTINGS__bindgen_ty_1__bindgen_ty_1 {
         }
     }
     #[inline]
+    pub fn IdleHibernationTimeoutMs(&self) -> u64 {
+        unsafe { ::std::mem::transmute(self._bitfield_1.get(44usize, 1u8) as u64) }
+    }
+    #[inline]
+    pub fn set_IdleHibernationTimeoutMs(&mut self, val: u64) {
+        unsafe {
+            let val: u64 = ::std::mem::transmute(val);
+            self._bitfield_1.set(44usize, 1u8, val as u64)
+        }
+    }
+    #[inline]
+    pub unsafe fn IdleHibernationTimeoutMs_raw(this: *const Self) -> u64 {
+        unsafe {
+            ::std::mem::transmute(<__BindgenBitfieldUnit<[u8; 8usize]>>::raw_get(
+                ::std::ptr::addr_of!((*this)._bitfield_1),
+                44usize,
+                1u8,
+            ) as u64)
+        }
+    }
+    #[inline]
+    pub unsafe fn set_IdleHibernationTimeoutMs_raw(this: *mut Self, val: u64) {
+        unsafe {
+            let val: u64 = ::std::mem::transmute(val);
+            <__BindgenBitfieldUnit<[u8; 8usize]>>::raw_set(
+                ::std::ptr::addr_of_mut!((*this)._bitfield_1),
+                44usize,
+                1u8,
+                val as u64,
+            )
+        }
+    }
+    #[inline]
     pub fn RESERVED(&self) -> u64 {
-        unsafe { ::std::mem::transmute(self._bitfield_1.get(44usize, 20u8) as u64) }
+        unsafe { ::std::mem::transmute(self._bitfield_1.get(45usize, 19u8) as u64) }
     }
     #[inline]
     pub fn set_RESERVED(&mut self, val: u64) {
         unsafe {
             let val: u64 = ::std::mem::transmute(val);
-            self._bitfield_1.set(44usize, 20u8, val as u64)
+            self._bitfield_1.set(45usize, 19u8, val as u64)
         }
     }
     #[inline]
@@ -3343,8 +3546,8 @@ impl QUIC_SETTINGS__bindgen_ty_1__bindgen_ty_1 {
         unsafe {
             ::std::mem::transmute(<__BindgenBitfieldUnit<[u8; 8usize]>>::raw_get(
                 ::std::ptr::addr_of!((*this)._bitfield_1),
-                44usize,
-                20u8,
+                45usize,
+                19u8,
             ) as u64)
         }
     }
@@ -3354,8 +3557,8 @@ impl QUIC_SETTINGS__bindgen_ty_1__bindgen_ty_1 {
             let val: u64 = ::std::mem::transmute(val);
             <__BindgenBitfieldUnit<[u8; 8usize]>>::raw_set(
                 ::std::ptr::addr_of_mut!((*this)._bitfield_1),
-                44usize,
-                20u8,
+                45usize,
+                19u8,
                 val as u64,
             )
         }
@@ -3406,6 +3609,7 @@ impl QUIC_SETTINGS__bindgen_ty_1__bindgen_ty_1 {
         NetStatsEventEnabled: u64,
         StreamMultiReceiveEnabled: u64,
         QTIPEnabled: u64,
+        IdleHibernationTimeoutMs: u64,
         RESERVED: u64,
     ) -> __BindgenBitfieldUnit<[u8; 8usize]> {
         let mut __bindgen_bitfield_unit: __BindgenBitfieldUnit<[u8; 8usize]> = Default::default();
@@ -3607,7 +3811,12 @@ impl QUIC_SETTINGS__bindgen_ty_1__bindgen_ty_1 {
             let QTIPEnabled: u64 = unsafe { ::std::mem::transmute(QTIPEnabled) };
             QTIPEnabled as u64
         });
-        __bindgen_bitfield_unit.set(44usize, 20u8, {
+        __bindgen_bitfield_unit.set(44usize, 1u8, {
+            let IdleHibernationTimeoutMs: u64 =
+                unsafe { ::std::mem::transmute(IdleHibernationTimeoutMs) };
+            IdleHibernationTimeoutMs as u64
+        });
+        __bindgen_bitfield_unit.set(45usize, 19u8, {
             let RESERVED: u64 = unsafe { ::std::mem::transmute(RESERVED) };
             RESERVED as u64
         });
@@ -4031,6 +4240,8 @@ const _: () = {
         [::std::mem::offset_of!(QUIC_SETTINGS, StreamRecvWindowBidiRemoteDefault) - 132usize];
     ["Offset of field: QUIC_SETTINGS::StreamRecvWindowUnidiDefault"]
         [::std::mem::offset_of!(QUIC_SETTINGS, StreamRecvWindowUnidiDefault) - 136usize];
+    ["Offset of field: QUIC_SETTINGS::IdleHibernationTimeoutMs"]
+        [::std::mem::offset_of!(QUIC_SETTINGS, IdleHibernationTimeoutMs) - 140usize];
 };
 impl QUIC_SETTINGS {
     #[inline]
@@ -4644,6 +4855,53 @@ pub type QUIC_SET_CALLBACK_HANDLER_FN = ::std::option::Option<
 >;
 #[repr(C)]
 #[derive(Debug, Copy, Clone)]
+pub struct QUIC_POOL_STATS {
+    pub PartitionIndex: u32,
+    pub EntrySize: u32,
+    pub Depth: u32,
+    pub TargetDepth: u32,
+    pub AllocCount: u64,
+    pub MissCount: u64,
+    pub BytesHeld: u64,
+}
+#[allow(clippy::unnecessary_operation, clippy::identity_op)]
+const _: () = {
+    ["Size of QUIC_POOL_STATS"][::std::mem::size_of::<QUIC_POOL_STATS>() - 40usize];
+    ["Alignment of QUIC_POOL_STATS"][::std::mem::align_of::<QUIC_POOL_STATS>() - 8usize];
+    ["Offset of field: QUIC_POOL_STATS::PartitionIndex"]
+        [::std::mem::offset_of!(QUIC_POOL_STATS, PartitionIndex) - 0usize];
+    ["Offset of field: QUIC_POOL_STATS::EntrySize"]
+        [::std::mem::offset_of!(QUIC_POOL_STATS, EntrySize) - 4usize];
+    ["Offset of field: QUIC_POOL_STATS::Depth"]
+        [::std::mem::offset_of!(QUIC_POOL_STATS, Depth) - 8usize];
+    ["Offset of field: QUIC_POOL_STATS::TargetDepth"]
+        [::std::mem::offset_of!(QUIC_POOL_STATS, TargetDepth) - 12usize];
+    ["Offset of field: QUIC_POOL_STATS::AllocCount"]
+        [::std::mem::offset_of!(QUIC_POOL_STATS, AllocCount) - 16usize];
+    ["Offset of field: QUIC_POOL_STATS::MissCount"]
+        [::std::mem::offset_of!(QUIC_POOL_STATS, MissCount) - 24usize];
+    ["Offset of field: QUIC_POOL_STATS::BytesHeld"]
+        [::std::mem::offset_of!(QUIC_POOL_STATS, BytesHeld) - 32usize];
+};
+#[repr(C)]
+#[derive(Debug, Copy, Clone)]
+pub struct QUIC_RESUMPTION_CACHE_CONFIG {
+    pub MaxEntryCount: u32,
+    pub EntryTimeoutMs: u32,
+}
+#[allow(clippy::unnecessary_operation, clippy::identity_op)]
+const _: () = {
+    ["Size of QUIC_RESUMPTION_CACHE_CONFIG"]
+        [::std::mem::size_of::<QUIC_RESUMPTION_CACHE_CONFIG>() - 8usize];
+    ["Alignment of QUIC_RESUMPTION_CACHE_CONFIG"]
+        [::std::mem::align_of::<QUIC_RESUMPTION_CACHE_CONFIG>() - 4usize];
+    ["Offset of field: QUIC_RESUMPTION_CACHE_CONFIG::MaxEntryCount"]
+        [::std::mem::offset_of!(QUIC_RESUMPTION_CACHE_CONFIG, MaxEntryCount) - 0usize];
+    ["Offset of field: QUIC_RESUMPTION_CACHE_CONFIG::EntryTimeoutMs"]
+        [::std::mem::offset_of!(QUIC_RESUMPTION_CACHE_CONFIG, EntryTimeoutMs) - 4usize];
+};
+#[repr(C)]
+#[derive(Debug, Copy, Clone)]
 pub struct QUIC_SCHANNEL_CREDENTIAL_ATTRIBUTE_W {
     pub Attribute: ::std::os::raw::c_ulong,
     pub BufferLength: ::std::os::raw::c_ulong,
@@ -4753,6 +5011,8 @@ pub const QUIC_LISTENER_EVENT_TYPE_QUIC_LISTENER_EVENT_NEW_CONNECTION: QUIC_LIST
 pub const QUIC_LISTENER_EVENT_TYPE_QUIC_LISTENER_EVENT_STOP_COMPLETE: QUIC_LISTENER_EVENT_TYPE = 1;
 pub const QUIC_LISTENER_EVENT_TYPE_QUIC_LISTENER_EVENT_DOS_MODE_CHANGED: QUIC_LISTENER_EVENT_TYPE =
     2;
+pub const QUIC_LISTENER_EVENT_TYPE_QUIC_LISTENER_EVENT_ADMISSION_LEVEL_CHANGED:
+    QUIC_LISTENER_EVENT_TYPE = 3;
 pub type QUIC_LISTENER_EVENT_TYPE = ::std::os::raw::c_int;
 #[repr(C)]
 #[derive(Copy, Clone)]
@@ -4766,6 +5026,7 @@ pub union QUIC_LISTENER_EVENT__bindgen_ty_1 {
     pub NEW_CONNECTION: QUIC_LISTENER_EVENT__bindgen_ty_1__bindgen_ty_1,
     pub STOP_COMPLETE: QUIC_LISTENER_EVENT__bindgen_ty_1__bindgen_ty_2,
     pub DOS_MODE_CHANGED: QUIC_LISTENER_EVENT__bindgen_ty_1__bindgen_ty_3,
+    pub ADMISSION_LEVEL_CHANGED: QUIC_LISTENER_EVENT__bindgen_ty_1__bindgen_ty_4,
 }
 #[repr(C)]
 #[derive(Debug, Copy, Clone)]
@@ -4980,6 +5241,30 @@ impl QUIC_LISTENER_EVENT__bindgen_ty_1__bindgen_ty_3 {
         __bindgen_bitfield_unit
     }
 }
+#[repr(C)]
+#[derive(Debug, Copy, Clone)]
+pub struct QUIC_LISTENER_EVENT__bindgen_ty_1__bindgen_ty_4 {
+    pub Level: QUIC_LISTENER_ADMISSION_LEVEL,
+    pub QueueDelayUs: u32,
+    pub HandshakeBacklog: u32,
+}
+#[allow(clippy::unnecessary_operation, clippy::identity_op)]
+const _: () = {
+    ["Size of QUIC_LISTENER_EVENT__bindgen_ty_1__bindgen_ty_4"]
+        [::std::mem::size_of::<QUIC_LISTENER_EVENT__bindgen_ty_1__bindgen_ty_4>() - 12usize];
+    ["Alignment of QUIC_LISTENER_EVENT__bindgen_ty_1__bindgen_ty_4"]
+        [::std::mem::align_of::<QUIC_LISTENER_EVENT__bindgen_ty_1__bindgen_ty_4>() - 4usize];
+    ["Offset of field: QUIC_LISTENER_EVENT__bindgen_ty_1__bindgen_ty_4::Level"]
+        [::std::mem::offset_of!(QUIC_LISTENER_EVENT__bindgen_ty_1__bindgen_ty_4, Level) - 0usize];
+    ["Offset of field: QUIC_LISTENER_EVENT__bindgen_ty_1__bindgen_ty_4::QueueDelayUs"][::std::mem::offset_of!(
+        QUIC_LISTENER_EVENT__bindgen_ty_1__bindgen_ty_4,
+        QueueDelayUs
+    ) - 4usize];
+    ["Offset of field: QUIC_LISTENER_EVENT__bindgen_ty_1__bindgen_ty_4::HandshakeBacklog"][::std::mem::offset_of!(
+        QUIC_LISTENER_EVENT__bindgen_ty_1__bindgen_ty_4,
+        HandshakeBacklog
+    ) - 8usize];
+};
 #[allow(clippy::unnecessary_operation, clippy::identity_op)]
 const _: () = {
     ["Size of QUIC_LISTENER_EVENT__bindgen_ty_1"]
@@ -4992,6 +5277,10 @@ const _: () = {
         [::std::mem::offset_of!(QUIC_LISTENER_EVENT__bindgen_ty_1, STOP_COMPLETE) - 0usize];
     ["Offset of field: QUIC_LISTENER_EVENT__bindgen_ty_1::DOS_MODE_CHANGED"]
         [::std::mem::offset_of!(QUIC_LISTENER_EVENT__bindgen_ty_1, DOS_MODE_CHANGED) - 0usize];
+    ["Offset of field: QUIC_LISTENER_EVENT__bindgen_ty_1::ADMISSION_LEVEL_CHANGED"][::std::mem::offset_of!(
+        QUIC_LISTENER_EVENT__bindgen_ty_1,
+        ADMISSION_LEVEL_CHANGED
+    ) - 0usize];
 };
 #[allow(clippy::unnecessary_operation, clippy::identity_op)]
 const _: () = {
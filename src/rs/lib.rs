@@ -258,6 +258,12 @@ pub struct QuicPerformanceCounters {
     pub send_stateless_reset: i64,
     pub send_stateless_retry: i64,
     pub conn_load_reject: i64,
+    pub conn_hibernated: i64,
+    pub conn_hibernated_bytes: i64,
+    pub conn_recv_queued: i64,
+    pub work_wakes: i64,
+    pub datapath_remote_frees: i64,
+    pub datapath_cross_node_sends: i64,
 }
 
 pub const QUIC_TLS_SECRETS_MAX_SECRET_LEN: usize = 64;
@@ -523,6 +529,21 @@ impl From<QuicPerformanceCountersParam> for QuicPerformanceCounters {
                     as usize],
             conn_load_reject: value
                 [crate::ffi::QUIC_PERFORMANCE_COUNTERS_QUIC_PERF_COUNTER_CONN_LOAD_REJECT as usize],
+            conn_hibernated: value
+                [crate::ffi::QUIC_PERFORMANCE_COUNTERS_QUIC_PERF_COUNTER_CONN_HIBERNATED as usize],
+            conn_hibernated_bytes: value
+                [crate::ffi::QUIC_PERFORMANCE_COUNTERS_QUIC_PERF_COUNTER_CONN_HIBERNATED_BYTES
+                    as usize],
+            conn_recv_queued: value
+                [crate::ffi::QUIC_PERFORMANCE_COUNTERS_QUIC_PERF_COUNTER_CONN_RECV_QUEUED as usize],
+            work_wakes: value
+                [crate::ffi::QUIC_PERFORMANCE_COUNTERS_QUIC_PERF_COUNTER_WORK_WAKES as usize],
+            datapath_remote_frees: value
+                [crate::ffi::QUIC_PERFORMANCE_COUNTERS_QUIC_PERF_COUNTER_DATAPATH_REMOTE_FREES
+                    as usize],
+            datapath_cross_node_sends: value
+                [crate::ffi::QUIC_PERFORMANCE_COUNTERS_QUIC_PERF_COUNTER_DATAPATH_CROSS_NODE_SENDS
+                    as usize],
         }
     }
 }
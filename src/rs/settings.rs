@@ -191,6 +191,12 @@ impl Settings {
         StreamRecvWindowUnidiDefault,
         u32
     );
+    #[cfg(feature = "preview-api")]
+    define_settings_entry!(
+        set_IdleHibernationTimeoutMs,
+        IdleHibernationTimeoutMs,
+        u32
+    );
 }
 
 #[cfg(test)]
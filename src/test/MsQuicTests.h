@@ -277,6 +277,11 @@ QuicTestCibirExtension(
 #ifdef QUIC_API_ENABLE_PREVIEW_FEATURES
 void
 QuicTestResumptionAcrossVersions();
+
+void
+QuicTestRegistrationResumptionCache(
+    _In_ int Family
+    );
 #endif
 
 void
@@ -377,6 +382,12 @@ QuicTestConnectionPoolCreate(
     _In_ bool XdpSupported,
     _In_ bool TestCibirSupport
     );
+
+void
+QuicTestConnectionHibernation(
+    _In_ int Family,
+    _In_ uint32_t NumberOfConnections
+    );
 #endif
 
 //
@@ -1404,4 +1415,17 @@ struct QUIC_RUN_CONNECTION_POOL_CREATE_PARAMS {
 #define IOCTL_QUIC_RUN_VALIDATE_CONNECTION_POOL_CREATE \
     QUIC_CTL_CODE(133, METHOD_BUFFERED, FILE_WRITE_DATA)
 
-#define QUIC_MAX_IOCTL_FUNC_CODE 133
+struct QUIC_RUN_CONNECTION_HIBERNATION_PARAMS {
+    int Family;
+    uint32_t NumberOfConnections;
+};
+
+#define IOCTL_QUIC_RUN_CONNECTION_HIBERNATION \
+    QUIC_CTL_CODE(134, METHOD_BUFFERED, FILE_WRITE_DATA)
+    // QUIC_RUN_CONNECTION_HIBERNATION_PARAMS
+
+#define IOCTL_QUIC_RUN_REGISTRATION_RESUMPTION_CACHE \
+    QUIC_CTL_CODE(135, METHOD_BUFFERED, FILE_WRITE_DATA)
+    // int - Family
+
+#define QUIC_MAX_IOCTL_FUNC_CODE 135
@@ -28,6 +28,7 @@ bool UseQTIP = false;
 const MsQuicApi* MsQuic;
 const char* OsRunner = nullptr;
 uint32_t Timeout = UINT32_MAX;
+uint32_t HibernationConnectionCount = 100;
 QUIC_CREDENTIAL_CONFIG ServerSelfSignedCredConfig;
 QUIC_CREDENTIAL_CONFIG ServerSelfSignedCredConfigClientAuth;
 QUIC_CREDENTIAL_CONFIG ClientCertCredConfig;
@@ -1770,6 +1771,28 @@ TEST_P(WithHandshakeArgs12, ConnectionPoolCreate) {
             GetParam().TestCibirSupport);
     }
 }
+
+TEST_P(WithFamilyArgs, ConnectionHibernation) {
+    TestLoggerT<ParamType> Logger("QuicTestConnectionHibernation", GetParam());
+    if (TestingKernelMode) {
+        QUIC_RUN_CONNECTION_HIBERNATION_PARAMS Params = {
+            GetParam().Family,
+            HibernationConnectionCount
+        };
+        ASSERT_TRUE(DriverClient.Run(IOCTL_QUIC_RUN_CONNECTION_HIBERNATION, Params));
+    } else {
+        QuicTestConnectionHibernation(GetParam().Family, HibernationConnectionCount);
+    }
+}
+
+TEST_P(WithFamilyArgs, RegistrationResumptionCache) {
+    TestLoggerT<ParamType> Logger("QuicTestRegistrationResumptionCache", GetParam());
+    if (TestingKernelMode) {
+        ASSERT_TRUE(DriverClient.Run(IOCTL_QUIC_RUN_REGISTRATION_RESUMPTION_CACHE, GetParam().Family));
+    } else {
+        QuicTestRegistrationResumptionCache(GetParam().Family);
+    }
+}
 #endif // QUIC_API_ENABLE_PREVIEW_FEATURES
 
 TEST_P(WithSendArgs1, Send) {
@@ -2774,6 +2797,11 @@ int main(int argc, char** argv) {
                 Timeout = atoi(argv[i + 1]);
                 ++i;
             }
+        } else if (strcmp("--hibernationConnections", argv[i]) == 0) {
+            if (i + 1 < argc) {
+                HibernationConnectionCount = atoi(argv[i + 1]);
+                ++i;
+            }
         }
     }
     ::testing::AddGlobalTestEnvironment(new QuicTestEnvironment);
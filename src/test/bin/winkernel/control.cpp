@@ -532,6 +532,8 @@ size_t QUIC_IOCTL_BUFFER_SIZES[] =
     sizeof(INT32),
     sizeof(QUIC_RUN_CONNECTION_POOL_CREATE_PARAMS),
     0,
+    sizeof(QUIC_RUN_CONNECTION_HIBERNATION_PARAMS),
+    sizeof(INT32),
 };
 
 CXPLAT_STATIC_ASSERT(
@@ -574,6 +576,7 @@ typedef union {
     BOOLEAN ClientShutdown;
     BOOLEAN EnableResumption;
     QUIC_RUN_CONNECTION_POOL_CREATE_PARAMS ConnPoolCreateParams;
+    QUIC_RUN_CONNECTION_HIBERNATION_PARAMS HibernationParams;
 } QUIC_IOCTL_PARAMS;
 
 #define QuicTestCtlRun(X) \
@@ -1539,6 +1542,21 @@ QuicTestCtlEvtIoDeviceControl(
     case IOCTL_QUIC_RUN_VALIDATE_CONNECTION_POOL_CREATE:
         QuicTestCtlRun(QuicTestValidateConnectionPoolCreate());
         break;
+
+    case IOCTL_QUIC_RUN_CONNECTION_HIBERNATION:
+        CXPLAT_FRE_ASSERT(Params != nullptr);
+        QuicTestCtlRun(
+            QuicTestConnectionHibernation(
+                Params->HibernationParams.Family,
+                Params->HibernationParams.NumberOfConnections));
+        break;
+
+    case IOCTL_QUIC_RUN_REGISTRATION_RESUMPTION_CACHE:
+        CXPLAT_FRE_ASSERT(Params != nullptr);
+        QuicTestCtlRun(
+            QuicTestRegistrationResumptionCache(
+                Params->Family));
+        break;
 #endif
 
     case IOCTL_QUIC_RUN_TEST_KEY_UPDATE_DURING_HANDSHAKE:
@@ -3429,6 +3429,58 @@ void QuicTestListenerParam()
             TEST_EQUAL(Length, sizeof(BOOLEAN)); //sizeof (((QUIC_LISTENER *)0)->DosModeEventsEnabled)
         }
     }
+
+    //
+    // QUIC_PARAM_LISTENER_ADMISSION_CONTROL
+    //
+    {
+        TestScopeLogger LogScope0("QUIC_PARAM_LISTENER_ADMISSION_CONTROL");
+        MsQuicListener Listener(Registration, CleanUpManual, DummyListenerCallback<MsQuicListener*>, nullptr);
+        TEST_TRUE(Listener.IsValid());
+
+        //
+        // SetParam
+        //
+        {
+            TestScopeLogger LogScope1("SetParam");
+            QUIC_LISTENER_ADMISSION_CONTROL Control = { 1000, 500 };
+            TEST_QUIC_STATUS(
+                QUIC_STATUS_INVALID_PARAMETER,
+                Listener.SetParam(
+                    QUIC_PARAM_LISTENER_ADMISSION_CONTROL,
+                    sizeof(Control) - 1,
+                    &Control));
+            TEST_QUIC_SUCCEEDED(
+                Listener.SetParam(
+                    QUIC_PARAM_LISTENER_ADMISSION_CONTROL,
+                    sizeof(Control),
+                    &Control));
+        }
+
+        //
+        // GetParam
+        //
+        {
+            TestScopeLogger LogScope1("GetParam");
+            uint32_t Length = 0;
+            TEST_QUIC_STATUS(
+                QUIC_STATUS_BUFFER_TOO_SMALL,
+                Listener.GetParam(
+                    QUIC_PARAM_LISTENER_ADMISSION_CONTROL,
+                    &Length,
+                    nullptr));
+            TEST_EQUAL(Length, sizeof(QUIC_LISTENER_ADMISSION_CONTROL));
+
+            QUIC_LISTENER_ADMISSION_CONTROL Control = { 0, 0 };
+            TEST_QUIC_SUCCEEDED(
+                Listener.GetParam(
+                    QUIC_PARAM_LISTENER_ADMISSION_CONTROL,
+                    &Length,
+                    &Control));
+            TEST_EQUAL(Control.QueueDelayTargetUs, 1000u);
+            TEST_EQUAL(Control.HandshakeBacklogTarget, 500u);
+        }
+    }
 #endif
 
 }
@@ -3640,6 +3640,91 @@ QuicTestResumptionAcrossVersions()
         }
     }
 }
+
+void
+QuicTestRegistrationResumptionCache(
+    _In_ int Family
+    )
+{
+    MsQuicRegistration Registration;
+    TEST_QUIC_SUCCEEDED(Registration.GetInitStatus());
+
+    const QUIC_RESUMPTION_CACHE_CONFIG CacheConfig = { 16, 0 };
+    TEST_QUIC_SUCCEEDED(
+        MsQuic->SetParam(
+            Registration,
+            QUIC_PARAM_REGISTRATION_RESUMPTION_CACHE,
+            sizeof(CacheConfig),
+            &CacheConfig));
+
+    MsQuicAlpn Alpn("MsQuicTest");
+
+    MsQuicSettings ServerSettings;
+    ServerSettings.SetServerResumptionLevel(QUIC_SERVER_RESUME_ONLY);
+
+    MsQuicConfiguration ServerConfiguration(Registration, Alpn, ServerSettings, ServerSelfSignedCredConfig);
+    TEST_QUIC_SUCCEEDED(ServerConfiguration.GetInitStatus());
+
+    MsQuicConfiguration ClientConfiguration(Registration, Alpn, MsQuicCredentialConfig());
+    TEST_QUIC_SUCCEEDED(ClientConfiguration.GetInitStatus());
+
+    const QUIC_ADDRESS_FAMILY QuicAddrFamily = (Family == 4) ? QUIC_ADDRESS_FAMILY_INET : QUIC_ADDRESS_FAMILY_INET6;
+
+    //
+    // The first connection receives a ticket, which the registration caches
+    // under its server name and ALPN. The copy handed to the app isn't used.
+    //
+    QUIC_BUFFER* ResumptionTicket = nullptr;
+    QuicTestPrimeResumption(QuicAddrFamily, Registration, ServerConfiguration, ClientConfiguration, &ResumptionTicket);
+    if (ResumptionTicket == nullptr) {
+        return;
+    }
+    CXPLAT_FREE(ResumptionTicket, QUIC_POOL_TEST);
+
+    TestListener Listener(Registration, ListenerAcceptConnection, ServerConfiguration);
+    TEST_TRUE(Listener.IsValid());
+    QuicAddr ServerLocalAddr(QuicAddrFamily);
+    TEST_QUIC_SUCCEEDED(Listener.Start(Alpn, &ServerLocalAddr.SockAddr));
+    TEST_QUIC_SUCCEEDED(Listener.GetLocalAddr(ServerLocalAddr));
+
+    UniquePtr<TestConnection> Server;
+    ServerAcceptContext ServerAcceptCtx((TestConnection**)&Server);
+    Listener.Context = &ServerAcceptCtx;
+
+    //
+    // The second connection on the registration is given no ticket, so it can
+    // only resume from the cache.
+    //
+    TestConnection Client(Registration);
+    TEST_TRUE(Client.IsValid());
+    Client.SetExpectedResumed(true);
+
+    if (UseDuoNic) {
+        QuicAddr RemoteAddr{QuicAddrFamily, ServerLocalAddr.GetPort()};
+        QuicAddrSetToDuoNic(&RemoteAddr.SockAddr);
+        TEST_QUIC_SUCCEEDED(Client.SetRemoteAddr(RemoteAddr));
+    }
+
+    TEST_QUIC_SUCCEEDED(
+        Client.Start(
+            ClientConfiguration,
+            QuicAddrFamily,
+            QUIC_LOCALHOST_FOR_AF(QuicAddrFamily),
+            ServerLocalAddr.GetPort()));
+
+    if (!Client.WaitForConnectionComplete()) {
+        return;
+    }
+    TEST_TRUE(Client.GetIsConnected());
+
+    TEST_NOT_EQUAL(nullptr, Server);
+    if (!Server->WaitForConnectionComplete()) {
+        return;
+    }
+    TEST_TRUE(Server->GetIsConnected());
+    TEST_TRUE(Client.GetResumed());
+    TEST_TRUE(Server->GetResumed());
+}
 #endif // QUIC_API_ENABLE_PREVIEW_FEATURES
 
 void
@@ -4244,4 +4329,135 @@ QuicTestConnectionPoolCreate(
         }
     }
 }
+
+struct HibernationConnectionContext {
+    CxPlatEvent ShutdownCompleteEvent;
+    bool PeerAcknowledgedShutdown {false};
+
+    static QUIC_STATUS QUIC_API ConnCallback(_In_ MsQuicConnection*, _In_opt_ void* Context, _Inout_ QUIC_CONNECTION_EVENT* Event) {
+        auto* This = (HibernationConnectionContext*)Context;
+        if (Event->Type == QUIC_CONNECTION_EVENT_SHUTDOWN_COMPLETE) {
+            This->PeerAcknowledgedShutdown = Event->SHUTDOWN_COMPLETE.PeerAcknowledgedShutdown;
+            This->ShutdownCompleteEvent.Set();
+        }
+        return QUIC_STATUS_SUCCESS;
+    }
+};
+
+static
+void
+GetHibernationCounters(
+    _Out_ int64_t* Count,
+    _Out_ int64_t* Bytes
+    )
+{
+    int64_t Counters[QUIC_PERF_COUNTER_MAX];
+    uint32_t BufferLength = sizeof(Counters);
+    TEST_QUIC_SUCCEEDED(
+        MsQuic->GetParam(
+            nullptr,
+            QUIC_PARAM_GLOBAL_PERF_COUNTERS,
+            &BufferLength,
+            Counters));
+    *Count = Counters[QUIC_PERF_COUNTER_CONN_HIBERNATED];
+    *Bytes = Counters[QUIC_PERF_COUNTER_CONN_HIBERNATED_BYTES];
+}
+
+//
+// Holds many idle loopback connections, waits for both ends of all of them to
+// hibernate and then closes them gracefully, which requires both ends to wake
+// up again.
+//
+void
+QuicTestConnectionHibernation(
+    _In_ int Family,
+    _In_ uint32_t NumberOfConnections
+    )
+{
+    //
+    // A hibernated connection keeps little more than the connection object
+    // itself, and none of the multi-kilobyte TLS or receive buffers.
+    //
+    const int64_t MaxHibernatedBytesPerConnection = 8 * 1024;
+    const uint32_t HibernationTimeoutMs = 100;
+
+    MsQuicRegistration Registration(true);
+    TEST_QUIC_SUCCEEDED(Registration.GetInitStatus());
+    MsQuicAlpn Alpn("MsQuicTest");
+
+    MsQuicSettings Settings;
+    Settings.SetIdleTimeoutMs(60 * 1000);
+    Settings.SetIdleHibernationTimeoutMs(HibernationTimeoutMs);
+
+    MsQuicConfiguration ServerConfiguration(Registration, Alpn, Settings, ServerSelfSignedCredConfig);
+    TEST_QUIC_SUCCEEDED(ServerConfiguration.GetInitStatus());
+
+    MsQuicConfiguration ClientConfiguration(Registration, Alpn, Settings, MsQuicCredentialConfig());
+    TEST_QUIC_SUCCEEDED(ClientConfiguration.GetInitStatus());
+
+    QUIC_ADDRESS_FAMILY QuicAddrFamily = (Family == 4) ? QUIC_ADDRESS_FAMILY_INET : QUIC_ADDRESS_FAMILY_INET6;
+    QuicAddr ServerLocalAddr(QuicAddrFamily);
+    MsQuicAutoAcceptListener Listener(Registration, ServerConfiguration, MsQuicConnection::NoOpCallback);
+    TEST_QUIC_SUCCEEDED(Listener.GetInitStatus());
+    TEST_QUIC_SUCCEEDED(Listener.Start(Alpn, &ServerLocalAddr.SockAddr));
+    TEST_QUIC_SUCCEEDED(Listener.GetLocalAddr(ServerLocalAddr));
+
+    int64_t BaseCount, BaseBytes;
+    GetHibernationCounters(&BaseCount, &BaseBytes);
+
+    UniquePtrArray<HibernationConnectionContext> Contexts(new(std::nothrow) HibernationConnectionContext[NumberOfConnections]);
+    TEST_NOT_EQUAL(nullptr, Contexts);
+    UniquePtrArray<UniquePtr<MsQuicConnection>> Connections(new(std::nothrow) UniquePtr<MsQuicConnection>[NumberOfConnections]);
+    TEST_NOT_EQUAL(nullptr, Connections);
+
+    for (uint32_t i = 0; i < NumberOfConnections; ++i) {
+        Connections[i].reset(
+            new(std::nothrow) MsQuicConnection(
+                Registration,
+                CleanUpManual,
+                HibernationConnectionContext::ConnCallback,
+                &Contexts[i]));
+        TEST_NOT_EQUAL(nullptr, Connections[i]);
+        TEST_QUIC_SUCCEEDED(Connections[i]->GetInitStatus());
+        TEST_QUIC_SUCCEEDED(
+            Connections[i]->Start(
+                ClientConfiguration,
+                QuicAddrFamily,
+                QUIC_TEST_LOOPBACK_FOR_AF(QuicAddrFamily),
+                ServerLocalAddr.GetPort()));
+    }
+    for (uint32_t i = 0; i < NumberOfConnections; ++i) {
+        TEST_TRUE(Connections[i]->HandshakeCompleteEvent.WaitTimeout(TestWaitTimeout));
+        TEST_TRUE(Connections[i]->HandshakeComplete);
+    }
+
+    //
+    // Both the client and the server side of every connection hibernate.
+    //
+    const int64_t ExpectedCount = 2 * (int64_t)NumberOfConnections;
+    int64_t Count = 0, Bytes = 0;
+    const uint64_t Start = CxPlatTimeMs64();
+    do {
+        CxPlatSleep(HibernationTimeoutMs);
+        GetHibernationCounters(&Count, &Bytes);
+    } while (Count - BaseCount < ExpectedCount &&
+             CxPlatTimeDiff64(Start, CxPlatTimeMs64()) < TestWaitTimeout + NumberOfConnections);
+    TEST_EQUAL(ExpectedCount, Count - BaseCount);
+
+    const int64_t BytesPerConnection = (Bytes - BaseBytes) / ExpectedCount;
+    TEST_TRUE(BytesPerConnection > 0);
+    TEST_TRUE(BytesPerConnection <= MaxHibernatedBytesPerConnection);
+
+    for (uint32_t i = 0; i < NumberOfConnections; ++i) {
+        Connections[i]->Shutdown(0);
+    }
+    for (uint32_t i = 0; i < NumberOfConnections; ++i) {
+        TEST_TRUE(Contexts[i].ShutdownCompleteEvent.WaitTimeout(TestWaitTimeout));
+        TEST_TRUE(Contexts[i].PeerAcknowledgedShutdown);
+    }
+
+    GetHibernationCounters(&Count, &Bytes);
+    TEST_EQUAL(BaseCount, Count);
+    TEST_EQUAL(BaseBytes, Bytes);
+}
 #endif // QUIC_API_ENABLE_PREVIEW_FEATURES
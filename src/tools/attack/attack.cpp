@@ -28,6 +28,10 @@
 
 #define ATTACK_PORT_DEFAULT 443
 
+#define ATTACK_SOURCE_PORTS_DEFAULT 64
+
+#define ATTACK_STATELESS_LENGTH 64
+
 const QUIC_HKDF_LABELS HkdfLabels = { "quic key", "quic iv", "quic hp", "quic ku" };
 
 static CXPLAT_DATAPATH* Datapath;
@@ -42,10 +46,15 @@ static uint32_t ThreadCount = ATTACK_THREADS_DEFAULT;
 static uint64_t AttackRate = ATTACK_RATE_DEFAULT;
 static const char* Alpn = "h3";
 static uint32_t Version = QUIC_VERSION_1;
+static uint32_t SourcePortCount = ATTACK_SOURCE_PORTS_DEFAULT;
 
 static uint64_t TimeStart;
 static int64_t TotalPacketCount;
 static int64_t TotalByteCount;
+static int64_t TotalResponseCount;
+static int64_t VersionNegotiationCount;
+static int64_t RetryCount;
+static int64_t StatelessResetCount;
 
 void PrintUsage()
 {
@@ -53,7 +62,7 @@ void PrintUsage()
 
     printf("Usage:\n");
     printf("  quicattack.exe -list\n\n");
-    printf("  quicattack.exe -type:<number> -ip:<ip_address_and_port> [-alpn:<protocol_name>] [-sni:<host_name>] [-timeout:<ms>] [-threads:<count>] [-rate:<packet_rate>]\n\n");
+    printf("  quicattack.exe -type:<number> -ip:<ip_address_and_port> [-alpn:<protocol_name>] [-sni:<host_name>] [-timeout:<ms>] [-threads:<count>] [-rate:<packet_rate>] [-ports:<source_port_count>]\n\n");
 }
 
 void PrintUsageList()
@@ -64,7 +73,9 @@ void PrintUsageList()
     printf("#1 - Random UDP 1 byte UDP packets.\n");
     printf("#2 - Random UDP full length UDP packets.\n");
     printf("#3 - Random QUIC initial packets.\n");
-    printf("#4 - Valid QUIC initial packets.\n\n");
+    printf("#4 - Valid QUIC initial packets.\n");
+    printf("#5 - Random QUIC short header packets (measures stateless reset rate).\n");
+    printf("#6 - Unsupported version QUIC packets (measures version negotiation rate).\n\n");
 }
 
 struct CallbackContext {
@@ -101,6 +112,23 @@ UdpRecvCallback(
     _In_ CXPLAT_RECV_DATA* RecvBufferChain
     )
 {
+    //
+    // Classify the stateless responses the server sends back to the attack.
+    //
+    for (CXPLAT_RECV_DATA* Data = RecvBufferChain; Data != nullptr; Data = Data->Next) {
+        if (Data->BufferLength < sizeof(QUIC_LONG_HEADER_V1)) {
+            continue;
+        }
+        const QUIC_LONG_HEADER_V1* Header = (const QUIC_LONG_HEADER_V1*)Data->Buffer;
+        if (!Header->IsLongHeader) {
+            InterlockedIncrement64(&StatelessResetCount);
+        } else if (Header->Version == QUIC_VERSION_VER_NEG) {
+            InterlockedIncrement64(&VersionNegotiationCount);
+        } else if (Header->Type == QUIC_RETRY_V1) {
+            InterlockedIncrement64(&RetryCount);
+        }
+        InterlockedIncrement64(&TotalResponseCount);
+    }
     CxPlatRecvDataReturn(RecvBufferChain);
 }
 
@@ -223,6 +251,134 @@ void RunAttackRandom(CXPLAT_SOCKET* Binding, uint16_t DatagramLength, bool Valid
     }
 }
 
+//
+// Sends packets that can only be answered statelessly (stateless reset or
+// version negotiation). The server only has one outstanding stateless operation
+// per remote address, so the packets are spread over many source ports.
+//
+void RunAttackStateless(bool VersionNegotiation)
+{
+    const uint16_t DatagramLength =
+        VersionNegotiation ? QUIC_MIN_INITIAL_LENGTH : ATTACK_STATELESS_LENGTH;
+
+    CXPLAT_SOCKET** Bindings =
+        (CXPLAT_SOCKET**)CXPLAT_ALLOC_PAGED(SourcePortCount * sizeof(CXPLAT_SOCKET*), QUIC_POOL_TOOL);
+    CXPLAT_ROUTE* Routes =
+        (CXPLAT_ROUTE*)CXPLAT_ALLOC_PAGED(SourcePortCount * sizeof(CXPLAT_ROUTE), QUIC_POOL_TOOL);
+    uint32_t BindingCount = 0;
+    if (Bindings == nullptr || Routes == nullptr) {
+        printf("Failed to allocate bindings!\n");
+        goto Exit;
+    }
+
+    for (; BindingCount < SourcePortCount; ++BindingCount) {
+        CXPLAT_UDP_CONFIG UdpConfig = {0};
+        UdpConfig.RemoteAddress = &ServerAddress;
+        QUIC_STATUS Status =
+            CxPlatSocketCreateUdp(
+                Datapath,
+                &UdpConfig,
+                &Bindings[BindingCount]);
+        if (QUIC_FAILED(Status)) {
+            printf("CxPlatSocketCreateUdp failed, 0x%x\n", Status);
+            goto Exit;
+        }
+
+        CXPLAT_ROUTE* Route = &Routes[BindingCount];
+        CxPlatZeroMemory(Route, sizeof(*Route));
+        CxPlatSocketGetLocalAddress(Bindings[BindingCount], &Route->LocalAddress);
+        CxPlatSocketGetRemoteAddress(Bindings[BindingCount], &Route->RemoteAddress);
+        CallbackContext Context = {Route, };
+        Status = CxPlatResolveRoute(Bindings[BindingCount], Route, 0, &Context, ResolveRouteComplete);
+        if (Status == QUIC_STATUS_PENDING) {
+            CxPlatEventInitialize(&(Context.Event), FALSE, FALSE);
+            BOOLEAN EventSet = CxPlatEventWaitWithTimeout(Context.Event, (uint32_t)TimeoutMs);
+            CxPlatEventUninitialize(Context.Event);
+            if (!EventSet) {
+                printf("Failed to CxPlatResolveRoute before timeout!\n");
+                ++BindingCount;
+                goto Exit;
+            }
+        }
+    }
+
+    {
+    uint64_t BucketTime = CxPlatTimeMs64(), CurTime;
+    uint64_t BucketCount = 0;
+    uint64_t BucketThreshold = CXPLAT_MAX(1, AttackRate / ThreadCount);
+    uint32_t Next = 0;
+
+    while (CxPlatTimeDiff64(TimeStart, (CurTime = CxPlatTimeMs64())) < TimeoutMs) {
+
+        if (CxPlatTimeDiff64(BucketTime, CurTime) > 1000) {
+            BucketTime = CurTime;
+            BucketCount = 0;
+        }
+
+        if (BucketCount >= BucketThreshold) {
+            continue;
+        }
+
+        CXPLAT_SOCKET* Binding = Bindings[Next];
+        CXPLAT_ROUTE* Route = &Routes[Next];
+        Next = (Next + 1) % BindingCount;
+
+        CXPLAT_SEND_CONFIG SendConfig = {Route, DatagramLength, CXPLAT_ECN_NON_ECT, 0, CXPLAT_DSCP_CS0 };
+        CXPLAT_SEND_DATA* SendData = CxPlatSendDataAlloc(Binding, &SendConfig);
+        if (SendData == nullptr) {
+            continue;
+        }
+
+        QUIC_BUFFER* SendBuffer = CxPlatSendDataAllocBuffer(SendData, DatagramLength);
+        if (SendBuffer == nullptr) {
+            CxPlatSendDataFree(SendData);
+            continue;
+        }
+
+        CxPlatRandom(DatagramLength, SendBuffer->Buffer);
+
+        if (VersionNegotiation) {
+            QUIC_LONG_HEADER_V1* Header =
+                (QUIC_LONG_HEADER_V1*)SendBuffer->Buffer;
+            Header->IsLongHeader = 1;
+            Header->FixedBit = 1;
+            Header->Version = QUIC_VERSION_RESERVED;
+            Header->DestCidLength = 8;
+            Header->DestCid[8] = 8;
+        } else {
+            QUIC_SHORT_HEADER_V1* Header =
+                (QUIC_SHORT_HEADER_V1*)SendBuffer->Buffer;
+            Header->IsLongHeader = 0;
+            Header->FixedBit = 1;
+        }
+
+        InterlockedExchangeAdd64(&TotalPacketCount, 1);
+        InterlockedExchangeAdd64(&TotalByteCount, DatagramLength + 8 + 20);
+
+        CxPlatSocketSend(Binding, Route, SendData);
+
+        BucketCount++;
+    }
+
+    //
+    // Give the last responses a chance to arrive.
+    //
+    CxPlatSleep(100);
+    }
+
+Exit:
+
+    for (uint32_t i = 0; i < BindingCount; ++i) {
+        CxPlatSocketDelete(Bindings[i]);
+    }
+    if (Bindings != nullptr) {
+        CXPLAT_FREE(Bindings, QUIC_POOL_TOOL);
+    }
+    if (Routes != nullptr) {
+        CXPLAT_FREE(Routes, QUIC_POOL_TOOL);
+    }
+}
+
 void RunAttackValidInitial(CXPLAT_SOCKET* Binding)
 {
     const StrBuffer InitialSalt("38762cf7f55934b34d179ae6a4c80cadccbb7f0a");
@@ -358,6 +514,11 @@ void RunAttackValidInitial(CXPLAT_SOCKET* Binding)
 
 CXPLAT_THREAD_CALLBACK(RunAttackThread, /* Context */)
 {
+    if (AttackType == 5 || AttackType == 6) {
+        RunAttackStateless(AttackType == 6);
+        CXPLAT_THREAD_RETURN(QUIC_STATUS_SUCCESS);
+    }
+
     CXPLAT_SOCKET* Binding;
     CXPLAT_UDP_CONFIG UdpConfig = {0};
     UdpConfig.LocalAddress = nullptr;
@@ -428,6 +589,11 @@ void RunAttack()
     uint64_t TimeEnd = CxPlatTimeMs64();
     printf("Packet Rate: %llu KHz\n", (unsigned long long)(TotalPacketCount) / CxPlatTimeDiff64(TimeStart, TimeEnd));
     printf("Bit Rate: %llu mbps\n", (unsigned long long)(8 * TotalByteCount) / (1000 * CxPlatTimeDiff64(TimeStart, TimeEnd)));
+    printf("Response Rate: %llu responses/sec (%llu VN, %llu Retry, %llu Stateless Reset)\n",
+        (unsigned long long)(1000 * TotalResponseCount) / CxPlatTimeDiff64(TimeStart, TimeEnd),
+        (unsigned long long)VersionNegotiationCount,
+        (unsigned long long)RetryCount,
+        (unsigned long long)StatelessResetCount);
     CXPLAT_FREE(Threads, QUIC_POOL_TOOL);
 
     delete Writer;
@@ -448,7 +614,7 @@ main(
         PrintUsageList();
         ErrorCode = 0;
     } else if (!TryGetValue(argc, argv, "type", &AttackType) ||
-        (AttackType <= 0 || AttackType > 4)) {
+        (AttackType <= 0 || AttackType > 6)) {
         PrintUsage();
     } else {
         const CXPLAT_UDP_DATAPATH_CALLBACKS DatapathCallbacks = {
@@ -477,6 +643,10 @@ main(
         TryGetValue(argc, argv, "sni", &ServerName);
         TryGetValue(argc, argv, "timeout", &TimeoutMs);
         TryGetValue(argc, argv, "rate", &AttackRate);
+        TryGetValue(argc, argv, "ports", &SourcePortCount);
+        if (SourcePortCount == 0) {
+            SourcePortCount = 1;
+        }
         if (!TryGetValue(argc, argv, "threads", &ThreadCount)) {
             ThreadCount = ATTACK_THREADS_DEFAULT;
         };
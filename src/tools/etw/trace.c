@@ -311,6 +311,24 @@ QuicTraceGlobalEvent(
             case QUIC_PERF_COUNTER_CONN_LOAD_REJECT:
                 printf("    Total connections rejected due to worker load:      ");
                 break;
+            case QUIC_PERF_COUNTER_CONN_HIBERNATED:
+                printf("    Current connections hibernated while idle:          ");
+                break;
+            case QUIC_PERF_COUNTER_CONN_HIBERNATED_BYTES:
+                printf("    Current memory held by hibernated connections:      ");
+                break;
+            case QUIC_PERF_COUNTER_CONN_RECV_QUEUED:
+                printf("    Total datagram chains queued to connections:        ");
+                break;
+            case QUIC_PERF_COUNTER_WORK_WAKES:
+                printf("    Total worker wake ups:                              ");
+                break;
+            case QUIC_PERF_COUNTER_DATAPATH_REMOTE_FREES:
+                printf("    Total recv buffers freed on another NUMA node:      ");
+                break;
+            case QUIC_PERF_COUNTER_DATAPATH_CROSS_NODE_SENDS:
+                printf("    Total send buffers for another NUMA node's socket:  ");
+                break;
             default:
                 printf("    Unknown:                                            ");
                 break;